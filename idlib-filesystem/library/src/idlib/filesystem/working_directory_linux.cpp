@@ -27,6 +27,7 @@
 #if defined(ID_LINUX)
 
 #include <memory>
+#include <stdexcept>
 
 #include <unistd.h>
 
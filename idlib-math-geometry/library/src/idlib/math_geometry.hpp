@@ -34,11 +34,22 @@
 
 #include "idlib/math_geometry/axis_aligned_box.hpp"
 #include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/bounding_volume_hierarchy.hpp"
 #include "idlib/math_geometry/cone.hpp"
+#include "idlib/math_geometry/dynamic_bounding_volume_hierarchy.hpp"
+#include "idlib/math_geometry/frustum.hpp"
+#include "idlib/math_geometry/kd_tree.hpp"
 #include "idlib/math_geometry/line.hpp"
+#include "idlib/math_geometry/loose_octree.hpp"
 #include "idlib/math_geometry/plane.hpp"
 #include "idlib/math_geometry/ray.hpp"
+#include "idlib/math_geometry/ray_cast.hpp"
+#include "idlib/math_geometry/ray_packet.hpp"
+#include "idlib/math_geometry/shadow_cascades.hpp"
 #include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math_geometry/sweep_and_prune.hpp"
+#include "idlib/math_geometry/triangle.hpp"
+#include "idlib/math_geometry/uniform_grid.hpp"
 
 #include "idlib/math_geometry/enclose_axis_aligned_box_in_axis_aligned_cube.hpp"
 #include "idlib/math_geometry/enclose_axis_aligned_box_in_sphere.hpp"
@@ -46,6 +57,8 @@
 #include "idlib/math_geometry/enclose_sphere_in_axis_aligned_box.hpp"
 
 #include "idlib/math_geometry/is_intersecting_axis_aligned_box_axis_aligned_cube.hpp"
+#include "idlib/math_geometry/is_intersecting_axis_aligned_box_sphere.hpp"
+#include "idlib/math_geometry/is_intersecting_axis_aligned_cube_sphere.hpp"
 
 #undef IDLIB_PRIVATE
 #pragma pop_macro("IDLIB_PRIVATE")
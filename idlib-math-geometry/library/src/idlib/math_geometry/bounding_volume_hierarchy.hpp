@@ -0,0 +1,672 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/bounding_volume_hierarchy.hpp
+/// @brief Bounding volume hierarchies of axis aligned boxes.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::bounding_volume_hierarchy is built from an array of axis aligned boxes, e.g. the bounds of the objects of a scene.
+/// Queries report the indices of the boxes in that array.
+/// @code
+/// idlib::bounding_volume_hierarchy<idlib::point<idlib::vector<single, 3>>> h(boxes.data(), boxes.size(), idlib::execution_policy::parallel());
+/// h.query(idlib::sphere<idlib::point<idlib::vector<single, 3>>>(p, r), [](size_t i) { /* box i intersects the sphere */ });
+/// h.query(ray, t_max, [](size_t i, single& t_max) { /* box i is hit by the ray, shrink t_max if object i is hit */ return false; });
+/// h.query(packet, t_max, [](size_t i, unsigned int hits, single *t_max) { /* box i is hit by the rays of the bitmask */ return false; });
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/ray_packet.hpp"
+#include "idlib/math/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief Get half of the surface area of an axis aligned box.
+/// @param min, max the minimum and the maximum of the axis aligned box
+/// @return the sum over the axes of the products of the extents along the other axes
+template <typename P>
+typename P::scalar_type half_area(const P& min, const P& max)
+{
+    using scalar_type = typename P::scalar_type;
+    scalar_type a = zero<scalar_type>();
+    for (size_t i = 0; i < P::dimensionality(); ++i)
+    {
+        scalar_type p = one<scalar_type>();
+        for (size_t j = 0; j < P::dimensionality(); ++j)
+        {
+            if (j != i)
+            { p *= max[j] - min[j]; }
+        }
+        a += p;
+    }
+    return a;
+}
+
+} // namespace internal
+
+/// @brief A bounding volume hierarchy of axis aligned boxes.
+/// @detail The hierarchy is a binary tree. Each node stores the axis aligned box enclosing the boxes below it.
+/// The nodes are stored in a single array with the children of a node next to each other.
+/// The hierarchy is built top-down. A node is split by the binned surface area heuristic (SAH):
+/// The centroids of its boxes are sorted into number_of_bins() bins along each axis and the split between two bins with the
+/// lowest expected cost of a query is selected. The expected cost of a split is proportional to
+/// \f$A + A_L N_L + A_R N_R\f$ where \f$A\f$, \f$A_L\f$, and \f$A_R\f$ are the surface areas of the node and its children and
+/// \f$N_L\f$ and \f$N_R\f$ are the numbers of boxes of the children. The first term is the cost of testing the children.
+/// A node with at most the maximum number of boxes of a leaf becomes a leaf if that cost is not lower than the cost \f$A N\f$ of the
+/// node as a leaf.
+/// @tparam P the point type
+template <typename P>
+struct bounding_volume_hierarchy
+{
+public:
+    /// @brief The point type of this bounding volume hierarchy type.
+    using point_type = P;
+
+    /// @brief The vector type of this bounding volume hierarchy type.
+    using vector_type = typename P::vector_type;
+
+    /// @brief The scalar type of this bounding volume hierarchy type.
+    using scalar_type = typename P::scalar_type;
+
+    /// @brief The axis aligned box type of this bounding volume hierarchy type.
+    using box_type = axis_aligned_box<P>;
+
+    /// @brief The ray type of this bounding volume hierarchy type.
+    using ray_type = ray<P>;
+
+    /// @brief A node of a bounding volume hierarchy.
+    struct node
+    {
+        /// @brief The axis aligned box enclosing the axis aligned boxes of this node.
+        box_type bounds;
+        /// @brief If this node is a leaf, the index of the first index of its boxes in get_indices().
+        /// Otherwise the index of the left child. The right child follows the left child.
+        std::uint32_t first;
+        /// @brief If this node is a leaf, the number of its boxes. Otherwise @a 0.
+        std::uint32_t count;
+
+        /// @brief Get if this node is a leaf.
+        /// @return @a true if this node is a leaf, @a false otherwise
+        bool is_leaf() const
+        { return count != 0; }
+    };
+
+    /// @brief The maximum number of bins of the binned surface area heuristic.
+    /// @remark The number of bins of a node is the minimum of this number and the number of boxes of the node.
+    static constexpr size_t number_of_bins()
+    { return 16; }
+
+    /// @brief The maximum depth of a bounding volume hierarchy.
+    /// @remark Nodes at that depth are leaves regardless of their numbers of boxes.
+    static constexpr size_t maximum_depth()
+    { return 64; }
+
+    /// @brief Construct this bounding volume hierarchy with its default values.
+    /// @remark The default values of a bounding volume hierarchy are no boxes.
+    bounding_volume_hierarchy()
+    {}
+
+    /// @brief Construct this bounding volume hierarchy from an array of axis aligned boxes.
+    /// @param boxes pointer to the first box
+    /// @param count the number of boxes. Must be smaller than \f$2^{32}\f$.
+    /// @param policy the execution policy. The subtrees of nodes with fewer than <c>minimum_elements_per_thread</c> boxes
+    /// are built by a single thread.
+    /// @param maximum_leaf_size the maximum number of boxes of a leaf. Must be greater than @a 0.
+    /// @throw std::invalid_argument @a count is not smaller than \f$2^{32}\f$ or @a maximum_leaf_size is @a 0
+    bounding_volume_hierarchy(const box_type *boxes, size_t count, const execution_policy& policy = execution_policy::sequential(),
+                              size_t maximum_leaf_size = 4);
+
+    bounding_volume_hierarchy(const bounding_volume_hierarchy&) = default;
+    bounding_volume_hierarchy& operator=(const bounding_volume_hierarchy&) = default;
+
+    /// @brief Get the number of boxes of this bounding volume hierarchy.
+    /// @return the number of boxes
+    size_t size() const
+    { return m_indices.size(); }
+
+    /// @brief Get if this bounding volume hierarchy has no boxes.
+    /// @return @a true if this bounding volume hierarchy has no boxes, @a false otherwise
+    bool empty() const
+    { return m_indices.empty(); }
+
+    /// @brief Get the nodes of this bounding volume hierarchy.
+    /// @return the nodes. The first node is the root node unless this bounding volume hierarchy is empty.
+    const std::vector<node>& get_nodes() const
+    { return m_nodes; }
+
+    /// @brief Get the indices of the boxes of the leaves of this bounding volume hierarchy.
+    /// @return the indices
+    const std::vector<std::uint32_t>& get_indices() const
+    { return m_indices; }
+
+    /// @brief Get the axis aligned box enclosing the boxes of this bounding volume hierarchy.
+    /// @return the axis aligned box
+    /// @throw std::logic_error this bounding volume hierarchy is empty
+    const box_type& get_bounds() const
+    {
+        if (empty())
+        { throw std::logic_error("bounding volume hierarchy is empty"); }
+        return m_nodes[0].bounds;
+    }
+
+    /// @brief Invoke a function for each box intersecting a geometry.
+    /// @param g the geometry, e.g. an axis aligned box, a sphere, or a point.
+    /// idlib::is_intersecting_functor must be specialized for an axis aligned box and the geometry.
+    /// @param f the function receiving the index of a box
+    template <typename G, typename F>
+    void query(const G& g, F&& f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+        std::uint32_t stack[maximum_depth()];
+        size_t n = 0;
+        std::uint32_t k = 0;
+        while (true)
+        {
+            const node& x = m_nodes[k];
+            if (is_intersecting(x.bounds, g))
+            {
+                if (x.is_leaf())
+                {
+                    for (size_t i = x.first, m = x.first + x.count; i < m; ++i)
+                    {
+                        if (is_intersecting(m_boxes[i], g))
+                        { f(size_t(m_indices[i])); }
+                    }
+                }
+                else
+                {
+                    stack[n++] = x.first + 1;
+                    k = x.first;
+                    continue;
+                }
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            k = stack[--n];
+        }
+    }
+
+    /// @brief Invoke a function for each box hit by a ray.
+    /// @param r the ray
+    /// @param t_max the maximum distance
+    /// @param f the function receiving the index of a box and a reference to the maximum distance.
+    /// The function may decrease the maximum distance, e.g. to the distance of the closest hit found so far.
+    /// If the function returns @a true, the traversal terminates.
+    /// @remark The boxes are visited front to back, as far as that is possible for a hierarchy:
+    /// Of two children, the child the ray enters first is visited first.
+    /// Subtrees and boxes entered by the ray beyond the maximum distance are skipped.
+    template <typename F>
+    void query(const ray_type& r, scalar_type t_max, F&& f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+        const internal::ray_box_test<P> test(r);
+        struct entry
+        {
+            std::uint32_t node;
+            scalar_type t;
+        };
+        entry stack[maximum_depth()];
+        size_t n = 0;
+        scalar_type t;
+        if (!test(m_nodes[0].bounds, t_max, t))
+        {
+            return;
+        }
+        std::uint32_t k = 0;
+        while (true)
+        {
+            const node& x = m_nodes[k];
+            if (x.is_leaf())
+            {
+                for (size_t i = x.first, m = x.first + x.count; i < m; ++i)
+                {
+                    if (test(m_boxes[i], t_max, t) && f(size_t(m_indices[i]), t_max))
+                    {
+                        return;
+                    }
+                }
+            }
+            else
+            {
+                scalar_type t0, t1;
+                const bool h0 = test(m_nodes[x.first].bounds, t_max, t0),
+                           h1 = test(m_nodes[x.first + 1].bounds, t_max, t1);
+                if (h0 && h1)
+                {
+                    if (t1 < t0)
+                    {
+                        stack[n++] = entry{ x.first, t0 };
+                        k = x.first + 1;
+                    }
+                    else
+                    {
+                        stack[n++] = entry{ x.first + 1, t1 };
+                        k = x.first;
+                    }
+                    continue;
+                }
+                if (h0 || h1)
+                {
+                    k = h0 ? x.first : x.first + 1;
+                    continue;
+                }
+            }
+            // Pop the next subtree entered by the ray within the maximum distance.
+            while (n > 0 && stack[n - 1].t > t_max)
+            {
+                --n;
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            k = stack[--n].node;
+        }
+    }
+
+    /// @brief Invoke a function for each box hit by any ray of a ray packet.
+    /// @param r the ray packet
+    /// @param t_max a pointer to the N maximum distances of the rays
+    /// @param f the function receiving the index of a box, the bitmask of the rays hitting the box (see idlib::ray_cast)
+    /// and the pointer to the maximum distances. The function may decrease the maximum distances.
+    /// If the function returns @a true, the traversal terminates.
+    /// @remark A node is visited if any ray of the packet hits its box within its maximum distance
+    /// such that the traversal of coherent rays is shared by the rays.
+    /// Of two children, the child nearer along the direction of the first ray of the packet is visited first.
+    template <size_t N, typename F>
+    void query(const ray_packet<P, N>& r, scalar_type *t_max, F&& f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+        vector_type d;
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            d[i] = r.get_directions(i)[0];
+        }
+        std::uint32_t stack[maximum_depth()];
+        size_t n = 0;
+        scalar_type t[N];
+        std::uint32_t k = 0;
+        while (true)
+        {
+            const node& x = m_nodes[k];
+            if (0 != ray_cast(r, x.bounds, t_max, t))
+            {
+                if (x.is_leaf())
+                {
+                    for (size_t i = x.first, m = x.first + x.count; i < m; ++i)
+                    {
+                        const unsigned int hits = ray_cast(r, m_boxes[i], t_max, t);
+                        if (0 != hits && f(size_t(m_indices[i]), hits, t_max))
+                        {
+                            return;
+                        }
+                    }
+                }
+                else
+                {
+                    // The sign of the projection of the difference of the centers of the children onto the direction.
+                    const box_type& b0 = m_nodes[x.first].bounds, & b1 = m_nodes[x.first + 1].bounds;
+                    scalar_type s = zero<scalar_type>();
+                    for (size_t i = 0; i < P::dimensionality(); ++i)
+                    {
+                        s += ((b1.get_min()[i] + b1.get_max()[i]) - (b0.get_min()[i] + b0.get_max()[i])) * d[i];
+                    }
+                    const std::uint32_t front = s < zero<scalar_type>() ? x.first + 1 : x.first;
+                    stack[n++] = front == x.first ? x.first + 1 : x.first;
+                    k = front;
+                    continue;
+                }
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            k = stack[--n];
+        }
+    }
+
+private:
+    /// @brief The nodes.
+    std::vector<node> m_nodes;
+
+    /// @brief The indices of the boxes of the leaves.
+    std::vector<std::uint32_t> m_indices;
+
+    /// @brief The boxes of the leaves in the order of their indices.
+    std::vector<box_type> m_boxes;
+
+}; // struct bounding_volume_hierarchy
+
+namespace internal {
+
+/// @internal
+/// @brief Builder of bounding volume hierarchies.
+template <typename P>
+struct bounding_volume_hierarchy_builder
+{
+    using hierarchy_type = bounding_volume_hierarchy<P>;
+    using node_type = typename hierarchy_type::node;
+    using box_type = typename hierarchy_type::box_type;
+    using scalar_type = typename P::scalar_type;
+    static constexpr size_t D = P::dimensionality();
+    static constexpr size_t B = hierarchy_type::number_of_bins();
+
+    /// @internal
+    /// @brief A box, its centroid, and its index.
+    /// The references are partitioned in place such that the boxes of a node are read sequentially.
+    struct reference
+    {
+        P min, max, centroid;
+        std::uint32_t index;
+    };
+
+    /// @internal
+    /// @brief A subtree built by a single thread.
+    struct task
+    {
+        /// @brief The index of the root node of the subtree.
+        size_t node;
+        /// @brief The range of the indices of the boxes of the subtree.
+        size_t begin, end;
+        /// @brief The depth of the root node of the subtree.
+        size_t depth;
+        /// @brief The nodes of the subtree.
+        std::vector<node_type> nodes;
+    };
+
+    reference *references;
+    size_t maximum_leaf_size;
+    /// @brief Nodes with at most this number of boxes are roots of tasks. If @a 0, no tasks are created.
+    size_t task_size;
+    std::vector<task> *tasks;
+
+    /// @internal
+    /// @brief Build the subtree of a node.
+    /// @param nodes the nodes
+    /// @param k the index of the node. The node must have been added.
+    /// @param begin, end the range of the indices of the boxes of the node
+    /// @param depth the depth of the node
+    void build(std::vector<node_type>& nodes, size_t k, size_t begin, size_t end, size_t depth) const
+    {
+        const size_t count = end - begin;
+        if (task_size != 0 && count <= task_size)
+        {
+            tasks->push_back(task{ k, begin, end, depth, std::vector<node_type>() });
+            return;
+        }
+        // Compute the bounds of the boxes and the bounds of their centroids.
+        P min(uninitialized), max(uninitialized), cmin(uninitialized), cmax(uninitialized);
+        bounds(begin, end, min, max, cmin, cmax);
+        nodes[k].bounds = box_type(min, max);
+        size_t axis, split;
+        if (count <= 1 || depth + 1 >= hierarchy_type::maximum_depth() || !find_split(begin, end, min, max, cmin, cmax, axis, split))
+        {
+            make_leaf(nodes[k], begin, end);
+            return;
+        }
+        size_t middle;
+        if (split == 0)
+        {
+            // All centroids are equal: Split the boxes in two halves.
+            middle = begin + count / 2;
+        }
+        else
+        {
+            const size_t m = std::min(B, count);
+            const scalar_type lo = cmin[axis], scale = scalar_type(m) / (cmax[axis] - cmin[axis]);
+            middle = std::partition(references + begin, references + end, [axis, split, m, lo, scale](const reference& r)
+            { return bin(r.centroid[axis], m, lo, scale) < split; }) - references;
+        }
+        const size_t left = nodes.size();
+        nodes.resize(left + 2);
+        nodes[k].first = std::uint32_t(left);
+        nodes[k].count = 0;
+        build(nodes, left, begin, middle, depth + 1);
+        build(nodes, left + 1, middle, end, depth + 1);
+    }
+
+private:
+    static size_t bin(scalar_type c, size_t m, scalar_type lo, scalar_type scale)
+    { return std::min(m - 1, size_t((c - lo) * scale)); }
+
+    static void empty(P& min, P& max)
+    {
+        for (size_t i = 0; i < D; ++i)
+        {
+            min[i] = std::numeric_limits<scalar_type>::max();
+            max[i] = std::numeric_limits<scalar_type>::lowest();
+        }
+    }
+
+    static void join(P& min, P& max, const P& a, const P& b)
+    {
+        for (size_t i = 0; i < D; ++i)
+        {
+            min[i] = std::min(min[i], a[i]);
+            max[i] = std::max(max[i], b[i]);
+        }
+    }
+
+    void bounds(size_t begin, size_t end, P& min, P& max, P& cmin, P& cmax) const
+    {
+        empty(min, max);
+        empty(cmin, cmax);
+        for (size_t i = begin; i < end; ++i)
+        {
+            const reference& r = references[i];
+            join(min, max, r.min, r.max);
+            join(cmin, cmax, r.centroid, r.centroid);
+        }
+    }
+
+    void make_leaf(node_type& x, size_t begin, size_t end) const
+    {
+        x.first = std::uint32_t(begin);
+        x.count = std::uint32_t(end - begin);
+    }
+
+    // Find the split with the lowest cost.
+    // Return false if the node should be a leaf. Otherwise the split is before bin split along the axis, or split is 0 if all centroids are equal.
+    bool find_split(size_t begin, size_t end, const P& min, const P& max, const P& cmin, const P& cmax, size_t& axis, size_t& split) const
+    {
+        struct bin_type
+        {
+            bin_type() : min(uninitialized), max(uninitialized), count(0)
+            {}
+            P min, max;
+            size_t count;
+        };
+        const size_t count = end - begin, m = std::min(B, count);
+        // The boxes are binned along all axes in a single pass as reading them is the dominant cost.
+        bin_type bins[D][B];
+        scalar_type lo[D], scale[D];
+        for (size_t a = 0; a < D; ++a)
+        {
+            lo[a] = cmin[a];
+            scale[a] = cmax[a] > cmin[a] ? scalar_type(m) / (cmax[a] - cmin[a]) : zero<scalar_type>();
+            for (size_t s = 0; s < m; ++s)
+            {
+                empty(bins[a][s].min, bins[a][s].max);
+                bins[a][s].count = 0;
+            }
+        }
+        for (size_t i = begin; i < end; ++i)
+        {
+            const reference& r = references[i];
+            for (size_t a = 0; a < D; ++a)
+            {
+                bin_type& b = bins[a][bin(r.centroid[a], m, lo[a], scale[a])];
+                join(b.min, b.max, r.min, r.max);
+                b.count++;
+            }
+        }
+        scalar_type best = std::numeric_limits<scalar_type>::max();
+        split = 0;
+        for (size_t a = 0; a < D; ++a)
+        {
+            if (!(cmax[a] > cmin[a]))
+            {
+                continue;
+            }
+            // The costs of the right sides of the splits, from right to left.
+            scalar_type right[B];
+            P rmin(uninitialized), rmax(uninitialized);
+            empty(rmin, rmax);
+            size_t n = 0;
+            for (size_t s = m - 1; s > 0; --s)
+            {
+                join(rmin, rmax, bins[a][s].min, bins[a][s].max);
+                n += bins[a][s].count;
+                right[s] = n == 0 ? zero<scalar_type>() : half_area(rmin, rmax) * scalar_type(n);
+            }
+            P lmin(uninitialized), lmax(uninitialized);
+            empty(lmin, lmax);
+            n = 0;
+            for (size_t s = 1; s < m; ++s)
+            {
+                join(lmin, lmax, bins[a][s - 1].min, bins[a][s - 1].max);
+                n += bins[a][s - 1].count;
+                if (n == 0 || n == count)
+                {
+                    continue;
+                }
+                const scalar_type cost = half_area(lmin, lmax) * scalar_type(n) + right[s];
+                if (cost < best)
+                {
+                    best = cost;
+                    axis = a;
+                    split = s;
+                }
+            }
+        }
+        if (split == 0)
+        {
+            // All centroids are equal.
+            return count > maximum_leaf_size;
+        }
+        // Nodes with at most maximum_leaf_size boxes are leaves unless a split is cheaper.
+        const scalar_type area = half_area(min, max);
+        return count > maximum_leaf_size || area + best < area * scalar_type(count);
+    }
+};
+
+} // namespace internal
+
+template <typename P>
+bounding_volume_hierarchy<P>::bounding_volume_hierarchy(const box_type *boxes, size_t count, const execution_policy& policy,
+                                                        size_t maximum_leaf_size)
+{
+    if (count >= size_t(std::numeric_limits<std::uint32_t>::max()))
+    { throw std::invalid_argument("too many boxes"); }
+    if (maximum_leaf_size == 0)
+    { throw std::invalid_argument("maximum leaf size is zero"); }
+    if (count == 0)
+    {
+        return;
+    }
+    using builder_type = internal::bounding_volume_hierarchy_builder<P>;
+    static const auto TWO = one<scalar_type>() + one<scalar_type>();
+    std::vector<typename builder_type::reference> references(count);
+    internal::parallel_for(count, policy, [boxes, &references](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            const P& min = boxes[i].get_min(), & max = boxes[i].get_max();
+            references[i] = { min, max, min + (max - min) / TWO, std::uint32_t(i) };
+        }
+    });
+    // The nodes near the root are built by the calling thread.
+    // Their subtrees with at most task_size boxes are built concurrently and appended afterwards.
+    const size_t threads = internal::number_of_threads(count, policy);
+    const size_t task_size = threads == 1 ? 0 : std::max(policy.minimum_elements_per_thread, count / (4 * threads));
+    std::vector<typename builder_type::task> tasks;
+    const builder_type builder{ references.data(), maximum_leaf_size, task_size, &tasks };
+    // A tree over n boxes has at most 2n - 1 nodes.
+    m_nodes.reserve(2 * count - 1);
+    m_nodes.resize(1);
+    builder.build(m_nodes, 0, 0, count, 0);
+    if (!tasks.empty())
+    {
+        const builder_type task_builder{ references.data(), maximum_leaf_size, 0, nullptr };
+        // The tasks are distributed dynamically as their sizes differ.
+        std::atomic<size_t> next(0);
+        internal::parallel_for(threads, execution_policy{ threads, 1 }, [&tasks, &task_builder, &next](size_t, size_t)
+        {
+            for (size_t i = next++; i < tasks.size(); i = next++)
+            {
+                auto& t = tasks[i];
+                t.nodes.reserve(2 * (t.end - t.begin) - 1);
+                t.nodes.resize(1);
+                task_builder.build(t.nodes, 0, t.begin, t.end, t.depth);
+            }
+        });
+        // The children of the root node of a subtree are at index 1 of its nodes.
+        for (auto& t : tasks)
+        {
+            const std::uint32_t offset = std::uint32_t(m_nodes.size() - 1);
+            for (auto& x : t.nodes)
+            {
+                if (!x.is_leaf())
+                { x.first += offset; }
+            }
+            m_nodes[t.node] = t.nodes[0];
+            m_nodes.insert(m_nodes.end(), t.nodes.begin() + 1, t.nodes.end());
+        }
+    }
+    m_indices.resize(count);
+    m_boxes.resize(count);
+    internal::parallel_for(count, policy, [this, &references](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            m_indices[i] = references[i].index;
+            m_boxes[i] = box_type(references[i].min, references[i].max);
+        }
+    });
+}
+
+} // namespace idlib
@@ -0,0 +1,528 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/dynamic_bounding_volume_hierarchy.hpp
+/// @brief Bounding volume hierarchies of axis aligned boxes supporting insertion, removal, and movement of boxes.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::dynamic_bounding_volume_hierarchy stores the bounds of moving objects. Each object is represented by a proxy.
+/// @code
+/// idlib::dynamic_bounding_volume_hierarchy<idlib::point<idlib::vector<single, 3>>> h(0.1f);
+/// auto proxy = h.insert(bounds); // Keep the proxy with the object.
+/// h.move(proxy, new_bounds);     // If the object moved.
+/// h.query_pairs([](size_t a, size_t b) { /* the fat boxes of the proxies a and b intersect */ });
+/// h.remove(proxy);               // If the object is destroyed.
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/bounding_volume_hierarchy.hpp"
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief A stack storing its first N elements in a fixed array and further elements in a vector.
+/// @remark The depth of a traversal is not bounded by a constant, but rarely exceeds the fixed array.
+template <typename T, size_t N>
+struct traversal_stack
+{
+    bool empty() const
+    { return m_size == 0; }
+
+    void push(const T& x)
+    {
+        if (m_size < N)
+        { m_fixed[m_size] = x; }
+        else
+        { m_overflow.push_back(x); }
+        m_size++;
+    }
+
+    T pop()
+    {
+        m_size--;
+        if (m_size < N)
+        { return m_fixed[m_size]; }
+        const T x = m_overflow.back();
+        m_overflow.pop_back();
+        return x;
+    }
+
+private:
+    T m_fixed[N];
+    std::vector<T> m_overflow;
+    size_t m_size = 0;
+};
+
+} // namespace internal
+
+/// @brief A bounding volume hierarchy of axis aligned boxes supporting insertion, removal, and movement of boxes.
+/// @detail The hierarchy is a binary tree. The leaves store fat boxes: The boxes inserted or moved enlarged by a margin along each axis.
+/// Moving a box within its fat box does not change the hierarchy.
+/// Otherwise the leaf of the box is removed and inserted again with a new fat box.
+/// A leaf is inserted as the sibling of the node for which the increase of the surface areas of the nodes is minimal.
+/// The ancestors of inserted and removed leaves are refitted and rebalanced by tree rotations.
+/// A proxy is the index of the leaf of a box. Proxies remain valid until they are removed.
+/// The proxies of removed boxes are reused.
+/// @tparam P the point type
+template <typename P>
+struct dynamic_bounding_volume_hierarchy
+{
+public:
+    /// @brief The point type of this dynamic bounding volume hierarchy type.
+    using point_type = P;
+
+    /// @brief The vector type of this dynamic bounding volume hierarchy type.
+    using vector_type = typename P::vector_type;
+
+    /// @brief The scalar type of this dynamic bounding volume hierarchy type.
+    using scalar_type = typename P::scalar_type;
+
+    /// @brief The axis aligned box type of this dynamic bounding volume hierarchy type.
+    using box_type = axis_aligned_box<P>;
+
+    /// @brief Construct this dynamic bounding volume hierarchy.
+    /// @param margin the margin by which boxes are enlarged along each axis. Must be non-negative.
+    /// @throw std::invalid_argument @a margin is negative
+    explicit dynamic_bounding_volume_hierarchy(scalar_type margin = zero<scalar_type>())
+        : m_margin(margin)
+    {
+        if (margin < zero<scalar_type>())
+        { throw std::invalid_argument("margin is negative"); }
+    }
+
+    dynamic_bounding_volume_hierarchy(const dynamic_bounding_volume_hierarchy&) = default;
+    dynamic_bounding_volume_hierarchy& operator=(const dynamic_bounding_volume_hierarchy&) = default;
+
+    /// @brief Get the margin by which boxes are enlarged along each axis.
+    /// @return the margin
+    scalar_type get_margin() const
+    { return m_margin; }
+
+    /// @brief Get the number of boxes of this dynamic bounding volume hierarchy.
+    /// @return the number of boxes
+    size_t size() const
+    { return m_size; }
+
+    /// @brief Get if this dynamic bounding volume hierarchy has no boxes.
+    /// @return @a true if this dynamic bounding volume hierarchy has no boxes, @a false otherwise
+    bool empty() const
+    { return m_size == 0; }
+
+    /// @brief Get the height of this dynamic bounding volume hierarchy.
+    /// @return the height. @a 0 if this dynamic bounding volume hierarchy has at most one box.
+    size_t get_height() const
+    { return m_root == null ? 0 : size_t(m_nodes[m_root].height); }
+
+    /// @brief Get the axis aligned box enclosing the fat boxes of this dynamic bounding volume hierarchy.
+    /// @return the axis aligned box
+    /// @throw std::logic_error this dynamic bounding volume hierarchy is empty
+    const box_type& get_bounds() const
+    {
+        if (empty())
+        { throw std::logic_error("dynamic bounding volume hierarchy is empty"); }
+        return m_nodes[m_root].bounds;
+    }
+
+    /// @brief Get the fat box of a proxy.
+    /// @param proxy the proxy
+    /// @return the fat box
+    /// @throw std::invalid_argument @a proxy is not a proxy of this dynamic bounding volume hierarchy
+    const box_type& get_box(size_t proxy) const
+    {
+        validate(proxy);
+        return m_nodes[proxy].bounds;
+    }
+
+    /// @brief Insert a box.
+    /// @param box the box
+    /// @return the proxy of the box
+    size_t insert(const box_type& box)
+    {
+        const std::uint32_t k = allocate();
+        m_nodes[k].bounds = fatten(box);
+        m_nodes[k].height = 0;
+        insert_leaf(k);
+        m_size++;
+        return k;
+    }
+
+    /// @brief Remove a box.
+    /// @param proxy the proxy of the box
+    /// @throw std::invalid_argument @a proxy is not a proxy of this dynamic bounding volume hierarchy
+    void remove(size_t proxy)
+    {
+        validate(proxy);
+        remove_leaf(std::uint32_t(proxy));
+        release(std::uint32_t(proxy));
+        m_size--;
+    }
+
+    /// @brief Move a box.
+    /// @param proxy the proxy of the box
+    /// @param box the moved box
+    /// @return @a true if the fat box of the proxy was changed, @a false if the fat box encloses the moved box
+    /// @throw std::invalid_argument @a proxy is not a proxy of this dynamic bounding volume hierarchy
+    bool move(size_t proxy, const box_type& box)
+    {
+        validate(proxy);
+        const std::uint32_t k = std::uint32_t(proxy);
+        if (is_enclosing(m_nodes[k].bounds, box))
+        {
+            return false;
+        }
+        remove_leaf(k);
+        m_nodes[k].bounds = fatten(box);
+        insert_leaf(k);
+        return true;
+    }
+
+    /// @brief Invoke a function for each fat box intersecting a geometry.
+    /// @param g the geometry, e.g. an axis aligned box, a sphere, or a point.
+    /// idlib::is_intersecting_functor must be specialized for an axis aligned box and the geometry.
+    /// @param f the function receiving the proxy of a box
+    template <typename G, typename F>
+    void query(const G& g, F&& f) const
+    {
+        if (m_root == null)
+        {
+            return;
+        }
+        internal::traversal_stack<std::uint32_t, 64> stack;
+        std::uint32_t k = m_root;
+        while (true)
+        {
+            const node& x = m_nodes[k];
+            if (is_intersecting(x.bounds, g))
+            {
+                if (x.is_leaf())
+                {
+                    f(size_t(k));
+                }
+                else
+                {
+                    stack.push(x.children[1]);
+                    k = x.children[0];
+                    continue;
+                }
+            }
+            if (stack.empty())
+            {
+                break;
+            }
+            k = stack.pop();
+        }
+    }
+
+    /// @brief Invoke a function for each pair of intersecting fat boxes.
+    /// @param f the function receiving the proxies @a a and @a b of the boxes where @a a is smaller than @a b.
+    /// Each pair is reported once.
+    /// @remark The hierarchy is traversed against itself: The pairs of a node are the pairs of its left child,
+    /// the pairs of its right child, and the pairs of intersecting boxes of its left and its right child.
+    /// The latter are found by descending into the larger of two intersecting nodes.
+    template <typename F>
+    void query_pairs(F&& f) const
+    {
+        if (m_root == null)
+        {
+            return;
+        }
+        // A pair (k, k) denotes the pairs of a node, a pair (j, k) with j != k the pairs between two nodes.
+        struct pair
+        {
+            std::uint32_t a, b;
+        };
+        const is_intersecting_functor<box_type, box_type> intersecting{};
+        internal::traversal_stack<pair, 64> stack;
+        if (!m_nodes[m_root].is_leaf())
+        { stack.push(pair{ m_root, m_root }); }
+        while (!stack.empty())
+        {
+            const pair p = stack.pop();
+            const node& a = m_nodes[p.a];
+            if (p.a == p.b)
+            {
+                // Leaves have no pairs.
+                for (std::uint32_t c : a.children)
+                {
+                    if (!m_nodes[c].is_leaf())
+                    { stack.push(pair{ c, c }); }
+                }
+                stack.push(pair{ a.children[0], a.children[1] });
+                continue;
+            }
+            const node& b = m_nodes[p.b];
+            if (!intersecting(a.bounds, b.bounds))
+            {
+                continue;
+            }
+            if (a.is_leaf() && b.is_leaf())
+            {
+                f(size_t(std::min(p.a, p.b)), size_t(std::max(p.a, p.b)));
+            }
+            else if (b.is_leaf() || (!a.is_leaf() && a.height >= b.height))
+            {
+                stack.push(pair{ a.children[0], p.b });
+                stack.push(pair{ a.children[1], p.b });
+            }
+            else
+            {
+                stack.push(pair{ p.a, b.children[0] });
+                stack.push(pair{ p.a, b.children[1] });
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint32_t null = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief A node of a dynamic bounding volume hierarchy.
+    struct node
+    {
+        /// @brief The fat box if this node is a leaf, the box enclosing the boxes of the children otherwise.
+        box_type bounds;
+        /// @brief The index of the parent node or null if this node is the root.
+        /// If this node is free, the index of the next free node or null.
+        std::uint32_t parent;
+        /// @brief The indices of the children if this node is not a leaf.
+        std::uint32_t children[2];
+        /// @brief The height of this node. @a 0 if this node is a leaf, @a -1 if this node is free.
+        std::int32_t height;
+
+        bool is_leaf() const
+        { return height == 0; }
+    };
+
+    /// @brief The nodes. Free nodes form a linked list.
+    std::vector<node> m_nodes;
+
+    /// @brief The index of the root node or null.
+    std::uint32_t m_root = null;
+
+    /// @brief The index of the first free node or null.
+    std::uint32_t m_free = null;
+
+    /// @brief The number of boxes.
+    size_t m_size = 0;
+
+    /// @brief The margin.
+    scalar_type m_margin;
+
+    void validate(size_t proxy) const
+    {
+        if (proxy >= m_nodes.size() || !m_nodes[proxy].is_leaf())
+        { throw std::invalid_argument("invalid proxy"); }
+    }
+
+    box_type fatten(const box_type& box) const
+    {
+        P min = box.get_min(), max = box.get_max();
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            min[i] -= m_margin;
+            max[i] += m_margin;
+        }
+        return box_type(min, max);
+    }
+
+    static scalar_type half_area(const box_type& box)
+    { return internal::half_area(box.get_min(), box.get_max()); }
+
+    static box_type join(const box_type& a, const box_type& b)
+    {
+        box_type c = a;
+        c.join(b);
+        return c;
+    }
+
+    std::uint32_t allocate()
+    {
+        if (m_free == null)
+        {
+            if (m_nodes.size() >= size_t(null))
+            { throw std::length_error("too many nodes"); }
+            m_nodes.emplace_back();
+            m_nodes.back().parent = null;
+            m_nodes.back().children[0] = m_nodes.back().children[1] = null;
+            return std::uint32_t(m_nodes.size() - 1);
+        }
+        const std::uint32_t k = m_free;
+        m_free = m_nodes[k].parent;
+        m_nodes[k].parent = null;
+        m_nodes[k].children[0] = m_nodes[k].children[1] = null;
+        return k;
+    }
+
+    void release(std::uint32_t k)
+    {
+        m_nodes[k].parent = m_free;
+        m_nodes[k].height = -1;
+        m_free = k;
+    }
+
+    // Recompute the height and the bounds of a node from its children.
+    void refit(std::uint32_t k)
+    {
+        node& x = m_nodes[k];
+        const node& a = m_nodes[x.children[0]], & b = m_nodes[x.children[1]];
+        x.height = 1 + std::max(a.height, b.height);
+        x.bounds = join(a.bounds, b.bounds);
+    }
+
+    // Rebalance and refit the ancestors of a node.
+    void refit_ancestors(std::uint32_t k)
+    {
+        while (k != null)
+        {
+            k = rotate(k);
+            refit(k);
+            k = m_nodes[k].parent;
+        }
+    }
+
+    void insert_leaf(std::uint32_t leaf)
+    {
+        if (m_root == null)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = null;
+            return;
+        }
+        // Find the best sibling: Descend into the child for which the increase of the surface areas is minimal
+        // unless making the node itself the sibling is cheaper. The cost of a sibling is the surface area of the new
+        // parent node plus the increase of the surface areas of the ancestors of the sibling ("inheritance").
+        const box_type box = m_nodes[leaf].bounds;
+        std::uint32_t k = m_root;
+        while (!m_nodes[k].is_leaf())
+        {
+            const node& x = m_nodes[k];
+            const scalar_type area = half_area(x.bounds),
+                              combined = half_area(join(x.bounds, box));
+            const scalar_type cost = combined + combined,
+                              inheritance = (combined - area) + (combined - area);
+            scalar_type costs[2];
+            for (size_t i = 0; i < 2; ++i)
+            {
+                const node& c = m_nodes[x.children[i]];
+                costs[i] = half_area(join(c.bounds, box)) + inheritance;
+                if (!c.is_leaf())
+                { costs[i] -= half_area(c.bounds); }
+            }
+            if (cost < costs[0] && cost < costs[1])
+            {
+                break;
+            }
+            k = costs[0] < costs[1] ? x.children[0] : x.children[1];
+        }
+        const std::uint32_t sibling = k;
+        const std::uint32_t parent = allocate();
+        const std::uint32_t grandparent = m_nodes[sibling].parent;
+        node& p = m_nodes[parent];
+        p.parent = grandparent;
+        p.children[0] = sibling;
+        p.children[1] = leaf;
+        p.height = m_nodes[sibling].height + 1;
+        p.bounds = join(box, m_nodes[sibling].bounds);
+        m_nodes[sibling].parent = parent;
+        m_nodes[leaf].parent = parent;
+        if (grandparent == null)
+        {
+            m_root = parent;
+        }
+        else
+        {
+            node& g = m_nodes[grandparent];
+            g.children[g.children[0] == sibling ? 0 : 1] = parent;
+        }
+        refit_ancestors(parent);
+    }
+
+    void remove_leaf(std::uint32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = null;
+            return;
+        }
+        const std::uint32_t parent = m_nodes[leaf].parent,
+                            grandparent = m_nodes[parent].parent;
+        const std::uint32_t sibling = m_nodes[parent].children[m_nodes[parent].children[0] == leaf ? 1 : 0];
+        m_nodes[sibling].parent = grandparent;
+        release(parent);
+        if (grandparent == null)
+        {
+            m_root = sibling;
+        }
+        else
+        {
+            node& g = m_nodes[grandparent];
+            g.children[g.children[0] == parent ? 0 : 1] = sibling;
+            refit_ancestors(grandparent);
+        }
+    }
+
+    // If the heights of the children of a node differ by more than one, rotate the higher child up.
+    // The lower grandchild below the higher child becomes the child of the node and the other grandchild remains.
+    // Return the index of the node at the position of the node. The caller refits that node.
+    std::uint32_t rotate(std::uint32_t k)
+    {
+        node& x = m_nodes[k];
+        const std::int32_t balance = m_nodes[x.children[1]].height - m_nodes[x.children[0]].height;
+        if (balance >= -1 && balance <= 1)
+        {
+            return k;
+        }
+        // The index of the higher child and the index of the lower child.
+        const size_t h = balance > 1 ? 1 : 0;
+        const std::uint32_t u = x.children[h];
+        node& y = m_nodes[u];
+        // The higher child replaces the node.
+        y.parent = x.parent;
+        x.parent = u;
+        if (y.parent == null)
+        {
+            m_root = u;
+        }
+        else
+        {
+            node& p = m_nodes[y.parent];
+            p.children[p.children[0] == k ? 0 : 1] = u;
+        }
+        // The higher grandchild remains a child of the higher child, the lower grandchild becomes a child of the node.
+        const size_t g = m_nodes[y.children[0]].height > m_nodes[y.children[1]].height ? 0 : 1;
+        const std::uint32_t lower = y.children[1 - g];
+        x.children[h] = lower;
+        m_nodes[lower].parent = k;
+        y.children[1 - g] = k;
+        refit(k);
+        return u;
+    }
+
+}; // struct dynamic_bounding_volume_hierarchy
+
+} // namespace idlib
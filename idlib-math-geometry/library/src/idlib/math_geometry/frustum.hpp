@@ -0,0 +1,483 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/frustum.hpp
+/// @brief View frusta and culling of geometries against view frusta.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::frustum is extracted from a view-projection matrix.
+/// idlib::cull tests contiguous arrays of spheres, axis aligned boxes, or axis aligned cubes against a frustum
+/// and writes a visibility bitmask with one bit per geometry.
+/// @code
+/// idlib::frustum<idlib::point<idlib::vector<single, 3>>> f(projection * view);
+/// std::vector<idlib::sphere<idlib::point<idlib::vector<single, 3>>>> spheres(n);
+/// std::vector<uint32_t> visibility(idlib::number_of_visibility_words(n));
+/// ...
+/// idlib::cull(f, spheres.data(), spheres.size(), visibility.data(), idlib::execution_policy::parallel());
+/// for (size_t i = 0; i < n; ++i)
+/// {
+///     if (visibility[i / 32] & (uint32_t(1) << (i % 32))) { /* sphere i is potentially visible */ }
+/// }
+/// @endcode
+/// If a SIMD instruction set is selected, the arrays are tested by SIMD kernels for idlib::single and @a double.
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/plane.hpp"
+#include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/simd.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace idlib {
+
+template <typename P>
+struct frustum;
+
+/// @brief A frustum is the intersection of the positive half-spaces of six planes.
+/// @detail The frustum of a view-projection matrix \f$M\f$ is the set of points \f$p\f$ which are mapped into the clip volume
+/// i.e. \f$-w' \leq x',y',z' \leq w'\f$ where \f$(x',y',z',w') = M(p,1)\f$. This is the convention of
+/// idlib::perspective_projection_matrix and idlib::orthographic_projection_matrix.
+/// @remark Let \f$r_0,\ldots,r_3\f$ be the rows of \f$M\f$. Then \f$-w' \leq x'\f$ is equivalent to \f$(r_3 + r_0) \cdot (p,1) \geq 0\f$
+/// and \f$x' \leq w'\f$ is equivalent to \f$(r_3 - r_0) \cdot (p,1) \geq 0\f$. The plane equations of the left, right,
+/// bottom, top, near, and far plane are hence \f$r_3 + r_0\f$, \f$r_3 - r_0\f$, \f$r_3 + r_1\f$, \f$r_3 - r_1\f$,
+/// \f$r_3 + r_2\f$, and \f$r_3 - r_2\f$. Their normals point into the frustum.
+/// @tparam P the point type of this frustum type
+template <typename S>
+struct frustum<point<vector<S, 3>>> : public equal_to_expr<frustum<point<vector<S, 3>>>>
+{
+public:
+    /// @brief The point type of this frustum type.
+    using point_type = point<vector<S, 3>>;
+
+    /// @brief The vector type of this frustum type.
+    using vector_type = typename point_type::vector_type;
+
+    /// @brief The scalar type of this frustum type.
+    using scalar_type = typename point_type::scalar_type;
+
+    /// @brief The plane type of this frustum type.
+    using plane_type = plane<point_type>;
+
+    /// @brief The matrix type of this frustum type.
+    using matrix_type = matrix<scalar_type, 4, 4>;
+
+    /// @brief The indices of the planes of a frustum.
+    enum plane_index
+    {
+        left = 0,
+        right = 1,
+        bottom = 2,
+        top = 3,
+        z_near = 4,
+        z_far = 5,
+    };
+
+    /// @brief Construct this frustum with the default values of a frustum.
+    /// @remark The default values of a frustum are the planes of the frustum of the identity matrix,
+    /// that is the frustum is the cube \f$[-1,+1]^3\f$.
+    frustum()
+        : frustum(identity<matrix_type>())
+    {}
+
+    /// @brief Construct this frustum from a view-projection matrix.
+    /// @param m the view-projection matrix
+    /// @throw std::domain_error the normal of a plane is the zero vector
+    explicit frustum(const matrix_type& m)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            m_planes[2 * i + 0] = plane_type(m(3, 0) + m(i, 0), m(3, 1) + m(i, 1), m(3, 2) + m(i, 2), m(3, 3) + m(i, 3));
+            m_planes[2 * i + 1] = plane_type(m(3, 0) - m(i, 0), m(3, 1) - m(i, 1), m(3, 2) - m(i, 2), m(3, 3) - m(i, 3));
+        }
+    }
+
+    frustum(const frustum&) = default;
+    frustum& operator=(const frustum&) = default;
+
+    /// @brief Get a plane of this frustum.
+    /// @param index the index of the plane
+    /// @return the plane
+    const plane_type& get_plane(plane_index index) const
+    { return m_planes[index]; }
+
+    /// @brief Get the planes of this frustum.
+    /// @return the planes of this frustum in the order of idlib::frustum::plane_index
+    const std::array<plane_type, 6>& get_planes() const
+    { return m_planes; }
+
+    // CRTP
+    bool equal_to(const frustum& other) const
+    { return m_planes == other.m_planes; }
+
+private:
+    /// @brief The planes of this frustum.
+    std::array<plane_type, 6> m_planes;
+
+}; // struct frustum
+
+namespace internal {
+
+/// @internal
+/// @brief Get the signed distance of a point from a plane.
+/// @remark The distance is computed exactly as by the kernels of idlib::internal::cull_kernel.
+template <typename S>
+S plane_distance(const plane<point<vector<S, 3>>>& p, const S& x, const S& y, const S& z)
+{
+    const auto& n = p.get_normal();
+    return ((n[0] * x + n[1] * y) + n[2] * z) + p.get_distance();
+}
+
+/// @internal
+/// @brief Get the signed distance of the corner of an axis aligned box farthest into the positive half-space of a plane.
+template <typename S>
+S plane_distance(const plane<point<vector<S, 3>>>& p, const point<vector<S, 3>>& min, const point<vector<S, 3>>& max)
+{
+    const auto& n = p.get_normal();
+    return plane_distance(p, n[0] >= 0 ? max[0] : min[0], n[1] >= 0 ? max[1] : min[1], n[2] >= 0 ? max[2] : min[2]);
+}
+
+/// @internal
+/// @brief Get the signed distance of the corner of an axis aligned box farthest into the negative half-space of a plane.
+template <typename S>
+S plane_distance_nearest(const plane<point<vector<S, 3>>>& p, const point<vector<S, 3>>& min, const point<vector<S, 3>>& max)
+{ return plane_distance(p, max, min); }
+
+} // namespace internal
+
+/// @brief Specialization of idlib::is_enclosing_functor.
+/// Determines if a frustum contains a point.
+/// @remark A frustum contains a point if the point is in the positive half-spaces of all planes of the frustum
+/// or on the planes.
+template <typename P>
+struct is_enclosing_functor<frustum<P>, P>
+{
+    bool operator()(const frustum<P>& a, const P& b) const
+    {
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance(p, b[0], b[1], b[2]) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_enclosing_functor
+
+/// @brief Specialization of idlib::is_enclosing_functor.
+/// Determines if a frustum contains an axis aligned box.
+/// @remark A frustum contains an axis aligned box if for all planes of the frustum
+/// the corner of the box farthest into the negative half-space of the plane is in the positive half-space of the plane or on the plane.
+template <typename P>
+struct is_enclosing_functor<frustum<P>, axis_aligned_box<P>>
+{
+    bool operator()(const frustum<P>& a, const axis_aligned_box<P>& b) const
+    {
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance_nearest(p, b.get_min(), b.get_max()) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_enclosing_functor
+
+/// @brief Specialization of idlib::is_enclosing_functor.
+/// Determines if a frustum contains an axis aligned cube.
+/// @remark The test is the test of idlib::is_enclosing_functor<frustum<P>, axis_aligned_box<P>>.
+template <typename P>
+struct is_enclosing_functor<frustum<P>, axis_aligned_cube<P>>
+{
+    bool operator()(const frustum<P>& a, const axis_aligned_cube<P>& b) const
+    {
+        const auto min = b.get_min(), max = b.get_max();
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance_nearest(p, min, max) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_enclosing_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a frustum and a sphere intersect.
+/// @remark A sphere with center \f$c\f$ and radius \f$r\f$ is considered as intersecting the frustum
+/// unless \f$d(c) + r < 0\f$ for a plane of the frustum where \f$d(c)\f$ is the signed distance of the center from the plane.
+/// The test is conservative: A sphere outside of the frustum near an edge of the frustum may be considered as intersecting.
+/// That is the usual trade-off for view frustum culling.
+template <typename P>
+struct is_intersecting_functor<frustum<P>, sphere<P>>
+{
+    bool operator()(const frustum<P>& a, const sphere<P>& b) const
+    {
+        const auto& c = b.get_center();
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance(p, c[0], c[1], c[2]) + b.get_radius() < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a frustum and an axis aligned box intersect.
+/// @remark An axis aligned box is considered as intersecting the frustum unless for a plane of the frustum
+/// the corner of the box farthest into the positive half-space of the plane is in the negative half-space of the plane.
+/// The test is conservative (cf. idlib::is_intersecting_functor<frustum<P>, sphere<P>>).
+template <typename P>
+struct is_intersecting_functor<frustum<P>, axis_aligned_box<P>>
+{
+    bool operator()(const frustum<P>& a, const axis_aligned_box<P>& b) const
+    {
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance(p, b.get_min(), b.get_max()) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a frustum and an axis aligned cube intersect.
+/// @remark The test is the test of idlib::is_intersecting_functor<frustum<P>, axis_aligned_box<P>>.
+template <typename P>
+struct is_intersecting_functor<frustum<P>, axis_aligned_cube<P>>
+{
+    bool operator()(const frustum<P>& a, const axis_aligned_cube<P>& b) const
+    {
+        const auto min = b.get_min(), max = b.get_max();
+        for (const auto& p : a.get_planes())
+        {
+            if (internal::plane_distance(p, min, max) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_intersecting_functor
+
+namespace internal {
+
+/// @internal
+/// @brief The kinds of geometries of idlib::internal::cull_kernel.
+enum class cull_kind
+{
+    /// @brief A sphere stored as \f$(c_x,c_y,c_z,r)\f$.
+    sphere,
+    /// @brief An axis aligned box stored as \f$(min_x,min_y,min_z,max_x,max_y,max_z)\f$.
+    axis_aligned_box,
+    /// @brief An axis aligned cube stored as \f$(c_x,c_y,c_z,s)\f$.
+    axis_aligned_cube,
+};
+
+/// @internal
+/// @brief Kernel testing an array of geometries against the planes of a frustum.
+/// @tparam Scalar the scalar type
+/// @tparam Kind the kind of the geometries
+template <typename Scalar, cull_kind Kind>
+struct cull_kernel
+{
+    using scalar_type = Scalar;
+    using pack_type = simd_native_pack<scalar_type>;
+    using register_type = typename pack_type::register_type;
+
+    /// @internal
+    /// @brief The number of scalars of a geometry.
+    static constexpr size_t number_of_scalars()
+    { return Kind == cull_kind::axis_aligned_box ? 6 : 4; }
+
+    /// @internal
+    /// @brief The number of bits of a word of a visibility bitmask.
+    static constexpr size_t bits_per_word()
+    { return 32; }
+
+    /// @internal
+    /// @brief Test an array of geometries.
+    /// @param planes the planes as \f$(n_x,n_y,n_z,d)\f$
+    /// @param source pointer to the first scalar of the first geometry
+    /// @param count the number of geometries
+    /// @param target pointer to the first word of the visibility bitmask
+    /// @remark The geometries of a word are transposed into rows such that the planes can be tested with full registers.
+    /// Spheres are transposed into the rows \f$c_x,c_y,c_z,r\f$, axis aligned boxes and axis aligned cubes into the rows
+    /// \f$min_x,min_y,min_z,max_x,max_y,max_z\f$. The corner of a box farthest into the positive half-space of a plane
+    /// does not depend on the box: It is selected once per plane by selecting the rows of its coordinates.
+    static void apply(const scalar_type (&planes)[6][4], const scalar_type *source, size_t count, std::uint32_t *target)
+    {
+        constexpr size_t B = bits_per_word(), W = pack_type::width();
+        static_assert(B % W == 0, "the number of bits of a word must be a multiple of the width of a pack");
+        alignas(64) scalar_type t[number_of_rows()][B];
+        register_type n[6][4];
+        const scalar_type *r[6][3];
+        for (size_t k = 0; k < 6; ++k)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            { n[k][j] = pack_type::broadcast(planes[k][j]); }
+            for (size_t j = 0; j < 3; ++j)
+            { r[k][j] = t[Kind != cull_kind::sphere && planes[k][j] >= 0 ? j + 3 : j]; }
+        }
+        for (size_t i = 0; i < count; i += B, ++target)
+        {
+            const size_t m = std::min(B, count - i);
+            transpose(t, source + i * number_of_scalars(), m);
+            std::uint32_t culled = 0;
+            for (size_t l = 0; l < B; l += W)
+            {
+                const register_type d = distance(n, r, t[3], l, std::make_index_sequence<6>{});
+                culled |= std::uint32_t(pack_type::bits(pack_type::cmp_gt(pack_type::zero(), d))) << l;
+            }
+            *target = ~culled & (m == B ? ~std::uint32_t(0) : (std::uint32_t(1) << m) - 1);
+        }
+    }
+
+private:
+    static constexpr size_t number_of_rows()
+    { return Kind == cull_kind::sphere ? 4 : 6; }
+
+    // Transpose the first m geometries of a word into the rows and set the remaining columns to zero.
+    static void transpose(scalar_type (&t)[number_of_rows()][bits_per_word()], const scalar_type *s, size_t m)
+    {
+        constexpr size_t K = number_of_scalars();
+        for (size_t l = 0; l < m; ++l, s += K)
+        {
+            if (Kind == cull_kind::axis_aligned_cube)
+            {
+                // The minimum and the maximum are computed as by axis_aligned_cube::get_min and axis_aligned_cube::get_max.
+                const scalar_type h = s[3] / scalar_type(2);
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    t[j][l] = s[j] - h;
+                    t[j + 3][l] = s[j] + h;
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < K; ++j)
+                { t[j][l] = s[j]; }
+            }
+        }
+        for (size_t j = 0; j < number_of_rows(); ++j)
+        { std::fill(t[j] + m, t[j] + bits_per_word(), scalar_type(0)); }
+    }
+
+    // The signed distances of the geometries in the columns [l, l + width()) from the planes: The minimum over the planes.
+    // The loop over the planes is unrolled such that the coefficients of the planes are kept in registers.
+    template <size_t ... Ks>
+    static register_type distance(const register_type (&n)[6][4], const scalar_type *const (&r)[6][3], const scalar_type *radius, size_t l,
+                                  std::index_sequence<Ks ...>)
+    {
+        const register_type x = Kind == cull_kind::sphere ? pack_type::load_aligned(radius + l) : pack_type::zero();
+        const register_type d[] = { distance(n[Ks], r[Ks], x, l) ... };
+        return pack_type::min(pack_type::min(pack_type::min(d[0], d[1]), pack_type::min(d[2], d[3])), pack_type::min(d[4], d[5]));
+    }
+
+    static register_type distance(const register_type (&n)[4], const scalar_type *const (&r)[3], register_type radius, size_t l)
+    {
+        const register_type d = pack_type::add(pack_type::add(pack_type::add(pack_type::mul(n[0], pack_type::load_aligned(r[0] + l)),
+                                                                             pack_type::mul(n[1], pack_type::load_aligned(r[1] + l))),
+                                                              pack_type::mul(n[2], pack_type::load_aligned(r[2] + l))),
+                                               n[3]);
+        return Kind == cull_kind::sphere ? pack_type::add(d, radius) : d;
+    }
+};
+
+/// @internal
+template <cull_kind Kind, typename P, typename T>
+void cull(const frustum<P>& f, const T *source, size_t count, std::uint32_t *target, const execution_policy& policy)
+{
+    using scalar_type = typename P::scalar_type;
+    using kernel_type = cull_kernel<scalar_type, Kind>;
+    static_assert(std::is_standard_layout<T>::value && sizeof(T) == kernel_type::number_of_scalars() * sizeof(scalar_type),
+                  "the scalars of the type are not stored contiguously");
+    scalar_type planes[6][4];
+    for (size_t k = 0; k < 6; ++k)
+    {
+        const auto& p = f.get_planes()[k];
+        for (size_t j = 0; j < 3; ++j)
+        { planes[k][j] = p.get_normal()[j]; }
+        planes[k][3] = p.get_distance();
+    }
+    const scalar_type *s = reinterpret_cast<const scalar_type *>(source);
+    constexpr size_t B = kernel_type::bits_per_word(), K = kernel_type::number_of_scalars();
+    const size_t words = (count + B - 1) / B;
+    parallel_for(words, group_policy(policy, B), [&planes, s, count, target](size_t first, size_t last)
+    {
+        kernel_type::apply(planes, s + first * B * K, std::min(count, last * B) - first * B, target + first);
+    });
+}
+
+} // namespace internal
+
+/// @brief Get the number of words of the visibility bitmask of idlib::cull.
+/// @param count the number of geometries
+/// @return the number of words
+inline size_t number_of_visibility_words(size_t count)
+{ return (count + 31) / 32; }
+
+/// @{
+/// @brief Test an array of geometries against a frustum.
+/// @param f the frustum
+/// @param source pointer to the first geometry
+/// @param count the number of geometries
+/// @param visibility pointer to the first word of the visibility bitmask.
+/// Must have space for at least <c>number_of_visibility_words(count)</c> words.
+/// Bit \f$i \bmod 32\f$ of word \f$\lfloor i / 32 \rfloor\f$ is set if geometry \f$i\f$ intersects the frustum as determined by idlib::is_intersecting.
+/// The bits of the last word beyond @a count are cleared.
+/// @param policy the execution policy
+template <typename P>
+void cull(const frustum<P>& f, const sphere<P> *source, size_t count, std::uint32_t *visibility,
+          const execution_policy& policy = execution_policy::sequential())
+{ internal::cull<internal::cull_kind::sphere>(f, source, count, visibility, policy); }
+
+template <typename P>
+void cull(const frustum<P>& f, const axis_aligned_box<P> *source, size_t count, std::uint32_t *visibility,
+          const execution_policy& policy = execution_policy::sequential())
+{ internal::cull<internal::cull_kind::axis_aligned_box>(f, source, count, visibility, policy); }
+
+template <typename P>
+void cull(const frustum<P>& f, const axis_aligned_cube<P> *source, size_t count, std::uint32_t *visibility,
+          const execution_policy& policy = execution_policy::sequential())
+{ internal::cull<internal::cull_kind::axis_aligned_cube>(f, source, count, visibility, policy); }
+/// @}
+
+} // namespace idlib
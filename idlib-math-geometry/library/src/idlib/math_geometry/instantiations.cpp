@@ -29,10 +29,19 @@
 #define IDLIB_PRIVATE 1
 #include "idlib/math_geometry/axis_aligned_box.hpp"
 #include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/bounding_volume_hierarchy.hpp"
+#include "idlib/math_geometry/dynamic_bounding_volume_hierarchy.hpp"
+#include "idlib/math_geometry/frustum.hpp"
+#include "idlib/math_geometry/kd_tree.hpp"
 #include "idlib/math_geometry/line.hpp"
+#include "idlib/math_geometry/loose_octree.hpp"
 #include "idlib/math_geometry/plane.hpp"
 #include "idlib/math_geometry/ray.hpp"
+#include "idlib/math_geometry/ray_packet.hpp"
 #include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math_geometry/sweep_and_prune.hpp"
+#include "idlib/math_geometry/triangle.hpp"
+#include "idlib/math_geometry/uniform_grid.hpp"
 #undef IDLIB_PRIVATE
 
 #define INSTANTIATE(A) \
@@ -48,9 +57,15 @@
     
 INSTANTIATE(axis_aligned_box)
 INSTANTIATE(axis_aligned_cube)
+INSTANTIATE(bounding_volume_hierarchy)
+INSTANTIATE(dynamic_bounding_volume_hierarchy)
+INSTANTIATE(kd_tree)
 INSTANTIATE(line)
+INSTANTIATE(loose_octree)
 INSTANTIATE(ray)
 INSTANTIATE(sphere)
+INSTANTIATE(sweep_and_prune)
+INSTANTIATE(triangle)
 
 #undef INSTANTIATE
 
@@ -59,6 +74,30 @@ INSTANTIATE(sphere)
     template struct idlib::A<idlib::point<idlib::vector<double, 3>>>; \
     template struct idlib::A<idlib::point<idlib::vector<quadruple, 3>>>;
 
+INSTANTIATE(frustum)
 INSTANTIATE(plane)
 
-#undef INSTANTIATION
+#undef INSTANTIATE
+
+#define INSTANTIATE(A, G) \
+    template struct idlib::A<idlib::G<idlib::point<idlib::vector<single, 2>>>>; \
+    template struct idlib::A<idlib::G<idlib::point<idlib::vector<single, 3>>>>; \
+    template struct idlib::A<idlib::G<idlib::point<idlib::vector<double, 2>>>>; \
+    template struct idlib::A<idlib::G<idlib::point<idlib::vector<double, 3>>>>;
+
+INSTANTIATE(uniform_grid, axis_aligned_box)
+INSTANTIATE(uniform_grid, axis_aligned_cube)
+INSTANTIATE(uniform_grid, sphere)
+
+#undef INSTANTIATE
+
+#define INSTANTIATE(A, N) \
+    template struct idlib::A<idlib::point<idlib::vector<single, 2>>, N>; \
+    template struct idlib::A<idlib::point<idlib::vector<single, 3>>, N>; \
+    template struct idlib::A<idlib::point<idlib::vector<double, 2>>, N>; \
+    template struct idlib::A<idlib::point<idlib::vector<double, 3>>, N>;
+
+INSTANTIATE(ray_packet, 4)
+INSTANTIATE(ray_packet, 8)
+
+#undef INSTANTIATE
@@ -78,4 +78,28 @@ struct is_intersecting_functor<axis_aligned_cube<P>, axis_aligned_box<P>>
     { return is_intersecting(b, a); }
 }; // is_intersecting_functor
 
+/// @brief Specialization of idlib::is_enclosing_functor.
+/// Determines if an axis aligned box contains an axis aligned cube.
+/// @remark An axis aligned box \f$X\f$ contains an axis aligned cube \f$Y\f$
+/// if for all axes \f$k\f$ the following conditions are true:
+/// - \f$X_{min_k} \leq Y_{min_k}\f$
+/// - \f$X_{max_k} \geq Y_{max_k}\f$
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_enclosing_functor<axis_aligned_box<P>, axis_aligned_cube<P>>
+{
+    bool operator()(const axis_aligned_box<P>& a, const axis_aligned_cube<P>& b) const
+    {
+        const auto min = b.get_min(), max = b.get_max();
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            if (a.get_min()[i] > min[i] || a.get_max()[i] < max[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}; // struct is_enclosing_functor
+
 } // namespace idlib
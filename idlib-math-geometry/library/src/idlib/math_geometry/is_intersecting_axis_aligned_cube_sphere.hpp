@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/is_intersecting_axis_aligned_cube_sphere.hpp
+/// @brief Get if an axis aligned cube and a sphere intersect.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/sphere.hpp"
+#include <cmath>
+
+namespace idlib {
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if an axis aligned cube and a sphere intersect.
+/// @remark An axis aligned cube \f$X\f$ with the center \f$X_c\f$ and the size \f$X_s\f$ and a sphere \f$Y\f$ with the center
+/// \f$Y_c\f$ and the radius \f$Y_r\f$ intersect if \f$|Q - Y_c|^2 \leq Y_r^2\f$ holds where \f$Q\f$ is the point of \f$X\f$
+/// closest to \f$Y_c\f$. The components of \f$Q - Y_c\f$ are the amounts by which \f$|X_{c_k} - Y_{c_k}|\f$ exceed \f$\frac{X_s}{2}\f$.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<axis_aligned_cube<P>, sphere<P>>
+{
+    bool operator()(const axis_aligned_cube<P>& a, const sphere<P>& b) const
+    {
+        using scalar_type = typename P::scalar_type;
+        static const auto TWO = one<scalar_type>() + one<scalar_type>();
+        const scalar_type h = a.get_size() / TWO;
+        auto distance_squared = zero<scalar_type>();
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            // If the center of the sphere is outside of the cube along this axis,
+            // then add the squared distance to the nearer face.
+            const auto d = std::abs(b.get_center()[i] - a.get_center()[i]) - h;
+            if (d > zero<scalar_type>())
+            {
+                distance_squared += d * d;
+            }
+        }
+        return distance_squared <= b.get_radius_squared();
+    }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a sphere and an axis aligned cube intersect.
+/// @remark The method which determines wether an axis aligned cube and
+/// a sphere intersect is re-used.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<sphere<P>, axis_aligned_cube<P>>
+{
+    bool operator()(const sphere<P>& a, const axis_aligned_cube<P>& b) const
+    { return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+} // namespace idlib
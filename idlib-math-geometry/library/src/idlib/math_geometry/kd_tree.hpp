@@ -0,0 +1,479 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/kd_tree.hpp
+/// @brief k-d trees of points.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::kd_tree is built from an array of points, e.g. a point cloud. Queries report the indices of the points in that array.
+/// @code
+/// idlib::kd_tree<idlib::point<idlib::vector<single, 3>>> t(points.data(), points.size(), idlib::execution_policy::parallel());
+/// auto n = t.nearest(p);                  // The nearest point is points[n.index].
+/// t.nearest(p, 8, neighbors);             // The 8 nearest points.
+/// t.query(idlib::sphere<idlib::point<idlib::vector<single, 3>>>(p, r), [](size_t i) { /* point i is in the sphere */ });
+/// t.nearest(queries.data(), queries.size(), 8, neighbors, idlib::execution_policy::parallel(0, 64)); // 8 nearest points of each query.
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+/// @brief A k-d tree of points.
+/// @detail The nodes of a k-d tree are cells. The cell of the root node encloses all points. The cell of an inner node is split by a
+/// plane orthogonal to the axis along which the cell has its greatest extent. The plane is placed at the median of the coordinates of the
+/// points of the cell along that axis such that the numbers of points of the children differ by at most one. Hence the depth of a tree over
+/// \f$n\f$ points is at most \f$\lceil \log_2 n \rceil\f$. Cells with at most the maximum leaf size points are leaves.
+///
+/// The nodes are stored in an array with the children of a node next to each other.
+/// The points are copied and ordered such that the points of a leaf are contiguous.
+///
+/// Nearest neighbor queries visit the child on the side of the query point first and skip cells farther away than the
+/// \f$k\f$-th nearest point found so far. Approximate queries with \f$\epsilon > 0\f$ skip cells farther away than that distance divided
+/// by \f$1 + \epsilon\f$, hence the distance of the \f$i\f$-th reported point is at most \f$1 + \epsilon\f$ times the distance of the
+/// \f$i\f$-th nearest point.
+/// @tparam P the point type
+template <typename P>
+struct kd_tree
+{
+public:
+    /// @brief The point type of this k-d tree type.
+    using point_type = P;
+
+    /// @brief The scalar type of this k-d tree type.
+    using scalar_type = typename P::scalar_type;
+
+    /// @brief The sphere type of this k-d tree type.
+    using sphere_type = sphere<P>;
+
+    /// @brief A node of a k-d tree.
+    struct node
+    {
+        /// @brief If this node is an inner node, the coordinate of the splitting plane along its axis.
+        /// The points of the left child are not greater and the points of the right child are not smaller than this coordinate.
+        scalar_type split;
+        /// @brief If this node is a leaf, the index of its first point in get_points().
+        /// Otherwise the index of the left child. The right child follows the left child.
+        std::uint32_t first;
+        /// @brief If this node is a leaf, the number of its points. Otherwise @a 0.
+        std::uint32_t count;
+        /// @brief If this node is an inner node, the axis of the splitting plane.
+        std::uint32_t axis;
+
+        /// @brief Get if this node is a leaf.
+        /// @return @a true if this node is a leaf, @a false otherwise
+        bool is_leaf() const
+        { return count != 0; }
+    };
+
+    /// @brief A point reported by a nearest neighbor query.
+    struct neighbor
+    {
+        /// @brief The index of the point.
+        size_t index;
+        /// @brief The squared distance of the point from the query point.
+        scalar_type squared_distance;
+    };
+
+    /// @brief The maximum depth of a k-d tree.
+    static constexpr size_t maximum_depth()
+    { return 64; }
+
+    /// @brief Construct this k-d tree with its default values.
+    /// @remark The default values of a k-d tree are no points.
+    kd_tree()
+    {}
+
+    /// @brief Construct this k-d tree from an array of points.
+    /// @param points pointer to the first point
+    /// @param count the number of points. Must be smaller than \f$2^{32}\f$.
+    /// @param policy the execution policy. The subtrees of nodes with fewer than <c>minimum_elements_per_thread</c> points
+    /// are built by a single thread.
+    /// @param maximum_leaf_size the maximum number of points of a leaf. Must be greater than @a 0.
+    /// @throw std::invalid_argument @a count is not smaller than \f$2^{32}\f$ or @a maximum_leaf_size is @a 0
+    kd_tree(const P *points, size_t count, const execution_policy& policy = execution_policy::sequential(), size_t maximum_leaf_size = 8);
+
+    kd_tree(const kd_tree&) = default;
+    kd_tree& operator=(const kd_tree&) = default;
+
+    /// @brief Get the number of points of this k-d tree.
+    /// @return the number of points
+    size_t size() const
+    { return m_points.size(); }
+
+    /// @brief Get if this k-d tree has no points.
+    /// @return @a true if this k-d tree has no points, @a false otherwise
+    bool empty() const
+    { return m_points.empty(); }
+
+    /// @brief Get the nodes of this k-d tree.
+    /// @return the nodes. The first node is the root node unless this k-d tree is empty.
+    const std::vector<node>& get_nodes() const
+    { return m_nodes; }
+
+    /// @brief Get the points of the leaves of this k-d tree.
+    /// @return the points
+    const std::vector<P>& get_points() const
+    { return m_points; }
+
+    /// @brief Get the indices of the points of the leaves of this k-d tree.
+    /// @return the indices
+    const std::vector<std::uint32_t>& get_indices() const
+    { return m_indices; }
+
+    /// @brief Get the nearest point of a point.
+    /// @param p the point
+    /// @param epsilon the approximation parameter. Must not be negative. If @a 0, the nearest point is found.
+    /// @return the nearest point
+    /// @throw std::logic_error this k-d tree is empty
+    neighbor nearest(const P& p, scalar_type epsilon = zero<scalar_type>()) const
+    {
+        neighbor n;
+        if (nearest(p, 1, &n, epsilon) == 0)
+        { throw std::logic_error("k-d tree is empty"); }
+        return n;
+    }
+
+    /// @brief Get the \f$k\f$ nearest points of a point.
+    /// @param p the point
+    /// @param k the number of points
+    /// @param neighbors pointer to an array of @a k neighbors receiving the nearest points sorted by distance
+    /// @param epsilon the approximation parameter. Must not be negative. If @a 0, the nearest points are found.
+    /// @return the number of points stored, the minimum of @a k and the number of points of this k-d tree
+    size_t nearest(const P& p, size_t k, neighbor *neighbors, scalar_type epsilon = zero<scalar_type>()) const
+    {
+        if (k == 0 || empty())
+        {
+            return 0;
+        }
+        const scalar_type factor = (one<scalar_type>() + epsilon) * (one<scalar_type>() + epsilon);
+        const auto farther = [](const neighbor& a, const neighbor& b) { return a.squared_distance < b.squared_distance; };
+        // The neighbors found so far form a max-heap with respect to their distances.
+        size_t n = 0;
+        struct entry
+        {
+            std::uint32_t node;
+            scalar_type squared_distance;
+        };
+        entry stack[maximum_depth()];
+        size_t m = 0;
+        stack[m++] = entry{ 0, zero<scalar_type>() };
+        while (m > 0)
+        {
+            const entry e = stack[--m];
+            if (n == k && e.squared_distance * factor >= neighbors[0].squared_distance)
+            {
+                continue;
+            }
+            const node *x = &m_nodes[e.node];
+            while (!x->is_leaf())
+            {
+                // The squared distance of the cell of the far child is at least the squared distance of the point from the plane.
+                const scalar_type d = p[x->axis] - x->split;
+                const entry far{ d < zero<scalar_type>() ? x->first + 1 : x->first, std::max(e.squared_distance, d * d) };
+                if (n < k || far.squared_distance * factor < neighbors[0].squared_distance)
+                { stack[m++] = far; }
+                x = &m_nodes[d < zero<scalar_type>() ? x->first : x->first + 1];
+            }
+            for (size_t i = x->first, j = x->first + x->count; i < j; ++i)
+            {
+                const scalar_type d = squared_distance(p, m_points[i]);
+                if (n < k)
+                {
+                    neighbors[n++] = neighbor{ m_indices[i], d };
+                    std::push_heap(neighbors, neighbors + n, farther);
+                }
+                else if (d < neighbors[0].squared_distance)
+                {
+                    std::pop_heap(neighbors, neighbors + n, farther);
+                    neighbors[n - 1] = neighbor{ m_indices[i], d };
+                    std::push_heap(neighbors, neighbors + n, farther);
+                }
+            }
+        }
+        std::sort_heap(neighbors, neighbors + n, farther);
+        return n;
+    }
+
+    /// @brief Get the \f$k\f$ nearest points of each point of an array of points.
+    /// @param points pointer to the first point
+    /// @param count the number of points
+    /// @param k the number of points per point
+    /// @param neighbors pointer to an array of <c>count * k</c> neighbors.
+    /// The neighbors \f$i k, \ldots, i k + k - 1\f$ receive the nearest points of point \f$i\f$ sorted by distance.
+    /// If this k-d tree has fewer than @a k points, only the first neighbors are assigned.
+    /// @param policy the execution policy
+    /// @param epsilon the approximation parameter. Must not be negative. If @a 0, the nearest points are found.
+    void nearest(const P *points, size_t count, size_t k, neighbor *neighbors, const execution_policy& policy = execution_policy::sequential(),
+                 scalar_type epsilon = zero<scalar_type>()) const
+    {
+        internal::parallel_for(count, policy, [this, points, k, neighbors, epsilon](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            { nearest(points[i], k, neighbors + i * k, epsilon); }
+        });
+    }
+
+    /// @brief Invoke a function for each point in a sphere.
+    /// @param s the sphere
+    /// @param f the function receiving the index of a point
+    template <typename F>
+    void query(const sphere_type& s, F&& f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+        const P& c = s.get_center();
+        const scalar_type r = s.get_radius_squared();
+        struct entry
+        {
+            std::uint32_t node;
+            scalar_type squared_distance;
+        };
+        entry stack[maximum_depth()];
+        size_t m = 0;
+        stack[m++] = entry{ 0, zero<scalar_type>() };
+        while (m > 0)
+        {
+            const entry e = stack[--m];
+            const node *x = &m_nodes[e.node];
+            while (!x->is_leaf())
+            {
+                const scalar_type d = c[x->axis] - x->split;
+                const entry far{ d < zero<scalar_type>() ? x->first + 1 : x->first, std::max(e.squared_distance, d * d) };
+                if (far.squared_distance <= r)
+                { stack[m++] = far; }
+                x = &m_nodes[d < zero<scalar_type>() ? x->first : x->first + 1];
+            }
+            for (size_t i = x->first, j = x->first + x->count; i < j; ++i)
+            {
+                if (squared_distance(c, m_points[i]) <= r)
+                { f(size_t(m_indices[i])); }
+            }
+        }
+    }
+
+    /// @brief Invoke a function for each point in each sphere of an array of spheres.
+    /// @param spheres pointer to the first sphere
+    /// @param count the number of spheres
+    /// @param f the function receiving the index of a sphere and the index of a point.
+    /// The function is invoked concurrently for different spheres if more than one thread is used.
+    /// @param policy the execution policy
+    template <typename F>
+    void query(const sphere_type *spheres, size_t count, F&& f, const execution_policy& policy = execution_policy::sequential()) const
+    {
+        internal::parallel_for(count, policy, [this, spheres, &f](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            { query(spheres[i], [&f, i](size_t j) { f(i, j); }); }
+        });
+    }
+
+private:
+    /// @brief The nodes.
+    std::vector<node> m_nodes;
+
+    /// @brief The points of the leaves.
+    std::vector<P> m_points;
+
+    /// @brief The indices of the points of the leaves.
+    std::vector<std::uint32_t> m_indices;
+
+    static scalar_type squared_distance(const P& a, const P& b)
+    {
+        scalar_type d = zero<scalar_type>();
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        { d += (a[i] - b[i]) * (a[i] - b[i]); }
+        return d;
+    }
+};
+
+namespace internal {
+
+/// @internal
+/// @brief Builds the nodes of a k-d tree.
+template <typename P>
+struct kd_tree_builder
+{
+    using tree_type = kd_tree<P>;
+    using node_type = typename tree_type::node;
+    using scalar_type = typename P::scalar_type;
+
+    /// @internal
+    /// @brief A point and its index.
+    /// The references are partitioned in place such that the points of a node are contiguous.
+    struct reference
+    {
+        P point;
+        std::uint32_t index;
+    };
+
+    /// @internal
+    /// @brief A subtree built by a single thread.
+    struct task
+    {
+        /// @brief The index of the root node of the subtree.
+        size_t node;
+        /// @brief The range of the indices of the points of the subtree.
+        size_t begin, end;
+        /// @brief The cell of the root node of the subtree.
+        P min, max;
+        /// @brief The nodes of the subtree.
+        std::vector<node_type> nodes;
+    };
+
+    reference *references;
+    size_t maximum_leaf_size;
+    /// @brief Nodes with at most this number of points are roots of tasks. If @a 0, no tasks are created.
+    size_t task_size;
+    std::vector<task> *tasks;
+
+    /// @internal
+    /// @brief Build the subtree of a node.
+    /// @param nodes the nodes
+    /// @param k the index of the node. The node must have been added.
+    /// @param begin, end the range of the indices of the points of the node
+    /// @param min, max the cell of the node
+    void build(std::vector<node_type>& nodes, size_t k, size_t begin, size_t end, const P& min, const P& max) const
+    {
+        const size_t count = end - begin;
+        if (task_size != 0 && count <= task_size)
+        {
+            tasks->push_back(task{ k, begin, end, min, max, std::vector<node_type>() });
+            return;
+        }
+        if (count <= maximum_leaf_size)
+        {
+            nodes[k] = node_type{ zero<scalar_type>(), std::uint32_t(begin), std::uint32_t(count), 0 };
+            return;
+        }
+        size_t axis = 0;
+        for (size_t i = 1; i < P::dimensionality(); ++i)
+        {
+            if (max[i] - min[i] > max[axis] - min[axis])
+            { axis = i; }
+        }
+        const size_t middle = begin + count / 2;
+        std::nth_element(references + begin, references + middle, references + end,
+                         [axis](const reference& a, const reference& b) { return a.point[axis] < b.point[axis]; });
+        const scalar_type split = references[middle].point[axis];
+        const size_t left = nodes.size();
+        nodes.resize(left + 2);
+        nodes[k] = node_type{ split, std::uint32_t(left), 0, std::uint32_t(axis) };
+        P left_max = max, right_min = min;
+        left_max[axis] = split;
+        right_min[axis] = split;
+        build(nodes, left, begin, middle, min, left_max);
+        build(nodes, left + 1, middle, end, right_min, max);
+    }
+};
+
+} // namespace internal
+
+template <typename P>
+kd_tree<P>::kd_tree(const P *points, size_t count, const execution_policy& policy, size_t maximum_leaf_size)
+{
+    if (count >= size_t(std::numeric_limits<std::uint32_t>::max()))
+    { throw std::invalid_argument("too many points"); }
+    if (maximum_leaf_size == 0)
+    { throw std::invalid_argument("maximum leaf size is zero"); }
+    if (count == 0)
+    {
+        return;
+    }
+    using builder_type = internal::kd_tree_builder<P>;
+    std::vector<typename builder_type::reference> references(count);
+    internal::parallel_for(count, policy, [points, &references](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        { references[i] = { points[i], std::uint32_t(i) }; }
+    });
+    P min = points[0], max = points[0];
+    for (size_t i = 1; i < count; ++i)
+    {
+        for (size_t j = 0; j < P::dimensionality(); ++j)
+        {
+            min[j] = std::min(min[j], points[i][j]);
+            max[j] = std::max(max[j], points[i][j]);
+        }
+    }
+    // The nodes near the root are built by the calling thread.
+    // Their subtrees with at most task_size points are built concurrently and appended afterwards.
+    const size_t threads = internal::number_of_threads(count, policy);
+    const size_t task_size = threads == 1 ? 0 : std::max(policy.minimum_elements_per_thread, count / (4 * threads));
+    std::vector<typename builder_type::task> tasks;
+    const builder_type builder{ references.data(), maximum_leaf_size, task_size, &tasks };
+    m_nodes.resize(1);
+    builder.build(m_nodes, 0, 0, count, min, max);
+    if (!tasks.empty())
+    {
+        const builder_type task_builder{ references.data(), maximum_leaf_size, 0, nullptr };
+        // The tasks are distributed dynamically as their sizes differ.
+        std::atomic<size_t> next(0);
+        internal::parallel_for(threads, execution_policy{ threads, 1 }, [&tasks, &task_builder, &next](size_t, size_t)
+        {
+            for (size_t i = next++; i < tasks.size(); i = next++)
+            {
+                auto& t = tasks[i];
+                t.nodes.resize(1);
+                task_builder.build(t.nodes, 0, t.begin, t.end, t.min, t.max);
+            }
+        });
+        // The children of the root node of a subtree are at index 1 of its nodes.
+        for (auto& t : tasks)
+        {
+            const std::uint32_t offset = std::uint32_t(m_nodes.size() - 1);
+            for (auto& x : t.nodes)
+            {
+                if (!x.is_leaf())
+                { x.first += offset; }
+            }
+            m_nodes[t.node] = t.nodes[0];
+            m_nodes.insert(m_nodes.end(), t.nodes.begin() + 1, t.nodes.end());
+        }
+    }
+    m_indices.resize(count);
+    m_points.resize(count);
+    internal::parallel_for(count, policy, [this, &references](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            m_indices[i] = references[i].index;
+            m_points[i] = references[i].point;
+        }
+    });
+}
+
+} // namespace idlib
@@ -0,0 +1,553 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/loose_octree.hpp
+/// @brief Loose octrees of axis aligned boxes.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::loose_octree stores the bounds of moving objects. Each object is represented by a handle.
+/// @code
+/// idlib::loose_octree<idlib::point<idlib::vector<single, 3>>> t(idlib::axis_aligned_cube<idlib::point<idlib::vector<single, 3>>>(center, 1024.0f));
+/// auto handle = t.insert(bounds); // Keep the handle with the object.
+/// t.move(handle, new_bounds);     // If the object moved.
+/// t.query(frustum, [](size_t handle) { /* the bounds of the object intersect the frustum */ });
+/// t.remove(handle);               // If the object is destroyed.
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/is_intersecting_axis_aligned_box_axis_aligned_cube.hpp"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief Get if idlib::is_enclosing_functor is specialized for two geometry types.
+template <typename A, typename B, typename = void>
+struct has_is_enclosing_functor : std::false_type
+{};
+
+template <typename A, typename B>
+struct has_is_enclosing_functor<A, B, std::void_t<decltype(is_enclosing_functor<A, B>()(std::declval<const A&>(), std::declval<const B&>()))>>
+    : std::true_type
+{};
+
+/// @internal
+/// @brief Get if a geometry is enclosing another geometry if idlib::is_enclosing_functor is specialized for the geometry types.
+/// @return the result of idlib::is_enclosing if idlib::is_enclosing_functor is specialized, @a false otherwise
+template <typename A, typename B>
+bool is_enclosing_if_specialized(const A& a, const B& b, std::true_type)
+{ return is_enclosing(a, b); }
+
+template <typename A, typename B>
+bool is_enclosing_if_specialized(const A&, const B&, std::false_type)
+{ return false; }
+
+} // namespace internal
+
+/// @brief A loose octree of axis aligned boxes.
+/// @detail The nodes of the octree are axis aligned cubes. The root node is a given cube, the \f$2^n\f$ children of a node are the
+/// cubes of half its size sharing a corner with it and its center. The loose cube of a node is the cube with the same center and twice
+/// the size. An axis aligned box is stored in the deepest node which contains its center and whose size is at least twice the greatest
+/// extent of the box along an axis. Hence the loose cube of that node contains the box. The node is determined by the center and the
+/// extent of the box alone and is found by descending at most maximum depth levels, creating nodes as required.
+/// Boxes with their center outside of the root node are stored in the root node.
+///
+/// The objects of a node form a doubly linked list such that removing an object takes constant time.
+/// Moving an object within its node takes constant time, otherwise it is removed and inserted again.
+/// Nodes without objects in their subtrees are removed. The nodes and the objects are stored in pools.
+///
+/// The tests are performed by idlib::is_intersecting. If idlib::is_enclosing is available for the geometry of a query and an
+/// axis aligned cube, then the objects of the subtree of a node whose loose cube is contained in the geometry are reported without tests.
+/// @tparam P the point type
+template <typename P>
+struct loose_octree
+{
+public:
+    /// @brief The point type of this loose octree type.
+    using point_type = P;
+
+    /// @brief The vector type of this loose octree type.
+    using vector_type = typename P::vector_type;
+
+    /// @brief The scalar type of this loose octree type.
+    using scalar_type = typename P::scalar_type;
+
+    /// @brief The axis aligned box type of this loose octree type.
+    using box_type = axis_aligned_box<P>;
+
+    /// @brief The axis aligned cube type of this loose octree type.
+    using cube_type = axis_aligned_cube<P>;
+
+    /// @brief The number of children of a node.
+    /// @return \f$2^n\f$
+    static constexpr size_t number_of_children()
+    { return size_t(1) << P::dimensionality(); }
+
+    /// @brief The greatest maximum depth of a loose octree.
+    static constexpr size_t greatest_maximum_depth()
+    { return 16; }
+
+    /// @brief The memory used by the nodes of a depth.
+    struct level_statistics
+    {
+        /// @brief The number of nodes.
+        size_t number_of_nodes;
+        /// @brief The number of objects of the nodes.
+        size_t number_of_objects;
+        /// @brief The number of Bytes of the nodes and the objects.
+        size_t number_of_bytes;
+    };
+
+    /// @brief Construct this loose octree.
+    /// @param bounds the cube of the root node. Its size must be positive.
+    /// @param maximum_depth the maximum depth of a node. Must not be greater than greatest_maximum_depth().
+    /// @throw std::invalid_argument the size of @a bounds is not positive or @a maximum_depth is greater than greatest_maximum_depth()
+    explicit loose_octree(const cube_type& bounds, size_t maximum_depth = 8)
+        : m_center(bounds.get_center()), m_maximum_depth(maximum_depth)
+    {
+        if (!(bounds.get_size() > zero<scalar_type>()))
+        { throw std::invalid_argument("size is not positive"); }
+        if (maximum_depth > greatest_maximum_depth())
+        { throw std::invalid_argument("maximum depth is too great"); }
+        static const auto TWO = one<scalar_type>() + one<scalar_type>();
+        m_sizes[0] = bounds.get_size();
+        for (size_t i = 1; i <= maximum_depth; ++i)
+        { m_sizes[i] = m_sizes[i - 1] / TWO; }
+        m_root = allocate_node(null, 0, m_center);
+    }
+
+    loose_octree(const loose_octree&) = default;
+    loose_octree& operator=(const loose_octree&) = default;
+
+    /// @brief Get the cube of the root node.
+    /// @return the cube
+    cube_type get_bounds() const
+    { return cube_type(m_center, m_sizes[0]); }
+
+    /// @brief Get the maximum depth of a node.
+    /// @return the maximum depth
+    size_t get_maximum_depth() const
+    { return m_maximum_depth; }
+
+    /// @brief Get the number of objects of this loose octree.
+    /// @return the number of objects
+    size_t size() const
+    { return m_nodes[m_root].count; }
+
+    /// @brief Get if this loose octree has no objects.
+    /// @return @a true if this loose octree has no objects, @a false otherwise
+    bool empty() const
+    { return size() == 0; }
+
+    /// @brief Get the box of an object.
+    /// @param handle the handle of the object
+    /// @return the box
+    /// @throw std::invalid_argument @a handle is not a handle of this loose octree
+    const box_type& get_box(size_t handle) const
+    {
+        validate(handle);
+        return m_objects[handle].box;
+    }
+
+    /// @brief Get the depth of the node of an object.
+    /// @param handle the handle of the object
+    /// @return the depth
+    /// @throw std::invalid_argument @a handle is not a handle of this loose octree
+    size_t get_depth(size_t handle) const
+    {
+        validate(handle);
+        return m_nodes[m_objects[handle].node].depth;
+    }
+
+    /// @brief Insert an object.
+    /// @param box the box of the object
+    /// @return the handle of the object
+    size_t insert(const box_type& box)
+    {
+        const std::uint32_t k = allocate_object();
+        m_objects[k].box = box;
+        link(k, find_node(box));
+        return k;
+    }
+
+    /// @brief Remove an object.
+    /// @param handle the handle of the object
+    /// @throw std::invalid_argument @a handle is not a handle of this loose octree
+    void remove(size_t handle)
+    {
+        validate(handle);
+        const std::uint32_t k = std::uint32_t(handle);
+        unlink(k);
+        release_object(k);
+    }
+
+    /// @brief Move an object.
+    /// @param handle the handle of the object
+    /// @param box the box of the moved object
+    /// @return @a true if the object was moved to another node, @a false otherwise
+    /// @throw std::invalid_argument @a handle is not a handle of this loose octree
+    bool move(size_t handle, const box_type& box)
+    {
+        validate(handle);
+        const std::uint32_t k = std::uint32_t(handle);
+        object& o = m_objects[k];
+        o.box = box;
+        // The object remains in its node if the node is the node of the box.
+        const node& x = m_nodes[o.node];
+        const P c = box.get_center();
+        const bool outside = !contains(m_nodes[m_root], c);
+        if (o.node == m_root ? outside || get_target_depth(box) == 0
+                             : !outside && get_target_depth(box) == x.depth && contains(x, c))
+        {
+            return false;
+        }
+        unlink(k);
+        link(k, find_node(box));
+        return true;
+    }
+
+    /// @brief Invoke a function for each object intersecting a geometry.
+    /// @param g the geometry, e.g. a frustum, an axis aligned box, or a sphere.
+    /// idlib::is_intersecting_functor must be specialized for the geometry and an axis aligned cube and for the geometry and an axis aligned box.
+    /// @param f the function receiving the handle of an object
+    template <typename G, typename F>
+    void query(const G& g, F&& f) const
+    {
+        static const auto TWO = one<scalar_type>() + one<scalar_type>();
+        // At most number_of_children() - 1 siblings of the nodes on the path to a node are on the stack.
+        // An entry is a node index and a flag indicating wether the loose cube of the node is contained in the geometry.
+        struct entry { std::uint32_t node; bool enclosed; };
+        entry stack[(number_of_children() - 1) * greatest_maximum_depth() + 1];
+        size_t n = 0;
+        if (m_nodes[m_root].count != 0)
+        { stack[n++] = entry{ m_root, false }; }
+        while (n > 0)
+        {
+            const entry e = stack[--n];
+            const node& x = m_nodes[e.node];
+            for (std::uint32_t i = x.first; i != null; i = m_objects[i].next)
+            {
+                if (e.enclosed || is_intersecting(g, m_objects[i].box))
+                { f(size_t(i)); }
+            }
+            for (std::uint32_t c : x.children)
+            {
+                if (c == null)
+                { continue; }
+                if (e.enclosed)
+                {
+                    stack[n++] = entry{ c, true };
+                    continue;
+                }
+                const cube_type loose(m_nodes[c].center, m_sizes[x.depth + 1] * TWO);
+                if (is_intersecting(g, loose))
+                {
+                    stack[n++] = entry{ c, internal::is_enclosing_if_specialized(g, loose, internal::has_is_enclosing_functor<G, cube_type>()) };
+                }
+            }
+        }
+    }
+
+    /// @brief Get the memory used by the nodes of each depth.
+    /// @return the statistics of the depths \f$0, \ldots, d\f$ where \f$d\f$ is the greatest depth of a node
+    std::vector<level_statistics> get_statistics() const
+    {
+        std::vector<level_statistics> levels;
+        for (size_t k = 0; k < m_nodes.size(); ++k)
+        {
+            const node& x = m_nodes[k];
+            if (x.depth == free_depth)
+            {
+                continue;
+            }
+            if (levels.size() <= x.depth)
+            { levels.resize(x.depth + 1, level_statistics{ 0, 0, 0 }); }
+            level_statistics& l = levels[x.depth];
+            l.number_of_nodes++;
+            l.number_of_bytes += sizeof(node);
+            for (std::uint32_t i = x.first; i != null; i = m_objects[i].next)
+            {
+                l.number_of_objects++;
+                l.number_of_bytes += sizeof(object);
+            }
+        }
+        return levels;
+    }
+
+    /// @brief Get the memory used by this loose octree including free nodes and objects in the pools.
+    /// @return the number of Bytes
+    size_t get_memory_usage() const
+    { return m_nodes.capacity() * sizeof(node) + m_objects.capacity() * sizeof(object); }
+
+private:
+    static constexpr std::uint32_t null = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief The depth of a free node.
+    static constexpr std::uint32_t free_depth = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief A node of a loose octree.
+    struct node
+    {
+        /// @brief The center of the cube of this node.
+        P center;
+        /// @brief The index of the parent node or null if this node is the root.
+        /// If this node is free, the index of the next free node or null.
+        std::uint32_t parent;
+        /// @brief The depth of this node or free_depth if this node is free.
+        std::uint32_t depth;
+        /// @brief The index of the first object of this node or null.
+        std::uint32_t first;
+        /// @brief The number of objects of this node and its descendants.
+        std::uint32_t count;
+        /// @brief The indices of the children or null.
+        std::uint32_t children[number_of_children()];
+    };
+
+    /// @brief An object of a loose octree.
+    struct object
+    {
+        /// @brief The box of this object.
+        box_type box;
+        /// @brief The index of the node of this object or null if this object is free.
+        std::uint32_t node;
+        /// @brief The indices of the previous and the next object of the node or null.
+        /// If this object is free, the index of the next free object or null.
+        std::uint32_t previous, next;
+    };
+
+    /// @brief The center of the root node.
+    P m_center;
+
+    /// @brief The sizes of the nodes of each depth.
+    scalar_type m_sizes[greatest_maximum_depth() + 1];
+
+    /// @brief The maximum depth.
+    size_t m_maximum_depth;
+
+    /// @brief The nodes.
+    std::vector<node> m_nodes;
+
+    /// @brief The objects.
+    std::vector<object> m_objects;
+
+    /// @brief The index of the root node.
+    std::uint32_t m_root;
+
+    /// @brief The index of the first free node or null.
+    std::uint32_t m_free_node = null;
+
+    /// @brief The index of the first free object or null.
+    std::uint32_t m_free_object = null;
+
+    void validate(size_t handle) const
+    {
+        if (handle >= m_objects.size() || m_objects[handle].node == null)
+        { throw std::invalid_argument("invalid handle"); }
+    }
+
+    bool contains(const node& x, const P& p) const
+    {
+        static const auto TWO = one<scalar_type>() + one<scalar_type>();
+        const scalar_type h = m_sizes[x.depth] / TWO;
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            if (p[i] < x.center[i] - h || p[i] > x.center[i] + h)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Get the depth of the node of a box: The greatest depth at which the size of a node is at least twice the greatest extent of the box.
+    size_t get_target_depth(const box_type& box) const
+    {
+        const auto s = box.get_size();
+        scalar_type e = s[0];
+        for (size_t i = 1; i < P::dimensionality(); ++i)
+        { e = std::max(e, s[i]); }
+        size_t depth = 0;
+        while (depth < m_maximum_depth && m_sizes[depth + 1] >= e)
+        {
+            ++depth;
+        }
+        return depth;
+    }
+
+    // Get the node of a box, creating nodes as required.
+    std::uint32_t find_node(const box_type& box)
+    {
+        static const auto TWO = one<scalar_type>() + one<scalar_type>();
+        const P c = box.get_center();
+        std::uint32_t k = m_root;
+        if (!contains(m_nodes[k], c))
+        {
+            return k;
+        }
+        for (size_t depth = get_target_depth(box), d = 0; d < depth; ++d)
+        {
+            // The child containing the center. Bit i of its index is set if the center is on the positive side along axis i.
+            const P& center = m_nodes[k].center;
+            const scalar_type h = m_sizes[d + 1] / TWO;
+            size_t j = 0;
+            P child = center;
+            for (size_t i = 0; i < P::dimensionality(); ++i)
+            {
+                if (c[i] >= center[i])
+                {
+                    j |= size_t(1) << i;
+                    child[i] += h;
+                }
+                else
+                {
+                    child[i] -= h;
+                }
+            }
+            std::uint32_t u = m_nodes[k].children[j];
+            if (u == null)
+            {
+                u = allocate_node(k, d + 1, child);
+                m_nodes[k].children[j] = u;
+            }
+            k = u;
+        }
+        return k;
+    }
+
+    // Add an object to the objects of a node.
+    void link(std::uint32_t k, std::uint32_t u)
+    {
+        object& o = m_objects[k];
+        node& x = m_nodes[u];
+        o.node = u;
+        o.previous = null;
+        o.next = x.first;
+        if (x.first != null)
+        { m_objects[x.first].previous = k; }
+        x.first = k;
+        for (std::uint32_t v = u; v != null; v = m_nodes[v].parent)
+        { m_nodes[v].count++; }
+    }
+
+    // Remove an object from the objects of its node. Remove the nodes without objects in their subtrees except for the root.
+    void unlink(std::uint32_t k)
+    {
+        object& o = m_objects[k];
+        node& x = m_nodes[o.node];
+        if (o.previous != null)
+        { m_objects[o.previous].next = o.next; }
+        else
+        { x.first = o.next; }
+        if (o.next != null)
+        { m_objects[o.next].previous = o.previous; }
+        std::uint32_t v = o.node;
+        o.node = null;
+        while (v != null)
+        {
+            node& y = m_nodes[v];
+            const std::uint32_t parent = y.parent;
+            if (--y.count == 0 && parent != null)
+            {
+                node& p = m_nodes[parent];
+                for (auto& c : p.children)
+                {
+                    if (c == v)
+                    { c = null; }
+                }
+                release_node(v);
+            }
+            v = parent;
+        }
+    }
+
+    std::uint32_t allocate_node(std::uint32_t parent, size_t depth, const P& center)
+    {
+        std::uint32_t k = m_free_node;
+        if (k == null)
+        {
+            if (m_nodes.size() >= size_t(null))
+            { throw std::length_error("too many nodes"); }
+            k = std::uint32_t(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        else
+        {
+            m_free_node = m_nodes[k].parent;
+        }
+        node& x = m_nodes[k];
+        x.center = center;
+        x.parent = parent;
+        x.depth = std::uint32_t(depth);
+        x.first = null;
+        x.count = 0;
+        for (auto& c : x.children)
+        { c = null; }
+        return k;
+    }
+
+    void release_node(std::uint32_t k)
+    {
+        // A node without objects in its subtree has no children.
+        m_nodes[k].depth = free_depth;
+        m_nodes[k].parent = m_free_node;
+        m_free_node = k;
+    }
+
+    std::uint32_t allocate_object()
+    {
+        std::uint32_t k = m_free_object;
+        if (k == null)
+        {
+            if (m_objects.size() >= size_t(null))
+            { throw std::length_error("too many objects"); }
+            k = std::uint32_t(m_objects.size());
+            m_objects.emplace_back();
+        }
+        else
+        {
+            m_free_object = m_objects[k].next;
+        }
+        return k;
+    }
+
+    void release_object(std::uint32_t k)
+    {
+        m_objects[k].next = m_free_object;
+        m_free_object = k;
+    }
+
+}; // struct loose_octree
+
+} // namespace idlib
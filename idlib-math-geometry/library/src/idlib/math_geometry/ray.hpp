@@ -89,7 +89,7 @@ public:
     /// @throw idlib::runtime_error the direction vecotr is the zero vector
     void set_direction(const vector_type& direction)
     {
-        auto result = normalize(m_direction, euclidean_norm_functor<vector_type>{});
+        auto result = normalize(direction, euclidean_norm_functor<vector_type>{});
         if (result.get_length() == zero<scalar_type>())
         { throw runtime_error(__FILE__, __LINE__, "direction vector is zero vector"); }
         m_direction = result.get_vector();
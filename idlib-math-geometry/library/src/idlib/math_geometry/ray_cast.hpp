@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/ray_cast.hpp
+/// @brief "ray cast" functor and function and its specializations for rays.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/plane.hpp"
+#include "idlib/math_geometry/ray.hpp"
+#include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math_geometry/triangle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace idlib {
+
+/// @brief A functor determining if and at which distance a ray hits a geometry.
+/// @details
+/// Let \f$O + t \vec{d}\f$ be the points of a ray. The ray hits a geometry at a distance \f$t \geq 0\f$ if
+/// \f$O + t \vec{d}\f$ is a point of the geometry. The entry distance is the smallest such distance,
+/// in particular it is \f$0\f$ if the origin is a point of the geometry.
+/// The functor receives the ray, the geometry, a maximum distance \f$t_{max}\f$ and a variable receiving the entry distance.
+/// It returns @a true if the entry distance is in \f$[0,t_{max}]\f$ and @a false otherwise.
+/// @tparam R, G the types of the ray and the geometry
+template <typename ... T>
+struct ray_cast_functor;
+
+template <typename R, typename G, typename T, typename U>
+auto ray_cast(const R& r, const G& g, const T& t_max, U& t) -> decltype(ray_cast_functor<R, G>()(r, g, t_max, t))
+{
+    return ray_cast_functor<R, G>()(r, g, t_max, t);
+}
+
+namespace internal {
+
+/// @internal
+/// @brief Test axis aligned boxes against a ray.
+/// @remark The reciprocals of the components of the direction of the ray are computed once.
+/// The intersection of the ray with the slab \f$[min_k,max_k]\f$ of axis \f$k\f$ is the interval of the distances
+/// \f$(min_k - O_k) / d_k\f$ and \f$(max_k - O_k) / d_k\f$. The ray hits the box if the intersection of the intervals is not empty.
+/// If \f$d_k\f$ is zero, the reciprocal is an infinity and the interval is either empty or unbounded,
+/// or a bound is NaN if the origin is on a face of the slab. The ray is in the slab then and the interval must be unbounded.
+/// The reciprocal of a zero, whatever its sign, is \f$+\infty\f$: Then the NaN is the lower bound if the origin is on the minimum face,
+/// the upper bound if the origin is on the maximum face, the other bound is an infinity of the correct sign,
+/// and the comparisons, which are false for a NaN, do not constrain the interval.
+template <typename P>
+struct ray_box_test
+{
+    using scalar_type = typename P::scalar_type;
+    using vector_type = typename P::vector_type;
+
+    explicit ray_box_test(const ray<P>& r)
+        : m_origin(r.get_origin())
+    {
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            const scalar_type d = r.get_direction()[i];
+            m_reciprocal[i] = d == zero<scalar_type>() ? std::numeric_limits<scalar_type>::infinity() : one<scalar_type>() / d;
+        }
+    }
+
+    /// @internal
+    /// @brief Get if the ray hits an axis aligned box within a distance.
+    /// @param b the axis aligned box
+    /// @param t_max the distance
+    /// @param t receives the distance at which the ray enters the box if the ray hits the box
+    /// @return @a true if the ray hits the box at a distance in \f$[0,t_{max}]\f$, @a false otherwise
+    bool operator()(const axis_aligned_box<P>& b, scalar_type t_max, scalar_type& t) const
+    {
+        scalar_type t0 = zero<scalar_type>(), t1 = t_max;
+        for (size_t i = 0; i < P::dimensionality(); ++i)
+        {
+            scalar_type u = (b.get_min()[i] - m_origin[i]) * m_reciprocal[i],
+                        v = (b.get_max()[i] - m_origin[i]) * m_reciprocal[i];
+            if (u > v) std::swap(u, v);
+            if (u > t0) t0 = u;
+            if (v < t1) t1 = v;
+            if (t0 > t1) return false;
+        }
+        t = t0;
+        return true;
+    }
+
+private:
+    P m_origin;
+    vector_type m_reciprocal;
+};
+
+} // namespace internal
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distance a ray hits an axis aligned box.
+/// @remark See idlib::internal::ray_box_test for the slab test.
+/// To test many boxes against the same ray, use an idlib::bounding_volume_hierarchy.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct ray_cast_functor<ray<P>, axis_aligned_box<P>>
+{
+    bool operator()(const ray<P>& a, const axis_aligned_box<P>& b, typename P::scalar_type t_max, typename P::scalar_type& t) const
+    { return internal::ray_box_test<P>(a)(b, t_max, t); }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distance a ray hits a sphere.
+/// @remark Let \f$C\f$ and \f$r\f$ be the center and the radius of the sphere and \f$\vec{m} = O - C\f$.
+/// As \f$\vec{d}\f$ is a unit vector, the ray is on the surface of the sphere at the distances
+/// \f$t = -p \pm \sqrt{p^2 - q}\f$ with \f$p = \vec{d} \cdot \vec{m}\f$ and \f$q = \vec{m} \cdot \vec{m} - r^2\f$.
+/// The ray misses the sphere if \f$p^2 - q < 0\f$ or if the greater distance is negative.
+/// The entry distance is the smaller distance clamped to \f$0\f$.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct ray_cast_functor<ray<P>, sphere<P>>
+{
+    using scalar_type = typename P::scalar_type;
+
+    bool operator()(const ray<P>& a, const sphere<P>& b, scalar_type t_max, scalar_type& t) const
+    {
+        const auto m = a.get_origin() - b.get_center();
+        const scalar_type p = dot_product(a.get_direction(), m),
+                          q = squared_euclidean_norm(m) - b.get_radius_squared(),
+                          s = p * p - q;
+        if (s < zero<scalar_type>())
+        {
+            return false;
+        }
+        const scalar_type r = std::sqrt(s);
+        if (r - p < zero<scalar_type>())
+        {
+            return false;
+        }
+        const scalar_type t0 = std::max(-p - r, zero<scalar_type>());
+        if (t0 > t_max)
+        {
+            return false;
+        }
+        t = t0;
+        return true;
+    }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distance a ray hits a plane.
+/// @remark Let \f$\hat{n} \cdot X + d = 0\f$ be the plane. The ray is on the plane at the distance
+/// \f$t = -(\hat{n} \cdot O + d) / (\hat{n} \cdot \vec{d})\f$.
+/// A ray parallel to the plane i.e. with \f$\hat{n} \cdot \vec{d} = 0\f$ never hits the plane.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct ray_cast_functor<ray<point<vector<S, 3>>>, plane<point<vector<S, 3>>>>
+{
+    bool operator()(const ray<point<vector<S, 3>>>& a, const plane<point<vector<S, 3>>>& b, S t_max, S& t) const
+    {
+        const S e = dot_product(b.get_normal(), a.get_direction());
+        if (e == zero<S>())
+        {
+            return false;
+        }
+        const S u = -b.distance(a.get_origin()) / e;
+        if (u < zero<S>() || u > t_max)
+        {
+            return false;
+        }
+        t = u;
+        return true;
+    }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distance a ray hits a triangle.
+/// @remark The test of Möller and Trumbore solves \f$O + t \vec{d} = A + u (B - A) + v (C - A)\f$ for \f$t\f$, \f$u\f$ and \f$v\f$ by Cramer's rule.
+/// The ray hits the triangle if \f$u \geq 0\f$, \f$v \geq 0\f$, \f$u + v \leq 1\f$ and \f$t \geq 0\f$ hold.
+/// Both sides of the triangle are hit. A ray parallel to the triangle never hits the triangle.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct ray_cast_functor<ray<point<vector<S, 3>>>, triangle<point<vector<S, 3>>>>
+{
+    bool operator()(const ray<point<vector<S, 3>>>& a, const triangle<point<vector<S, 3>>>& b, S t_max, S& t) const
+    {
+        const auto e1 = b.get_b() - b.get_a(),
+                   e2 = b.get_c() - b.get_a();
+        const auto p = cross_product(a.get_direction(), e2);
+        const S det = dot_product(e1, p);
+        if (det == zero<S>())
+        {
+            return false;
+        }
+        const S inv = one<S>() / det;
+        const auto s = a.get_origin() - b.get_a();
+        const S u = dot_product(s, p) * inv;
+        if (u < zero<S>() || u > one<S>())
+        {
+            return false;
+        }
+        const auto q = cross_product(s, e1);
+        const S v = dot_product(a.get_direction(), q) * inv;
+        if (v < zero<S>() || u + v > one<S>())
+        {
+            return false;
+        }
+        const S w = dot_product(e2, q) * inv;
+        if (w < zero<S>() || w > t_max)
+        {
+            return false;
+        }
+        t = w;
+        return true;
+    }
+}; // struct ray_cast_functor
+
+namespace internal {
+
+/// @internal
+/// @brief Get if a ray hits a geometry at any distance.
+template <typename P, typename G>
+struct is_intersecting_ray
+{
+    bool operator()(const ray<P>& a, const G& b) const
+    {
+        using scalar_type = typename P::scalar_type;
+        scalar_type t;
+        return ray_cast(a, b, std::numeric_limits<scalar_type>::infinity(), t);
+    }
+};
+
+} // namespace internal
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a ray and an axis aligned box intersect.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<ray<P>, axis_aligned_box<P>>
+    : internal::is_intersecting_ray<P, axis_aligned_box<P>>
+{}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if an axis aligned box and a ray intersect.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<axis_aligned_box<P>, ray<P>>
+{
+    bool operator()(const axis_aligned_box<P>& a, const ray<P>& b) const
+    { return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a ray and a sphere intersect.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<ray<P>, sphere<P>>
+    : internal::is_intersecting_ray<P, sphere<P>>
+{}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a sphere and a ray intersect.
+/// @tparam P the point type of the geometry types
+template <typename P>
+struct is_intersecting_functor<sphere<P>, ray<P>>
+{
+    bool operator()(const sphere<P>& a, const ray<P>& b) const
+    { return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a ray and a plane intersect.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct is_intersecting_functor<ray<point<vector<S, 3>>>, plane<point<vector<S, 3>>>>
+    : internal::is_intersecting_ray<point<vector<S, 3>>, plane<point<vector<S, 3>>>>
+{}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a plane and a ray intersect.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct is_intersecting_functor<plane<point<vector<S, 3>>>, ray<point<vector<S, 3>>>>
+{
+    bool operator()(const plane<point<vector<S, 3>>>& a, const ray<point<vector<S, 3>>>& b) const
+    { return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a ray and a triangle intersect.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct is_intersecting_functor<ray<point<vector<S, 3>>>, triangle<point<vector<S, 3>>>>
+    : internal::is_intersecting_ray<point<vector<S, 3>>, triangle<point<vector<S, 3>>>>
+{}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a triangle and a ray intersect.
+/// @tparam S the scalar type of the geometry types
+template <typename S>
+struct is_intersecting_functor<triangle<point<vector<S, 3>>>, ray<point<vector<S, 3>>>>
+{
+    bool operator()(const triangle<point<vector<S, 3>>>& a, const ray<point<vector<S, 3>>>& b) const
+    { return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+} // namespace idlib
@@ -0,0 +1,362 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/ray_packet.hpp
+/// @brief Packets of rays.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::ray_packet of 4 or 8 rays is tested against a geometry at once, one ray per scalar of an idlib::internal::simd_pack.
+/// This amortizes the tests of coherent rays, e.g. rays through neighbouring pixels or rays from a viewer to nearby targets.
+/// idlib::ray_cast returns a bitmask of the rays hitting the geometry:
+/// @code
+/// idlib::ray_packet<idlib::point<idlib::vector<single, 3>>, 8> p(rays);
+/// single t_max[8], t[8];
+/// unsigned int hits = idlib::ray_cast(p, box, t_max, t); // bit i is set if ray i hits the box, t[i] is its entry distance
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/ray_cast.hpp"
+#include "idlib/math/simd.hpp"
+#include <algorithm>
+#include <type_traits>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to the width of the idlib::internal::simd_pack the rays of a packet of @a N rays are processed with.
+template <typename Scalar, size_t N>
+struct ray_packet_width : std::integral_constant<size_t, std::min(simd_native_width<Scalar>::value, N)>
+{};
+
+} // namespace internal
+
+/// @brief A packet of rays.
+/// @detail The origins, the directions and the reciprocals of the components of the directions of the rays
+/// are stored component-wise such that the rays are processed with SIMD instructions.
+/// @tparam P the point type of the rays
+/// @tparam N the number of rays. Must be @a 4 or @a 8.
+template <typename P, size_t N>
+struct ray_packet
+{
+    static_assert(N == 4 || N == 8, "the number of rays of a ray packet must be 4 or 8");
+
+public:
+    /// @brief The point type of this ray packet type.
+    using point_type = P;
+
+    /// @brief The vector type of this ray packet type.
+    using vector_type = typename point_type::vector_type;
+
+    /// @brief The scalar type of this ray packet type.
+    using scalar_type = typename point_type::scalar_type;
+
+    /// @brief The ray type of this ray packet type.
+    using ray_type = ray<point_type>;
+
+    /// @brief The dimensionality of this ray packet type.
+    /// @return the dimensionality
+    static constexpr size_t dimensionality()
+    { return vector_type::dimensionality(); }
+
+    /// @brief The number of rays of this ray packet type.
+    /// @return the number of rays
+    static constexpr size_t size()
+    { return N; }
+
+    /// @brief Construct this ray packet with the specified rays.
+    /// @param rays a pointer to an array of N rays
+    explicit ray_packet(const ray_type *rays)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t k = 0; k < dimensionality(); ++k)
+            {
+                m_origins[k][i] = rays[i].get_origin()[k];
+                m_directions[k][i] = rays[i].get_direction()[k];
+                m_reciprocals[k][i] = one<scalar_type>() / m_directions[k][i];
+            }
+        }
+    }
+
+    ray_packet(const ray_packet&) = default;
+    ray_packet& operator=(const ray_packet&) = default;
+
+    /// @brief Get a ray of this ray packet.
+    /// @param i the index of the ray. Must be smaller than N.
+    /// @return the ray
+    ray_type get_ray(size_t i) const
+    {
+        point_type o;
+        vector_type d;
+        for (size_t k = 0; k < dimensionality(); ++k)
+        {
+            o[k] = m_origins[k][i];
+            d[k] = m_directions[k][i];
+        }
+        return ray_type(o, d);
+    }
+
+    /// @brief Get the components of the origins of the rays of this ray packet along an axis.
+    /// @param k the index of the axis
+    /// @return a pointer to the N components
+    const scalar_type *get_origins(size_t k) const
+    { return m_origins[k]; }
+
+    /// @brief Get the components of the directions of the rays of this ray packet along an axis.
+    /// @param k the index of the axis
+    /// @return a pointer to the N components
+    const scalar_type *get_directions(size_t k) const
+    { return m_directions[k]; }
+
+    /// @brief Get the reciprocals of the components of the directions of the rays of this ray packet along an axis.
+    /// @param k the index of the axis
+    /// @return a pointer to the N reciprocals
+    const scalar_type *get_reciprocals(size_t k) const
+    { return m_reciprocals[k]; }
+
+private:
+    /// @brief The components of the origins.
+    alignas(N * sizeof(scalar_type)) scalar_type m_origins[P::dimensionality()][N];
+
+    /// @brief The components of the directions.
+    alignas(N * sizeof(scalar_type)) scalar_type m_directions[P::dimensionality()][N];
+
+    /// @brief The reciprocals of the components of the directions.
+    alignas(N * sizeof(scalar_type)) scalar_type m_reciprocals[P::dimensionality()][N];
+
+}; // struct ray_packet
+
+namespace internal {
+
+/// @internal
+/// @brief Get the bits of the scalars of a pack of a ray packet.
+/// @param m the bits of the scalars of the pack
+/// @param l the index of the first ray of the pack
+/// @return the bits of the rays
+template <size_t W>
+unsigned int ray_packet_bits(unsigned int m, size_t l)
+{ return (m & ((1u << W) - 1)) << l; }
+
+} // namespace internal
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distances the rays of a ray packet hit an axis aligned box.
+/// @remark The slab test of idlib::internal::ray_box_test is applied to the rays of the packet at once.
+/// A NaN is replaced by an infinity which does not constrain the interval.
+/// @tparam P the point type of the geometry types
+/// @tparam N the number of rays of the ray packet
+template <typename P, size_t N>
+struct ray_cast_functor<ray_packet<P, N>, axis_aligned_box<P>>
+{
+    using scalar_type = typename P::scalar_type;
+
+    /// @param a the ray packet
+    /// @param b the axis aligned box
+    /// @param t_max a pointer to the N maximum distances of the rays
+    /// @param t a pointer to N variables. Element i receives the entry distance of ray i if ray i hits the box.
+    /// @return the bitmask of the rays hitting the box: Bit \f$i\f$ is set if ray \f$i\f$ hits the box at a distance in \f$[0,t_{max_i}]\f$.
+    unsigned int operator()(const ray_packet<P, N>& a, const axis_aligned_box<P>& b, const scalar_type *t_max, scalar_type *t) const
+    {
+        static constexpr size_t W = internal::ray_packet_width<scalar_type, N>::value;
+        using pack = internal::simd_pack<scalar_type, W>;
+        const auto inf = pack::broadcast(std::numeric_limits<scalar_type>::infinity()),
+                   ninf = pack::neg(inf);
+        unsigned int hits = 0;
+        for (size_t l = 0; l < N; l += W)
+        {
+            auto t0 = pack::zero(), t1 = pack::load(t_max + l);
+            for (size_t k = 0; k < P::dimensionality(); ++k)
+            {
+                const auto o = pack::load_aligned(a.get_origins(k) + l),
+                           r = pack::load_aligned(a.get_reciprocals(k) + l);
+                const auto u = pack::mul(pack::sub(pack::broadcast(b.get_min()[k]), o), r),
+                           v = pack::mul(pack::sub(pack::broadcast(b.get_max()[k]), o), r);
+                // idlib::internal::simd_pack::min and idlib::internal::simd_pack::max return their 2nd argument if any argument is NaN.
+                t0 = pack::max(pack::min(pack::max(u, ninf), pack::max(v, ninf)), t0);
+                t1 = pack::min(pack::max(pack::min(u, inf), pack::min(v, inf)), t1);
+            }
+            pack::store(t + l, t0);
+            hits |= internal::ray_packet_bits<W>(~pack::bits(pack::cmp_gt(t0, t1)), l);
+        }
+        return hits;
+    }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distances the rays of a ray packet hit a sphere.
+/// @remark See idlib::ray_cast_functor<ray<P>, sphere<P>>.
+/// @tparam P the point type of the geometry types
+/// @tparam N the number of rays of the ray packet
+template <typename P, size_t N>
+struct ray_cast_functor<ray_packet<P, N>, sphere<P>>
+{
+    using scalar_type = typename P::scalar_type;
+
+    /// @param a the ray packet
+    /// @param b the sphere
+    /// @param t_max a pointer to the N maximum distances of the rays
+    /// @param t a pointer to N variables. Element i receives the entry distance of ray i if ray i hits the sphere.
+    /// @return the bitmask of the rays hitting the sphere: Bit \f$i\f$ is set if ray \f$i\f$ hits the sphere at a distance in \f$[0,t_{max_i}]\f$.
+    unsigned int operator()(const ray_packet<P, N>& a, const sphere<P>& b, const scalar_type *t_max, scalar_type *t) const
+    {
+        static constexpr size_t W = internal::ray_packet_width<scalar_type, N>::value;
+        using pack = internal::simd_pack<scalar_type, W>;
+        const auto z = pack::zero(),
+                   r2 = pack::broadcast(b.get_radius_squared());
+        unsigned int hits = 0;
+        for (size_t l = 0; l < N; l += W)
+        {
+            auto p = pack::zero(), q = pack::zero();
+            for (size_t k = 0; k < P::dimensionality(); ++k)
+            {
+                const auto m = pack::sub(pack::load_aligned(a.get_origins(k) + l), pack::broadcast(b.get_center()[k]));
+                p = pack::add(p, pack::mul(pack::load_aligned(a.get_directions(k) + l), m));
+                q = pack::add(q, pack::mul(m, m));
+            }
+            const auto s = pack::sub(pack::mul(p, p), pack::sub(q, r2));
+            const auto r = pack::sqrt(pack::max(s, z));
+            const auto t0 = pack::max(pack::sub(pack::neg(p), r), z);
+            const unsigned int misses = pack::bits(pack::cmp_gt(z, s))
+                                      | pack::bits(pack::cmp_gt(p, r))
+                                      | pack::bits(pack::cmp_gt(t0, pack::load(t_max + l)));
+            pack::store(t + l, t0);
+            hits |= internal::ray_packet_bits<W>(~misses, l);
+        }
+        return hits;
+    }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distances the rays of a ray packet hit a plane.
+/// @remark See idlib::ray_cast_functor<ray<P>, plane<P>>.
+/// @tparam S the scalar type of the geometry types
+/// @tparam N the number of rays of the ray packet
+template <typename S, size_t N>
+struct ray_cast_functor<ray_packet<point<vector<S, 3>>, N>, plane<point<vector<S, 3>>>>
+{
+    /// @param a the ray packet
+    /// @param b the plane
+    /// @param t_max a pointer to the N maximum distances of the rays
+    /// @param t a pointer to N variables. Element i receives the entry distance of ray i if ray i hits the plane.
+    /// @return the bitmask of the rays hitting the plane: Bit \f$i\f$ is set if ray \f$i\f$ hits the plane at a distance in \f$[0,t_{max_i}]\f$.
+    unsigned int operator()(const ray_packet<point<vector<S, 3>>, N>& a, const plane<point<vector<S, 3>>>& b, const S *t_max, S *t) const
+    {
+        static constexpr size_t W = internal::ray_packet_width<S, N>::value;
+        using pack = internal::simd_pack<S, W>;
+        const auto z = pack::zero();
+        unsigned int hits = 0;
+        for (size_t l = 0; l < N; l += W)
+        {
+            auto e = pack::zero(), h = pack::zero();
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const auto n = pack::broadcast(b.get_normal()[k]);
+                e = pack::add(e, pack::mul(n, pack::load_aligned(a.get_directions(k) + l)));
+                h = pack::add(h, pack::mul(n, pack::load_aligned(a.get_origins(k) + l)));
+            }
+            h = pack::add(h, pack::broadcast(b.get_distance()));
+            const auto u = pack::div(pack::neg(h), e);
+            // A ray is parallel to the plane if neither e > 0 nor e < 0 holds.
+            const unsigned int misses = ~(pack::bits(pack::cmp_gt(e, z)) | pack::bits(pack::cmp_gt(z, e)))
+                                      | pack::bits(pack::cmp_gt(z, u))
+                                      | pack::bits(pack::cmp_gt(u, pack::load(t_max + l)));
+            pack::store(t + l, u);
+            hits |= internal::ray_packet_bits<W>(~misses, l);
+        }
+        return hits;
+    }
+}; // struct ray_cast_functor
+
+/// @brief Specialization of idlib::ray_cast_functor.
+/// Determines if and at which distances the rays of a ray packet hit a triangle.
+/// @remark See idlib::ray_cast_functor<ray<P>, triangle<P>>.
+/// The edges of the triangle are computed once for all rays of the packet.
+/// @tparam S the scalar type of the geometry types
+/// @tparam N the number of rays of the ray packet
+template <typename S, size_t N>
+struct ray_cast_functor<ray_packet<point<vector<S, 3>>, N>, triangle<point<vector<S, 3>>>>
+{
+    /// @param a the ray packet
+    /// @param b the triangle
+    /// @param t_max a pointer to the N maximum distances of the rays
+    /// @param t a pointer to N variables. Element i receives the entry distance of ray i if ray i hits the triangle.
+    /// @return the bitmask of the rays hitting the triangle: Bit \f$i\f$ is set if ray \f$i\f$ hits the triangle at a distance in \f$[0,t_{max_i}]\f$.
+    unsigned int operator()(const ray_packet<point<vector<S, 3>>, N>& a, const triangle<point<vector<S, 3>>>& b, const S *t_max, S *t) const
+    {
+        static constexpr size_t W = internal::ray_packet_width<S, N>::value;
+        using pack = internal::simd_pack<S, W>;
+        const auto e1 = b.get_b() - b.get_a(),
+                   e2 = b.get_c() - b.get_a();
+        const auto ax = pack::broadcast(b.get_a()[0]), ay = pack::broadcast(b.get_a()[1]), az = pack::broadcast(b.get_a()[2]),
+                   fx = pack::broadcast(e1[0]), fy = pack::broadcast(e1[1]), fz = pack::broadcast(e1[2]),
+                   gx = pack::broadcast(e2[0]), gy = pack::broadcast(e2[1]), gz = pack::broadcast(e2[2]);
+        const auto z = pack::zero(), o = pack::broadcast(one<S>());
+        unsigned int hits = 0;
+        for (size_t l = 0; l < N; l += W)
+        {
+            const auto dx = pack::load_aligned(a.get_directions(0) + l),
+                       dy = pack::load_aligned(a.get_directions(1) + l),
+                       dz = pack::load_aligned(a.get_directions(2) + l);
+            const auto sx = pack::sub(pack::load_aligned(a.get_origins(0) + l), ax),
+                       sy = pack::sub(pack::load_aligned(a.get_origins(1) + l), ay),
+                       sz = pack::sub(pack::load_aligned(a.get_origins(2) + l), az);
+            // p = d x e2, q = s x e1
+            const auto px = pack::sub(pack::mul(dy, gz), pack::mul(dz, gy)),
+                       py = pack::sub(pack::mul(dz, gx), pack::mul(dx, gz)),
+                       pz = pack::sub(pack::mul(dx, gy), pack::mul(dy, gx));
+            const auto qx = pack::sub(pack::mul(sy, fz), pack::mul(sz, fy)),
+                       qy = pack::sub(pack::mul(sz, fx), pack::mul(sx, fz)),
+                       qz = pack::sub(pack::mul(sx, fy), pack::mul(sy, fx));
+            const auto det = dot(fx, fy, fz, px, py, pz);
+            const auto inv = pack::div(o, det);
+            const auto u = pack::mul(dot(sx, sy, sz, px, py, pz), inv),
+                       v = pack::mul(dot(dx, dy, dz, qx, qy, qz), inv),
+                       w = pack::mul(dot(gx, gy, gz, qx, qy, qz), inv);
+            // A ray is parallel to the triangle if neither det > 0 nor det < 0 holds.
+            // If v >= 0 and u + v <= 1 hold, then u <= 1 holds.
+            const unsigned int misses = ~(pack::bits(pack::cmp_gt(det, z)) | pack::bits(pack::cmp_gt(z, det)))
+                                      | pack::bits(pack::cmp_gt(z, pack::min(u, v))) | pack::bits(pack::cmp_gt(pack::add(u, v), o))
+                                      | pack::bits(pack::cmp_gt(z, w)) | pack::bits(pack::cmp_gt(w, pack::load(t_max + l)));
+            pack::store(t + l, w);
+            hits |= internal::ray_packet_bits<W>(~misses, l);
+        }
+        return hits;
+    }
+
+private:
+    template <typename R>
+    static R dot(R x0, R x1, R x2, R y0, R y1, R y2)
+    {
+        using pack = internal::simd_pack<S, internal::ray_packet_width<S, N>::value>;
+        return pack::add(pack::add(pack::mul(x0, y0), pack::mul(x1, y1)), pack::mul(x2, y2));
+    }
+}; // struct ray_cast_functor
+
+} // namespace idlib
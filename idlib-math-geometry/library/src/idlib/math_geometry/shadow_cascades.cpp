@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "idlib/math_geometry/shadow_cascades.hpp"
+
+#include "idlib/math/orthographic_projection_matrix.hpp"
+#include "idlib/math/transform.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace idlib {
+
+namespace {
+
+using point_type = point<vector<single, 3>>;
+using vector_type = vector<single, 3>;
+using matrix_type = matrix<single, 4, 4>;
+
+// Get the corners of a slice in the view space of the camera.
+// t is the tangent of half of the field of view angle in the y direction.
+void get_corners(single t, single aspect, single z_near, single z_far, point_type (&corners)[8])
+{
+    const single z[] = { z_near, z_far };
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const single y = z[i] * t, x = y * aspect;
+        corners[4 * i + 0] = point_type(-x, -y, -z[i]);
+        corners[4 * i + 1] = point_type(+x, -y, -z[i]);
+        corners[4 * i + 2] = point_type(-x, +y, -z[i]);
+        corners[4 * i + 3] = point_type(+x, +y, -z[i]);
+    }
+}
+
+// Get the orthographic projection matrix mapping an axis aligned box in view space to the clip volume.
+// The view looks along the negative z-axis hence the distances of the depth clipping planes are the negated z-coordinates.
+matrix_type get_projection(const point_type& min, const point_type& max)
+{ return orthographic_projection_matrix(min[0], max[0], min[1], max[1], -max[2], -min[2]); }
+
+// Get the tangent of half of the field of view angle in the y direction.
+single get_tangent(const angle<single, radians>& fov_y)
+{ return std::tan(fov_y * 0.5f); }
+
+} // namespace
+
+void split_distances(single z_near, single z_far, single lambda, size_t count, single *distances)
+{
+    IDLIB_DEBUG_ASSERT(z_near > 0.0f && z_far > z_near);
+    IDLIB_DEBUG_ASSERT(lambda >= 0.0f && lambda <= 1.0f);
+    IDLIB_DEBUG_ASSERT(count > 0);
+    distances[0] = z_near;
+    for (size_t i = 1; i < count; ++i)
+    {
+        const single s = single(i) / single(count);
+        const single logarithmic = z_near * std::pow(z_far / z_near, s),
+                     uniform = z_near + (z_far - z_near) * s;
+        distances[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+    distances[count] = z_far;
+}
+
+std::array<point<vector<single, 3>>, 8> view_volume_slice(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                                                          single z_near, single z_far)
+{
+    point_type corners[8];
+    get_corners(get_tangent(fov_y), aspect, z_near, z_far, corners);
+    transform_points(view.affine_inverse(), corners, 8, corners);
+    std::array<point_type, 8> result;
+    std::copy(std::begin(corners), std::end(corners), result.begin());
+    return result;
+}
+
+void shadow_cascades(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                     const single *distances, size_t count, const matrix<single, 4, 4>& light_view,
+                     axis_aligned_box<point<vector<single, 3>>> *bounds, matrix<single, 4, 4> *matrices)
+{
+    // The matrix mapping the view space of the camera to the view space of the light.
+    const matrix_type m = light_view * view.affine_inverse();
+    const single t = get_tangent(fov_y);
+    for (size_t i = 0; i < count; ++i)
+    {
+        point_type corners[8];
+        get_corners(t, aspect, distances[i], distances[i + 1], corners);
+        transform_points(m, corners, 8, corners);
+        point_type min = corners[0], max = corners[0];
+        for (size_t j = 1; j < 8; ++j)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                min[k] = std::min(min[k], corners[j][k]);
+                max[k] = std::max(max[k], corners[j][k]);
+            }
+        }
+        bounds[i] = axis_aligned_box<point_type>(min, max);
+        matrices[i] = get_projection(min, max) * light_view;
+    }
+}
+
+void shadow_cascades(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                     const single *distances, size_t count, const matrix<single, 4, 4>& light_view,
+                     sphere<point<vector<single, 3>>> *bounds, matrix<single, 4, 4> *matrices)
+{
+    const matrix_type m = light_view * view.affine_inverse();
+    // The squared distance of a corner from the axis of the view volume is (z t)^2 (1 + aspect^2) at the distance z from the viewer.
+    const single t = get_tangent(fov_y), u = t * t * (1.0f + aspect * aspect);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // By symmetry, the center of the smallest sphere enclosing the slice is on the axis of the view volume.
+        // Its distance z from the viewer minimizes the maximum of the distances to the corners of the near plane and to the
+        // corners of the far plane. Both are equal for z = ((z_1^2 + b) - (z_0^2 + a)) / (2 (z_1 - z_0)) where a and b are the
+        // squared distances of the corners of the near plane and of the far plane from the axis.
+        const single z0 = distances[i], z1 = distances[i + 1];
+        const single a = z0 * z0 * u, b = z1 * z1 * u;
+        const single z = std::min(std::max(((z1 * z1 + b) - (z0 * z0 + a)) / (2.0f * (z1 - z0)), z0), z1);
+        const single r = std::sqrt(std::max((z - z0) * (z - z0) + a, (z1 - z) * (z1 - z) + b));
+        point_type c(0.0f, 0.0f, -z);
+        transform_points(m, &c, 1, &c);
+        bounds[i] = sphere<point_type>(c, r);
+        const vector_type e(r, r, r);
+        matrices[i] = get_projection(c - e, c + e) * light_view;
+    }
+}
+
+} // namespace idlib
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/shadow_cascades.hpp
+/// @brief Slices of perspective view volumes and the shadow cascades of directional lights.
+/// @author Michael Heilmann
+
+/// @detail
+/// The view volume of a perspective camera is split at distances computed by idlib::split_distances into slices.
+/// idlib::shadow_cascades fits an axis aligned box or a sphere to each slice and computes the matrices of the
+/// orthographic projections of a directional light onto the slices in one call.
+/// @code
+/// const auto view = idlib::look_at_matrix(eye, center, up);
+/// const auto light_view = idlib::look_at_matrix(center - light_direction, center, light_up);
+/// single distances[5];
+/// idlib::split_distances(0.1f, 200.0f, 0.75f, 4, distances);
+/// idlib::axis_aligned_box<idlib::point<idlib::vector<single, 3>>> bounds[4];
+/// idlib::matrix<single, 4, 4> matrices[4];
+/// idlib::shadow_cascades(view, fov_y, aspect, distances, 4, light_view, bounds, matrices);
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math/angle-degrees-radians-turns.hpp"
+#include "idlib/math/matrix.hpp"
+#include <array>
+
+namespace idlib {
+
+/// @brief Compute the distances of the splits of a view volume into slices.
+/// @param z_near the distance of the viewer to the near clipping plane
+/// @param z_far the distance of the viewer to the far clipping plane
+/// @param lambda the weight of the logarithmic split scheme. Must be within \f$[0,1]\f$.
+/// @param count the number of slices. Must be greater than @a 0.
+/// @param distances pointer to the first distance. Must have space for at least <c>count + 1</c> distances.
+/// @pre @a z_near must be positive, @a z_far must be greater than @a z_near
+/// @remark Distance \f$i\f$ is the blend
+/// \f[
+/// d_i = \lambda \, n \left(\frac{f}{n}\right)^{i/N} + (1 - \lambda) \left(n + (f - n)\frac{i}{N}\right)
+/// \f]
+/// of the logarithmic split scheme and the uniform split scheme where \f$n\f$ is @a z_near, \f$f\f$ is @a z_far, and \f$N\f$ is @a count.
+/// The first distance is @a z_near and the last distance is @a z_far.
+void split_distances(single z_near, single z_far, single lambda, size_t count, single *distances);
+
+/// @brief Get the corners of a slice of the view volume of a perspective camera.
+/// @param view the view matrix of the camera (cf. idlib::look_at_matrix)
+/// @param fov_y, aspect the field of view angle in the y direction and the aspect ratio (cf. idlib::perspective_projection_matrix)
+/// @param z_near, z_far the distances of the viewer to the near plane and the far plane of the slice
+/// @return the corners of the slice in world space. The corners of the near plane precede the corners of the far plane.
+/// @throw std::domain_error the view matrix is not invertible
+std::array<point<vector<single, 3>>, 8> view_volume_slice(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                                                          single z_near, single z_far);
+
+/// @{
+/// @brief Compute the shadow cascades of a directional light.
+/// @param view the view matrix of the camera (cf. idlib::look_at_matrix)
+/// @param fov_y, aspect the field of view angle in the y direction and the aspect ratio (cf. idlib::perspective_projection_matrix)
+/// @param distances pointer to the first of <c>count + 1</c> increasing positive distances of the splits (cf. idlib::split_distances)
+/// @param count the number of cascades
+/// @param light_view the view matrix of the light. The light looks along the negative z-axis of its view space.
+/// @param bounds pointer to the first bounding geometry. Must have space for at least @a count geometries.
+/// Geometry \f$i\f$ is set to the axis aligned box or the sphere enclosing the slice between the distances \f$i\f$ and \f$i+1\f$
+/// in the view space of the light. The axis aligned box is the smallest axis aligned box enclosing the slice and the sphere is the
+/// smallest sphere enclosing the slice.
+/// @param matrices pointer to the first matrix. Must have space for at least @a count matrices.
+/// Matrix \f$i\f$ is set to \f$P_i L\f$ where \f$L\f$ is @a light_view and \f$P_i\f$ is the orthographic projection matrix mapping
+/// the bounding axis aligned box of geometry \f$i\f$ to the clip volume (cf. idlib::orthographic_projection_matrix).
+/// @throw std::domain_error the view matrix is not invertible
+/// @remark No memory is allocated. The view matrix is inverted once for all cascades.
+/// @remark The radius of a sphere depends only on the distances of the slice, the field of view and the aspect ratio.
+/// Hence the extent of the orthographic projection of a sphere and the size of its texels in world space do not change if the camera rotates,
+/// whereas the center of the sphere moves with the view direction.
+/// Constant texel sizes are a prerequisite to avoid shimmering of the edges of shadows, at the expense of resolution.
+/// @remark To cull geometries against a cascade, construct an idlib::frustum from its matrix.
+void shadow_cascades(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                     const single *distances, size_t count, const matrix<single, 4, 4>& light_view,
+                     axis_aligned_box<point<vector<single, 3>>> *bounds, matrix<single, 4, 4> *matrices);
+
+void shadow_cascades(const matrix<single, 4, 4>& view, const angle<single, radians>& fov_y, single aspect,
+                     const single *distances, size_t count, const matrix<single, 4, 4>& light_view,
+                     sphere<point<vector<single, 3>>> *bounds, matrix<single, 4, 4> *matrices);
+/// @}
+
+} // namespace idlib
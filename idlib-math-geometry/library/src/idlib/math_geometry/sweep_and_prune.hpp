@@ -0,0 +1,559 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/sweep_and_prune.hpp
+/// @brief Sweep and prune over axis aligned boxes.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::sweep_and_prune stores the bounds of moving objects and keeps track of the pairs of overlapping bounds.
+/// Each object is represented by a handle.
+/// @code
+/// idlib::sweep_and_prune<idlib::point<idlib::vector<single, 3>>> s(3);
+/// auto handle = s.insert(bounds); // Keep the handle with the object.
+/// s.move(handle, new_bounds);     // If the object moved.
+/// s.update([](size_t a, size_t b) { /* the bounds of a and b started overlapping */ },
+///          [](size_t a, size_t b) { /* the bounds of a and b stopped overlapping */ }); // Once per frame.
+/// s.remove(handle);               // If the object is destroyed.
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief A hash table mapping pairs of handles to flags.
+/// @detail The table uses open addressing with linear probing. Its capacity is a power of two and it is at most half full.
+/// The key of a pair \f$a < b\f$ is \f$a \cdot 2^{32} + b\f$.
+struct pair_table
+{
+public:
+    /// @brief An entry of a pair table.
+    struct entry
+    {
+        /// @brief The key of the pair or empty_key if this entry is empty.
+        std::uint64_t key;
+        /// @brief The flags of the pair.
+        std::uint8_t flags;
+    };
+
+    static constexpr std::uint64_t empty_key = std::numeric_limits<std::uint64_t>::max();
+
+    /// @brief Get the entry of a pair.
+    /// @param key the key of the pair
+    /// @return a pointer to the entry or @a nullptr if the pair is not in this table
+    entry *find(std::uint64_t key)
+    {
+        if (m_entries.empty())
+        {
+            return nullptr;
+        }
+        for (size_t i = get_index(key);; i = (i + 1) & (m_entries.size() - 1))
+        {
+            if (m_entries[i].key == key)
+            {
+                return &m_entries[i];
+            }
+            if (m_entries[i].key == empty_key)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    /// @brief Get the entry of a pair, adding it with no flags set if the pair is not in this table.
+    /// @param key the key of the pair
+    /// @return the entry. It remains valid until a pair is added or removed.
+    entry& get(std::uint64_t key)
+    {
+        if (2 * (m_size + 1) > m_entries.size())
+        {
+            grow();
+        }
+        size_t i = get_index(key);
+        while (m_entries[i].key != key)
+        {
+            if (m_entries[i].key == empty_key)
+            {
+                m_entries[i] = entry{ key, 0 };
+                m_size++;
+                break;
+            }
+            i = (i + 1) & (m_entries.size() - 1);
+        }
+        return m_entries[i];
+    }
+
+    /// @brief Remove a pair.
+    /// @param e the entry of the pair
+    void remove(entry *e)
+    {
+        // The following entries of the cluster are moved such that each entry is reachable from its index without passing an empty entry.
+        const size_t mask = m_entries.size() - 1;
+        size_t i = size_t(e - m_entries.data());
+        for (size_t j = (i + 1) & mask; m_entries[j].key != empty_key; j = (j + 1) & mask)
+        {
+            const size_t k = get_index(m_entries[j].key);
+            // Move the entry at j to i if i is cyclically in [k, j).
+            if (((j - k) & mask) >= ((j - i) & mask))
+            {
+                m_entries[i] = m_entries[j];
+                i = j;
+            }
+        }
+        m_entries[i].key = empty_key;
+        m_size--;
+    }
+
+    /// @brief Invoke a function for each entry.
+    /// @param f the function receiving an entry
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (const entry& e : m_entries)
+        {
+            if (e.key != empty_key)
+            { f(e); }
+        }
+    }
+
+private:
+    std::vector<entry> m_entries;
+
+    size_t m_size = 0;
+
+    size_t m_shift = 64;
+
+    // Fibonacci hashing: The most significant bits of the product of the key and 2^64 divided by the golden ratio.
+    size_t get_index(std::uint64_t key) const
+    { return size_t((key * UINT64_C(0x9e3779b97f4a7c15)) >> m_shift); }
+
+    void grow()
+    {
+        std::vector<entry> entries(std::max<size_t>(64, 2 * m_entries.size()), entry{ empty_key, 0 });
+        entries.swap(m_entries);
+        m_shift = 64;
+        for (size_t n = m_entries.size(); n > 1; n >>= 1)
+        {
+            m_shift--;
+        }
+        for (const entry& e : entries)
+        {
+            if (e.key != empty_key)
+            {
+                size_t i = get_index(e.key);
+                while (m_entries[i].key != empty_key)
+                {
+                    i = (i + 1) & (m_entries.size() - 1);
+                }
+                m_entries[i] = e;
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+/// @brief Sweep and prune over axis aligned boxes.
+/// @detail For each sorted axis, the minima and the maxima of the boxes along that axis (the endpoints) are kept in a sorted array.
+/// Two boxes overlap along an axis if and only if the minimum of each box precedes the maximum of the other box in the array of that axis.
+/// If a box is moved, its endpoints are moved to their new positions by insertion sort. Whenever an endpoint passes another endpoint,
+/// the overlap of two boxes along that axis starts or stops and the pair is added or removed if the boxes overlap along the other
+/// sorted axes with respect to the order of their endpoints. Hence the cost of a movement is proportional to the number of endpoints
+/// passed and not to the number of objects. This is efficient for coherent motion where boxes move by small distances.
+///
+/// The overlapping pairs are the pairs of boxes overlapping along all sorted axes. If all axes are sorted, these are the intersecting
+/// boxes. If only the first axis is sorted, less memory is used and fewer endpoints are passed, but the overlapping pairs are candidates
+/// which must be tested along the other axes.
+/// The changes of the overlapping pairs are reported by update(). A pair which starts and stops overlapping between two updates
+/// is not reported.
+/// @remark Inserting an object and removing an object take time linear in the number of objects in the worst case.
+/// @tparam P the point type
+template <typename P>
+struct sweep_and_prune
+{
+public:
+    /// @brief The point type of this sweep and prune type.
+    using point_type = P;
+
+    /// @brief The scalar type of this sweep and prune type.
+    using scalar_type = typename P::scalar_type;
+
+    /// @brief The axis aligned box type of this sweep and prune type.
+    using box_type = axis_aligned_box<P>;
+
+    /// @brief Construct this sweep and prune.
+    /// @param number_of_axes the number of sorted axes. The axes \f$0, \ldots, n - 1\f$ are sorted.
+    /// Must be at least @a 1 and at most the dimensionality of the point type.
+    /// @throw std::invalid_argument @a number_of_axes is @a 0 or greater than the dimensionality of the point type
+    explicit sweep_and_prune(size_t number_of_axes = P::dimensionality())
+        : m_number_of_axes(number_of_axes)
+    {
+        if (number_of_axes < 1 || number_of_axes > P::dimensionality())
+        { throw std::invalid_argument("invalid number of axes"); }
+    }
+
+    sweep_and_prune(const sweep_and_prune&) = default;
+    sweep_and_prune& operator=(const sweep_and_prune&) = default;
+
+    /// @brief Get the number of sorted axes.
+    /// @return the number of sorted axes
+    size_t get_number_of_axes() const
+    { return m_number_of_axes; }
+
+    /// @brief Get the number of objects of this sweep and prune.
+    /// @return the number of objects
+    size_t size() const
+    { return m_endpoints[0].size() / 2; }
+
+    /// @brief Get if this sweep and prune has no objects.
+    /// @return @a true if this sweep and prune has no objects, @a false otherwise
+    bool empty() const
+    { return size() == 0; }
+
+    /// @brief Get the box of an object.
+    /// @param handle the handle of the object
+    /// @return the box
+    /// @throw std::invalid_argument @a handle is not a handle of this sweep and prune
+    const box_type& get_box(size_t handle) const
+    {
+        validate(handle);
+        return m_boxes[handle];
+    }
+
+    /// @brief Insert an object.
+    /// @param box the box of the object
+    /// @return the handle of the object
+    /// @remark The handles of removed objects are reused after the next update.
+    size_t insert(const box_type& box)
+    {
+        std::uint32_t k;
+        if (!m_free.empty())
+        {
+            k = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            if (m_objects.size() >= size_t(null) / 2)
+            { throw std::length_error("too many objects"); }
+            k = std::uint32_t(m_objects.size());
+            m_objects.emplace_back();
+            m_boxes.emplace_back();
+        }
+        object& o = m_objects[k];
+        m_boxes[k] = box;
+        // The endpoints are appended such that the object does not overlap other objects along any axis,
+        // then they are sorted to their positions.
+        for (size_t i = 0; i < m_number_of_axes; ++i)
+        {
+            auto& v = m_endpoints[i];
+            o.endpoints[i][0] = std::uint32_t(v.size());
+            v.push_back(endpoint{ box.get_min()[i], k << 1 });
+            o.endpoints[i][1] = std::uint32_t(v.size());
+            v.push_back(endpoint{ box.get_max()[i], (k << 1) | 1 });
+        }
+        for (size_t i = 0; i < m_number_of_axes; ++i)
+        {
+            sort_down(i, o.endpoints[i][0]);
+            sort_down(i, o.endpoints[i][1]);
+        }
+        return k;
+    }
+
+    /// @brief Remove an object.
+    /// @param handle the handle of the object
+    /// @throw std::invalid_argument @a handle is not a handle of this sweep and prune
+    void remove(size_t handle)
+    {
+        validate(handle);
+        const std::uint32_t k = std::uint32_t(handle);
+        object& o = m_objects[k];
+        // The overlapping pairs of the object overlap along the first axis:
+        // The maximum of the other object succeeds the minimum of the object.
+        const auto& u = m_endpoints[0];
+        for (size_t j = o.endpoints[0][0] + 1; j < u.size(); ++j)
+        {
+            if (is_maximum(u[j]) && get_object(u[j]) != k && is_overlapping(k, get_object(u[j]), m_number_of_axes))
+            { remove_pair(k, get_object(u[j])); }
+        }
+        for (size_t i = 0; i < m_number_of_axes; ++i)
+        {
+            auto& v = m_endpoints[i];
+            v.erase(v.begin() + o.endpoints[i][1]);
+            v.erase(v.begin() + o.endpoints[i][0]);
+            for (size_t j = o.endpoints[i][0]; j < v.size(); ++j)
+            { set_index(i, j); }
+        }
+        o.endpoints[0][0] = null;
+        m_released.push_back(k);
+    }
+
+    /// @brief Move an object.
+    /// @param handle the handle of the object
+    /// @param box the new box of the object
+    /// @throw std::invalid_argument @a handle is not a handle of this sweep and prune
+    void move(size_t handle, const box_type& box)
+    {
+        validate(handle);
+        object& o = m_objects[handle];
+        m_boxes[handle] = box;
+        for (size_t i = 0; i < m_number_of_axes; ++i)
+        {
+            auto& v = m_endpoints[i];
+            endpoint& min = v[o.endpoints[i][0]];
+            endpoint& max = v[o.endpoints[i][1]];
+            // If the maximum increases, the maximum is sorted first, otherwise the minimum is sorted first.
+            // Hence the minimum never passes the maximum of the object.
+            const bool maximum_first = box.get_max()[i] >= max.value;
+            min.value = box.get_min()[i];
+            max.value = box.get_max()[i];
+            if (maximum_first)
+            {
+                sort(i, o.endpoints[i][1]);
+                sort(i, o.endpoints[i][0]);
+            }
+            else
+            {
+                sort(i, o.endpoints[i][0]);
+                sort(i, o.endpoints[i][1]);
+            }
+        }
+    }
+
+    /// @brief Report the changes of the overlapping pairs since the last update.
+    /// @param added the function receiving the handles \f$a < b\f$ of two objects which started overlapping
+    /// @param removed the function receiving the handles \f$a < b\f$ of two objects which stopped overlapping.
+    /// The pairs of removed objects are reported as removed pairs.
+    template <typename F, typename G>
+    void update(F&& added, G&& removed)
+    {
+        for (std::uint64_t key : m_changes)
+        {
+            const auto e = m_pairs.find(key);
+            std::uint8_t& flags = e->flags;
+            const bool overlapping = (flags & overlapping_flag) != 0, reported = (flags & reported_flag) != 0;
+            if (overlapping && !reported)
+            { added(size_t(key >> 32), size_t(key & 0xffffffff)); }
+            else if (!overlapping && reported)
+            { removed(size_t(key >> 32), size_t(key & 0xffffffff)); }
+            if (overlapping)
+            { flags = reported_flag | overlapping_flag; }
+            else
+            { m_pairs.remove(e); }
+        }
+        m_changes.clear();
+        m_free.insert(m_free.end(), m_released.begin(), m_released.end());
+        m_released.clear();
+    }
+
+    /// @brief Invoke a function for each overlapping pair.
+    /// @param f the function receiving the handles \f$a < b\f$ of two objects
+    /// @remark The pairs include the changes not yet reported by update().
+    template <typename F>
+    void query_pairs(F&& f) const
+    {
+        m_pairs.for_each([&f](const internal::pair_table::entry& e)
+        {
+            if ((e.flags & overlapping_flag) != 0)
+            { f(size_t(e.key >> 32), size_t(e.key & 0xffffffff)); }
+        });
+    }
+
+private:
+    static constexpr std::uint32_t null = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief The flags of a pair.
+    /// A pair is overlapping, was overlapping at the last update, and has changed since the last update.
+    static constexpr std::uint8_t overlapping_flag = 1, reported_flag = 2, changed_flag = 4;
+
+    /// @brief An endpoint.
+    struct endpoint
+    {
+        /// @brief The minimum or the maximum of a box along an axis.
+        scalar_type value;
+        /// @brief The handle of the object shifted left by one. The least significant bit is set if this is a maximum.
+        std::uint32_t data;
+    };
+
+    /// @brief An object of a sweep and prune.
+    struct object
+    {
+        /// @brief The indices of the minimum and the maximum along the sorted axes.
+        /// The index of the minimum along the first axis is null if this object is removed.
+        std::uint32_t endpoints[P::dimensionality()][2];
+    };
+
+    /// @brief The number of sorted axes.
+    size_t m_number_of_axes;
+
+    /// @brief The endpoints of the sorted axes.
+    std::vector<endpoint> m_endpoints[P::dimensionality()];
+
+    /// @brief The objects.
+    std::vector<object> m_objects;
+
+    /// @brief The boxes of the objects.
+    std::vector<box_type> m_boxes;
+
+    /// @brief The handles of the objects removed before and after the last update.
+    std::vector<std::uint32_t> m_free, m_released;
+
+    /// @brief The pairs which are overlapping or which were overlapping at the last update.
+    internal::pair_table m_pairs;
+
+    /// @brief The keys of the pairs which have changed since the last update.
+    std::vector<std::uint64_t> m_changes;
+
+    void validate(size_t handle) const
+    {
+        if (handle >= m_objects.size() || m_objects[handle].endpoints[0][0] == null)
+        { throw std::invalid_argument("invalid handle"); }
+    }
+
+    static bool is_maximum(const endpoint& e)
+    { return (e.data & 1) != 0; }
+
+    static std::uint32_t get_object(const endpoint& e)
+    { return e.data >> 1; }
+
+    // A minimum precedes a maximum of the same value such that boxes touching each other overlap.
+    static bool precedes(const endpoint& e, const endpoint& f)
+    { return e.value < f.value || (e.value == f.value && !is_maximum(e) && is_maximum(f)); }
+
+    // Store the index of the endpoint at an index in its object.
+    void set_index(size_t axis, size_t j)
+    {
+        const endpoint& e = m_endpoints[axis][j];
+        m_objects[get_object(e)].endpoints[axis][e.data & 1] = std::uint32_t(j);
+    }
+
+    // Move the endpoint at an index to its position.
+    void sort(size_t axis, size_t j)
+    {
+        auto& v = m_endpoints[axis];
+        const endpoint e = v[j];
+        if (j > 0 && precedes(e, v[j - 1]))
+        {
+            sort_down(axis, j);
+        }
+        else
+        {
+            // The endpoint moves towards the end.
+            while (j + 1 < v.size() && precedes(v[j + 1], e))
+            {
+                const endpoint f = v[j + 1];
+                if (is_maximum(e) != is_maximum(f) && is_overlapping(get_object(e), get_object(f), axis))
+                {
+                    if (is_maximum(e))
+                    { add_pair(get_object(e), get_object(f)); }
+                    else
+                    { remove_pair(get_object(e), get_object(f)); }
+                }
+                v[j] = f;
+                set_index(axis, j);
+                ++j;
+            }
+            v[j] = e;
+            set_index(axis, j);
+        }
+    }
+
+    // Move the endpoint at an index towards the beginning to its position.
+    void sort_down(size_t axis, size_t j)
+    {
+        auto& v = m_endpoints[axis];
+        const endpoint e = v[j];
+        while (j > 0 && precedes(e, v[j - 1]))
+        {
+            const endpoint f = v[j - 1];
+            if (is_maximum(e) != is_maximum(f) && is_overlapping(get_object(e), get_object(f), axis))
+            {
+                if (is_maximum(e))
+                { remove_pair(get_object(e), get_object(f)); }
+                else
+                { add_pair(get_object(e), get_object(f)); }
+            }
+            v[j] = f;
+            set_index(axis, j);
+            --j;
+        }
+        v[j] = e;
+        set_index(axis, j);
+    }
+
+    static std::uint64_t get_key(std::uint32_t a, std::uint32_t b)
+    { return a < b ? (std::uint64_t(a) << 32) | b : (std::uint64_t(b) << 32) | a; }
+
+    // Get if two objects overlap along the sorted axes except for an axis with respect to the order of the endpoints.
+    bool is_overlapping(std::uint32_t a, std::uint32_t b, size_t axis) const
+    {
+        const object& x = m_objects[a], &y = m_objects[b];
+        for (size_t i = 0; i < m_number_of_axes; ++i)
+        {
+            if (i != axis && (x.endpoints[i][0] > y.endpoints[i][1] || y.endpoints[i][0] > x.endpoints[i][1]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Add a pair. The pair is not overlapping.
+    void add_pair(std::uint32_t a, std::uint32_t b)
+    {
+        const std::uint64_t key = get_key(a, b);
+        std::uint8_t& flags = m_pairs.get(key).flags;
+        flags |= overlapping_flag;
+        if ((flags & changed_flag) == 0)
+        {
+            flags |= changed_flag;
+            m_changes.push_back(key);
+        }
+    }
+
+    // Remove a pair. The pair is overlapping.
+    void remove_pair(std::uint32_t a, std::uint32_t b)
+    {
+        std::uint8_t& flags = m_pairs.find(get_key(a, b))->flags;
+        flags &= ~overlapping_flag;
+        if ((flags & changed_flag) == 0)
+        {
+            flags |= changed_flag;
+            m_changes.push_back(get_key(a, b));
+        }
+    }
+}; // struct sweep_and_prune
+
+} // namespace idlib
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/triangle.hpp
+/// @brief Triangles.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/point.hpp"
+#include "idlib/crtp.hpp"
+
+namespace idlib {
+
+/// @brief A triangle.
+/// @detail
+/// A triangle is specified by three corner points \f$A\f$, \f$B\f$ and \f$C\f$.
+/// The set of points of a triangle is given by
+/// \f$\{ A + u (B - A) + v (C - A) | u, v \in \mathbb{R}_{\geq 0}, u + v \leq 1 \}\f$.
+template <typename P>
+struct triangle : public equal_to_expr<triangle<P>>
+{
+public:
+    /// @brief The point type of this triangle type.
+    using point_type = P;
+
+    /// @brief The vector type of this triangle type.
+    using vector_type = typename point_type::vector_type;
+
+    /// @brief The scalar type of this triangle type.
+    using scalar_type = typename point_type::scalar_type;
+
+    /// @brief The dimensionality of this triangle type.
+    /// @return the dimensionality
+    static constexpr size_t dimensionality()
+    { return vector_type::dimensionality(); }
+
+    /// @brief Default construct this triangle.
+    /// @post All corner points of the triangle are the origin.
+    triangle()
+        : m_a(zero<point_type>()), m_b(zero<point_type>()), m_c(zero<point_type>())
+    {}
+
+    /// @brief Construct this triangle with the specified corner points.
+    /// @param a, b, c the corner points \f$A\f$, \f$B\f$ and \f$C\f$
+    triangle(const point_type& a, const point_type& b, const point_type& c) :
+        m_a(a), m_b(b), m_c(c)
+    {}
+
+    triangle(const triangle&) = default;
+    triangle& operator=(const triangle&) = default;
+
+    /// @brief Get the 1st corner point \f$A\f$ of this triangle.
+    /// @return the 1st corner point \f$A\f$ of this triangle
+    const point_type& get_a() const
+    { return m_a; }
+
+    /// @brief Get the 2nd corner point \f$B\f$ of this triangle.
+    /// @return the 2nd corner point \f$B\f$ of this triangle
+    const point_type& get_b() const
+    { return m_b; }
+
+    /// @brief Get the 3rd corner point \f$C\f$ of this triangle.
+    /// @return the 3rd corner point \f$C\f$ of this triangle
+    const point_type& get_c() const
+    { return m_c; }
+
+    // CRTP
+    bool equal_to(const triangle& other) const
+    {
+        return m_a == other.m_a
+            && m_b == other.m_b
+            && m_c == other.m_c;
+    }
+
+private:
+    /// @brief The 1st corner point \f$A\f$.
+    point_type m_a;
+
+    /// @brief The 2nd corner point \f$B\f$.
+    point_type m_b;
+
+    /// @brief The 3rd corner point \f$C\f$.
+    point_type m_c;
+
+}; // struct triangle
+
+/// @brief Specialization of idlib::enclose_functor enclosing a triangle in a triangle.
+/// @detail The triangle \f$b\f$ enclosing a triangle \f$a\f$ is \f$a\f$ itself i.e. \f$b = a\f$.
+/// @tparam P the point type of the triangles
+template <typename P>
+struct enclose_functor<triangle<P>, triangle<P>>
+{
+    auto operator()(const triangle<P>& source) const
+    { return source; }
+}; // struct enclose_functor
+
+/// @brief Specialization of idlib::translate_functor.
+/// Translates a triangle.
+/// @tparam P the point type of the triangle
+template <typename P>
+struct translate_functor<triangle<P>, typename P::vector_type>
+{
+    auto operator()(const triangle<P>& x, const typename P::vector_type& t) const
+    { return triangle<P>(x.get_a() + t, x.get_b() + t, x.get_c() + t); }
+}; // struct translate_functor
+
+} // namespace idlib
@@ -0,0 +1,451 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math_geometry/uniform_grid.hpp
+/// @brief Uniform grids of spheres, axis aligned cubes, or axis aligned boxes.
+/// @author Michael Heilmann
+
+/// @detail
+/// An idlib::uniform_grid is rebuilt from an array of objects of similar size, e.g. each frame from the bounds of agents.
+/// Queries report the indices of the objects in that array.
+/// @code
+/// idlib::uniform_grid<idlib::sphere<idlib::point<idlib::vector<single, 3>>>> grid(2.0f);
+/// grid.build(spheres.data(), spheres.size(), idlib::execution_policy::parallel());
+/// grid.query(idlib::sphere<idlib::point<idlib::vector<single, 3>>>(p, r), [](size_t i) { /* sphere i intersects the sphere */ });
+/// grid.query_pairs([](size_t i, size_t j) { /* spheres i and j intersect */ });
+/// @endcode
+
+#pragma once
+
+#include "idlib/math_geometry/axis_aligned_box.hpp"
+#include "idlib/math_geometry/axis_aligned_cube.hpp"
+#include "idlib/math_geometry/sphere.hpp"
+#include "idlib/math_geometry/is_intersecting_axis_aligned_box_sphere.hpp"
+#include "idlib/math_geometry/is_intersecting_axis_aligned_cube_sphere.hpp"
+#include "idlib/math/parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief The center and the extent of the objects of a uniform grid.
+/// Specializations provide
+/// @code
+/// static P get_center(const G& x);
+/// static typename P::scalar_type get_extent(const G& x); // The maximum distance of a point of x to the center along an axis.
+/// @endcode
+/// @tparam G the object type
+template <typename G>
+struct uniform_grid_traits;
+
+template <typename P>
+struct uniform_grid_traits<sphere<P>>
+{
+    static const P& get_center(const sphere<P>& x)
+    { return x.get_center(); }
+    static typename P::scalar_type get_extent(const sphere<P>& x)
+    { return x.get_radius(); }
+};
+
+template <typename P>
+struct uniform_grid_traits<axis_aligned_cube<P>>
+{
+    static const P& get_center(const axis_aligned_cube<P>& x)
+    { return x.get_center(); }
+    static typename P::scalar_type get_extent(const axis_aligned_cube<P>& x)
+    { return x.get_size() / (one<typename P::scalar_type>() + one<typename P::scalar_type>()); }
+};
+
+template <typename P>
+struct uniform_grid_traits<axis_aligned_box<P>>
+{
+    static P get_center(const axis_aligned_box<P>& x)
+    { return x.get_center(); }
+    static typename P::scalar_type get_extent(const axis_aligned_box<P>& x)
+    {
+        const auto s = x.get_size();
+        auto e = s[0];
+        for (size_t i = 1; i < P::dimensionality(); ++i)
+        { e = std::max(e, s[i]); }
+        return e / (one<typename P::scalar_type>() + one<typename P::scalar_type>());
+    }
+};
+
+} // namespace internal
+
+/// @brief A uniform grid of spheres, axis aligned cubes, or axis aligned boxes.
+/// @detail Space is divided into cubic cells of the same size. An object is stored in the cell containing its center.
+/// Two objects intersect only if the distance of their centers along each axis is at most the sum of their extents,
+/// hence only if their cells are at most \f$k = \lceil 2e / s \rceil\f$ cells apart along each axis where \f$e\f$ is the greatest
+/// extent of an object and \f$s\f$ is the cell size. If the cell size is at least the greatest size of an object, then \f$k = 1\f$.
+///
+/// The cells are not stored. Instead, the cell coordinates are hashed into a table of buckets with at least twice as many buckets as
+/// objects. The objects are sorted by bucket and copied such that the objects of a bucket are contiguous in memory.
+/// Objects of different cells in the same bucket are told apart by their cell coordinates.
+///
+/// The intersection tests are performed by idlib::is_intersecting.
+/// @tparam G the object type. Must be idlib::sphere, idlib::axis_aligned_cube, or idlib::axis_aligned_box.
+template <typename G>
+struct uniform_grid
+{
+public:
+    /// @brief The object type of this uniform grid type.
+    using object_type = G;
+
+    /// @brief The point type of this uniform grid type.
+    using point_type = typename G::point_type;
+
+    /// @brief The vector type of this uniform grid type.
+    using vector_type = typename point_type::vector_type;
+
+    /// @brief The scalar type of this uniform grid type.
+    using scalar_type = typename point_type::scalar_type;
+
+    /// @brief The sphere type of this uniform grid type.
+    using sphere_type = sphere<point_type>;
+
+    /// @brief The type of the coordinates of a cell.
+    using cell_type = std::array<std::int32_t, point_type::dimensionality()>;
+
+    /// @brief Construct this uniform grid.
+    /// @param cell_size the size of the cells. Must be positive.
+    /// @throw std::invalid_argument @a cell_size is not positive
+    explicit uniform_grid(scalar_type cell_size = one<scalar_type>())
+        : m_cell_size(cell_size)
+    {
+        if (!(cell_size > zero<scalar_type>()))
+        { throw std::invalid_argument("cell size is not positive"); }
+    }
+
+    uniform_grid(const uniform_grid&) = default;
+    uniform_grid& operator=(const uniform_grid&) = default;
+
+    /// @brief Get the size of the cells.
+    /// @return the size of the cells
+    scalar_type get_cell_size() const
+    { return m_cell_size; }
+
+    /// @brief Get the number of objects of this uniform grid.
+    /// @return the number of objects
+    size_t size() const
+    { return m_indices.size(); }
+
+    /// @brief Get if this uniform grid has no objects.
+    /// @return @a true if this uniform grid has no objects, @a false otherwise
+    bool empty() const
+    { return m_indices.empty(); }
+
+    /// @brief Get the coordinates of the cell containing a point.
+    /// @param p the point
+    /// @return the coordinates of the cell
+    /// @remark The coordinates are the components of the point divided by the cell size, rounded down.
+    /// They must be representable by <c>std::int32_t</c>.
+    cell_type get_cell(const point_type& p) const
+    {
+        cell_type c;
+        for (size_t i = 0; i < point_type::dimensionality(); ++i)
+        { c[i] = std::int32_t(std::floor(p[i] / m_cell_size)); }
+        return c;
+    }
+
+    /// @brief Build this uniform grid from an array of objects.
+    /// @param objects pointer to the first object
+    /// @param count the number of objects. Must be smaller than \f$2^{31}\f$.
+    /// @param policy the execution policy
+    /// @throw std::invalid_argument @a count is not smaller than \f$2^{31}\f$
+    /// @remark The result does not depend on the execution policy.
+    /// The buffers of this grid are reused, so rebuilding with a similar number of objects, e.g. every frame, does not allocate memory.
+    void build(const G *objects, size_t count, const execution_policy& policy = execution_policy::sequential());
+
+    /// @brief Invoke a function for each object intersecting a sphere.
+    /// @param s the sphere
+    /// @param f the function receiving the index of an object
+    template <typename F>
+    void query(const sphere_type& s, F&& f) const
+    {
+        if (empty())
+        {
+            return;
+        }
+        // The cells of objects intersecting the sphere.
+        const scalar_type r = s.get_radius() + m_extent;
+        point_type lo = s.get_center(), hi = s.get_center();
+        for (size_t i = 0; i < point_type::dimensionality(); ++i)
+        {
+            lo[i] -= r;
+            hi[i] += r;
+        }
+        const cell_type first = get_cell(lo), last = get_cell(hi);
+        double cells = 1.0;
+        for (size_t i = 0; i < point_type::dimensionality(); ++i)
+        { cells *= double(last[i]) - double(first[i]) + 1.0; }
+        if (cells > double(size()))
+        {
+            // Testing all objects is cheaper than visiting the cells.
+            for (size_t i = 0; i < size(); ++i)
+            {
+                if (is_intersecting(m_objects[i], s))
+                { f(size_t(m_indices[i])); }
+            }
+            return;
+        }
+        cell_type c = first;
+        do
+        {
+            const std::uint32_t b = get_bucket(c);
+            for (std::uint32_t i = m_starts[b], n = m_starts[b + 1]; i < n; ++i)
+            {
+                if (m_cells[i] == c && is_intersecting(m_objects[i], s))
+                { f(size_t(m_indices[i])); }
+            }
+        } while (next(c, first, last));
+    }
+
+    /// @brief Invoke a function for each pair of intersecting objects.
+    /// @param f the function receiving the indices @a i and @a j of the objects where @a i is smaller than @a j.
+    /// Each pair is reported once.
+    /// @remark The objects of a cell are tested against the objects of the same cell and against the objects of the cells in
+    /// the half of its neighborhood following it in lexicographic order.
+    template <typename F>
+    void query_pairs(F&& f) const
+    {
+        const is_intersecting_functor<G, G> intersecting{};
+        for (std::uint32_t i = 0, n = std::uint32_t(size()); i < n; ++i)
+        {
+            const cell_type& c = m_cells[i];
+            for (const cell_type& o : m_neighbors)
+            {
+                cell_type d;
+                bool same = true;
+                for (size_t k = 0; k < point_type::dimensionality(); ++k)
+                {
+                    d[k] = c[k] + o[k];
+                    same = same && o[k] == 0;
+                }
+                const std::uint32_t b = get_bucket(d);
+                // Within the same cell, the object is tested against the objects following it in the same bucket.
+                for (std::uint32_t j = same ? i + 1 : m_starts[b], m = m_starts[b + 1]; j < m; ++j)
+                {
+                    if (m_cells[j] == d && intersecting(m_objects[i], m_objects[j]))
+                    { f(size_t(std::min(m_indices[i], m_indices[j])), size_t(std::max(m_indices[i], m_indices[j]))); }
+                }
+            }
+        }
+    }
+
+private:
+    /// @brief The cell size.
+    scalar_type m_cell_size;
+
+    /// @brief The greatest extent of an object.
+    scalar_type m_extent = zero<scalar_type>();
+
+    /// @brief The offsets of the cells tested by query_pairs: The cell itself and the half of its neighborhood following it.
+    std::vector<cell_type> m_neighbors;
+
+    /// @brief The index of the first object of each bucket, followed by the number of objects.
+    std::vector<std::uint32_t> m_starts;
+
+    /// @brief The indices of the objects sorted by bucket.
+    std::vector<std::uint32_t> m_indices;
+
+    /// @brief The objects sorted by bucket.
+    std::vector<G> m_objects;
+
+    /// @brief The cells of the objects sorted by bucket.
+    std::vector<cell_type> m_cells;
+
+    /// @brief The cells of the objects in the order of the objects. Reused by subsequent builds.
+    std::vector<cell_type> m_build_cells;
+
+    /// @brief The buckets of the objects in the order of the objects. Reused by subsequent builds.
+    std::vector<std::uint32_t> m_build_buckets;
+
+    /// @brief The number of objects of each bucket per range of objects, one row of buckets per range. Reused by subsequent builds.
+    std::vector<std::uint32_t> m_build_counts;
+
+    /// @brief The number of objects per range of buckets. Reused by subsequent builds.
+    std::vector<std::uint32_t> m_build_totals;
+
+    /// @brief The greatest extent of an object per range of objects. Reused by subsequent builds.
+    std::vector<scalar_type> m_build_extents;
+
+    std::uint32_t get_bucket(const cell_type& c) const
+    {
+        static constexpr std::uint32_t primes[] = { 73856093u, 19349663u, 83492791u, 25165843u };
+        std::uint32_t h = 0;
+        for (size_t i = 0; i < point_type::dimensionality(); ++i)
+        { h ^= std::uint32_t(c[i]) * primes[i % 4]; }
+        return h & std::uint32_t(m_starts.size() - 2);
+    }
+
+    // Advance the coordinates c to the next cell in [first,last]. Return false if c was the last cell.
+    static bool next(cell_type& c, const cell_type& first, const cell_type& last)
+    {
+        for (size_t i = 0; i < point_type::dimensionality(); ++i)
+        {
+            if (c[i] < last[i])
+            {
+                c[i]++;
+                return true;
+            }
+            c[i] = first[i];
+        }
+        return false;
+    }
+
+}; // struct uniform_grid
+
+template <typename G>
+void uniform_grid<G>::build(const G *objects, size_t count, const execution_policy& policy)
+{
+    using traits = internal::uniform_grid_traits<G>;
+    static constexpr size_t D = point_type::dimensionality();
+    if (count >= size_t(std::numeric_limits<std::int32_t>::max()))
+    { throw std::invalid_argument("too many objects"); }
+    // The number of buckets is a power of two and at least twice the number of objects.
+    size_t number_of_buckets = 1;
+    while (number_of_buckets < 2 * count)
+    { number_of_buckets *= 2; }
+    m_starts.resize(number_of_buckets + 1);
+    m_indices.resize(count);
+    m_objects.resize(count);
+    m_cells.resize(count);
+    // The objects are partitioned into one contiguous range per thread. Each thread counts the objects of its range per bucket.
+    // The prefix sums over the buckets and the ranges are the positions of the objects of each range and bucket.
+    // The prefix sums are computed by partitioning the buckets into one contiguous range per thread:
+    // Each thread sums the counts of its range, the sums are scanned, and each thread scans its range starting at its sum.
+    const size_t threads = internal::number_of_threads(count, policy);
+    const execution_policy per_thread{ threads, 1 };
+    const auto range = [count, threads](size_t t) { return (count * t) / threads; };
+    const auto bucket_range = [number_of_buckets, threads](size_t t) { return (number_of_buckets * t) / threads; };
+    m_build_cells.resize(count);
+    m_build_buckets.resize(count);
+    m_build_counts.resize(threads * number_of_buckets);
+    m_build_totals.resize(threads);
+    m_build_extents.assign(threads, zero<scalar_type>());
+    std::uint32_t *counts = m_build_counts.data();
+    internal::parallel_for(threads, per_thread, [&](size_t first, size_t last)
+    {
+        for (size_t t = first; t < last; ++t)
+        {
+            std::uint32_t *row = counts + t * number_of_buckets;
+            std::fill(row, row + number_of_buckets, 0);
+            for (size_t i = range(t); i < range(t + 1); ++i)
+            {
+                m_build_cells[i] = get_cell(traits::get_center(objects[i]));
+                m_build_buckets[i] = get_bucket(m_build_cells[i]);
+                row[m_build_buckets[i]]++;
+                m_build_extents[t] = std::max(m_build_extents[t], traits::get_extent(objects[i]));
+            }
+        }
+    });
+    internal::parallel_for(threads, per_thread, [&](size_t first, size_t last)
+    {
+        for (size_t r = first; r < last; ++r)
+        {
+            std::uint32_t n = 0;
+            for (size_t t = 0; t < threads; ++t)
+            {
+                const std::uint32_t *row = counts + t * number_of_buckets;
+                for (size_t b = bucket_range(r); b < bucket_range(r + 1); ++b)
+                { n += row[b]; }
+            }
+            m_build_totals[r] = n;
+        }
+    });
+    std::uint32_t position = 0;
+    for (size_t r = 0; r < threads; ++r)
+    {
+        const std::uint32_t n = m_build_totals[r];
+        m_build_totals[r] = position;
+        position += n;
+    }
+    m_starts[number_of_buckets] = position;
+    internal::parallel_for(threads, per_thread, [&](size_t first, size_t last)
+    {
+        for (size_t r = first; r < last; ++r)
+        {
+            std::uint32_t p = m_build_totals[r];
+            for (size_t b = bucket_range(r); b < bucket_range(r + 1); ++b)
+            {
+                m_starts[b] = p;
+                for (size_t t = 0; t < threads; ++t)
+                {
+                    std::uint32_t& c = counts[t * number_of_buckets + b];
+                    const std::uint32_t n = c;
+                    c = p;
+                    p += n;
+                }
+            }
+        }
+    });
+    internal::parallel_for(threads, per_thread, [&](size_t first, size_t last)
+    {
+        for (size_t t = first; t < last; ++t)
+        {
+            std::uint32_t *row = counts + t * number_of_buckets;
+            for (size_t i = range(t); i < range(t + 1); ++i)
+            {
+                const std::uint32_t j = row[m_build_buckets[i]]++;
+                m_indices[j] = std::uint32_t(i);
+                m_objects[j] = objects[i];
+                m_cells[j] = m_build_cells[i];
+            }
+        }
+    });
+    m_extent = zero<scalar_type>();
+    for (const auto& e : m_build_extents)
+    { m_extent = std::max(m_extent, e); }
+    // The offsets of the cells at most k cells apart along each axis which follow the cell in lexicographic order, and the cell itself.
+    const scalar_type k = std::ceil((m_extent + m_extent) / m_cell_size);
+    const std::int32_t n = std::max(std::int32_t(1), std::int32_t(k));
+    m_neighbors.clear();
+    cell_type first, last, o;
+    first.fill(-n);
+    last.fill(n);
+    o = first;
+    do
+    {
+        // The offset follows the cell if its last non-zero component is positive.
+        size_t i = D;
+        while (i > 0 && o[i - 1] == 0)
+        {
+            --i;
+        }
+        if (i == 0 || o[i - 1] > 0)
+        { m_neighbors.push_back(o); }
+    } while (next(o, first, last));
+}
+
+} // namespace idlib
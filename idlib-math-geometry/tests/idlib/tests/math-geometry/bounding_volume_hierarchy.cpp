@@ -0,0 +1,302 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct bounding_volume_hierarchy_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using ray_type = idlib::ray<point_type>;
+    using hierarchy_type = idlib::bounding_volume_hierarchy<point_type>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-100,+100]^3\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -100, 100), get_scalar(3 * i + 1, -100, 100), get_scalar(3 * i + 2, -100, 100)); }
+
+    /// @brief Get pseudo-random boxes. Some boxes are equal.
+    static std::vector<box_type> get_boxes(size_t count)
+    {
+        std::vector<box_type> boxes;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto p = get_point(i % 2000);
+            boxes.emplace_back(p, p + vector_type(get_scalar(i, 0, 5), get_scalar(i + 1, 0, 5), get_scalar(i + 2, 0, 5)));
+        }
+        return boxes;
+    }
+
+    /// @brief Assert the nodes enclose their boxes and each box is in a leaf exactly once.
+    static void check_structure(const hierarchy_type& h, const std::vector<box_type>& boxes, size_t maximum_leaf_size)
+    {
+        ASSERT_EQ(boxes.size(), h.size());
+        std::vector<size_t> leaves(boxes.size(), 0);
+        const auto& nodes = h.get_nodes();
+        for (const auto& x : nodes)
+        {
+            if (x.is_leaf())
+            {
+                ASSERT_LE(x.count, maximum_leaf_size);
+                for (size_t i = x.first; i < x.first + x.count; ++i)
+                {
+                    const size_t j = h.get_indices()[i];
+                    leaves[j]++;
+                    ASSERT_TRUE(idlib::is_enclosing(x.bounds, boxes[j]));
+                }
+            }
+            else
+            {
+                ASSERT_LT(x.first + 1, nodes.size());
+                ASSERT_TRUE(idlib::is_enclosing(x.bounds, nodes[x.first].bounds));
+                ASSERT_TRUE(idlib::is_enclosing(x.bounds, nodes[x.first + 1].bounds));
+            }
+        }
+        ASSERT_TRUE(std::all_of(leaves.begin(), leaves.end(), [](size_t n) { return n == 1; }));
+    }
+
+    /// @brief Assert a query reports the boxes intersecting a geometry.
+    template <typename G>
+    static void check_query(const hierarchy_type& h, const std::vector<box_type>& boxes, const G& g)
+    {
+        std::vector<size_t> expected, actual;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            if (idlib::is_intersecting(boxes[i], g))
+            { expected.push_back(i); }
+        }
+        h.query(g, [&actual](size_t i) { actual.push_back(i); });
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+    }
+};
+
+using bounding_volume_hierarchy_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(bounding_volume_hierarchy_test, bounding_volume_hierarchy_test_types);
+
+TYPED_TEST(bounding_volume_hierarchy_test, empty)
+{
+    using fixture = TestFixture;
+    const typename fixture::hierarchy_type h;
+    ASSERT_TRUE(h.empty());
+    ASSERT_THROW(h.get_bounds(), std::logic_error);
+    size_t n = 0;
+    h.query(typename fixture::point_type(0, 0, 0), [&n](size_t) { n++; });
+    h.query(typename fixture::ray_type(typename fixture::point_type(0, 0, 0), typename fixture::vector_type(1, 0, 0)), 100,
+            [&n](size_t, typename fixture::scalar_type&) { n++; return false; });
+    ASSERT_EQ(0, n);
+}
+
+TYPED_TEST(bounding_volume_hierarchy_test, structure)
+{
+    using fixture = TestFixture;
+    const auto boxes = fixture::get_boxes(3000);
+    for (size_t maximum_leaf_size : { 1, 4, 8 })
+    {
+        const typename fixture::hierarchy_type h(boxes.data(), boxes.size(), idlib::execution_policy::sequential(), maximum_leaf_size);
+        fixture::check_structure(h, boxes, maximum_leaf_size);
+    }
+    // The hierarchy built in parallel has the same nodes.
+    const typename fixture::hierarchy_type h(boxes.data(), boxes.size());
+    const typename fixture::hierarchy_type g(boxes.data(), boxes.size(), idlib::execution_policy::parallel(3, 100));
+    fixture::check_structure(g, boxes, 4);
+    ASSERT_EQ(h.get_indices(), g.get_indices());
+    ASSERT_EQ(h.get_nodes().size(), g.get_nodes().size());
+    ASSERT_EQ(h.get_bounds(), g.get_bounds());
+    // Equal boxes are split into leaves.
+    const std::vector<typename fixture::box_type> equal(100, boxes[0]);
+    fixture::check_structure(typename fixture::hierarchy_type(equal.data(), equal.size()), equal, 4);
+    ASSERT_THROW(typename fixture::hierarchy_type(boxes.data(), boxes.size(), idlib::execution_policy::sequential(), 0), std::invalid_argument);
+}
+
+TYPED_TEST(bounding_volume_hierarchy_test, query)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const auto boxes = fixture::get_boxes(3000);
+    const typename fixture::hierarchy_type h(boxes.data(), boxes.size(), idlib::execution_policy::parallel(2, 100));
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const auto p = fixture::get_point(5000 + i);
+        fixture::check_query(h, boxes, p);
+        fixture::check_query(h, boxes, typename fixture::box_type(p, p + typename fixture::vector_type(20, 10, 5)));
+        fixture::check_query(h, boxes, typename fixture::sphere_type(p, fixture::get_scalar(i, 0, 30)));
+    }
+    fixture::check_query(h, boxes, point_type(1000, 0, 0));
+}
+
+TYPED_TEST(bounding_volume_hierarchy_test, ray)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    const auto boxes = fixture::get_boxes(3000);
+    const typename fixture::hierarchy_type h(boxes.data(), boxes.size());
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const auto p = fixture::get_point(7000 + i);
+        const typename fixture::ray_type r(p, fixture::get_point(9000 + i) - p);
+        const idlib::internal::ray_box_test<typename fixture::point_type> test(r);
+        // All hits.
+        std::vector<size_t> expected, actual;
+        scalar_type t, closest = std::numeric_limits<scalar_type>::max();
+        for (size_t j = 0; j < boxes.size(); ++j)
+        {
+            if (test(boxes[j], 150, t))
+            {
+                expected.push_back(j);
+                closest = std::min(closest, t);
+            }
+        }
+        h.query(r, 150, [&actual](size_t j, scalar_type&) { actual.push_back(j); return false; });
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        // The closest hit: The maximum distance is decreased to the distance of the closest hit found so far.
+        scalar_type found = std::numeric_limits<scalar_type>::max();
+        size_t visited = 0;
+        h.query(r, 150, [&](size_t j, scalar_type& t_max)
+        {
+            visited++;
+            test(boxes[j], t_max, t);
+            found = std::min(found, t);
+            t_max = t;
+            return false;
+        });
+        if (expected.empty())
+        {
+            ASSERT_EQ(0, visited);
+        }
+        else
+        {
+            ASSERT_EQ(closest, found);
+        }
+        // Early out.
+        visited = 0;
+        h.query(r, 150, [&visited](size_t, scalar_type&) { visited++; return true; });
+        ASSERT_EQ(expected.empty() ? 0 : 1, visited);
+    }
+}
+
+TYPED_TEST(bounding_volume_hierarchy_test, ray_packet)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    const auto boxes = fixture::get_boxes(3000);
+    const typename fixture::hierarchy_type h(boxes.data(), boxes.size());
+    for (size_t i = 0; i < 20; ++i)
+    {
+        // Coherent rays from a common origin to nearby targets, and incoherent rays.
+        std::vector<typename fixture::ray_type> rays;
+        const auto p = fixture::get_point(7000 + i);
+        for (size_t j = 0; j < 8; ++j)
+        {
+            const auto o = i % 2 == 0 ? p : fixture::get_point(7100 + 8 * i + j);
+            rays.emplace_back(o, fixture::get_point(9000 + i) + typename fixture::vector_type(scalar_type(j), 0, 0) - o);
+        }
+        const idlib::ray_packet<typename fixture::point_type, 8> r(rays.data());
+        // All hits.
+        std::vector<std::pair<size_t, size_t>> expected, actual;
+        for (size_t j = 0; j < boxes.size(); ++j)
+        {
+            for (size_t k = 0; k < 8; ++k)
+            {
+                scalar_type t;
+                if (idlib::ray_cast(rays[k], boxes[j], scalar_type(150), t))
+                { expected.emplace_back(j, k); }
+            }
+        }
+        scalar_type t_max[8] = { 150, 150, 150, 150, 150, 150, 150, 150 };
+        h.query(r, t_max, [&actual](size_t j, unsigned int hits, scalar_type *)
+        {
+            for (size_t k = 0; k < 8; ++k)
+            {
+                if (hits & (1u << k))
+                { actual.emplace_back(j, k); }
+            }
+            return false;
+        });
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        // The closest hits: The maximum distances are decreased to the distances of the closest hits found so far.
+        for (size_t k = 0; k < 8; ++k)
+        {
+            scalar_type closest = 150;
+            h.query(rays[k], 150, [&](size_t j, scalar_type& t_max)
+            {
+                idlib::ray_cast(rays[k], boxes[j], t_max, t_max);
+                closest = t_max;
+                return false;
+            });
+            t_max[k] = closest;
+        }
+        scalar_type found[8] = { 150, 150, 150, 150, 150, 150, 150, 150 };
+        h.query(r, found, [&](size_t j, unsigned int, scalar_type *t_max)
+        {
+            scalar_type t[8];
+            const unsigned int hits = idlib::ray_cast(r, boxes[j], t_max, t);
+            for (size_t k = 0; k < 8; ++k)
+            {
+                if (hits & (1u << k))
+                { t_max[k] = t[k]; }
+            }
+            return false;
+        });
+        for (size_t k = 0; k < 8; ++k)
+        {
+            ASSERT_NEAR(t_max[k], found[k], 1e-3);
+        }
+    }
+}
+
+TEST(bounding_volume_hierarchy_test, point_2s)
+{
+    using point_type = idlib::point<idlib::vector<single, 2>>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    std::vector<box_type> boxes;
+    for (size_t i = 0; i < 30; ++i)
+    {
+        for (size_t j = 0; j < 30; ++j)
+        { boxes.emplace_back(point_type(single(i), single(j)), point_type(single(i) + 0.5f, single(j) + 0.5f)); }
+    }
+    const idlib::bounding_volume_hierarchy<point_type> h(boxes.data(), boxes.size());
+    std::vector<size_t> actual;
+    h.query(box_type(point_type(2.25f, 3.25f), point_type(3.75f, 3.75f)), [&actual](size_t i) { actual.push_back(i); });
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(std::vector<size_t>({ 2 * 30 + 3, 3 * 30 + 3 }), actual);
+    ASSERT_EQ(box_type(point_type(0.0f, 0.0f), point_type(29.5f, 29.5f)), h.get_bounds());
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct dynamic_bounding_volume_hierarchy_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using hierarchy_type = idlib::dynamic_bounding_volume_hierarchy<point_type>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-100,+100]^3\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -100, 100), get_scalar(3 * i + 1, -100, 100), get_scalar(3 * i + 2, -100, 100)); }
+
+    /// @brief Get a pseudo-random box.
+    static box_type get_box(size_t i)
+    {
+        const auto p = get_point(i);
+        return box_type(p, p + vector_type(get_scalar(i, 0, 5), get_scalar(i + 1, 0, 5), get_scalar(i + 2, 0, 5)));
+    }
+
+    /// @brief Assert the proxies enclose their boxes and queries and pair queries report the intersecting fat boxes.
+    /// @param proxies the proxies and their boxes
+    template <typename G>
+    static void check(const hierarchy_type& h, const std::vector<std::pair<size_t, box_type>>& proxies, const G& g)
+    {
+        ASSERT_EQ(proxies.size(), h.size());
+        std::vector<size_t> expected, actual;
+        for (const auto& p : proxies)
+        {
+            ASSERT_TRUE(idlib::is_enclosing(h.get_box(p.first), p.second));
+            ASSERT_TRUE(idlib::is_enclosing(h.get_bounds(), h.get_box(p.first)));
+            if (idlib::is_intersecting(h.get_box(p.first), g))
+            { expected.push_back(p.first); }
+        }
+        h.query(g, [&actual](size_t i) { actual.push_back(i); });
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        std::vector<std::pair<size_t, size_t>> expected_pairs, actual_pairs;
+        for (size_t i = 0; i < proxies.size(); ++i)
+        {
+            for (size_t j = i + 1; j < proxies.size(); ++j)
+            {
+                const size_t a = proxies[i].first, b = proxies[j].first;
+                if (idlib::is_intersecting(h.get_box(a), h.get_box(b)))
+                { expected_pairs.emplace_back(std::min(a, b), std::max(a, b)); }
+            }
+        }
+        h.query_pairs([&actual_pairs](size_t a, size_t b) { actual_pairs.emplace_back(a, b); });
+        std::sort(expected_pairs.begin(), expected_pairs.end());
+        std::sort(actual_pairs.begin(), actual_pairs.end());
+        ASSERT_EQ(expected_pairs, actual_pairs);
+    }
+};
+
+using dynamic_bounding_volume_hierarchy_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(dynamic_bounding_volume_hierarchy_test, dynamic_bounding_volume_hierarchy_test_types);
+
+TYPED_TEST(dynamic_bounding_volume_hierarchy_test, empty)
+{
+    using fixture = TestFixture;
+    typename fixture::hierarchy_type h;
+    ASSERT_TRUE(h.empty());
+    ASSERT_EQ(0, h.get_height());
+    ASSERT_THROW(h.get_bounds(), std::logic_error);
+    ASSERT_THROW(h.get_box(0), std::invalid_argument);
+    ASSERT_THROW(h.remove(0), std::invalid_argument);
+    size_t n = 0;
+    h.query(typename fixture::point_type(0, 0, 0), [&n](size_t) { n++; });
+    h.query_pairs([&n](size_t, size_t) { n++; });
+    ASSERT_EQ(0, n);
+    ASSERT_THROW(typename fixture::hierarchy_type(-1), std::invalid_argument);
+}
+
+TYPED_TEST(dynamic_bounding_volume_hierarchy_test, insert_remove)
+{
+    using fixture = TestFixture;
+    typename fixture::hierarchy_type h(1);
+    std::vector<std::pair<size_t, typename fixture::box_type>> proxies;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        const auto b = fixture::get_box(i);
+        proxies.emplace_back(h.insert(b), b);
+    }
+    const auto p = fixture::get_point(1000);
+    fixture::check(h, proxies, typename fixture::box_type(p, p + typename fixture::vector_type(30, 20, 10)));
+    // Remove every third box. The proxies of removed boxes are invalid.
+    std::vector<size_t> removed;
+    for (size_t i = 0; i < proxies.size(); i += 2)
+    {
+        h.remove(proxies[i].first);
+        removed.push_back(proxies[i].first);
+        proxies.erase(proxies.begin() + i);
+    }
+    for (size_t proxy : removed)
+    { ASSERT_THROW(h.remove(proxy), std::invalid_argument); }
+    fixture::check(h, proxies, typename fixture::sphere_type(p, 25));
+    // The proxies of removed boxes are reused.
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const auto b = fixture::get_box(2000 + i);
+        proxies.emplace_back(h.insert(b), b);
+    }
+    fixture::check(h, proxies, p);
+    for (const auto& x : proxies)
+    { h.remove(x.first); }
+    ASSERT_TRUE(h.empty());
+}
+
+TYPED_TEST(dynamic_bounding_volume_hierarchy_test, move)
+{
+    using fixture = TestFixture;
+    using vector_type = typename fixture::vector_type;
+    typename fixture::hierarchy_type h(1);
+    std::vector<std::pair<size_t, typename fixture::box_type>> proxies;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        const auto b = fixture::get_box(i);
+        proxies.emplace_back(h.insert(b), b);
+    }
+    // Moving a box within its fat box does not change the fat box.
+    const auto fat = h.get_box(proxies[0].first);
+    ASSERT_FALSE(h.move(proxies[0].first, idlib::translate(proxies[0].second, vector_type(0.5, -0.5, 0.5))));
+    ASSERT_EQ(fat, h.get_box(proxies[0].first));
+    // Moving boxes out of their fat boxes.
+    for (size_t step = 0; step < 10; ++step)
+    {
+        for (size_t i = 0; i < proxies.size(); ++i)
+        {
+            auto& x = proxies[i];
+            x.second = idlib::translate(x.second, vector_type(fixture::get_scalar(i + step, -3, 3), fixture::get_scalar(i + step + 1, -3, 3), 2));
+            h.move(x.first, x.second);
+        }
+        fixture::check(h, proxies, fixture::get_box(3000 + step));
+    }
+    ASSERT_THROW(h.move(size_t(-1), proxies[0].second), std::invalid_argument);
+}
+
+TYPED_TEST(dynamic_bounding_volume_hierarchy_test, balance)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    // Inserting boxes sorted along an axis would produce a list without rotations.
+    typename fixture::hierarchy_type h;
+    std::vector<std::pair<size_t, typename fixture::box_type>> proxies;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        const typename fixture::box_type b(point_type(i, 0, 0), point_type(i + 0.5, 1, 1));
+        proxies.emplace_back(h.insert(b), b);
+    }
+    ASSERT_LE(h.get_height(), 20);
+    fixture::check(h, proxies, point_type(100.25, 0.5, 0.5));
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/tests/math-geometry/utilities.hpp"
+#include "idlib/math_geometry/frustum.hpp"
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct frustum_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using point_type = idlib::point<idlib::vector<scalar_type, 3>>;
+    using frustum_type = idlib::frustum<point_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using axis_aligned_box_type = idlib::axis_aligned_box<point_type>;
+    using axis_aligned_cube_type = idlib::axis_aligned_cube<point_type>;
+    using matrix_type = idlib::matrix<scalar_type, 4, 4>;
+
+    /// @brief Get a view-projection matrix.
+    /// The camera is at \f$(0,0,10)\f$ and looks along the negative z-axis,
+    /// the field of view is 90 degrees, the near plane is at distance 1 and the far plane at distance 100.
+    static matrix_type get_matrix()
+    {
+        const auto s = idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(90.0f), 1.0f, 1.0f, 100.0f)
+                     * idlib::translation_matrix(idlib::vector<single, 3>(0.0f, 0.0f, -10.0f));
+        matrix_type m;
+        for (size_t i = 0; i < 16; ++i)
+        { m(i) = scalar_type(s(i)); }
+        return m;
+    }
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in a cube around the frustum of get_matrix().
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -120, 120), get_scalar(3 * i + 1, -120, 120), get_scalar(3 * i + 2, -120, 20)); }
+
+    /// @brief Assert the visibility bitmask is the bitmask computed by idlib::is_intersecting.
+    template <typename T>
+    static void check(const frustum_type& f, const std::vector<T>& geometries)
+    {
+        std::vector<uint32_t> visibility(idlib::number_of_visibility_words(geometries.size()), 0xdeadbeef);
+        idlib::cull(f, geometries.data(), geometries.size(), visibility.data());
+        std::vector<uint32_t> expected(visibility.size(), 0);
+        size_t visible = 0;
+        for (size_t i = 0; i < geometries.size(); ++i)
+        {
+            if (idlib::is_intersecting(f, geometries[i]))
+            {
+                expected[i / 32] |= uint32_t(1) << (i % 32);
+                visible++;
+            }
+        }
+        ASSERT_EQ(expected, visibility);
+        // Both visible and invisible geometries are tested.
+        ASSERT_LT(size_t(0), visible);
+        ASSERT_GT(geometries.size(), visible);
+        for (size_t n = 2; n <= 5; ++n)
+        {
+            std::vector<uint32_t> v(visibility.size());
+            idlib::cull(f, geometries.data(), geometries.size(), v.data(), idlib::execution_policy::parallel(n, 1));
+            ASSERT_EQ(visibility, v);
+        }
+    }
+};
+
+using frustum_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(frustum_test, frustum_test_types);
+
+TYPED_TEST(frustum_test, planes)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    using frustum_type = typename fixture::frustum_type;
+    using scalar_type = typename fixture::scalar_type;
+    const frustum_type f(fixture::get_matrix());
+    for (const auto& p : f.get_planes())
+    {
+        ASSERT_NEAR(scalar_type(1), idlib::euclidean_norm(p.get_normal()), 1e-6);
+    }
+    // The near plane is the plane z = 9, the far plane is the plane z = -90.
+    ASSERT_NEAR(scalar_type(-1), f.get_plane(frustum_type::z_near).get_normal()[2], 1e-6);
+    ASSERT_NEAR(scalar_type(9), f.get_plane(frustum_type::z_near).get_distance(), 1e-4);
+    ASSERT_NEAR(scalar_type(1), f.get_plane(frustum_type::z_far).get_normal()[2], 1e-6);
+    ASSERT_NEAR(scalar_type(90), f.get_plane(frustum_type::z_far).get_distance(), 1e-3);
+    ASSERT_TRUE(idlib::is_enclosing(f, point_type(0, 0, 0)));
+    ASSERT_TRUE(idlib::is_enclosing(f, point_type(9, -9, -0.5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 0, 9.5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 0, 11)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 0, -91)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(11, 0, 0)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, -11, 0)));
+    // The default frustum is the cube [-1,+1]^3.
+    const frustum_type g;
+    ASSERT_TRUE(idlib::is_enclosing(g, point_type(1, -1, 1)));
+    ASSERT_FALSE(idlib::is_enclosing(g, point_type(0, 0, 1.5)));
+}
+
+TYPED_TEST(frustum_test, orthographic)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    using frustum_type = typename fixture::frustum_type;
+    using scalar_type = typename fixture::scalar_type;
+    const auto s = idlib::orthographic_projection_matrix(-2.0f, 2.0f, -1.0f, 1.0f, 1.0f, 10.0f);
+    typename fixture::matrix_type m;
+    for (size_t i = 0; i < 16; ++i)
+    { m(i) = scalar_type(s(i)); }
+    const frustum_type f(m);
+    ASSERT_TRUE(idlib::is_enclosing(f, point_type(-1.5, 0.5, -5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(-2.5, 0.5, -5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 1.5, -5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 0, -0.5)));
+    ASSERT_FALSE(idlib::is_enclosing(f, point_type(0, 0, -10.5)));
+}
+
+TYPED_TEST(frustum_test, intersecting)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const typename fixture::frustum_type f(fixture::get_matrix());
+    using sphere_type = typename fixture::sphere_type;
+    using axis_aligned_box_type = typename fixture::axis_aligned_box_type;
+    using axis_aligned_cube_type = typename fixture::axis_aligned_cube_type;
+    ASSERT_TRUE(idlib::is_intersecting(f, sphere_type(point_type(0, 0, 0), 1)));
+    ASSERT_TRUE(idlib::is_intersecting(f, sphere_type(point_type(0, 0, 11), 2)));
+    ASSERT_FALSE(idlib::is_intersecting(f, sphere_type(point_type(0, 0, 11), 1)));
+    ASSERT_TRUE(idlib::is_intersecting(f, axis_aligned_box_type(point_type(-20, -20, -1), point_type(-9, 20, 1))));
+    ASSERT_FALSE(idlib::is_intersecting(f, axis_aligned_box_type(point_type(-20, -20, -1), point_type(-12, 20, 1))));
+    ASSERT_TRUE(idlib::is_intersecting(f, axis_aligned_cube_type(point_type(0, 0, -95), 12)));
+    ASSERT_FALSE(idlib::is_intersecting(f, axis_aligned_cube_type(point_type(0, 0, -95), 8)));
+}
+
+TYPED_TEST(frustum_test, enclosing)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const typename fixture::frustum_type f(fixture::get_matrix());
+    using axis_aligned_box_type = typename fixture::axis_aligned_box_type;
+    using axis_aligned_cube_type = typename fixture::axis_aligned_cube_type;
+    ASSERT_TRUE(idlib::is_enclosing(f, axis_aligned_box_type(point_type(-5, -5, -1), point_type(5, 5, 1))));
+    // Boxes and cubes intersecting a plane of the frustum are not contained in the frustum.
+    ASSERT_TRUE(idlib::is_intersecting(f, axis_aligned_box_type(point_type(-1, -1, 8), point_type(1, 1, 10))));
+    ASSERT_FALSE(idlib::is_enclosing(f, axis_aligned_box_type(point_type(-1, -1, 8), point_type(1, 1, 10))));
+    ASSERT_FALSE(idlib::is_enclosing(f, axis_aligned_box_type(point_type(-20, -20, -1), point_type(-9, 20, 1))));
+    ASSERT_TRUE(idlib::is_enclosing(f, axis_aligned_cube_type(point_type(0, 0, -10), 4)));
+    ASSERT_TRUE(idlib::is_intersecting(f, axis_aligned_cube_type(point_type(0, 0, -95), 12)));
+    ASSERT_FALSE(idlib::is_enclosing(f, axis_aligned_cube_type(point_type(0, 0, -95), 12)));
+}
+
+TYPED_TEST(frustum_test, cull)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    const typename fixture::frustum_type f(fixture::get_matrix());
+    // The numbers of geometries are not multiples of the number of bits of a word.
+    std::vector<typename fixture::sphere_type> spheres;
+    for (size_t i = 0; i < 1000 + 7; ++i)
+    { spheres.emplace_back(fixture::get_point(i), fixture::get_scalar(i, 0, 20)); }
+    fixture::check(f, spheres);
+    std::vector<typename fixture::axis_aligned_box_type> boxes;
+    for (size_t i = 0; i < 1000 + 13; ++i)
+    {
+        const auto p = fixture::get_point(i);
+        boxes.emplace_back(p, p + idlib::vector<scalar_type, 3>(fixture::get_scalar(i, 0, 10), fixture::get_scalar(i + 1, 0, 20), fixture::get_scalar(i + 2, 0, 30)));
+    }
+    fixture::check(f, boxes);
+    std::vector<typename fixture::axis_aligned_cube_type> cubes;
+    for (size_t i = 0; i < 1000 + 31; ++i)
+    { cubes.emplace_back(fixture::get_point(i), fixture::get_scalar(i, 0, scalar_type(30))); }
+    fixture::check(f, cubes);
+}
+
+TYPED_TEST(frustum_test, cull_clears_unused_bits)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const typename fixture::frustum_type f(fixture::get_matrix());
+    const std::vector<typename fixture::sphere_type> spheres(3, typename fixture::sphere_type(point_type(0, 0, 0), 1));
+    uint32_t visibility = 0xffffffff;
+    idlib::cull(f, spheres.data(), spheres.size(), &visibility);
+    ASSERT_EQ(uint32_t(7), visibility);
+    idlib::cull(f, spheres.data(), 0, &visibility);
+    ASSERT_EQ(uint32_t(7), visibility);
+}
+
+} // namespace idlib::tests
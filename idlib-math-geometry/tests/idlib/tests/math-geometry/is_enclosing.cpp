@@ -34,6 +34,14 @@ TEST(is_enclosing, axis_aligned_box_3s_axis_aligned_box_3s) {
     ASSERT_TRUE(!idlib::is_enclosing(x, y));
 }
 
+TEST(is_enclosing, axis_aligned_box_3s_axis_aligned_cube_3s) {
+    auto x = axis_aligned_box_3s(point_3s(-1.0f, -1.0f, -1.0f), point_3s(+1.0f, +2.0f, +1.0f));
+    ASSERT_TRUE(idlib::is_enclosing(x, axis_aligned_cube_3s(point_3s(0.0f, 0.5f, 0.0f), 2.0f)));
+    ASSERT_TRUE(idlib::is_enclosing(x, axis_aligned_cube_3s(point_3s(0.5f, 1.5f, 0.0f), 1.0f)));
+    ASSERT_TRUE(!idlib::is_enclosing(x, axis_aligned_cube_3s(point_3s(0.0f, 0.5f, 0.0f), 3.0f)));
+    ASSERT_TRUE(!idlib::is_enclosing(x, axis_aligned_cube_3s(point_3s(1.0f, 0.0f, 0.0f), 1.0f)));
+}
+
 TEST(is_enclosing, axis_aligned_box_3s_point_3s) {
     auto x = axis_aligned_box_3s(point_3s(-1.0f, -1.0f, -1.0f), point_3s(+1.0f, +1.0f, +1.0f));
     auto y = Utilities::get_contained_point_3s(x);
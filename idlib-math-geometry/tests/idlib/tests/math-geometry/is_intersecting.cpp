@@ -83,4 +83,37 @@ TEST(intersection, axis_aligned_cube_3s_point_3s) {
     ASSERT_TRUE(!is_intersecting(x, y) && !is_intersecting(y, x));
 }
 
+TEST(intersection, axis_aligned_box_3s_sphere_3s) {
+    auto x = axis_aligned_box_3s(point_3s(-1.0f, -1.0f, -1.0f),
+                                 point_3s(+1.0f, +1.0f, +1.0f));
+    // The sphere touches a face.
+    auto y = sphere_3s(point_3s(2.0f, 0.0f, 0.0f), 1.0f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+    // The sphere is near a corner but does not touch it.
+    y = sphere_3s(point_3s(2.0f, 2.0f, 2.0f), 1.5f);
+    ASSERT_TRUE(!is_intersecting(x, y) && !is_intersecting(y, x));
+    // The sphere contains the corner.
+    y = sphere_3s(point_3s(2.0f, 2.0f, 2.0f), 1.8f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+    // The box contains the sphere.
+    y = sphere_3s(point_3s(0.0f, 0.0f, 0.0f), 0.5f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+}
+
+TEST(intersection, axis_aligned_cube_3s_sphere_3s) {
+    auto x = axis_aligned_cube_3s(point_3s(0.0f, 0.0f, 0.0f), 2.0f);
+    // The sphere touches a face.
+    auto y = sphere_3s(point_3s(0.0f, -2.0f, 0.0f), 1.0f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+    // The sphere is near a corner but does not touch it.
+    y = sphere_3s(point_3s(-2.0f, 2.0f, -2.0f), 1.5f);
+    ASSERT_TRUE(!is_intersecting(x, y) && !is_intersecting(y, x));
+    // The sphere contains the corner.
+    y = sphere_3s(point_3s(-2.0f, 2.0f, -2.0f), 1.8f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+    // The cube contains the sphere.
+    y = sphere_3s(point_3s(0.5f, 0.0f, 0.0f), 0.25f);
+    ASSERT_TRUE(is_intersecting(x, y) && is_intersecting(y, x));
+}
+
 } // namespace idlib::tests
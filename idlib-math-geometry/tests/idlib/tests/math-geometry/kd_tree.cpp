@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct kd_tree_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using tree_type = idlib::kd_tree<point_type>;
+    using neighbor_type = typename tree_type::neighbor;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-100,+100]^2 \times [-10,+10]\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -100, 100), get_scalar(3 * i + 1, -100, 100), get_scalar(3 * i + 2, -10, 10)); }
+
+    /// @brief Get pseudo-random points. Some points occur more than once.
+    static std::vector<point_type> get_points(size_t count)
+    {
+        std::vector<point_type> points;
+        for (size_t i = 0; i < count; ++i)
+        { points.push_back(i % 10 == 9 ? points[i / 2] : get_point(i)); }
+        return points;
+    }
+
+    static scalar_type squared_distance(const point_type& a, const point_type& b)
+    {
+        scalar_type d = 0;
+        for (size_t i = 0; i < 3; ++i)
+        { d += (a[i] - b[i]) * (a[i] - b[i]); }
+        return d;
+    }
+
+    /// @brief Assert the nodes of the tree partition the points.
+    static void check_nodes(const tree_type& t, const std::vector<point_type>& points, size_t maximum_leaf_size)
+    {
+        ASSERT_EQ(points.size(), t.size());
+        std::vector<std::uint32_t> indices = t.get_indices();
+        for (size_t i = 0; i < indices.size(); ++i)
+        { ASSERT_EQ(points[indices[i]], t.get_points()[i]); }
+        std::sort(indices.begin(), indices.end());
+        for (size_t i = 0; i < indices.size(); ++i)
+        { ASSERT_EQ(i, indices[i]); }
+        // Each node is visited with the range of its points.
+        struct entry { size_t node, begin, end; };
+        std::vector<entry> stack{ { 0, 0, points.size() } };
+        size_t leaves = 0;
+        while (!stack.empty())
+        {
+            const entry e = stack.back();
+            stack.pop_back();
+            const auto& x = t.get_nodes()[e.node];
+            if (x.is_leaf())
+            {
+                ASSERT_EQ(e.begin, x.first);
+                ASSERT_EQ(e.end - e.begin, x.count);
+                ASSERT_GE(maximum_leaf_size, x.count);
+                leaves += x.count;
+                continue;
+            }
+            const size_t middle = e.begin + (e.end - e.begin) / 2;
+            for (size_t i = e.begin; i < e.end; ++i)
+            {
+                if (i < middle)
+                { ASSERT_LE(t.get_points()[i][x.axis], x.split); }
+                else
+                { ASSERT_GE(t.get_points()[i][x.axis], x.split); }
+            }
+            stack.push_back(entry{ x.first, e.begin, middle });
+            stack.push_back(entry{ x.first + 1, middle, e.end });
+        }
+        ASSERT_EQ(points.size(), leaves);
+    }
+
+    /// @brief Assert the neighbors are the k nearest points or, if epsilon is positive, approximations.
+    static void check_nearest(const std::vector<point_type>& points, const point_type& p, size_t k, scalar_type epsilon,
+                              const neighbor_type *neighbors, size_t n)
+    {
+        ASSERT_EQ(std::min(k, points.size()), n);
+        std::vector<scalar_type> expected;
+        for (const auto& q : points)
+        { expected.push_back(squared_distance(p, q)); }
+        std::sort(expected.begin(), expected.end());
+        const scalar_type factor = (1 + epsilon) * (1 + epsilon);
+        for (size_t i = 0; i < n; ++i)
+        {
+            ASSERT_EQ(squared_distance(p, points[neighbors[i].index]), neighbors[i].squared_distance);
+            if (i > 0)
+            { ASSERT_LE(neighbors[i - 1].squared_distance, neighbors[i].squared_distance); }
+            if (epsilon == 0)
+            { ASSERT_EQ(expected[i], neighbors[i].squared_distance); }
+            else
+            { ASSERT_LE(neighbors[i].squared_distance, expected[i] * factor); }
+        }
+        // The indices are distinct.
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < n; ++i)
+        { indices.push_back(neighbors[i].index); }
+        std::sort(indices.begin(), indices.end());
+        ASSERT_TRUE(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+    }
+
+    /// @brief Get the indices of the points in a sphere.
+    static std::vector<size_t> get_enclosed(const std::vector<point_type>& points, const sphere_type& s)
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            if (squared_distance(s.get_center(), points[i]) <= s.get_radius_squared())
+            { indices.push_back(i); }
+        }
+        return indices;
+    }
+};
+
+using kd_tree_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(kd_tree_test, kd_tree_test_types);
+
+TYPED_TEST(kd_tree_test, empty)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const typename fixture::tree_type t;
+    ASSERT_TRUE(t.empty());
+    ASSERT_THROW(t.nearest(point_type(0, 0, 0)), std::logic_error);
+    typename fixture::neighbor_type n;
+    ASSERT_EQ(size_t(0), t.nearest(point_type(0, 0, 0), 1, &n));
+    size_t count = 0;
+    t.query(typename fixture::sphere_type(point_type(0, 0, 0), 100), [&count](size_t) { count++; });
+    ASSERT_EQ(size_t(0), count);
+    const point_type p(0, 0, 0);
+    ASSERT_TRUE(typename fixture::tree_type(&p, 0).empty());
+    ASSERT_THROW(typename fixture::tree_type(&p, 1, idlib::execution_policy::sequential(), 0), std::invalid_argument);
+}
+
+TYPED_TEST(kd_tree_test, build)
+{
+    using fixture = TestFixture;
+    const auto points = fixture::get_points(3000);
+    for (size_t leaf_size : { 1, 8 })
+    {
+        for (size_t threads : { 1, 3 })
+        {
+            const typename fixture::tree_type t(points.data(), points.size(), idlib::execution_policy::parallel(threads, 1), leaf_size);
+            fixture::check_nodes(t, points, leaf_size);
+        }
+    }
+    // All points are equal.
+    const std::vector<typename fixture::point_type> equal(100, points[0]);
+    const typename fixture::tree_type t(equal.data(), equal.size());
+    fixture::check_nodes(t, equal, 8);
+    ASSERT_EQ(size_t(8), t.nearest(points[0] + typename fixture::vector_type(1, 0, 0), 8, std::vector<typename fixture::neighbor_type>(8).data()));
+}
+
+TYPED_TEST(kd_tree_test, nearest)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    const auto points = fixture::get_points(3000);
+    for (size_t leaf_size : { 1, 8 })
+    {
+        const typename fixture::tree_type t(points.data(), points.size(), idlib::execution_policy::sequential(), leaf_size);
+        std::vector<typename fixture::neighbor_type> neighbors(points.size() + 1);
+        for (size_t i = 0; i < 50; ++i)
+        {
+            // Query points of the tree and points in and outside of the cell of the root node.
+            const auto q = fixture::get_point(10000 + i);
+            const auto p = i % 5 == 0 ? points[i] : typename fixture::point_type(q[0] * scalar_type(1.5), q[1], q[2] * scalar_type(1.5));
+            for (size_t k : { size_t(1), size_t(7), points.size() + 1 })
+            {
+                for (scalar_type epsilon : { scalar_type(0), scalar_type(0.5) })
+                {
+                    const size_t n = t.nearest(p, k, neighbors.data(), epsilon);
+                    fixture::check_nearest(points, p, k, epsilon, neighbors.data(), n);
+                }
+            }
+            const auto n = t.nearest(p);
+            fixture::check_nearest(points, p, 1, 0, &n, 1);
+        }
+    }
+}
+
+TYPED_TEST(kd_tree_test, query)
+{
+    using fixture = TestFixture;
+    using sphere_type = typename fixture::sphere_type;
+    const auto points = fixture::get_points(3000);
+    const typename fixture::tree_type t(points.data(), points.size());
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const sphere_type s(fixture::get_point(10000 + i), fixture::get_scalar(i, 0, 30));
+        std::vector<size_t> actual;
+        t.query(s, [&actual](size_t j) { actual.push_back(j); });
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(fixture::get_enclosed(points, s), actual);
+    }
+}
+
+TYPED_TEST(kd_tree_test, batches)
+{
+    using fixture = TestFixture;
+    using sphere_type = typename fixture::sphere_type;
+    const auto points = fixture::get_points(3000);
+    const typename fixture::tree_type t(points.data(), points.size(), idlib::execution_policy::parallel(3, 1));
+    std::vector<typename fixture::point_type> queries;
+    std::vector<sphere_type> spheres;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        queries.push_back(fixture::get_point(10000 + i));
+        spheres.emplace_back(queries.back(), fixture::get_scalar(i, 0, 20));
+    }
+    const size_t k = 5;
+    std::vector<typename fixture::neighbor_type> neighbors(queries.size() * k);
+    t.nearest(queries.data(), queries.size(), k, neighbors.data(), idlib::execution_policy::parallel(3, 1));
+    for (size_t i = 0; i < queries.size(); ++i)
+    { fixture::check_nearest(points, queries[i], k, 0, neighbors.data() + i * k, k); }
+    std::mutex mutex;
+    std::vector<std::vector<size_t>> actual(spheres.size());
+    t.query(spheres.data(), spheres.size(), [&mutex, &actual](size_t i, size_t j)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        actual[i].push_back(j);
+    }, idlib::execution_policy::parallel(3, 1));
+    for (size_t i = 0; i < spheres.size(); ++i)
+    {
+        std::sort(actual[i].begin(), actual[i].end());
+        ASSERT_EQ(fixture::get_enclosed(points, spheres[i]), actual[i]);
+    }
+}
+
+TEST(kd_tree_test, point_2s)
+{
+    using point_type = idlib::point<idlib::vector<single, 2>>;
+    std::vector<point_type> points;
+    for (size_t i = 0; i < 100; ++i)
+    { points.emplace_back(single(i % 10), single(i / 10)); }
+    const idlib::kd_tree<point_type> t(points.data(), points.size(), idlib::execution_policy::sequential(), 2);
+    const auto n = t.nearest(point_type(3.2f, 6.9f));
+    ASSERT_EQ(size_t(73), n.index);
+    ASSERT_NEAR(0.05f, n.squared_distance, 1e-5f);
+    std::vector<size_t> indices;
+    t.query(idlib::sphere<point_type>(point_type(5, 5), 1), [&indices](size_t i) { indices.push_back(i); });
+    std::sort(indices.begin(), indices.end());
+    ASSERT_EQ((std::vector<size_t>{ 45, 54, 55, 56, 65 }), indices);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct loose_octree_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using cube_type = idlib::axis_aligned_cube<point_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using frustum_type = idlib::frustum<point_type>;
+    using tree_type = idlib::loose_octree<point_type>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-100,+100]^3\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -100, 100), get_scalar(3 * i + 1, -100, 100), get_scalar(3 * i + 2, -100, 100)); }
+
+    /// @brief Get a pseudo-random box. The sizes of the boxes differ by orders of magnitude.
+    static box_type get_box(size_t i)
+    {
+        const auto p = get_point(i);
+        const scalar_type s = i % 50 == 0 ? 40 : (i % 5 == 0 ? 5 : 0.5);
+        return box_type(p, p + vector_type(get_scalar(i, 0, s), get_scalar(i + 1, 0, s), get_scalar(i + 2, 0, s)));
+    }
+
+    /// @brief Get a view-projection matrix.
+    /// The camera is at \f$(0,0,10)\f$ and looks along the negative z-axis,
+    /// the field of view is 90 degrees, the near plane is at distance 1 and the far plane at distance 100.
+    static frustum_type get_frustum()
+    {
+        const auto s = idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(90.0f), 1.0f, 1.0f, 100.0f)
+                     * idlib::translation_matrix(idlib::vector<single, 3>(0.0f, 0.0f, -10.0f));
+        idlib::matrix<scalar_type, 4, 4> m;
+        for (size_t i = 0; i < 16; ++i)
+        { m(i) = scalar_type(s(i)); }
+        return frustum_type(m);
+    }
+
+    /// @brief Assert the tree stores the objects and its queries report the intersecting objects.
+    /// @param objects the handles and the boxes of the objects
+    template <typename G>
+    static void check(const tree_type& t, const std::vector<std::pair<size_t, box_type>>& objects, const G& g)
+    {
+        ASSERT_EQ(objects.size(), t.size());
+        std::vector<size_t> expected, actual;
+        for (const auto& o : objects)
+        {
+            ASSERT_EQ(o.second, t.get_box(o.first));
+            if (idlib::is_intersecting(g, o.second))
+            { expected.push_back(o.first); }
+        }
+        t.query(g, [&actual](size_t i) { actual.push_back(i); });
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        size_t n = 0;
+        for (const auto& l : t.get_statistics())
+        { n += l.number_of_objects; }
+        ASSERT_EQ(objects.size(), n);
+    }
+
+    /// @brief Assert the tree stores the objects and box, sphere, and frustum queries report the intersecting objects.
+    static void check_queries(const tree_type& t, const std::vector<std::pair<size_t, box_type>>& objects)
+    {
+        for (size_t i = 0; i < 20; ++i)
+        {
+            const auto p = get_point(5000 + i);
+            check(t, objects, box_type(p, p + vector_type(30, 20, 10)));
+            check(t, objects, sphere_type(p, get_scalar(i, 0, 30)));
+        }
+        check(t, objects, get_frustum());
+    }
+};
+
+using loose_octree_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(loose_octree_test, loose_octree_test_types);
+
+TYPED_TEST(loose_octree_test, empty)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    typename fixture::tree_type t(typename fixture::cube_type(point_type(0, 0, 0), 256));
+    ASSERT_TRUE(t.empty());
+    ASSERT_THROW(t.get_box(0), std::invalid_argument);
+    ASSERT_THROW(t.remove(0), std::invalid_argument);
+    size_t n = 0;
+    t.query(typename fixture::sphere_type(point_type(0, 0, 0), 1000), [&n](size_t) { n++; });
+    ASSERT_EQ(0, n);
+    ASSERT_EQ(1, t.get_statistics().size());
+    ASSERT_THROW(typename fixture::tree_type(typename fixture::cube_type(point_type(0, 0, 0), 0)), std::invalid_argument);
+    ASSERT_THROW(typename fixture::tree_type(typename fixture::cube_type(point_type(0, 0, 0), 1), 17), std::invalid_argument);
+}
+
+TYPED_TEST(loose_octree_test, depth)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    using box_type = typename fixture::box_type;
+    typename fixture::tree_type t(typename fixture::cube_type(point_type(0, 0, 0), 256), 4);
+    // The node of a box is the deepest node whose size is at least the size of the box.
+    ASSERT_EQ(0, t.get_depth(t.insert(box_type(point_type(0, 0, 0), point_type(200, 1, 1)))));
+    ASSERT_EQ(1, t.get_depth(t.insert(box_type(point_type(0, 0, 0), point_type(100, 1, 1)))));
+    ASSERT_EQ(2, t.get_depth(t.insert(box_type(point_type(0, 0, 0), point_type(64, 1, 1)))));
+    ASSERT_EQ(4, t.get_depth(t.insert(box_type(point_type(0, 0, 0), point_type(1, 1, 1)))));
+    // Boxes with their center outside of the root node are stored in the root node.
+    ASSERT_EQ(0, t.get_depth(t.insert(box_type(point_type(500, 0, 0), point_type(501, 1, 1)))));
+    const auto statistics = t.get_statistics();
+    ASSERT_EQ(5, statistics.size());
+    for (const auto& l : statistics)
+    {
+        ASSERT_EQ(1, l.number_of_nodes);
+        ASSERT_LT(0, l.number_of_bytes);
+    }
+    ASSERT_EQ(2, statistics[0].number_of_objects);
+    ASSERT_EQ(0, statistics[3].number_of_objects);
+}
+
+TYPED_TEST(loose_octree_test, insert_remove)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    typename fixture::tree_type t(typename fixture::cube_type(point_type(0, 0, 0), 200), 6);
+    std::vector<std::pair<size_t, typename fixture::box_type>> objects;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const auto b = fixture::get_box(i);
+        objects.emplace_back(t.insert(b), b);
+    }
+    fixture::check_queries(t, objects);
+    // Remove every other object.
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        t.remove(objects[i].first);
+        ASSERT_THROW(t.remove(objects[i].first), std::invalid_argument);
+        objects.erase(objects.begin() + i);
+    }
+    fixture::check_queries(t, objects);
+    // Nodes without objects are removed.
+    for (const auto& o : objects)
+    { t.remove(o.first); }
+    objects.clear();
+    ASSERT_TRUE(t.empty());
+    ASSERT_EQ(1, t.get_statistics().size());
+    // The handles and nodes of removed objects are reused.
+    const size_t memory = t.get_memory_usage();
+    for (size_t i = 0; i < 500; ++i)
+    {
+        const auto b = fixture::get_box(2000 + i);
+        objects.emplace_back(t.insert(b), b);
+    }
+    ASSERT_EQ(memory, t.get_memory_usage());
+    fixture::check_queries(t, objects);
+}
+
+TYPED_TEST(loose_octree_test, move)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    typename fixture::tree_type t(typename fixture::cube_type(point_type(0, 0, 0), 200), 6);
+    std::vector<std::pair<size_t, typename fixture::box_type>> objects;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const auto b = fixture::get_box(i);
+        objects.emplace_back(t.insert(b), b);
+    }
+    size_t moved = 0;
+    for (size_t step = 0; step < 10; ++step)
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            auto& o = objects[i];
+            // Some objects jump, some leave the root node.
+            const typename fixture::scalar_type s = i % 7 == 0 ? 50 : 0.5;
+            o.second = idlib::translate(o.second, vector_type(fixture::get_scalar(i + step, -s, s), fixture::get_scalar(i + step + 1, -s, s), 0.25));
+            moved += t.move(o.first, o.second) ? 1 : 0;
+        }
+        fixture::check_queries(t, objects);
+    }
+    // Most moves do not change the node of an object.
+    ASSERT_LT(0, moved);
+    ASSERT_GT(5 * objects.size(), moved);
+    ASSERT_THROW(t.move(size_t(-1), objects[0].second), std::invalid_argument);
+}
+
+TEST(loose_octree_test, point_2s)
+{
+    using point_type = idlib::point<idlib::vector<single, 2>>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    idlib::loose_octree<point_type> t(idlib::axis_aligned_cube<point_type>(point_type(0, 0), 16));
+    std::vector<size_t> handles;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        const point_type p(single(i % 4) * 4.0f - 7.5f, single(i / 4) * 4.0f - 7.5f);
+        handles.push_back(t.insert(box_type(p, p + idlib::vector<single, 2>(1, 1))));
+    }
+    std::vector<size_t> actual;
+    t.query(point_type(0.75f, 0.75f), [&actual](size_t i) { actual.push_back(i); });
+    ASSERT_EQ(std::vector<size_t>{ handles[10] }, actual);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <cmath>
+#include <limits>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct ray_cast_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using plane_type = idlib::plane<point_type>;
+    using triangle_type = idlib::triangle<point_type>;
+    using ray_type = idlib::ray<point_type>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-10,+10]^3\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -10, 10), get_scalar(3 * i + 1, -10, 10), get_scalar(3 * i + 2, -10, 10)); }
+
+    /// @brief Get pseudo-random rays. Some rays are parallel to the axes.
+    static std::vector<ray_type> get_rays(size_t count)
+    {
+        std::vector<ray_type> rays;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto p = get_point(i);
+            auto d = get_point(count + i) - p;
+            if (i % 4 == 3)
+            { d[i % 3] = 0; d[(i + 1) % 3] = 0; }
+            rays.emplace_back(p, d);
+        }
+        return rays;
+    }
+
+    /// @brief Assert the rays of ray packets of N rays hit a geometry if and at the distances the rays hit the geometry.
+    template <size_t N, typename G>
+    static void check_packets(const std::vector<ray_type>& rays, const G& g)
+    {
+        for (size_t i = 0; i + N <= rays.size(); i += N)
+        {
+            const idlib::ray_packet<point_type, N> p(rays.data() + i);
+            scalar_type t_max[N], t[N];
+            for (size_t j = 0; j < N; ++j)
+            { t_max[j] = j % 2 == 0 ? std::numeric_limits<scalar_type>::infinity() : get_scalar(i + j, 0, 20); }
+            const unsigned int hits = idlib::ray_cast(p, g, t_max, t);
+            ASSERT_EQ(0, hits >> N);
+            for (size_t j = 0; j < N; ++j)
+            {
+                scalar_type u;
+                const bool hit = idlib::ray_cast(rays[i + j], g, t_max[j], u);
+                ASSERT_EQ(hit, 0 != (hits & (1u << j)));
+                if (hit)
+                {
+                    ASSERT_NEAR(u, t[j], 1e-3);
+                }
+            }
+        }
+    }
+};
+
+using ray_cast_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(ray_cast_test, ray_cast_test_types);
+
+TYPED_TEST(ray_cast_test, axis_aligned_box)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    using ray_type = typename fixture::ray_type;
+    const typename fixture::box_type b(point_type(-1, -1, -1), point_type(1, 1, 1));
+    scalar_type t = -1;
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(-5, 0, 0), vector_type(1, 0, 0)), b, 10, t));
+    ASSERT_EQ(4, t);
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(-5, 0, 0), vector_type(1, 0, 0)), b, 3, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(-5, 0, 0), vector_type(-1, 0, 0)), b, 10, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(-5, 2, 0), vector_type(1, 0, 0)), b, 10, t));
+    // The origin is inside the box.
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(0, 0, 0), vector_type(0, 1, 0)), b, 10, t));
+    ASSERT_EQ(0, t);
+    ASSERT_TRUE(idlib::is_intersecting(ray_type(point_type(-5, -5, -5), vector_type(1, 1, 1)), b));
+    ASSERT_TRUE(idlib::is_intersecting(b, ray_type(point_type(-5, -5, -5), vector_type(1, 1, 1))));
+    ASSERT_FALSE(idlib::is_intersecting(b, ray_type(point_type(-5, -5, -5), vector_type(1, 1, -1))));
+    // The origin is on a face and the component of the direction along the normal of the face is +0 or -0.
+    const scalar_type pz = scalar_type(+0.0), nz = scalar_type(-0.0);
+    const ray_type on_face[4] = { ray_type(point_type(-1, 0, -5), vector_type(pz, 0, 1)), ray_type(point_type(-1, 0, -5), vector_type(nz, 0, 1)),
+                                  ray_type(point_type(1, 0, -5), vector_type(pz, 0, 1)), ray_type(point_type(1, 0, -5), vector_type(nz, 0, 1)) };
+    const idlib::ray_packet<point_type, 4> p(on_face);
+    const scalar_type t_max[4] = { 10, 10, 10, 10 };
+    scalar_type u[4];
+    ASSERT_EQ(0xfu, idlib::ray_cast(p, b, t_max, u));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(idlib::ray_cast(on_face[i], b, 10, t));
+        ASSERT_EQ(4, t);
+        ASSERT_EQ(4, u[i]);
+    }
+    const auto rays = fixture::get_rays(96);
+    fixture::template check_packets<4>(rays, b);
+    fixture::template check_packets<8>(rays, b);
+    fixture::template check_packets<8>(rays, typename fixture::box_type(point_type(-3, 2, -7), point_type(1, 5, 0)));
+}
+
+TYPED_TEST(ray_cast_test, sphere)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    using ray_type = typename fixture::ray_type;
+    const typename fixture::sphere_type s(point_type(1, 2, 3), 2);
+    scalar_type t = -1;
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(1, 2, -7), vector_type(0, 0, 1)), s, 10, t));
+    ASSERT_NEAR(8, t, 1e-5);
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(1, 2, -7), vector_type(0, 0, 1)), s, 7, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(1, 2, -7), vector_type(0, 0, -1)), s, 10, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(1, 5, -7), vector_type(0, 0, 1)), s, 10, t));
+    // The origin is inside the sphere.
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(1, 3, 3), vector_type(1, 0, 0)), s, 10, t));
+    ASSERT_EQ(0, t);
+    ASSERT_TRUE(idlib::is_intersecting(ray_type(point_type(-5, 2, 3), vector_type(1, 0, 0)), s));
+    ASSERT_TRUE(idlib::is_intersecting(s, ray_type(point_type(-5, 2, 3), vector_type(1, 0, 0))));
+    ASSERT_FALSE(idlib::is_intersecting(s, ray_type(point_type(-5, 2, 3), vector_type(-1, 0, 0))));
+    const auto rays = fixture::get_rays(96);
+    fixture::template check_packets<4>(rays, s);
+    fixture::template check_packets<8>(rays, s);
+}
+
+TYPED_TEST(ray_cast_test, plane)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    using ray_type = typename fixture::ray_type;
+    // The plane z = 2.
+    const typename fixture::plane_type p(point_type(0, 0, 2), vector_type(0, 0, 1));
+    scalar_type t = -1;
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(5, 5, -1), vector_type(0, 0, 1)), p, 10, t));
+    ASSERT_NEAR(3, t, 1e-5);
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(5, 5, 6), vector_type(0, 0, -1)), p, 10, t));
+    ASSERT_NEAR(4, t, 1e-5);
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(5, 5, 6), vector_type(0, 0, -1)), p, 3, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(5, 5, 6), vector_type(0, 0, 1)), p, 10, t));
+    // The ray is parallel to the plane.
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(5, 5, 6), vector_type(1, 0, 0)), p, 10, t));
+    ASSERT_TRUE(idlib::is_intersecting(ray_type(point_type(5, 5, 6), vector_type(1, 0, -1)), p));
+    ASSERT_TRUE(idlib::is_intersecting(p, ray_type(point_type(5, 5, 6), vector_type(1, 0, -1))));
+    ASSERT_FALSE(idlib::is_intersecting(p, ray_type(point_type(5, 5, 6), vector_type(1, 0, 1))));
+    const auto rays = fixture::get_rays(96);
+    fixture::template check_packets<4>(rays, p);
+    fixture::template check_packets<8>(rays, p);
+}
+
+TYPED_TEST(ray_cast_test, triangle)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    using ray_type = typename fixture::ray_type;
+    const typename fixture::triangle_type x(point_type(0, 0, 1), point_type(4, 0, 1), point_type(0, 4, 1));
+    scalar_type t = -1;
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(1, 1, -2), vector_type(0, 0, 1)), x, 10, t));
+    ASSERT_NEAR(3, t, 1e-5);
+    // Both sides of the triangle are hit.
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(1, 1, 3), vector_type(0, 0, -1)), x, 10, t));
+    ASSERT_NEAR(2, t, 1e-5);
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(1, 1, 3), vector_type(0, 0, -1)), x, 1, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(1, 1, 3), vector_type(0, 0, 1)), x, 10, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(3, 3, 3), vector_type(0, 0, -1)), x, 10, t));
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(-1, 1, 3), vector_type(0, 0, -1)), x, 10, t));
+    // The ray is parallel to the triangle.
+    ASSERT_FALSE(idlib::ray_cast(ray_type(point_type(-1, 1, 1), vector_type(1, 0, 0)), x, 10, t));
+    ASSERT_TRUE(idlib::is_intersecting(ray_type(point_type(1, 1, 3), vector_type(0, 0, -1)), x));
+    ASSERT_TRUE(idlib::is_intersecting(x, ray_type(point_type(1, 1, 3), vector_type(0, 0, -1))));
+    ASSERT_FALSE(idlib::is_intersecting(x, ray_type(point_type(1, 1, 3), vector_type(0, 1, 0))));
+    const auto rays = fixture::get_rays(96);
+    fixture::template check_packets<4>(rays, x);
+    fixture::template check_packets<8>(rays, x);
+    fixture::template check_packets<8>(rays, typename fixture::triangle_type(point_type(-8, -8, -2), point_type(9, -3, 4), point_type(-2, 9, 1)));
+}
+
+TYPED_TEST(ray_cast_test, ray_packet)
+{
+    using fixture = TestFixture;
+    const auto rays = fixture::get_rays(8);
+    const idlib::ray_packet<typename fixture::point_type, 8> p(rays.data());
+    for (size_t i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(rays[i].get_origin(), p.get_ray(i).get_origin());
+        for (size_t k = 0; k < 3; ++k)
+        {
+            ASSERT_NEAR(rays[i].get_direction()[k], p.get_ray(i).get_direction()[k], 1e-5);
+            ASSERT_EQ(rays[i].get_direction()[k], p.get_directions(k)[i]);
+        }
+    }
+}
+
+TEST(ray_cast_test, point_2s)
+{
+    using vector_type = idlib::vector<single, 2>;
+    using point_type = idlib::point<vector_type>;
+    using ray_type = idlib::ray<point_type>;
+    const idlib::axis_aligned_box<point_type> b(point_type(1, 1), point_type(2, 3));
+    const idlib::sphere<point_type> s(point_type(5, 0), 1);
+    single t;
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(0, 2), vector_type(1, 0)), b, 10, t));
+    ASSERT_EQ(1, t);
+    ASSERT_TRUE(idlib::ray_cast(ray_type(point_type(0, 0), vector_type(1, 0)), s, 10, t));
+    ASSERT_NEAR(4, t, 1e-5);
+    const ray_type rays[4] = { ray_type(point_type(0, 2), vector_type(1, 0)), ray_type(point_type(0, 0), vector_type(1, 0)),
+                               ray_type(point_type(0, 0), vector_type(1, 1)), ray_type(point_type(0, 2), vector_type(-1, 0)) };
+    const idlib::ray_packet<point_type, 4> p(rays);
+    const single t_max[4] = { 10, 10, 10, 10 };
+    single u[4];
+    ASSERT_EQ(0x5u, idlib::ray_cast(p, b, t_max, u));
+    ASSERT_EQ(1, u[0]);
+    ASSERT_NEAR(std::sqrt(2.0f), u[2], 1e-5);
+    ASSERT_EQ(0x2u, idlib::ray_cast(p, s, t_max, u));
+    ASSERT_NEAR(4, u[1], 1e-5);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+
+namespace idlib::tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using matrix_4s = idlib::matrix<single, 4, 4>;
+using axis_aligned_box_3s = idlib::axis_aligned_box<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+
+namespace {
+
+/// @brief A camera and a directional light.
+struct scene
+{
+    idlib::angle<single, idlib::radians> fov_y = idlib::semantic_cast<idlib::angle<single, idlib::radians>>(idlib::angle<single, idlib::degrees>(60.0f));
+    single aspect = 1.5f;
+    matrix_4s view = idlib::look_at_matrix(vector_3s(3.0f, 2.0f, 10.0f), vector_3s(-1.0f, 0.0f, -5.0f), vector_3s(0.0f, 1.0f, 0.0f));
+    matrix_4s light_view = idlib::look_at_matrix(vector_3s(20.0f, 40.0f, 10.0f), vector_3s(0.0f, 0.0f, 0.0f), vector_3s(0.0f, 1.0f, 0.0f));
+    single distances[5];
+    scene()
+    { idlib::split_distances(1.0f, 100.0f, 0.5f, 4, distances); }
+};
+
+/// @brief Get the point \f$p'\f$ with \f$(p',w') = M(p,1)\f$.
+point_3s transform(const matrix_4s& m, const point_3s& p)
+{
+    point_3s q;
+    idlib::transform_points(m, &p, 1, &q);
+    return q;
+}
+
+} // namespace
+
+TEST(shadow_cascades_test, split_distances)
+{
+    single d[5];
+    idlib::split_distances(1.0f, 81.0f, 0.0f, 4, d);
+    ASSERT_FLOAT_EQ(1.0f, d[0]);
+    ASSERT_FLOAT_EQ(21.0f, d[1]);
+    ASSERT_FLOAT_EQ(41.0f, d[2]);
+    ASSERT_FLOAT_EQ(61.0f, d[3]);
+    ASSERT_FLOAT_EQ(81.0f, d[4]);
+    idlib::split_distances(1.0f, 81.0f, 1.0f, 4, d);
+    ASSERT_FLOAT_EQ(1.0f, d[0]);
+    ASSERT_FLOAT_EQ(3.0f, d[1]);
+    ASSERT_FLOAT_EQ(9.0f, d[2]);
+    ASSERT_FLOAT_EQ(27.0f, d[3]);
+    ASSERT_FLOAT_EQ(81.0f, d[4]);
+    idlib::split_distances(1.0f, 81.0f, 0.5f, 4, d);
+    ASSERT_FLOAT_EQ(12.0f, d[1]);
+    ASSERT_FLOAT_EQ(81.0f, d[4]);
+}
+
+TEST(shadow_cascades_test, view_volume_slice)
+{
+    const scene s;
+    // The corners of the view volume are mapped to the corners of the clip volume by the view-projection matrix.
+    const auto m = idlib::perspective_projection_matrix(s.fov_y, s.aspect, 1.0f, 100.0f) * s.view;
+    const auto corners = idlib::view_volume_slice(s.view, s.fov_y, s.aspect, 1.0f, 100.0f);
+    for (size_t i = 0; i < 8; ++i)
+    {
+        point_3s p;
+        idlib::project_points(m, &corners[i], 1, &p);
+        ASSERT_NEAR(i & 1 ? +1.0f : -1.0f, p[0], 1e-3f);
+        ASSERT_NEAR(i & 2 ? +1.0f : -1.0f, p[1], 1e-3f);
+        ASSERT_NEAR(i & 4 ? +1.0f : -1.0f, p[2], 1e-3f);
+    }
+}
+
+TEST(shadow_cascades_test, axis_aligned_boxes)
+{
+    const scene s;
+    axis_aligned_box_3s bounds[4];
+    matrix_4s matrices[4];
+    idlib::shadow_cascades(s.view, s.fov_y, s.aspect, s.distances, 4, s.light_view, bounds, matrices);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto corners = idlib::view_volume_slice(s.view, s.fov_y, s.aspect, s.distances[i], s.distances[i + 1]);
+        vector_3s min(+1.0f, +1.0f, +1.0f), max(-1.0f, -1.0f, -1.0f);
+        for (const auto& corner : corners)
+        {
+            // The box encloses the slice.
+            const auto p = transform(s.light_view, corner);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                ASSERT_LE(bounds[i].get_min()[k] - 1e-3f, p[k]);
+                ASSERT_GE(bounds[i].get_max()[k] + 1e-3f, p[k]);
+            }
+            // The matrix maps the slice into the clip volume.
+            const auto q = transform(matrices[i], corner);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                min[k] = std::min(min[k], q[k]);
+                max[k] = std::max(max[k], q[k]);
+            }
+        }
+        // The box is tight.
+        for (size_t k = 0; k < 3; ++k)
+        {
+            ASSERT_NEAR(-1.0f, min[k], 1e-4f);
+            ASSERT_NEAR(+1.0f, max[k], 1e-4f);
+        }
+    }
+}
+
+TEST(shadow_cascades_test, spheres)
+{
+    scene s;
+    sphere_3s bounds[4];
+    matrix_4s matrices[4];
+    idlib::shadow_cascades(s.view, s.fov_y, s.aspect, s.distances, 4, s.light_view, bounds, matrices);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto corners = idlib::view_volume_slice(s.view, s.fov_y, s.aspect, s.distances[i], s.distances[i + 1]);
+        const single r = bounds[i].get_radius();
+        single d = 0.0f;
+        for (const auto& corner : corners)
+        {
+            // The sphere encloses the slice.
+            const auto p = transform(s.light_view, corner);
+            d = std::max(d, idlib::euclidean_norm(p - bounds[i].get_center()));
+            // The matrix maps the slice into the clip volume.
+            const auto q = transform(matrices[i], corner);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                ASSERT_GE(1.0f + 1e-4f, std::abs(q[k]));
+            }
+        }
+        ASSERT_GE(r * (1.0f + 1e-5f), d);
+        // The sphere is tight: Corners of the slice are on the sphere.
+        ASSERT_NEAR(r, d, r * 1e-5f);
+    }
+    // The radii of the spheres and the distances of their centers from the eye do not change if the camera rotates.
+    s.view = idlib::look_at_matrix(vector_3s(3.0f, 2.0f, 10.0f), vector_3s(10.0f, 2.0f, 0.0f), vector_3s(0.0f, 1.0f, 0.0f));
+    sphere_3s other[4];
+    idlib::shadow_cascades(s.view, s.fov_y, s.aspect, s.distances, 4, s.light_view, other, matrices);
+    const auto eye = transform(s.light_view, point_3s(3.0f, 2.0f, 10.0f));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_NEAR(bounds[i].get_radius(), other[i].get_radius(), bounds[i].get_radius() * 1e-5f);
+        ASSERT_NEAR(idlib::euclidean_norm(bounds[i].get_center() - eye), idlib::euclidean_norm(other[i].get_center() - eye), 1e-3f);
+    }
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <set>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct sweep_and_prune_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using sweep_and_prune_type = idlib::sweep_and_prune<point_type>;
+    using pair_type = std::pair<size_t, size_t>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random box in \f$[-20,+20]^3\f$.
+    static box_type get_box(size_t i)
+    {
+        const point_type p(get_scalar(3 * i, -20, 18), get_scalar(3 * i + 1, -20, 18), get_scalar(3 * i + 2, -20, 18));
+        return box_type(p, p + vector_type(get_scalar(i, 0.5, 2), get_scalar(i + 1, 0.5, 2), get_scalar(i + 2, 0.5, 2)));
+    }
+
+    /// @brief Get the pairs of boxes overlapping along the first axes.
+    /// @param objects the handles and the boxes of the objects
+    static std::set<pair_type> get_pairs(const std::vector<std::pair<size_t, box_type>>& objects, size_t number_of_axes)
+    {
+        std::set<pair_type> pairs;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            for (size_t j = i + 1; j < objects.size(); ++j)
+            {
+                const auto& a = objects[i].second, &b = objects[j].second;
+                bool overlapping = true;
+                for (size_t k = 0; k < number_of_axes; ++k)
+                {
+                    overlapping = overlapping && a.get_min()[k] <= b.get_max()[k] && b.get_min()[k] <= a.get_max()[k];
+                }
+                if (overlapping)
+                { pairs.emplace(std::min(objects[i].first, objects[j].first), std::max(objects[i].first, objects[j].first)); }
+            }
+        }
+        return pairs;
+    }
+
+    /// @brief Update and apply the reported changes to the reported pairs.
+    /// Assert the reported pairs and the overlapping pairs are the pairs of the objects.
+    static void check(sweep_and_prune_type& s, const std::vector<std::pair<size_t, box_type>>& objects, std::set<pair_type>& reported)
+    {
+        ASSERT_EQ(objects.size(), s.size());
+        s.update([&reported](size_t a, size_t b)
+                 {
+                     ASSERT_LT(a, b);
+                     ASSERT_TRUE(reported.emplace(a, b).second);
+                 },
+                 [&reported](size_t a, size_t b)
+                 {
+                     ASSERT_LT(a, b);
+                     ASSERT_EQ(size_t(1), reported.erase(pair_type(a, b)));
+                 });
+        const auto expected = get_pairs(objects, s.get_number_of_axes());
+        ASSERT_EQ(expected, reported);
+        std::set<pair_type> overlapping;
+        s.query_pairs([&overlapping](size_t a, size_t b) { ASSERT_TRUE(overlapping.emplace(a, b).second); });
+        ASSERT_EQ(expected, overlapping);
+    }
+
+    /// @brief Move, insert, and remove boxes over a number of frames.
+    static void simulate(size_t number_of_axes)
+    {
+        sweep_and_prune_type s(number_of_axes);
+        std::vector<std::pair<size_t, box_type>> objects;
+        std::set<pair_type> reported;
+        size_t next = 0;
+        for (; next < 300; ++next)
+        { objects.emplace_back(s.insert(get_box(next)), get_box(next)); }
+        check(s, objects, reported);
+        ASSERT_FALSE(reported.empty());
+        for (size_t frame = 0; frame < 30; ++frame)
+        {
+            for (size_t i = 0; i < objects.size(); ++i)
+            {
+                // Most boxes move by small distances, some boxes move by large distances or change their size.
+                const size_t j = 7 * frame + i;
+                const scalar_type d = j % 13 == 0 ? 10 : 0.5;
+                const vector_type t(get_scalar(j, -d, d), get_scalar(j + 1, -d, d), get_scalar(j + 2, -d, d));
+                auto& b = objects[i].second;
+                b = j % 17 == 0 ? box_type(b.get_min() + t, b.get_min() + t + vector_type(get_scalar(j, 0.1f, 3), 1, 1))
+                                : box_type(b.get_min() + t, b.get_max() + t);
+                s.move(objects[i].first, b);
+                ASSERT_EQ(b, s.get_box(objects[i].first));
+            }
+            for (size_t i = 0; i < 5; ++i)
+            {
+                const size_t j = (frame * 31 + i * 47) % objects.size();
+                s.remove(objects[j].first);
+                objects.erase(objects.begin() + j);
+                objects.emplace_back(s.insert(get_box(next)), get_box(next));
+                next++;
+            }
+            check(s, objects, reported);
+        }
+    }
+};
+
+using sweep_and_prune_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(sweep_and_prune_test, sweep_and_prune_test_types);
+
+TYPED_TEST(sweep_and_prune_test, empty)
+{
+    using fixture = TestFixture;
+    typename fixture::sweep_and_prune_type s;
+    ASSERT_TRUE(s.empty());
+    ASSERT_EQ(size_t(3), s.get_number_of_axes());
+    ASSERT_THROW(s.get_box(0), std::invalid_argument);
+    ASSERT_THROW(s.remove(0), std::invalid_argument);
+    ASSERT_THROW(typename fixture::sweep_and_prune_type(0), std::invalid_argument);
+    ASSERT_THROW(typename fixture::sweep_and_prune_type(4), std::invalid_argument);
+    size_t n = 0;
+    s.update([&n](size_t, size_t) { n++; }, [&n](size_t, size_t) { n++; });
+    s.query_pairs([&n](size_t, size_t) { n++; });
+    ASSERT_EQ(size_t(0), n);
+}
+
+TYPED_TEST(sweep_and_prune_test, changes)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    using box_type = typename fixture::box_type;
+    using pair_type = typename fixture::pair_type;
+    typename fixture::sweep_and_prune_type s;
+    std::vector<pair_type> added, removed;
+    const auto update = [&]()
+    {
+        added.clear();
+        removed.clear();
+        s.update([&added](size_t a, size_t b) { added.emplace_back(a, b); },
+                 [&removed](size_t a, size_t b) { removed.emplace_back(a, b); });
+    };
+    const auto a = s.insert(box_type(point_type(0, 0, 0), point_type(1, 1, 1)));
+    const auto b = s.insert(box_type(point_type(2, 0, 0), point_type(3, 1, 1)));
+    update();
+    ASSERT_TRUE(added.empty() && removed.empty());
+    // Boxes touching each other overlap.
+    s.move(a, box_type(point_type(1, 0, 0), point_type(2, 1, 1)));
+    update();
+    ASSERT_EQ(std::vector<pair_type>{ pair_type(a, b) }, added);
+    ASSERT_TRUE(removed.empty());
+    // Overlapping along the first axis only.
+    s.move(a, box_type(point_type(2, 2, 0), point_type(3, 3, 1)));
+    update();
+    ASSERT_TRUE(added.empty());
+    ASSERT_EQ(std::vector<pair_type>{ pair_type(a, b) }, removed);
+    // A pair starting and stopping to overlap between two updates is not reported.
+    s.move(a, box_type(point_type(2, 0.5, 0), point_type(3, 1.5, 1)));
+    s.move(a, box_type(point_type(-2, 0, 0), point_type(-1, 1, 1)));
+    update();
+    ASSERT_TRUE(added.empty() && removed.empty());
+    // A pair stopping and starting to overlap between two updates is not reported.
+    s.move(a, box_type(point_type(2.5, 0.5, 0.5), point_type(2.6, 0.6, 0.6)));
+    update();
+    ASSERT_EQ(std::vector<pair_type>{ pair_type(a, b) }, added);
+    s.move(a, box_type(point_type(5, 0, 0), point_type(6, 1, 1)));
+    s.move(a, box_type(point_type(-1, -1, -1), point_type(5, 5, 5)));
+    update();
+    ASSERT_TRUE(added.empty() && removed.empty());
+    // The pairs of a removed object are removed. Its handle is not reused before the next update.
+    s.remove(b);
+    const auto c = s.insert(box_type(point_type(0, 0, 0), point_type(1, 1, 1)));
+    ASSERT_NE(b, c);
+    update();
+    ASSERT_EQ(std::vector<pair_type>{ pair_type(std::min(a, c), std::max(a, c)) }, added);
+    ASSERT_EQ(std::vector<pair_type>{ pair_type(a, b) }, removed);
+    ASSERT_THROW(s.move(b, box_type()), std::invalid_argument);
+    ASSERT_EQ(b, s.insert(box_type(point_type(10, 10, 10), point_type(11, 11, 11))));
+}
+
+TYPED_TEST(sweep_and_prune_test, one_axis)
+{
+    TestFixture::simulate(1);
+}
+
+TYPED_TEST(sweep_and_prune_test, three_axes)
+{
+    TestFixture::simulate(3);
+}
+
+TEST(sweep_and_prune_test, point_2s)
+{
+    using point_type = idlib::point<idlib::vector<single, 2>>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+    using pair_type = std::pair<size_t, size_t>;
+    idlib::sweep_and_prune<point_type> s;
+    ASSERT_EQ(size_t(2), s.get_number_of_axes());
+    const auto a = s.insert(box_type(point_type(0, 0), point_type(2, 2)));
+    const auto b = s.insert(box_type(point_type(1, 1), point_type(3, 3)));
+    const auto c = s.insert(box_type(point_type(1, 5), point_type(3, 6)));
+    std::set<pair_type> pairs;
+    s.update([&pairs](size_t a, size_t b) { pairs.emplace(a, b); }, [](size_t, size_t) {});
+    ASSERT_EQ(std::set<pair_type>({ pair_type(a, b) }), pairs);
+    s.move(c, box_type(point_type(1, 1.5f), point_type(3, 2.5f)));
+    s.update([&pairs](size_t a, size_t b) { pairs.emplace(a, b); }, [](size_t, size_t) {});
+    ASSERT_EQ(std::set<pair_type>({ pair_type(a, b), pair_type(a, c), pair_type(b, c) }), pairs);
+}
+
+} // namespace idlib::tests
@@ -35,6 +35,7 @@ using axis_aligned_cube_3s = idlib::axis_aligned_cube<point_3s>;
 using sphere_3s = idlib::sphere<point_3s>;
 using ray_3s = idlib::ray<point_3s>;
 using plane_3s = idlib::plane<point_3s>;
+using triangle_3s = idlib::triangle<point_3s>;
 
 TEST(translate_test, point_3s)
 {
@@ -99,4 +100,14 @@ TEST(translate_test, plane_3s)
     ASSERT_EQ(x, y);
 }
 
+TEST(translate_test, triangle_3s)
+{
+    auto t = vector_3s(+1.0f, +2.0f, +3.0f);
+    auto x = triangle_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, 0.0f, 0.0f), point_3s(0.0f, 1.0f, 0.0f));
+    auto y = translate(x, t);
+    ASSERT_EQ(point_3s(1.0f, 3.0f, 3.0f), y.get_c());
+    y = translate(y, -t);
+    ASSERT_EQ(x, y);
+}
+
 } // namespace idlib::tests
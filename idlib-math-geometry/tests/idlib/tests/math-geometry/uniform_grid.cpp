@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct uniform_grid_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using sphere_type = idlib::sphere<point_type>;
+    using cube_type = idlib::axis_aligned_cube<point_type>;
+    using box_type = idlib::axis_aligned_box<point_type>;
+
+    /// @brief Get a pseudo-random scalar in \f$[a,b]\f$.
+    static scalar_type get_scalar(size_t i, scalar_type a, scalar_type b)
+    { return a + (b - a) * scalar_type((i * 2654435761u) % 10007) / scalar_type(10006); }
+
+    /// @brief Get a pseudo-random point in \f$[-50,+50]^3\f$.
+    static point_type get_point(size_t i)
+    { return point_type(get_scalar(3 * i, -50, 50), get_scalar(3 * i + 1, -50, 50), get_scalar(3 * i + 2, -50, 50)); }
+
+    static std::vector<sphere_type> get_spheres(size_t count, scalar_type maximum_radius)
+    {
+        std::vector<sphere_type> spheres;
+        for (size_t i = 0; i < count; ++i)
+        { spheres.emplace_back(get_point(i), get_scalar(i + 7, 0, maximum_radius)); }
+        return spheres;
+    }
+
+    static std::vector<cube_type> get_cubes(size_t count, scalar_type maximum_size)
+    {
+        std::vector<cube_type> cubes;
+        for (size_t i = 0; i < count; ++i)
+        { cubes.emplace_back(get_point(i), get_scalar(i + 7, 0, maximum_size)); }
+        return cubes;
+    }
+
+    /// @brief Assert the queries of a grid report the intersecting objects.
+    template <typename G>
+    static void check(const std::vector<G>& objects, scalar_type cell_size)
+    {
+        idlib::uniform_grid<G> grid(cell_size);
+        grid.build(objects.data(), objects.size());
+        ASSERT_EQ(objects.size(), grid.size());
+        // Pairs.
+        std::vector<std::pair<size_t, size_t>> expected_pairs, actual_pairs;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            for (size_t j = i + 1; j < objects.size(); ++j)
+            {
+                if (idlib::is_intersecting(objects[i], objects[j]))
+                { expected_pairs.emplace_back(i, j); }
+            }
+        }
+        grid.query_pairs([&actual_pairs](size_t i, size_t j) { actual_pairs.emplace_back(i, j); });
+        std::sort(actual_pairs.begin(), actual_pairs.end());
+        ASSERT_EQ(expected_pairs, actual_pairs);
+        // Radius queries.
+        for (size_t k = 0; k < 20; ++k)
+        {
+            const sphere_type s(get_point(5000 + k), get_scalar(k, 0, 10));
+            std::vector<size_t> expected, actual;
+            for (size_t i = 0; i < objects.size(); ++i)
+            {
+                if (idlib::is_intersecting(objects[i], s))
+                { expected.push_back(i); }
+            }
+            grid.query(s, [&actual](size_t i) { actual.push_back(i); });
+            std::sort(actual.begin(), actual.end());
+            ASSERT_EQ(expected, actual);
+        }
+        // A sphere covering all cells.
+        size_t n = 0;
+        grid.query(sphere_type(point_type(0, 0, 0), 1000), [&n](size_t) { n++; });
+        ASSERT_EQ(objects.size(), n);
+        // The grid built in parallel is the same.
+        idlib::uniform_grid<G> other(cell_size);
+        other.build(objects.data(), objects.size(), idlib::execution_policy::parallel(3, 100));
+        std::vector<std::pair<size_t, size_t>> other_pairs;
+        other.query_pairs([&other_pairs](size_t i, size_t j) { other_pairs.emplace_back(i, j); });
+        std::vector<std::pair<size_t, size_t>> pairs;
+        grid.query_pairs([&pairs](size_t i, size_t j) { pairs.emplace_back(i, j); });
+        ASSERT_EQ(pairs, other_pairs);
+    }
+};
+
+using uniform_grid_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(uniform_grid_test, uniform_grid_test_types);
+
+TYPED_TEST(uniform_grid_test, empty)
+{
+    using fixture = TestFixture;
+    idlib::uniform_grid<typename fixture::sphere_type> grid;
+    ASSERT_TRUE(grid.empty());
+    size_t n = 0;
+    grid.query(typename fixture::sphere_type(typename fixture::point_type(0, 0, 0), 1), [&n](size_t) { n++; });
+    grid.query_pairs([&n](size_t, size_t) { n++; });
+    grid.build(nullptr, 0);
+    grid.query_pairs([&n](size_t, size_t) { n++; });
+    ASSERT_EQ(0, n);
+    ASSERT_THROW(idlib::uniform_grid<typename fixture::sphere_type>(0), std::invalid_argument);
+}
+
+TYPED_TEST(uniform_grid_test, spheres)
+{
+    using fixture = TestFixture;
+    const auto spheres = fixture::get_spheres(1500, 2);
+    fixture::check(spheres, 4);
+    // Cells smaller than the spheres.
+    fixture::check(spheres, 1.5);
+    // Cells much larger than the spheres.
+    fixture::check(spheres, 40);
+}
+
+TYPED_TEST(uniform_grid_test, cubes)
+{
+    using fixture = TestFixture;
+    const auto cubes = fixture::get_cubes(1500, 4);
+    fixture::check(cubes, 4);
+    fixture::check(cubes, 1);
+}
+
+TYPED_TEST(uniform_grid_test, boxes)
+{
+    using fixture = TestFixture;
+    std::vector<typename fixture::box_type> boxes;
+    for (size_t i = 0; i < 1500; ++i)
+    {
+        const auto p = fixture::get_point(i);
+        boxes.emplace_back(p, p + typename fixture::vector_type(fixture::get_scalar(i, 0, 3), fixture::get_scalar(i + 1, 0, 1), 2));
+    }
+    fixture::check(boxes, 3);
+}
+
+TEST(uniform_grid_test, spheres_2s)
+{
+    using point_type = idlib::point<idlib::vector<single, 2>>;
+    using sphere_type = idlib::sphere<point_type>;
+    std::vector<sphere_type> spheres;
+    for (size_t i = 0; i < 100; ++i)
+    { spheres.emplace_back(point_type(single(i % 10), single(i / 10)), 0.5f); }
+    idlib::uniform_grid<sphere_type> grid(1);
+    grid.build(spheres.data(), spheres.size());
+    // Each sphere touches the spheres left, right, below, and above it.
+    size_t n = 0;
+    grid.query_pairs([&n](size_t, size_t) { n++; });
+    ASSERT_EQ(2 * 9 * 10, n);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Idlib: A C++ utility library
+# Copyright (C) 2017-2018 Michael Heilmann
+#
+# This software is provided 'as-is', without any express or implied warranty.
+# In no event will the authors be held liable for any damages arising from the use of this software.
+#
+# Permission is granted to anyone to use this software for any purpose,
+# including commercial applications, and to alter it and redistribute it freely,
+# subject to the following restrictions:
+#
+# 1. The origin of this software must not be misrepresented;
+#    you must not claim that you wrote the original software.
+#    If you use this software in a product, an acknowledgment
+#    in the product documentation would be appreciated but is not required.
+#
+# 2. Altered source versions must be plainly marked as such,
+#    and must not be misrepresented as being the original software.
+#
+# 3. This notice may not be removed or altered from any source distribution.
+
+"""Compare two runs of idlib-math-benchmarks.
+
+Usage:
+    idlib-math-benchmarks --json --output=baseline.json
+    ... change the code, rebuild ...
+    idlib-math-benchmarks --json --output=contender.json
+    python3 compare.py baseline.json contender.json [--threshold=0.05] [--metric=nanoseconds|cycles]
+
+A benchmark regressed if its time per iteration grew by more than the threshold (a fraction, 0.05 is 5%).
+It improved if its time per iteration shrank by more than the threshold.
+The exit code is 1 if a benchmark regressed, 0 otherwise.
+"""
+
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path) as file:
+        document = json.load(file)
+    return document.get("context", {}), {b["name"]: b[metric + "_per_iteration"] for b in document["benchmarks"]}
+
+
+def main(argv):
+    threshold, metric, paths = 0.05, "nanoseconds", []
+    for argument in argv[1:]:
+        if argument.startswith("--threshold="):
+            threshold = float(argument[len("--threshold="):])
+        elif argument.startswith("--metric="):
+            metric = argument[len("--metric="):]
+            if metric not in ("nanoseconds", "cycles"):
+                sys.exit("unknown metric " + metric)
+        elif argument.startswith("--"):
+            sys.exit("unknown option " + argument)
+        else:
+            paths.append(argument)
+    if len(paths) != 2:
+        sys.exit(__doc__)
+    baseline_context, baseline = load(paths[0], metric)
+    contender_context, contender = load(paths[1], metric)
+    if baseline_context != contender_context:
+        print("warning: the contexts differ: %s vs. %s" % (baseline_context, contender_context))
+
+    regressions = 0
+    width = max([len(name) for name in baseline] + [len(name) for name in contender] + [9])
+    print("%-*s %14s %14s %9s" % (width, "benchmark", "baseline", "contender", "change"))
+    for name in sorted(set(baseline) | set(contender)):
+        if name not in contender:
+            print("%-*s %14.1f %14s %9s" % (width, name, baseline[name], "-", "removed"))
+            continue
+        if name not in baseline:
+            print("%-*s %14s %14.1f %9s" % (width, name, "-", contender[name], "added"))
+            continue
+        x, y = baseline[name], contender[name]
+        change = (y - x) / x if x > 0 else 0.0
+        verdict = ""
+        if change > threshold:
+            verdict, regressions = "REGRESSION", regressions + 1
+        elif change < -threshold:
+            verdict = "improvement"
+        print("%-*s %14.1f %14.1f %+8.1f%% %s" % (width, name, x, y, 100.0 * change, verdict))
+    print("%d regression(s) above a threshold of %.1f%%" % (regressions, 100.0 * threshold))
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/benchmark.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define IDLIB_BENCHMARKS_WITH_RDTSC (1)
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define IDLIB_BENCHMARKS_WITH_RDTSC (1)
+#else
+    #define IDLIB_BENCHMARKS_WITH_RDTSC (0)
+#endif
+
+namespace idlib::benchmarks {
+
+std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::uint64_t cycles()
+{
+#if 1 == IDLIB_BENCHMARKS_WITH_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+result run(const benchmark& benchmark, std::chrono::nanoseconds minimum_duration)
+{
+    using clock = std::chrono::steady_clock;
+    // Warm up.
+    benchmark.function(1);
+    size_t iterations = 1;
+    while (true)
+    {
+        auto start = clock::now();
+        auto start_cycles = cycles();
+        benchmark.function(iterations);
+        auto duration_cycles = cycles() - start_cycles;
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+        if (duration >= minimum_duration)
+        {
+            return { benchmark.name, iterations, double(duration.count()) / double(iterations),
+                     double(duration_cycles) / double(iterations) };
+        }
+        iterations *= 2;
+    }
+}
+
+namespace {
+
+std::string quote(const std::string& s)
+{
+    std::string t = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            t += '\\';
+        }
+        t += c;
+    }
+    return t + "\"";
+}
+
+} // namespace
+
+void write_json(std::FILE *file, const std::vector<std::pair<std::string, std::string>>& context, const std::vector<result>& results)
+{
+    std::fprintf(file, "{\n  \"context\": {");
+    for (size_t i = 0; i < context.size(); ++i)
+    {
+        std::fprintf(file, "%s\n    %s: %s", i > 0 ? "," : "", quote(context[i].first).c_str(), quote(context[i].second).c_str());
+    }
+    std::fprintf(file, "\n  },\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        std::fprintf(file, "%s\n    { \"name\": %s, \"iterations\": %zu, \"nanoseconds_per_iteration\": %.3f, \"cycles_per_iteration\": %.1f }",
+                     i > 0 ? "," : "", quote(r.name).c_str(), r.iterations, r.nanoseconds_per_iteration, r.cycles_per_iteration);
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+}
+
+} // namespace idlib::benchmarks
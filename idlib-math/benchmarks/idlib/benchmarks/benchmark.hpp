@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/benchmarks/benchmark.hpp
+/// @brief A minimal harness for micro benchmarks.
+/// @author Michael Heilmann
+
+/// @detail
+/// A benchmark is a function receiving a number of iterations.
+/// It is registered by the IDLIB_BENCHMARK macro:
+/// @code
+/// IDLIB_BENCHMARK(my_benchmark)
+/// {
+///     for (size_t i = 0; i < iterations; ++i)
+///     { idlib::benchmarks::do_not_optimize(...); }
+/// }
+/// @endcode
+/// idlib::benchmarks::run increases the number of iterations until the benchmark runs for a minimum duration.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace idlib::benchmarks {
+
+/// @brief A benchmark.
+struct benchmark
+{
+    /// @brief The name of the benchmark.
+    std::string name;
+    /// @brief The function of the benchmark receiving the number of iterations.
+    std::function<void(size_t)> function;
+};
+
+/// @brief The result of running a benchmark.
+struct result
+{
+    /// @brief The name of the benchmark.
+    std::string name;
+    /// @brief The number of iterations of the last run.
+    size_t iterations;
+    /// @brief The duration of an iteration in nanoseconds.
+    double nanoseconds_per_iteration;
+    /// @brief The duration of an iteration in reference cycles of the time stamp counter.
+    /// @a 0 if no time stamp counter is available.
+    double cycles_per_iteration;
+};
+
+/// @brief Get the list of registered benchmarks.
+/// @return the list of registered benchmarks
+std::vector<benchmark>& registry();
+
+/// @brief Registers a benchmark upon construction.
+struct registration
+{
+    registration(const std::string& name, const std::function<void(size_t)>& function)
+    { registry().push_back({ name, function }); }
+};
+
+/// @brief Get the value of the time stamp counter.
+/// @return the value of the time stamp counter if one is available, @a 0 otherwise
+std::uint64_t cycles();
+
+/// @brief Run a benchmark.
+/// @param benchmark the benchmark
+/// @param minimum_duration the minimum duration of the final run
+/// @return the result
+result run(const benchmark& benchmark, std::chrono::nanoseconds minimum_duration = std::chrono::milliseconds(200));
+
+/// @brief Write results as JSON.
+/// @param file the file to write to
+/// @param context name/value pairs describing the build and the machine
+/// @param results the results
+/// @remark The format is
+/// @code
+/// {
+///   "context": { "<name>": "<value>", ... },
+///   "benchmarks": [ { "name": "<name>", "iterations": <n>, "nanoseconds_per_iteration": <x>, "cycles_per_iteration": <y> }, ... ]
+/// }
+/// @endcode
+/// and is read by <c>compare.py</c>.
+void write_json(std::FILE *file, const std::vector<std::pair<std::string, std::string>>& context, const std::vector<result>& results);
+
+/// @brief Prevent the compiler from optimizing away the computation of a value.
+/// @param x the value
+template <typename T>
+inline void do_not_optimize(const T& x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&x) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &x;
+#endif
+}
+
+} // namespace idlib::benchmarks
+
+#define IDLIB_BENCHMARK_CONCATENATE_IMPL(a, b) a##b
+#define IDLIB_BENCHMARK_CONCATENATE(a, b) IDLIB_BENCHMARK_CONCATENATE_IMPL(a, b)
+
+/// @brief Define and register a benchmark.
+/// The body of the benchmark follows the macro. The number of iterations is available as @a iterations.
+/// @param NAME the name of the benchmark
+#define IDLIB_BENCHMARK(NAME) \
+    static void IDLIB_BENCHMARK_CONCATENATE(benchmark_, NAME)(size_t iterations); \
+    static const idlib::benchmarks::registration IDLIB_BENCHMARK_CONCATENATE(registration_, NAME)(#NAME, &IDLIB_BENCHMARK_CONCATENATE(benchmark_, NAME)); \
+    static void IDLIB_BENCHMARK_CONCATENATE(benchmark_, NAME)(size_t iterations)
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math/simd.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define IDLIB_BENCHMARKS_STRINGIFY_IMPL(x) #x
+#define IDLIB_BENCHMARKS_STRINGIFY(x) IDLIB_BENCHMARKS_STRINGIFY_IMPL(x)
+
+namespace {
+
+const char *get_simd_name()
+{
+#if IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_AVX
+    return "avx";
+#elif IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_SSE2
+    return "sse2";
+#else
+    return "none";
+#endif
+}
+
+const char *get_compiler_name()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " IDLIB_BENCHMARKS_STRINGIFY(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+/// @brief Run all registered benchmarks.
+/// Usage: <c>idlib-math-benchmarks [--json] [--output=<file>] [--minimum-duration=<milliseconds>] [<filter>]</c>
+/// - If a filter is specified, only the benchmarks whose name contain the filter are run.
+/// - If <c>--json</c> is specified, the results are written as JSON (cf. idlib::benchmarks::write_json) instead of a table.
+///   Two JSON files are compared by <c>compare.py</c>.
+/// - If <c>--output=<file></c> is specified, the results are written to that file instead of the standard output.
+/// - <c>--minimum-duration=<milliseconds></c> sets the minimum duration of the final run of each benchmark (default 200).
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr, *output = nullptr;
+    bool json = false;
+    long minimum_duration = 200;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--json"))
+        {
+            json = true;
+        }
+        else if (!std::strncmp(argv[i], "--output=", 9))
+        {
+            output = argv[i] + 9;
+        }
+        else if (!std::strncmp(argv[i], "--minimum-duration=", 19))
+        {
+            minimum_duration = std::strtol(argv[i] + 19, nullptr, 10);
+        }
+        else if (!std::strncmp(argv[i], "--", 2))
+        {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+    std::FILE *file = stdout;
+    if (output && !(file = std::fopen(output, "w")))
+    {
+        std::fprintf(stderr, "unable to open %s\n", output);
+        return 1;
+    }
+    std::vector<idlib::benchmarks::result> results;
+    for (const auto& benchmark : idlib::benchmarks::registry())
+    {
+        if (filter && !std::strstr(benchmark.name.c_str(), filter))
+        {
+            continue;
+        }
+        auto result = idlib::benchmarks::run(benchmark, std::chrono::milliseconds(minimum_duration));
+        if (!json)
+        {
+            std::fprintf(file, "%-60s %12.3f ns/iteration %12.1f cycles/iteration %12zu iterations\n", result.name.c_str(),
+                         result.nanoseconds_per_iteration, result.cycles_per_iteration, result.iterations);
+            std::fflush(file);
+        }
+        results.push_back(result);
+    }
+    if (json)
+    {
+        idlib::benchmarks::write_json(file, { { "simd", get_simd_name() }, { "compiler", get_compiler_name() } }, results);
+    }
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+    return 0;
+}
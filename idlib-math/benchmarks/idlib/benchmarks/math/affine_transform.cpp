@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the composition and the inverses of idlib::affine_transform with the product and the inverses of
+/// \f$4 \times 4\f$ matrices representing the same rigid transformations.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_values = 256;
+
+template <typename E>
+struct operands
+{
+    using matrix_type = idlib::matrix<E, 4, 4>;
+    using transform_type = idlib::affine_transform<E>;
+    std::vector<matrix_type> a, b, r;
+    std::vector<transform_type> c, d, s;
+    operands() : a(number_of_values), b(number_of_values), r(number_of_values), c(number_of_values), d(number_of_values), s(number_of_values)
+    {
+        for (size_t i = 0; i < number_of_values; ++i)
+        {
+            const auto x = idlib::translation_matrix(idlib::vector<single, 3>(single(i), 1.0f, 2.0f))
+                         * idlib::rotation_matrix_y(idlib::angle<single, idlib::degrees>(single(i))),
+                       y = idlib::translation_matrix(idlib::vector<single, 3>(-2.0f, single(i), 0.5f))
+                         * idlib::rotation_matrix_x(idlib::angle<single, idlib::degrees>(single(i)));
+            for (size_t k = 0; k < 16; ++k)
+            {
+                a[i](k) = E(x(k));
+                b[i](k) = E(y(k));
+            }
+            c[i] = idlib::semantic_cast<transform_type>(a[i]);
+            d[i] = idlib::semantic_cast<transform_type>(b[i]);
+        }
+    }
+};
+
+/// @brief Run an operation on matrices @a iterations times. Each iteration computes a single operation.
+template <typename E, typename F>
+void run_matrix(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        x.r[j] = f(x.a[j], x.b[j]);
+        idlib::benchmarks::do_not_optimize(x.r[j]);
+    }
+}
+
+/// @brief Run an operation on affine transformations @a iterations times. Each iteration computes a single operation.
+template <typename E, typename F>
+void run_transform(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        x.s[j] = f(x.c[j], x.d[j]);
+        idlib::benchmarks::do_not_optimize(x.s[j]);
+    }
+}
+
+template <typename E>
+using matrix4 = idlib::matrix<E, 4, 4>;
+
+template <typename E>
+using transform = idlib::affine_transform<E>;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(affine_transform_compose_##E##_matrix4) \
+    { run_matrix<E>(iterations, [](const matrix4<E>& a, const matrix4<E>& b) { return a * b; }); } \
+    IDLIB_BENCHMARK(affine_transform_compose_##E) \
+    { run_transform<E>(iterations, [](const transform<E>& a, const transform<E>& b) { return a * b; }); } \
+    IDLIB_BENCHMARK(affine_transform_inverse_##E##_matrix4) \
+    { run_matrix<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return a.inverse(); }); } \
+    IDLIB_BENCHMARK(affine_transform_inverse_##E) \
+    { run_transform<E>(iterations, [](const transform<E>& a, const transform<E>&) { return a.inverse(); }); } \
+    IDLIB_BENCHMARK(affine_transform_orthonormal_inverse_##E) \
+    { run_transform<E>(iterations, [](const transform<E>& a, const transform<E>&) { return a.orthonormal_inverse(); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
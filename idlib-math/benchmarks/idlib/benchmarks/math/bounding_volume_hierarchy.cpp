@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark building idlib::bounding_volume_hierarchy and querying it compared to testing all boxes.
+/// The hierarchy is built over 100000 boxes. An iteration of a query benchmark performs 100 queries.
+/// The parallel variants use all hardware threads.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_boxes = 100000;
+constexpr size_t number_of_queries = 100;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using box_type = idlib::axis_aligned_box<point_type>;
+using hierarchy_type = idlib::bounding_volume_hierarchy<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+point_type get_point()
+{
+    const single x = get_scalar(-1000, 1000), y = get_scalar(-1000, 1000), z = get_scalar(-1000, 1000);
+    return point_type(x, y, z);
+}
+
+struct operands
+{
+    std::vector<box_type> boxes;
+    std::vector<box_type> queries;
+    std::vector<idlib::ray<point_type>> rays;
+    hierarchy_type hierarchy;
+    size_t result = 0;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const auto p = get_point();
+            const single x = get_scalar(1, 10), y = get_scalar(1, 10), z = get_scalar(1, 10);
+            boxes.emplace_back(p, p + vector_type(x, y, z));
+        }
+        for (size_t i = 0; i < number_of_queries; ++i)
+        {
+            const auto p = get_point();
+            queries.emplace_back(p, p + vector_type(50, 50, 50));
+            rays.emplace_back(p, get_point() - p);
+        }
+        hierarchy = hierarchy_type(boxes.data(), boxes.size());
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(bounding_volume_hierarchy_build)
+{ run(iterations, [](operands& x) { x.result += hierarchy_type(x.boxes.data(), x.boxes.size()).get_nodes().size(); }); }
+
+IDLIB_BENCHMARK(bounding_volume_hierarchy_build_parallel)
+{ run(iterations, [](operands& x) { x.result += hierarchy_type(x.boxes.data(), x.boxes.size(), idlib::execution_policy::parallel()).get_nodes().size(); }); }
+
+IDLIB_BENCHMARK(bounding_volume_hierarchy_query_box_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        {
+            for (const auto& b : x.boxes)
+            { x.result += idlib::is_intersecting(b, q) ? 1 : 0; }
+        }
+    });
+}
+
+IDLIB_BENCHMARK(bounding_volume_hierarchy_query_box)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        { x.hierarchy.query(q, [&x](size_t) { x.result++; }); }
+    });
+}
+
+IDLIB_BENCHMARK(bounding_volume_hierarchy_query_ray)
+{
+    run(iterations, [](operands& x)
+    {
+        // The closest hit of each ray.
+        for (const auto& r : x.rays)
+        {
+            const idlib::internal::ray_box_test<point_type> test(r);
+            x.hierarchy.query(r, 5000.0f, [&x, &test](size_t i, single& t_max)
+            {
+                single t;
+                if (test(x.boxes[i], t_max, t))
+                {
+                    t_max = t;
+                    x.result++;
+                }
+                return false;
+            });
+        }
+    });
+}
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare solving linear systems by the inverse of the matrix with solving them by the decompositions.
+/// An iteration solves a \f$6 \times 6\f$ system for one right-hand side and for 64 right-hand sides,
+/// e.g. the normal equations of a least-squares fit evaluated for one measurement and for several measurements.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t order = 6;
+
+template <typename E, size_t K>
+struct operands
+{
+    idlib::matrix<E, order, order> a;
+    std::vector<idlib::vector<E, order>> b, x;
+    operands() : x(K)
+    {
+        idlib::matrix<E, order, order> m;
+        for (size_t i = 0; i < order * order; ++i)
+        { m(i) = E(int((i * 5) % 7) - 3); }
+        a = idlib::transpose(m) * m + idlib::identity<idlib::matrix<E, order, order>>();
+        for (size_t i = 0; i < K; ++i)
+        {
+            idlib::vector<E, order> v;
+            for (size_t j = 0; j < order; ++j)
+            { v[j] = E(int((i + j) % 5) - 2); }
+            b.push_back(v);
+        }
+    }
+};
+
+template <typename E>
+idlib::vector<E, order> multiply(const idlib::matrix<E, order, order>& a, const idlib::vector<E, order>& b)
+{
+    idlib::vector<E, order> x;
+    for (size_t i = 0; i < order; ++i)
+    {
+        for (size_t j = 0; j < order; ++j)
+        { x[i] += a(i, j) * b[j]; }
+    }
+    return x;
+}
+
+template <typename E, size_t K, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E, K> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x.a, x.b, x.x);
+        idlib::benchmarks::do_not_optimize(x.x);
+    }
+}
+
+template <typename E>
+using matrix = idlib::matrix<E, order, order>;
+
+template <typename E>
+using vectors = std::vector<idlib::vector<E, order>>;
+
+} // namespace
+
+#define DEFINE(E, K) \
+    IDLIB_BENCHMARK(decomposition_solve_##E##_##K##_inverse) \
+    { run<E, K>(iterations, [](const matrix<E>& a, const vectors<E>& b, vectors<E>& x) { const auto c = a.inverse(); for (size_t i = 0; i < b.size(); ++i) { x[i] = multiply(c, b[i]); } }); } \
+    IDLIB_BENCHMARK(decomposition_solve_##E##_##K##_lu) \
+    { run<E, K>(iterations, [](const matrix<E>& a, const vectors<E>& b, vectors<E>& x) { const idlib::lu_decomposition<E, order> d(a); for (size_t i = 0; i < b.size(); ++i) { x[i] = d.solve(b[i]); } }); } \
+    IDLIB_BENCHMARK(decomposition_solve_##E##_##K##_cholesky) \
+    { run<E, K>(iterations, [](const matrix<E>& a, const vectors<E>& b, vectors<E>& x) { const idlib::cholesky_decomposition<E, order> d(a); for (size_t i = 0; i < b.size(); ++i) { x[i] = d.solve(b[i]); } }); } \
+    IDLIB_BENCHMARK(decomposition_solve_##E##_##K##_qr) \
+    { run<E, K>(iterations, [](const matrix<E>& a, const vectors<E>& b, vectors<E>& x) { const idlib::qr_decomposition<E, order> d(a); for (size_t i = 0; i < b.size(); ++i) { x[i] = d.solve(b[i]); } }); }
+
+DEFINE(single, 1)
+DEFINE(single, 64)
+DEFINE(double, 1)
+DEFINE(double, 64)
+
+#undef DEFINE
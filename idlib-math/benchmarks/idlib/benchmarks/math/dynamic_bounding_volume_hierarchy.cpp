@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark updating idlib::dynamic_bounding_volume_hierarchy for moving boxes compared to rebuilding idlib::bounding_volume_hierarchy.
+/// 10000 boxes move along random directions. An iteration of a move benchmark moves all boxes by one step.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_boxes = 10000;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using box_type = idlib::axis_aligned_box<point_type>;
+using hierarchy_type = idlib::dynamic_bounding_volume_hierarchy<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+struct operands
+{
+    std::vector<box_type> boxes;
+    std::vector<vector_type> velocities;
+    std::vector<size_t> proxies;
+    hierarchy_type hierarchy;
+    size_t result = 0;
+    operands()
+        : hierarchy(0.5f)
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const single x = get_scalar(-200, 200), y = get_scalar(-200, 200), z = get_scalar(-200, 200);
+            const single u = get_scalar(1, 4), v = get_scalar(1, 4), w = get_scalar(1, 4);
+            boxes.emplace_back(point_type(x, y, z), point_type(x + u, y + v, z + w));
+            const single a = get_scalar(-0.2f, 0.2f), b = get_scalar(-0.2f, 0.2f), c = get_scalar(-0.2f, 0.2f);
+            velocities.emplace_back(a, b, c);
+            proxies.push_back(hierarchy.insert(boxes.back()));
+        }
+    }
+    void step()
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        { boxes[i] = idlib::translate(boxes[i], velocities[i]); }
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(dynamic_bounding_volume_hierarchy_insert)
+{
+    run(iterations, [](operands& x)
+    {
+        hierarchy_type h(0.5f);
+        for (const auto& b : x.boxes)
+        { x.result += h.insert(b); }
+    });
+}
+
+IDLIB_BENCHMARK(dynamic_bounding_volume_hierarchy_move)
+{
+    run(iterations, [](operands& x)
+    {
+        x.step();
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        { x.result += x.hierarchy.move(x.proxies[i], x.boxes[i]) ? 1 : 0; }
+    });
+}
+
+IDLIB_BENCHMARK(dynamic_bounding_volume_hierarchy_rebuild)
+{
+    run(iterations, [](operands& x)
+    {
+        x.step();
+        x.result += idlib::bounding_volume_hierarchy<point_type>(x.boxes.data(), x.boxes.size()).get_nodes().size();
+    });
+}
+
+IDLIB_BENCHMARK(dynamic_bounding_volume_hierarchy_query_pairs)
+{ run(iterations, [](operands& x) { x.hierarchy.query_pairs([&x](size_t a, size_t b) { x.result += a ^ b; }); }); }
+
+IDLIB_BENCHMARK(dynamic_bounding_volume_hierarchy_query_pairs_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const auto& a = x.hierarchy.get_box(x.proxies[i]);
+            for (size_t j = i + 1; j < number_of_boxes; ++j)
+            {
+                if (idlib::is_intersecting(a, x.hierarchy.get_box(x.proxies[j])))
+                { x.result += i ^ j; }
+            }
+        }
+    });
+}
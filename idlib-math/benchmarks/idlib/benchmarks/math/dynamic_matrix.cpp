@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the textbook triple loop with the cache-blocked idlib::multiply for dynamic matrices,
+/// sequentially and with a parallel execution policy.
+/// An iteration computes the product of two 256 x 256 matrices.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t order = 256;
+
+template <typename E>
+struct operands
+{
+    idlib::dynamic_matrix<E> a, b, c;
+    operands() : a(order, order), b(order, order)
+    {
+        for (size_t i = 0; i < order * order; ++i)
+        {
+            a(i) = E(int(i % 13) - 6);
+            b(i) = E(int(i % 7) - 3);
+        }
+    }
+};
+
+template <typename E>
+void naive(const idlib::dynamic_matrix<E>& a, const idlib::dynamic_matrix<E>& b, idlib::dynamic_matrix<E>& c)
+{
+    c.resize(a.number_of_rows(), b.number_of_columns());
+    for (size_t i = 0; i < a.number_of_rows(); ++i)
+    {
+        for (size_t j = 0; j < b.number_of_columns(); ++j)
+        {
+            E s = 0;
+            for (size_t k = 0; k < a.number_of_columns(); ++k)
+            { s += a(i, k) * b(k, j); }
+            c(i, j) = s;
+        }
+    }
+}
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x.a, x.b, x.c);
+        idlib::benchmarks::do_not_optimize(x.c);
+    }
+}
+
+template <typename E>
+using dynamic_matrix = idlib::dynamic_matrix<E>;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(dynamic_matrix_multiply_##E##_naive) \
+    { run<E>(iterations, [](const dynamic_matrix<E>& a, const dynamic_matrix<E>& b, dynamic_matrix<E>& c) { naive(a, b, c); }); } \
+    IDLIB_BENCHMARK(dynamic_matrix_multiply_##E) \
+    { run<E>(iterations, [](const dynamic_matrix<E>& a, const dynamic_matrix<E>& b, dynamic_matrix<E>& c) { idlib::multiply(a, b, c); }); } \
+    IDLIB_BENCHMARK(dynamic_matrix_multiply_##E##_parallel) \
+    { run<E>(iterations, [](const dynamic_matrix<E>& a, const dynamic_matrix<E>& b, dynamic_matrix<E>& c) { idlib::multiply(a, b, c, idlib::execution_policy::parallel()); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
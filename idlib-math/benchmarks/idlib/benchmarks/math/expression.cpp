@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare eager evaluation with lazy evaluation of <c>a + b * s - c</c> and of compound assignments.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_values = 1024;
+
+template <typename T>
+std::vector<T> get_values(int offset)
+{
+    std::vector<T> values(number_of_values);
+    for (size_t i = 0; i < number_of_values; ++i)
+    {
+        for (size_t j = 0; j < idlib::arithmetic_expression_traits<T>::size(); ++j)
+        { values[i](j) = typename idlib::arithmetic_expression_traits<T>::element_type(int((i + j) % 17) + offset); }
+    }
+    return values;
+}
+
+template <typename T>
+struct operands
+{
+    using element_type = typename idlib::arithmetic_expression_traits<T>::element_type;
+    std::vector<T> a = get_values<T>(0), b = get_values<T>(3), c = get_values<T>(-5), r = std::vector<T>(number_of_values);
+    element_type s = element_type(0.5);
+};
+
+template <typename T>
+void eager(size_t iterations)
+{
+    static operands<T> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (size_t j = 0; j < number_of_values; ++j)
+        { x.r[j] = x.a[j] + x.b[j] * x.s - x.c[j]; }
+        idlib::benchmarks::do_not_optimize(x.r);
+    }
+}
+
+template <typename T>
+void lazy(size_t iterations)
+{
+    static operands<T> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (size_t j = 0; j < number_of_values; ++j)
+        { idlib::assign(x.r[j], idlib::lazy(x.a[j]) + idlib::lazy(x.b[j]) * x.s - idlib::lazy(x.c[j])); }
+        idlib::benchmarks::do_not_optimize(x.r);
+    }
+}
+
+template <typename T>
+void compound(size_t iterations)
+{
+    static operands<T> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (size_t j = 0; j < number_of_values; ++j)
+        { x.r[j] = x.a[j]; x.r[j] += x.b[j]; x.r[j] -= x.c[j]; x.r[j] *= x.s; }
+        idlib::benchmarks::do_not_optimize(x.r);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(expression_eager_vector_single_3) { eager<idlib::vector<single, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_lazy_vector_single_3) { lazy<idlib::vector<single, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_compound_vector_single_3) { compound<idlib::vector<single, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_eager_vector_single_4) { eager<idlib::vector<single, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_lazy_vector_single_4) { lazy<idlib::vector<single, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_compound_vector_single_4) { compound<idlib::vector<single, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_eager_vector_double_3) { eager<idlib::vector<double, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_lazy_vector_double_3) { lazy<idlib::vector<double, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_compound_vector_double_3) { compound<idlib::vector<double, 3>>(iterations); }
+IDLIB_BENCHMARK(expression_eager_vector_double_4) { eager<idlib::vector<double, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_lazy_vector_double_4) { lazy<idlib::vector<double, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_compound_vector_double_4) { compound<idlib::vector<double, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_eager_matrix_single_4_4) { eager<idlib::matrix<single, 4, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_lazy_matrix_single_4_4) { lazy<idlib::matrix<single, 4, 4>>(iterations); }
+IDLIB_BENCHMARK(expression_compound_matrix_single_4_4) { compound<idlib::matrix<single, 4, 4>>(iterations); }
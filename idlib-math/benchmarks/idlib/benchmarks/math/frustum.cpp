@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare a scalar loop over idlib::is_intersecting with idlib::cull.
+/// An iteration tests 100000 spheres or axis aligned boxes against a view frustum, e.g. the objects of a frame.
+/// The parallel variants use all hardware threads.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+
+namespace {
+
+constexpr size_t number_of_objects = 100000;
+
+template <typename E>
+using point = idlib::point<idlib::vector<E, 3>>;
+
+template <typename E>
+struct operands
+{
+    idlib::frustum<point<E>> f;
+    std::vector<idlib::sphere<point<E>>> spheres;
+    std::vector<idlib::axis_aligned_box<point<E>>> boxes;
+    std::vector<uint32_t> visibility;
+    operands() : visibility(idlib::number_of_visibility_words(number_of_objects))
+    {
+        const auto s = idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(60.0f), 1.5f, 1.0f, 500.0f);
+        idlib::matrix<E, 4, 4> m;
+        for (size_t i = 0; i < 16; ++i)
+        { m(i) = E(s(i)); }
+        f = idlib::frustum<point<E>>(m);
+        for (size_t i = 0; i < number_of_objects; ++i)
+        {
+            const point<E> p(E(int(i % 1000) - 500), E(int(i % 777) - 388), E(-int(i % 613)));
+            spheres.emplace_back(p, E(i % 7));
+            boxes.emplace_back(p, p + idlib::vector<E, 3>(E(i % 5), E(i % 3), E(i % 7)));
+        }
+    }
+};
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.visibility);
+    }
+}
+
+template <typename T, typename G>
+void scalar_cull(const T& f, const std::vector<G>& geometries, std::vector<uint32_t>& visibility)
+{
+    std::fill(visibility.begin(), visibility.end(), 0);
+    for (size_t i = 0; i < geometries.size(); ++i)
+    {
+        if (idlib::is_intersecting(f, geometries[i]))
+        { visibility[i / 32] |= uint32_t(1) << (i % 32); }
+    }
+}
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(cull_spheres_##E##_scalar) \
+    { run<E>(iterations, [](operands<E>& x) { scalar_cull(x.f, x.spheres, x.visibility); }); } \
+    IDLIB_BENCHMARK(cull_spheres_##E) \
+    { run<E>(iterations, [](operands<E>& x) { idlib::cull(x.f, x.spheres.data(), x.spheres.size(), x.visibility.data()); }); } \
+    IDLIB_BENCHMARK(cull_spheres_##E##_parallel) \
+    { run<E>(iterations, [](operands<E>& x) { idlib::cull(x.f, x.spheres.data(), x.spheres.size(), x.visibility.data(), idlib::execution_policy::parallel()); }); } \
+    IDLIB_BENCHMARK(cull_boxes_##E##_scalar) \
+    { run<E>(iterations, [](operands<E>& x) { scalar_cull(x.f, x.boxes, x.visibility); }); } \
+    IDLIB_BENCHMARK(cull_boxes_##E) \
+    { run<E>(iterations, [](operands<E>& x) { idlib::cull(x.f, x.boxes.data(), x.boxes.size(), x.visibility.data()); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
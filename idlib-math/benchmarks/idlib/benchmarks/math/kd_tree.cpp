@@ -0,0 +1,165 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark building idlib::kd_tree and querying it compared to testing all points.
+/// The tree is built over 100000 points. An iteration of a query benchmark performs 1000 queries.
+/// The parallel variants use all hardware threads.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_points = 100000;
+constexpr size_t number_of_queries = 1000;
+constexpr size_t k = 8;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using sphere_type = idlib::sphere<point_type>;
+using tree_type = idlib::kd_tree<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+point_type get_point()
+{
+    const single x = get_scalar(-100, 100), y = get_scalar(-100, 100), z = get_scalar(-100, 100);
+    return point_type(x, y, z);
+}
+
+struct operands
+{
+    std::vector<point_type> points;
+    std::vector<point_type> queries;
+    std::vector<sphere_type> spheres;
+    std::vector<tree_type::neighbor> neighbors;
+    tree_type tree;
+    size_t result = 0;
+    operands()
+        : neighbors(number_of_queries * k)
+    {
+        for (size_t i = 0; i < number_of_points; ++i)
+        { points.push_back(get_point()); }
+        for (size_t i = 0; i < number_of_queries; ++i)
+        {
+            queries.push_back(get_point());
+            spheres.emplace_back(queries.back(), 5.0f);
+        }
+        tree = tree_type(points.data(), points.size());
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(kd_tree_build)
+{ run(iterations, [](operands& x) { x.result += tree_type(x.points.data(), x.points.size()).get_nodes().size(); }); }
+
+IDLIB_BENCHMARK(kd_tree_build_parallel)
+{
+    run(iterations, [](operands& x)
+    { x.result += tree_type(x.points.data(), x.points.size(), idlib::execution_policy::parallel()).get_nodes().size(); });
+}
+
+IDLIB_BENCHMARK(kd_tree_nearest)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        { x.result += x.tree.nearest(q).index; }
+    });
+}
+
+IDLIB_BENCHMARK(kd_tree_nearest_approximate)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        { x.result += x.tree.nearest(q, 1.0f).index; }
+    });
+}
+
+IDLIB_BENCHMARK(kd_tree_nearest_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        {
+            size_t index = 0;
+            single best = std::numeric_limits<single>::max();
+            for (size_t i = 0; i < x.points.size(); ++i)
+            {
+                const single d = idlib::squared_euclidean_norm(x.points[i] - q);
+                if (d < best)
+                {
+                    best = d;
+                    index = i;
+                }
+            }
+            x.result += index;
+        }
+    });
+}
+
+IDLIB_BENCHMARK(kd_tree_nearest_8)
+{
+    run(iterations, [](operands& x)
+    {
+        for (size_t i = 0; i < number_of_queries; ++i)
+        { x.result += x.tree.nearest(x.queries[i], k, x.neighbors.data() + i * k); }
+    });
+}
+
+IDLIB_BENCHMARK(kd_tree_nearest_8_parallel)
+{
+    run(iterations, [](operands& x)
+    {
+        x.tree.nearest(x.queries.data(), x.queries.size(), k, x.neighbors.data(), idlib::execution_policy::parallel(0, 64));
+        x.result += x.neighbors[0].index;
+    });
+}
+
+IDLIB_BENCHMARK(kd_tree_query)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& s : x.spheres)
+        { x.tree.query(s, [&x](size_t i) { x.result += i; }); }
+    });
+}
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark updating and querying idlib::loose_octree compared to testing all boxes.
+/// 10000 boxes move along random directions. An iteration of the move benchmark moves all boxes by one step,
+/// an iteration of the box query benchmark performs 100 queries.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_boxes = 10000;
+constexpr size_t number_of_queries = 100;
+// The nodes of depth 4 are cubes of size 32 holding about 5 boxes each. Deeper nodes hold at most one box
+// such that the tests of the nodes outweigh the tests of the boxes saved (cf. idlib::loose_octree::get_statistics).
+constexpr size_t maximum_depth = 4;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using box_type = idlib::axis_aligned_box<point_type>;
+using cube_type = idlib::axis_aligned_cube<point_type>;
+using tree_type = idlib::loose_octree<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+point_type get_point()
+{
+    const single x = get_scalar(-200, 200), y = get_scalar(-200, 200), z = get_scalar(-200, 200);
+    return point_type(x, y, z);
+}
+
+struct operands
+{
+    std::vector<box_type> boxes;
+    std::vector<vector_type> velocities;
+    std::vector<size_t> handles;
+    std::vector<box_type> queries;
+    idlib::frustum<point_type> frustum;
+    tree_type tree;
+    size_t result = 0;
+    operands()
+        : frustum(idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(60.0f), 1.0f, 1.0f, 300.0f)
+                * idlib::translation_matrix(vector_type(0.0f, 0.0f, -200.0f))),
+          tree(cube_type(point_type(0, 0, 0), 512.0f), maximum_depth)
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const auto p = get_point();
+            const single u = get_scalar(1, 4), v = get_scalar(1, 4), w = get_scalar(1, 4);
+            boxes.emplace_back(p, p + vector_type(u, v, w));
+            const single a = get_scalar(-0.2f, 0.2f), b = get_scalar(-0.2f, 0.2f), c = get_scalar(-0.2f, 0.2f);
+            velocities.emplace_back(a, b, c);
+            handles.push_back(tree.insert(boxes.back()));
+        }
+        for (size_t i = 0; i < number_of_queries; ++i)
+        {
+            const auto p = get_point();
+            queries.emplace_back(p, p + vector_type(50, 50, 50));
+        }
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(loose_octree_insert)
+{
+    run(iterations, [](operands& x)
+    {
+        tree_type t(cube_type(point_type(0, 0, 0), 512.0f), maximum_depth);
+        for (const auto& b : x.boxes)
+        { x.result += t.insert(b); }
+    });
+}
+
+IDLIB_BENCHMARK(loose_octree_move)
+{
+    run(iterations, [](operands& x)
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            x.boxes[i] = idlib::translate(x.boxes[i], x.velocities[i]);
+            x.result += x.tree.move(x.handles[i], x.boxes[i]) ? 1 : 0;
+        }
+    });
+}
+
+IDLIB_BENCHMARK(loose_octree_query_box)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        { x.tree.query(q, [&x](size_t) { x.result++; }); }
+    });
+}
+
+IDLIB_BENCHMARK(loose_octree_query_box_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        {
+            for (const auto& b : x.boxes)
+            { x.result += idlib::is_intersecting(q, b) ? 1 : 0; }
+        }
+    });
+}
+
+IDLIB_BENCHMARK(loose_octree_query_frustum)
+{ run(iterations, [](operands& x) { x.tree.query(x.frustum, [&x](size_t) { x.result++; }); }); }
+
+IDLIB_BENCHMARK(loose_octree_query_frustum_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& b : x.boxes)
+        { x.result += idlib::is_intersecting(x.frustum, b) ? 1 : 0; }
+    });
+}
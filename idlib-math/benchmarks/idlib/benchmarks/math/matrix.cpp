@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the scalar code paths of the product, the transpose, the inverse, and the affine inverse of
+/// \f$4 \times 4\f$ matrices with the code paths selected by idlib::matrix (the SIMD code paths if a SIMD instruction set is selected).
+/// Measure the product, the determinant, and the inverse of \f$2 \times 2\f$, \f$3 \times 3\f$, \f$4 \times 4\f$,
+/// and \f$6 \times 6\f$ matrices (the latter by the LU decomposition).
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_values = 256;
+
+template <typename E>
+struct operands
+{
+    using matrix_type = idlib::matrix<E, 4, 4>;
+    std::vector<matrix_type> a, b, r;
+    operands() : a(number_of_values), b(number_of_values), r(number_of_values)
+    {
+        for (size_t i = 0; i < number_of_values; ++i)
+        {
+            // Affine transformation matrices.
+            const auto s = idlib::translation_matrix(idlib::vector<single, 3>(single(i), 1.0f, 2.0f))
+                         * idlib::rotation_matrix_y(idlib::angle<single, idlib::degrees>(single(i))),
+                       t = idlib::scaling_matrix(idlib::vector<single, 3>(2.0f, single(i + 1), 0.5f))
+                         * idlib::rotation_matrix_x(idlib::angle<single, idlib::degrees>(single(i)));
+            for (size_t k = 0; k < 16; ++k)
+            {
+                a[i](k) = E(s(k));
+                b[i](k) = E(t(k));
+            }
+        }
+    }
+};
+
+/// @brief Run an operation @a iterations times. Each iteration computes a single operation.
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        x.r[j] = f(x.a[j], x.b[j]);
+        idlib::benchmarks::do_not_optimize(x.r[j]);
+    }
+}
+
+template <typename E>
+using matrix4 = idlib::matrix<E, 4, 4>;
+
+template <typename E>
+using product_functor = idlib::arithmetic_binary_star_functor<matrix4<E>, matrix4<E>>;
+
+template <typename E>
+using transpose_functor = idlib::transpose_functor<matrix4<E>>;
+
+template <typename E, size_t N>
+struct square_operands
+{
+    using matrix_type = idlib::matrix<E, N, N>;
+    std::vector<matrix_type> a, b, r;
+    square_operands() : a(number_of_values), b(number_of_values), r(number_of_values)
+    {
+        for (size_t i = 0; i < number_of_values; ++i)
+        {
+            // Diagonally dominant, hence regular, matrices.
+            for (size_t j = 0; j < N; ++j)
+            {
+                for (size_t k = 0; k < N; ++k)
+                {
+                    a[i](j, k) = j == k ? E(N + 1 + i % 3) : E(int((i + j * N + k) % 5) - 2) / E(4);
+                    b[i](j, k) = j == k ? E(N + 2) : E(int((i * 3 + j + k * N) % 7) - 3) / E(8);
+                }
+            }
+        }
+    }
+};
+
+/// @brief Run an operation on square matrices @a iterations times. Each iteration computes a single operation.
+template <typename E, size_t N, typename F>
+void run_square(size_t iterations, F f)
+{
+    static square_operands<E, N> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        const auto r = f(x.a[j], x.b[j]);
+        idlib::benchmarks::do_not_optimize(r);
+    }
+}
+
+template <typename E, size_t N>
+using matrix = idlib::matrix<E, N, N>;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(matrix4_product_##E##_scalar) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>& b) { return product_functor<E>().impl(a, b, std::false_type{}); }); } \
+    IDLIB_BENCHMARK(matrix4_product_##E) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>& b) { return a * b; }); } \
+    IDLIB_BENCHMARK(matrix4_transpose_##E##_scalar) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return transpose_functor<E>().impl(a, std::false_type{}); }); } \
+    IDLIB_BENCHMARK(matrix4_transpose_##E) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return idlib::transpose(a); }); } \
+    IDLIB_BENCHMARK(matrix4_inverse_##E##_scalar) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return a.inverse(std::false_type{}); }); } \
+    IDLIB_BENCHMARK(matrix4_inverse_##E) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return a.inverse(); }); } \
+    IDLIB_BENCHMARK(matrix4_affine_inverse_##E##_scalar) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return a.affine_inverse(std::false_type{}); }); } \
+    IDLIB_BENCHMARK(matrix4_affine_inverse_##E) \
+    { run<E>(iterations, [](const matrix4<E>& a, const matrix4<E>&) { return a.affine_inverse(); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
+
+#define DEFINE(E, N) \
+    IDLIB_BENCHMARK(matrix##N##_product_##E) \
+    { run_square<E, N>(iterations, [](const matrix<E, N>& a, const matrix<E, N>& b) { return a * b; }); } \
+    IDLIB_BENCHMARK(matrix##N##_determinant_##E) \
+    { run_square<E, N>(iterations, [](const matrix<E, N>& a, const matrix<E, N>&) { return a.det(); }); } \
+    IDLIB_BENCHMARK(matrix##N##_inverse_##E) \
+    { run_square<E, N>(iterations, [](const matrix<E, N>& a, const matrix<E, N>&) { return a.inverse(); }); }
+
+DEFINE(single, 2)
+DEFINE(single, 3)
+DEFINE(single, 6)
+DEFINE(double, 2)
+DEFINE(double, 3)
+DEFINE(double, 6)
+
+#undef DEFINE
+
+// The product and the inverse of 4x4 matrices are measured above.
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(matrix4_determinant_##E) \
+    { run_square<E, 4>(iterations, [](const matrix<E, 4>& a, const matrix<E, 4>&) { return a.det(); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
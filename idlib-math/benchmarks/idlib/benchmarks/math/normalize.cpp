@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the precision policies of idlib::normalize for single vectors and for batches of vectors.
+/// An iteration normalizes an array of vectors, e.g. the normals or light directions of a frame.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_vectors = 4096;
+
+using vector_type = idlib::vector<single, 3>;
+
+struct operands
+{
+    std::vector<vector_type> v, r;
+    idlib::vector_batch<single, 3> a, b;
+    operands() : r(number_of_vectors)
+    {
+        for (size_t i = 0; i < number_of_vectors; ++i)
+        { v.emplace_back(single(1 + i % 7), single(i % 13) - 6.0f, single(i % 5) * 0.5f); }
+        a = idlib::vector_batch<single, 3>(v.data(), v.size());
+    }
+};
+
+operands& get_operands()
+{
+    static operands x;
+    return x;
+}
+
+template <idlib::precision P>
+void run_scalar(size_t iterations)
+{
+    auto& x = get_operands();
+    const idlib::euclidean_norm_functor<vector_type, P> norm;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (size_t j = 0; j < number_of_vectors; ++j)
+        { x.r[j] = idlib::normalize(x.v[j], norm).get_vector_or_default(); }
+        idlib::benchmarks::do_not_optimize(x.r);
+    }
+}
+
+template <idlib::precision P>
+void run_batch(size_t iterations)
+{
+    auto& x = get_operands();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        idlib::normalize<P>(x.a, x.b);
+        idlib::benchmarks::do_not_optimize(x.b);
+    }
+}
+
+} // namespace
+
+#define DEFINE(P) \
+    IDLIB_BENCHMARK(normalize_##P) \
+    { run_scalar<idlib::precision::P>(iterations); } \
+    IDLIB_BENCHMARK(normalize_batch_##P) \
+    { run_batch<idlib::precision::P>(iterations); }
+
+DEFINE(exact)
+DEFINE(newton_raphson)
+DEFINE(estimate)
+
+#undef DEFINE
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief The builders of the perspective projection, the orthographic projection, and the look-at matrices.
+/// An iteration builds a single matrix from the next parameters of an array, e.g. the cameras of the views of a frame.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_values = 256;
+
+struct operands
+{
+    std::vector<idlib::vector<single, 3>> eye, center;
+    std::vector<single> s;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_values; ++i)
+        {
+            eye.emplace_back(single(i % 7) - 3.0f, 2.0f, single(i % 5) + 10.0f);
+            center.emplace_back(single(i % 3), 0.0f, single(i % 11) * -1.0f);
+            s.push_back(1.0f + single(i % 17) / 16.0f);
+        }
+    }
+};
+
+/// @brief Run a builder @a iterations times. Each iteration builds a single matrix.
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        const auto r = f(x.eye[j], x.center[j], x.s[j]);
+        idlib::benchmarks::do_not_optimize(r);
+    }
+}
+
+using vector3 = idlib::vector<single, 3>;
+
+} // namespace
+
+IDLIB_BENCHMARK(perspective_projection_matrix_degrees)
+{
+    run(iterations, [](const vector3&, const vector3&, single s)
+    { return idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(45.0f * s), 16.0f / 9.0f, 0.1f, 100.0f * s); });
+}
+
+IDLIB_BENCHMARK(perspective_projection_matrix_radians)
+{
+    run(iterations, [](const vector3&, const vector3&, single s)
+    { return idlib::perspective_projection_matrix(idlib::angle<single, idlib::radians>(0.75f * s), 16.0f / 9.0f, 0.1f, 100.0f * s); });
+}
+
+IDLIB_BENCHMARK(orthographic_projection_matrix)
+{
+    run(iterations, [](const vector3&, const vector3&, single s)
+    { return idlib::orthographic_projection_matrix(-s, +s, -s, +s, 0.1f, 100.0f * s); });
+}
+
+IDLIB_BENCHMARK(look_at_matrix)
+{
+    run(iterations, [](const vector3& eye, const vector3& center, single)
+    { return idlib::look_at_matrix(eye, center, vector3(0.0f, 1.0f, 0.0f)); });
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the scalar code path of the batched idlib::nlerp with the code path selected by it
+/// (the SIMD code path if a SIMD instruction set is selected), with the batched idlib::slerp, and with a parallel execution policy.
+/// An iteration blends two arrays of quaternions, e.g. the bone rotations of two animation poses.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_quaternions = 100000;
+
+template <typename E>
+struct operands
+{
+    using quaternion_type = idlib::quaternion<E>;
+    std::vector<quaternion_type> a, b, r;
+    operands() : r(number_of_quaternions)
+    {
+        for (size_t i = 0; i < number_of_quaternions; ++i)
+        {
+            const idlib::vector<E, 3> axis(E(1), E(i % 7), E(i % 3));
+            a.emplace_back(axis, idlib::angle<E, idlib::degrees>(E(i % 360)));
+            b.emplace_back(axis, idlib::angle<E, idlib::degrees>(E((i * 7) % 360)));
+        }
+    }
+};
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x.a.data(), x.b.data(), number_of_quaternions, E(0.25), x.r.data());
+        idlib::benchmarks::do_not_optimize(x.r);
+    }
+}
+
+template <typename E>
+using quaternion = idlib::quaternion<E>;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(quaternion_nlerp_##E##_scalar) \
+    { run<E>(iterations, [](const quaternion<E> *a, const quaternion<E> *b, size_t n, E t, quaternion<E> *r) { idlib::internal::quaternion_kernels<E>::nlerp(a, b, n, t, r, std::false_type{}); }); } \
+    IDLIB_BENCHMARK(quaternion_nlerp_##E) \
+    { run<E>(iterations, [](const quaternion<E> *a, const quaternion<E> *b, size_t n, E t, quaternion<E> *r) { idlib::nlerp(a, b, n, t, r); }); } \
+    IDLIB_BENCHMARK(quaternion_nlerp_##E##_parallel) \
+    { run<E>(iterations, [](const quaternion<E> *a, const quaternion<E> *b, size_t n, E t, quaternion<E> *r) { idlib::nlerp(a, b, n, t, r, idlib::execution_policy::parallel()); }); } \
+    IDLIB_BENCHMARK(quaternion_slerp_##E) \
+    { run<E>(iterations, [](const quaternion<E> *a, const quaternion<E> *b, size_t n, E t, quaternion<E> *r) { idlib::slerp(a, b, n, t, r); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
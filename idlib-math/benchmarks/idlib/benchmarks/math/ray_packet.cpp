@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark testing coherent rays one by one compared to testing them in packets of idlib::ray_packet.
+/// The rays are the rays of a 64 x 64 pixel pinhole camera. The packets are rays of neighbouring pixels.
+/// An iteration of a hierarchy benchmark finds the closest hit of each ray in an idlib::bounding_volume_hierarchy of 100000 boxes.
+/// An iteration of a triangle benchmark tests each ray against 64 triangles.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_boxes = 100000;
+constexpr size_t number_of_triangles = 64;
+constexpr size_t resolution = 64;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using box_type = idlib::axis_aligned_box<point_type>;
+using ray_type = idlib::ray<point_type>;
+using triangle_type = idlib::triangle<point_type>;
+using hierarchy_type = idlib::bounding_volume_hierarchy<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+point_type get_point()
+{
+    const single x = get_scalar(-1000, 1000), y = get_scalar(-1000, 1000), z = get_scalar(-1000, 1000);
+    return point_type(x, y, z);
+}
+
+struct operands
+{
+    std::vector<box_type> boxes;
+    std::vector<triangle_type> triangles;
+    /// @brief The rays in the order of the packets: Packets of 4 rays are 2 x 2 pixels, packets of 8 rays are 4 x 2 pixels.
+    std::vector<ray_type> rays;
+    std::vector<idlib::ray_packet<point_type, 4>> packets_4;
+    std::vector<idlib::ray_packet<point_type, 8>> packets_8;
+    hierarchy_type hierarchy;
+    size_t result = 0;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const auto p = get_point();
+            const single x = get_scalar(1, 20), y = get_scalar(1, 20), z = get_scalar(1, 20);
+            boxes.emplace_back(p, p + vector_type(x, y, z));
+        }
+        for (size_t i = 0; i < number_of_triangles; ++i)
+        {
+            const auto p = point_type(get_scalar(-200, 200), get_scalar(-200, 200), 0);
+            triangles.emplace_back(p, p + vector_type(get_scalar(10, 50), 0, get_scalar(-5, 5)), p + vector_type(0, get_scalar(10, 50), get_scalar(-5, 5)));
+        }
+        const point_type eye(0, 0, -1500);
+        for (size_t y = 0; y < resolution; y += 2)
+        {
+            for (size_t x = 0; x < resolution; x += 4)
+            {
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    const single u = single(x + i % 4) / resolution - 0.5f, v = single(y + i / 4) / resolution - 0.5f;
+                    rays.emplace_back(eye, vector_type(u * 0.5f, v * 0.5f, 1));
+                }
+            }
+        }
+        for (size_t i = 0; i < rays.size(); i += 8)
+        {
+            const ray_type r[8] = { rays[i], rays[i + 1], rays[i + 4], rays[i + 5], rays[i + 2], rays[i + 3], rays[i + 6], rays[i + 7] };
+            packets_4.emplace_back(r);
+            packets_4.emplace_back(r + 4);
+            packets_8.emplace_back(rays.data() + i);
+        }
+        hierarchy = hierarchy_type(boxes.data(), boxes.size());
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+template <size_t N>
+void query(operands& x, const std::vector<idlib::ray_packet<point_type, N>>& packets)
+{
+    for (const auto& p : packets)
+    {
+        single t_max[N];
+        std::fill(t_max, t_max + N, 5000.0f);
+        x.hierarchy.query(p, t_max, [&x, &p](size_t i, unsigned int, single *t_max)
+        {
+            single t[N];
+            const unsigned int hits = idlib::ray_cast(p, x.boxes[i], t_max, t);
+            for (size_t j = 0; j < N; ++j)
+            {
+                if (hits & (1u << j))
+                {
+                    t_max[j] = t[j];
+                    x.result++;
+                }
+            }
+            return false;
+        });
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(ray_packet_query_ray)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& r : x.rays)
+        {
+            x.hierarchy.query(r, 5000.0f, [&x, &r](size_t i, single& t_max)
+            {
+                if (idlib::ray_cast(r, x.boxes[i], t_max, t_max))
+                { x.result++; }
+                return false;
+            });
+        }
+    });
+}
+
+IDLIB_BENCHMARK(ray_packet_query_packet_4)
+{ run(iterations, [](operands& x) { query(x, x.packets_4); }); }
+
+IDLIB_BENCHMARK(ray_packet_query_packet_8)
+{ run(iterations, [](operands& x) { query(x, x.packets_8); }); }
+
+IDLIB_BENCHMARK(ray_packet_triangle_ray)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& r : x.rays)
+        {
+            single t_max = 5000.0f;
+            for (const auto& y : x.triangles)
+            { x.result += idlib::ray_cast(r, y, t_max, t_max) ? 1 : 0; }
+        }
+    });
+}
+
+IDLIB_BENCHMARK(ray_packet_triangle_packet_8)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& p : x.packets_8)
+        {
+            single t_max[8], t[8];
+            std::fill(t_max, t_max + 8, 5000.0f);
+            for (const auto& y : x.triangles)
+            {
+                const unsigned int hits = idlib::ray_cast(p, y, t_max, t);
+                for (size_t j = 0; j < 8; ++j)
+                {
+                    if (hits & (1u << j))
+                    {
+                        t_max[j] = t[j];
+                        x.result++;
+                    }
+                }
+            }
+        }
+    });
+}
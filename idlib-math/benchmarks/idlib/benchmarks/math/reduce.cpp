@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare a scalar loop with idlib::bounds and idlib::centroid.
+/// An iteration computes the bounds or the centroid of a point cloud of 65536 points.
+/// The parallel variants use all hardware threads.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_points = 65536;
+
+template <typename E>
+struct operands
+{
+    using point_type = idlib::point<idlib::vector<E, 3>>;
+    std::vector<point_type> p;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_points; ++i)
+        { p.emplace_back(E(int(i % 1000) - 500) / E(8), E(int(i % 777)) / E(16), E(int(i % 313) - 100) / E(4)); }
+    }
+};
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const auto r = f(x.p.data(), number_of_points);
+        idlib::benchmarks::do_not_optimize(r);
+    }
+}
+
+template <typename E>
+using point = idlib::point<idlib::vector<E, 3>>;
+
+template <typename E>
+std::pair<point<E>, point<E>> scalar_bounds(const point<E> *p, size_t n)
+{
+    auto r = std::make_pair(p[0], p[0]);
+    for (size_t i = 1; i < n; ++i)
+    {
+        r.first = idlib::zip_min(r.first, p[i]);
+        r.second = idlib::zip_max(r.second, p[i]);
+    }
+    return r;
+}
+
+template <typename E>
+point<E> scalar_centroid(const point<E> *p, size_t n)
+{
+    idlib::vector<E, 3> s;
+    for (size_t i = 0; i < n; ++i)
+    { s += p[i] - point<E>(); }
+    return point<E>() + s / E(n);
+}
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(bounds_##E##_scalar) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return scalar_bounds(p, n); }); } \
+    IDLIB_BENCHMARK(bounds_##E) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return idlib::bounds(p, n); }); } \
+    IDLIB_BENCHMARK(bounds_##E##_parallel) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return idlib::bounds(p, n, idlib::execution_policy::parallel()); }); } \
+    IDLIB_BENCHMARK(centroid_##E##_scalar) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return scalar_centroid(p, n); }); } \
+    IDLIB_BENCHMARK(centroid_##E) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return idlib::centroid(p, n); }); } \
+    IDLIB_BENCHMARK(centroid_##E##_parallel) \
+    { run<E>(iterations, [](const point<E> *p, size_t n) { return idlib::centroid(p, n, idlib::execution_policy::parallel()); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare computing shadow cascades by hand with idlib::shadow_cascades.
+/// By hand, the corners of each slice are unprojected by the inverse of the view-projection matrix of the slice.
+/// An iteration computes 8 cascades, e.g. the cascades of a light of a frame.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr size_t number_of_cascades = 8;
+
+using point_type = idlib::point<idlib::vector<single, 3>>;
+using matrix_type = idlib::matrix<single, 4, 4>;
+
+struct operands
+{
+    idlib::angle<single, idlib::radians> fov_y = idlib::semantic_cast<idlib::angle<single, idlib::radians>>(idlib::angle<single, idlib::degrees>(60.0f));
+    single aspect = 1.5f;
+    matrix_type view = idlib::look_at_matrix(idlib::vector<single, 3>(3.0f, 2.0f, 10.0f), idlib::vector<single, 3>(-1.0f, 0.0f, -5.0f),
+                                             idlib::vector<single, 3>(0.0f, 1.0f, 0.0f));
+    matrix_type light_view = idlib::look_at_matrix(idlib::vector<single, 3>(20.0f, 40.0f, 10.0f), idlib::vector<single, 3>(0.0f, 0.0f, 0.0f),
+                                                   idlib::vector<single, 3>(0.0f, 1.0f, 0.0f));
+    single distances[number_of_cascades + 1];
+    idlib::axis_aligned_box<point_type> boxes[number_of_cascades];
+    idlib::sphere<point_type> spheres[number_of_cascades];
+    matrix_type matrices[number_of_cascades];
+    operands()
+    { idlib::split_distances(0.1f, 500.0f, 0.75f, number_of_cascades, distances); }
+};
+
+void by_hand(operands& x)
+{
+    for (size_t i = 0; i < number_of_cascades; ++i)
+    {
+        const auto m = (idlib::perspective_projection_matrix(x.fov_y, x.aspect, x.distances[i], x.distances[i + 1]) * x.view).inverse();
+        point_type corners[8];
+        for (size_t j = 0; j < 8; ++j)
+        {
+            corners[j] = point_type(j & 1 ? +1.0f : -1.0f, j & 2 ? +1.0f : -1.0f, j & 4 ? +1.0f : -1.0f);
+        }
+        idlib::project_points(m, corners, 8, corners);
+        idlib::transform_points(x.light_view, corners, 8, corners);
+        point_type min = corners[0], max = corners[0];
+        for (size_t j = 1; j < 8; ++j)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                min[k] = std::min(min[k], corners[j][k]);
+                max[k] = std::max(max[k], corners[j][k]);
+            }
+        }
+        x.boxes[i] = idlib::axis_aligned_box<point_type>(min, max);
+        x.matrices[i] = idlib::orthographic_projection_matrix(min[0], max[0], min[1], max[1], -max[2], -min[2]) * x.light_view;
+    }
+}
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.matrices);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(shadow_cascades_by_hand)
+{ run(iterations, [](operands& x) { by_hand(x); }); }
+
+IDLIB_BENCHMARK(shadow_cascades_boxes)
+{ run(iterations, [](operands& x) { idlib::shadow_cascades(x.view, x.fov_y, x.aspect, x.distances, number_of_cascades, x.light_view, x.boxes, x.matrices); }); }
+
+IDLIB_BENCHMARK(shadow_cascades_spheres)
+{ run(iterations, [](operands& x) { idlib::shadow_cascades(x.view, x.fov_y, x.aspect, x.distances, number_of_cascades, x.light_view, x.spheres, x.matrices); }); }
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the sines and cosines of the C++ standard library with idlib::sincos and the batched idlib::sincos.
+/// An iteration computes the sines and cosines of an array of angles in radians, e.g. the yaw angles of the objects of a frame.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_angles = 4096;
+
+template <typename E>
+struct operands
+{
+    using angle_type = idlib::angle<E, idlib::radians>;
+    std::vector<angle_type> x;
+    std::vector<E> s, c;
+    operands() : s(number_of_angles), c(number_of_angles)
+    {
+        for (size_t i = 0; i < number_of_angles; ++i)
+        { x.emplace_back(E(int(i % 1000) - 500) / E(50)); }
+    }
+};
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x.x.data(), number_of_angles, x.s.data(), x.c.data());
+        idlib::benchmarks::do_not_optimize(x.s);
+        idlib::benchmarks::do_not_optimize(x.c);
+    }
+}
+
+template <typename E>
+using angle = idlib::angle<E, idlib::radians>;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(sincos_##E##_std) \
+    { run<E>(iterations, [](const angle<E> *x, size_t n, E *s, E *c) { for (size_t i = 0; i < n; ++i) { s[i] = std::sin(x[i]); c[i] = std::cos(x[i]); } }); } \
+    IDLIB_BENCHMARK(sincos_##E) \
+    { run<E>(iterations, [](const angle<E> *x, size_t n, E *s, E *c) { for (size_t i = 0; i < n; ++i) { const auto r = idlib::sincos(x[i]); s[i] = r.first; c[i] = r.second; } }); } \
+    IDLIB_BENCHMARK(sincos_##E##_batch) \
+    { run<E>(iterations, [](const angle<E> *x, size_t n, E *s, E *c) { idlib::sincos(x, n, s, c); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark updating idlib::sweep_and_prune compared to idlib::dynamic_bounding_volume_hierarchy.
+/// 10000 boxes move back and forth along random directions. An iteration moves all boxes or 1% of the boxes by one step
+/// and reports the changes of the overlapping pairs. The hierarchy moves all boxes and reports all intersecting pairs.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_boxes = 10000;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using box_type = idlib::axis_aligned_box<point_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+struct operands
+{
+    std::vector<box_type> boxes;
+    std::vector<vector_type> velocities;
+    size_t frame = 0;
+    size_t result = 0;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        {
+            const point_type p(get_scalar(-50, 50), get_scalar(-50, 50), get_scalar(-50, 50));
+            boxes.emplace_back(p, p + vector_type(get_scalar(0.5f, 2), get_scalar(0.5f, 2), get_scalar(0.5f, 2)));
+            velocities.emplace_back(get_scalar(-0.05f, 0.05f), get_scalar(-0.05f, 0.05f), get_scalar(-0.05f, 0.05f));
+        }
+    }
+    // Move the boxes [first, last) by one step. The boxes reverse their directions every 100 frames.
+    void step(size_t first, size_t last)
+    {
+        const single s = (frame++ / 100) % 2 == 0 ? 1.0f : -1.0f;
+        for (size_t i = first; i < last; ++i)
+        { boxes[i] = idlib::translate(boxes[i], velocities[i] * s); }
+    }
+};
+
+template <size_t N>
+struct sweep_and_prune_operands : operands
+{
+    idlib::sweep_and_prune<point_type> s;
+    std::vector<size_t> handles;
+    sweep_and_prune_operands()
+        : s(N)
+    {
+        for (const auto& b : boxes)
+        { handles.push_back(s.insert(b)); }
+        s.update([](size_t, size_t) {}, [](size_t, size_t) {});
+    }
+    void update(size_t first, size_t last)
+    {
+        step(first, last);
+        for (size_t i = first; i < last; ++i)
+        { s.move(handles[i], boxes[i]); }
+        s.update([this](size_t a, size_t b) { result += a ^ b; }, [this](size_t a, size_t b) { result -= a ^ b; });
+    }
+};
+
+struct dynamic_bounding_volume_hierarchy_operands : operands
+{
+    idlib::dynamic_bounding_volume_hierarchy<point_type> hierarchy;
+    std::vector<size_t> proxies;
+    dynamic_bounding_volume_hierarchy_operands()
+        : hierarchy(0.1f)
+    {
+        for (const auto& b : boxes)
+        { proxies.push_back(hierarchy.insert(b)); }
+    }
+};
+
+template <typename T, typename F>
+void run(size_t iterations, F f)
+{
+    static T x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(sweep_and_prune_1_axis)
+{ run<sweep_and_prune_operands<1>>(iterations, [](auto& x) { x.update(0, number_of_boxes); }); }
+
+IDLIB_BENCHMARK(sweep_and_prune_3_axes)
+{ run<sweep_and_prune_operands<3>>(iterations, [](auto& x) { x.update(0, number_of_boxes); }); }
+
+IDLIB_BENCHMARK(sweep_and_prune_3_axes_1_percent)
+{ run<sweep_and_prune_operands<3>>(iterations, [](auto& x) { x.update(0, number_of_boxes / 100); }); }
+
+IDLIB_BENCHMARK(sweep_and_prune_dynamic_bounding_volume_hierarchy)
+{
+    run<dynamic_bounding_volume_hierarchy_operands>(iterations, [](auto& x)
+    {
+        x.step(0, number_of_boxes);
+        for (size_t i = 0; i < number_of_boxes; ++i)
+        { x.hierarchy.move(x.proxies[i], x.boxes[i]); }
+        x.hierarchy.query_pairs([&x](size_t a, size_t b) { x.result += a ^ b; });
+    });
+}
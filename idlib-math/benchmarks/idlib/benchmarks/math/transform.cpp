@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compare the scalar code path of idlib::transform_points and idlib::project_points with the code path
+/// selected by these functions (the SIMD code path if a SIMD instruction set is selected) and with a parallel execution policy.
+/// An iteration transforms an array of points.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_points = 65536;
+
+template <typename E>
+struct operands
+{
+    using point_type = idlib::point<idlib::vector<E, 3>>;
+    idlib::matrix<E, 4, 4> m;
+    std::vector<point_type> source, target;
+    operands() : source(number_of_points), target(number_of_points)
+    {
+        const auto s = idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(60.0f), 1.5f, 0.5f, 100.0f)
+                     * idlib::translation_matrix(idlib::vector<single, 3>(1.0f, -2.0f, -10.0f))
+                     * idlib::rotation_matrix_y(idlib::angle<single, idlib::degrees>(30.0f));
+        for (size_t k = 0; k < 16; ++k)
+        { m(k) = E(s(k)); }
+        for (size_t i = 0; i < number_of_points; ++i)
+        { source[i] = point_type(E(i % 17), E(i % 13), E(i % 7)); }
+    }
+};
+
+template <typename E, idlib::internal::transform_kind Kind, typename Path>
+void run_kernel(size_t iterations, Path path)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        idlib::internal::transform_kernel<E, Kind>::apply(&(x.m(0)), idlib::internal::scalars(x.source.data()), number_of_points,
+                                                          idlib::internal::scalars(x.target.data()), path);
+        idlib::benchmarks::do_not_optimize(x.target);
+    }
+}
+
+template <typename E, typename F>
+void run(size_t iterations, F f)
+{
+    static operands<E> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x.m, x.source.data(), number_of_points, x.target.data());
+        idlib::benchmarks::do_not_optimize(x.target);
+    }
+}
+
+using kind = idlib::internal::transform_kind;
+
+} // namespace
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(transform_points_##E##_scalar) \
+    { run_kernel<E, kind::point>(iterations, std::false_type{}); } \
+    IDLIB_BENCHMARK(transform_points_##E) \
+    { run<E>(iterations, [](const auto& m, const auto *s, size_t n, auto *t) { idlib::transform_points(m, s, n, t); }); } \
+    IDLIB_BENCHMARK(transform_points_##E##_parallel) \
+    { run<E>(iterations, [](const auto& m, const auto *s, size_t n, auto *t) { idlib::transform_points(m, s, n, t, idlib::execution_policy::parallel()); }); } \
+    IDLIB_BENCHMARK(project_points_##E##_scalar) \
+    { run_kernel<E, kind::projection>(iterations, std::false_type{}); } \
+    IDLIB_BENCHMARK(project_points_##E) \
+    { run<E>(iterations, [](const auto& m, const auto *s, size_t n, auto *t) { idlib::project_points(m, s, n, t); }); } \
+    IDLIB_BENCHMARK(project_points_##E##_parallel) \
+    { run<E>(iterations, [](const auto& m, const auto *s, size_t n, auto *t) { idlib::project_points(m, s, n, t, idlib::execution_policy::parallel()); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Benchmark building idlib::uniform_grid and querying it compared to testing all spheres.
+/// The grid is built over 10000 spheres. An iteration of the radius query benchmark performs 100 queries.
+/// The parallel variant uses all hardware threads, the 4 threads variant uses 4 threads regardless of the hardware.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+#include "idlib/math_geometry.hpp"
+#include <random>
+
+namespace {
+
+constexpr size_t number_of_spheres = 10000;
+constexpr size_t number_of_queries = 100;
+
+using vector_type = idlib::vector<single, 3>;
+using point_type = idlib::point<vector_type>;
+using sphere_type = idlib::sphere<point_type>;
+using grid_type = idlib::uniform_grid<sphere_type>;
+
+std::mt19937 generator;
+
+single get_scalar(single a, single b)
+{ return std::uniform_real_distribution<single>(a, b)(generator); }
+
+point_type get_point()
+{
+    const single x = get_scalar(-50, 50), y = get_scalar(-50, 50), z = get_scalar(-50, 50);
+    return point_type(x, y, z);
+}
+
+struct operands
+{
+    std::vector<sphere_type> spheres;
+    std::vector<sphere_type> queries;
+    grid_type grid;
+    size_t result = 0;
+    operands()
+        : grid(2.0f)
+    {
+        for (size_t i = 0; i < number_of_spheres; ++i)
+        {
+            const auto p = get_point();
+            spheres.emplace_back(p, get_scalar(0.5f, 1.0f));
+        }
+        for (size_t i = 0; i < number_of_queries; ++i)
+        {
+            const auto p = get_point();
+            queries.emplace_back(p, 5.0f);
+        }
+        grid.build(spheres.data(), spheres.size());
+    }
+};
+
+template <typename F>
+void run(size_t iterations, F f)
+{
+    static operands x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f(x);
+        idlib::benchmarks::do_not_optimize(x.result);
+    }
+}
+
+} // namespace
+
+IDLIB_BENCHMARK(uniform_grid_build)
+{
+    run(iterations, [](operands& x)
+    {
+        x.grid.build(x.spheres.data(), x.spheres.size());
+        x.result += x.grid.size();
+    });
+}
+
+IDLIB_BENCHMARK(uniform_grid_build_parallel)
+{
+    run(iterations, [](operands& x)
+    {
+        x.grid.build(x.spheres.data(), x.spheres.size(), idlib::execution_policy::parallel());
+        x.result += x.grid.size();
+    });
+}
+
+IDLIB_BENCHMARK(uniform_grid_build_4_threads)
+{
+    run(iterations, [](operands& x)
+    {
+        x.grid.build(x.spheres.data(), x.spheres.size(), idlib::execution_policy::parallel(4, 1));
+        x.result += x.grid.size();
+    });
+}
+
+IDLIB_BENCHMARK(uniform_grid_query_pairs)
+{ run(iterations, [](operands& x) { x.grid.query_pairs([&x](size_t i, size_t j) { x.result += i ^ j; }); }); }
+
+IDLIB_BENCHMARK(uniform_grid_query_pairs_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (size_t i = 0; i < number_of_spheres; ++i)
+        {
+            for (size_t j = i + 1; j < number_of_spheres; ++j)
+            {
+                if (idlib::is_intersecting(x.spheres[i], x.spheres[j]))
+                { x.result += i ^ j; }
+            }
+        }
+    });
+}
+
+IDLIB_BENCHMARK(uniform_grid_query_sphere)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        { x.grid.query(q, [&x](size_t) { x.result++; }); }
+    });
+}
+
+IDLIB_BENCHMARK(uniform_grid_query_sphere_brute_force)
+{
+    run(iterations, [](operands& x)
+    {
+        for (const auto& q : x.queries)
+        {
+            for (const auto& s : x.spheres)
+            { x.result += idlib::is_intersecting(s, q) ? 1 : 0; }
+        }
+    });
+}
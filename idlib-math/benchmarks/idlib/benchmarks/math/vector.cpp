@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief The arithmetic of vectors and points, the norms, the dot and the cross product, and the normalization of vectors.
+/// An iteration computes a single operation on the next operands of an array.
+
+#include "idlib/benchmarks/benchmark.hpp"
+#include "idlib/math.hpp"
+
+namespace {
+
+constexpr size_t number_of_values = 256;
+
+template <typename E, size_t N>
+struct operands
+{
+    using vector_type = idlib::vector<E, N>;
+    using point_type = idlib::point<vector_type>;
+    std::vector<vector_type> a, b;
+    std::vector<point_type> p, q;
+    operands()
+    {
+        for (size_t i = 0; i < number_of_values; ++i)
+        {
+            a.push_back(vector_type::generate([i](size_t j) { return E(int((i + j) % 13) - 6) + E(0.5); }));
+            b.push_back(vector_type::generate([i](size_t j) { return E(int((i * 7 + j) % 11) - 5) + E(0.25); }));
+            p.push_back(idlib::zero<point_type>() + a.back());
+            q.push_back(idlib::zero<point_type>() + b.back());
+        }
+    }
+};
+
+/// @brief Run an operation on vectors @a iterations times. Each iteration computes a single operation.
+template <typename E, size_t N, typename F>
+void run_vector(size_t iterations, F f)
+{
+    static operands<E, N> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        const auto r = f(x.a[j], x.b[j]);
+        idlib::benchmarks::do_not_optimize(r);
+    }
+}
+
+/// @brief Run an operation on points @a iterations times. Each iteration computes a single operation.
+template <typename E, size_t N, typename F>
+void run_point(size_t iterations, F f)
+{
+    static operands<E, N> x;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const size_t j = i % number_of_values;
+        const auto r = f(x.p[j], x.q[j], x.b[j]);
+        idlib::benchmarks::do_not_optimize(r);
+    }
+}
+
+template <typename E, size_t N>
+using vector = idlib::vector<E, N>;
+
+template <typename E, size_t N>
+using point = idlib::point<vector<E, N>>;
+
+} // namespace
+
+#define DEFINE(E, N) \
+    IDLIB_BENCHMARK(vector##N##_addition_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>& b) { return a + b; }); } \
+    IDLIB_BENCHMARK(vector##N##_scalar_multiplication_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>& b) { return a * b[0]; }); } \
+    IDLIB_BENCHMARK(vector##N##_dot_product_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>& b) { return idlib::dot_product(a, b); }); } \
+    IDLIB_BENCHMARK(vector##N##_squared_euclidean_norm_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>&) { return idlib::squared_euclidean_norm(a); }); } \
+    IDLIB_BENCHMARK(vector##N##_euclidean_norm_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>&) { return idlib::euclidean_norm(a); }); } \
+    IDLIB_BENCHMARK(vector##N##_manhattan_norm_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>&) { return idlib::manhattan_norm(a); }); } \
+    IDLIB_BENCHMARK(vector##N##_maximum_norm_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>&) { return idlib::maximum_norm(a); }); } \
+    IDLIB_BENCHMARK(vector##N##_normalize_##E) \
+    { run_vector<E, N>(iterations, [](const vector<E, N>& a, const vector<E, N>&) { return idlib::normalize(a, idlib::euclidean_norm_functor<vector<E, N>>()).get_vector_or_default(); }); } \
+    IDLIB_BENCHMARK(point##N##_vector_addition_##E) \
+    { run_point<E, N>(iterations, [](const point<E, N>& p, const point<E, N>&, const vector<E, N>& v) { return p + v; }); } \
+    IDLIB_BENCHMARK(point##N##_point_subtraction_##E) \
+    { run_point<E, N>(iterations, [](const point<E, N>& p, const point<E, N>& q, const vector<E, N>&) { return p - q; }); }
+
+DEFINE(single, 2)
+DEFINE(single, 3)
+DEFINE(single, 4)
+DEFINE(double, 2)
+DEFINE(double, 3)
+DEFINE(double, 4)
+
+#undef DEFINE
+
+#define DEFINE(E) \
+    IDLIB_BENCHMARK(vector3_cross_product_##E) \
+    { run_vector<E, 3>(iterations, [](const vector<E, 3>& a, const vector<E, 3>& b) { return idlib::cross_product(a, b); }); }
+
+DEFINE(single)
+DEFINE(double)
+
+#undef DEFINE
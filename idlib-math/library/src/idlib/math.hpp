@@ -32,14 +32,20 @@
 #undef IDLIB_PRIVATE
 #define IDLIB_PRIVATE 1
 
+#include "idlib/math/affine_transform.hpp"
+#include "idlib/math/aligned.hpp"
 #include "idlib/math/angle.hpp"
 #include "idlib/math/angle-degrees-radians-turns.hpp"
 #include "idlib/math/arithmetic_array_1d.hpp"
 #include "idlib/math/arithmetic_array_2d.hpp"
+#include "idlib/math/arithmetic_expression.hpp"
 #include "idlib/math/arithmetic_functor.hpp"
+#include "idlib/math/cholesky_decomposition.hpp"
 #include "idlib/math/constant_generator.hpp"
 #include "idlib/math/conditional_generator.hpp"
 #include "idlib/math/dimensionality.hpp"
+#include "idlib/math/dynamic_matrix.hpp"
+#include "idlib/math/dynamic_vector.hpp"
 #include "idlib/math/enclose.hpp"
 #include "idlib/math/generator.hpp"
 #include "idlib/math/identity.hpp"
@@ -47,19 +53,28 @@
 #include "idlib/math/is_enclosing.hpp"
 #include "idlib/math/is_intersecting.hpp"
 #include "idlib/math/look_at_matrix.hpp"
+#include "idlib/math/lu_decomposition.hpp"
 #include "idlib/math/matrix.hpp"
 #include "idlib/math/operators.hpp"
 #include "idlib/math/orthographic_projection_matrix.hpp"
+#include "idlib/math/parallel.hpp"
 #include "idlib/math/perspective_projection_matrix.hpp"
 #include "idlib/math/point.hpp"
+#include "idlib/math/quaternion.hpp"
+#include "idlib/math/qr_decomposition.hpp"
+#include "idlib/math/reduce.hpp"
 #include "idlib/math/rotation_matrix.hpp"
 #include "idlib/math/scaling_matrix.hpp"
+#include "idlib/math/sincos.hpp"
 #include "idlib/math/trace.hpp"
+#include "idlib/math/transform.hpp"
 #include "idlib/math/transpose.hpp"
 #include "idlib/math/translate.hpp"
 #include "idlib/math/translation_matrix.hpp"
+#include "idlib/math/uninitialized.hpp"
 #include "idlib/math/angle_units.hpp"
 #include "idlib/math/vector.hpp"
+#include "idlib/math/vector_batch.hpp"
 #include "idlib/math/vector-rejection-projection.hpp"
 
 #undef IDLIB_PRIVATE
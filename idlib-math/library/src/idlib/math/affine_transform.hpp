@@ -0,0 +1,409 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/affine_transform.hpp
+/// @brief Affine transformations of the three-dimensional Euclidean space.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/arithmetic_functor.hpp"
+#include "idlib/math/identity.hpp"
+#include "idlib/math/inverse.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/point.hpp"
+#include "idlib/math/simd_matrix.hpp"
+#include "idlib/math/uninitialized.hpp"
+#include "idlib/math/vector.hpp"
+#include "idlib/semantic_cast.hpp"
+#include <stdexcept>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief An affine transformation \f$x \mapsto A x + t\f$ of the three-dimensional Euclidean space
+/// with a \f$3 \times 3\f$ matrix \f$A\f$, the linear part, and a vector \f$t\f$, the translation.
+/// @remark The transformation is stored as the \f$3 \times 4\f$ matrix \f$\begin{pmatrix} A & t \end{pmatrix}\f$ in row-major order.
+/// The last row \f$(0, 0, 0, 1)\f$ of the corresponding \f$4 \times 4\f$ matrix is implicit.
+/// Hence a transformation stores \f$12\f$ instead of \f$16\f$ scalars,
+/// and composition and inversion skip the operations on the last row.
+/// If the linear part is orthonormal (that is, the transformation is a rotation followed by a translation),
+/// orthonormal_inverse() computes the inverse by a transpose.
+/// @remark An affine transformation is converted into a \f$4 \times 4\f$ matrix and vice versa by idlib::semantic_cast.
+/// @code
+/// idlib::affine_transform<single> a(idlib::identity<idlib::matrix<single, 3, 3>>(), t), b = ...;
+/// auto c = a * b;                     // composition: first b, then a
+/// auto p = c * q;                     // transform a point or a vector
+/// auto m = idlib::semantic_cast<idlib::matrix<single, 4, 4>>(c);
+/// @endcode
+/// @tparam Scalar the scalar type
+template <typename Scalar>
+struct affine_transform
+{
+public:
+    /// @brief The scalar type.
+    using scalar_type = Scalar;
+
+    /// @brief The vector type.
+    using vector_type = vector<scalar_type, 3>;
+
+    /// @brief The point type.
+    using point_type = point<vector_type>;
+
+    /// @brief The type of the linear part.
+    using linear_type = matrix<scalar_type, 3, 3>;
+
+    /// @brief The type of this template/template specialization.
+    using transform_type = affine_transform<scalar_type>;
+
+    /// @brief Get the number of stored elements.
+    /// @return the number of stored elements
+    static constexpr size_t number_of_elements()
+    { return 12; }
+
+    /// @brief Construct this transformation with the identity transformation.
+    constexpr affine_transform()
+        : m_elements{}
+    {
+        for (size_t i = 0; i < 3; ++i)
+        { at(i, i) = one<scalar_type>(); }
+    }
+
+    /// @brief Construct this transformation with the specified linear part and the specified translation.
+    /// @param linear the linear part
+    /// @param translation the translation
+    constexpr affine_transform(const linear_type& linear, const vector_type& translation)
+        : m_elements{}
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            { at(i, j) = linear(i, j); }
+            at(i, 3) = translation[i];
+        }
+    }
+
+    /// @brief Construct this transformation without initializing its element values.
+    explicit affine_transform(uninitialized_t)
+    {}
+
+    constexpr affine_transform(const transform_type& other) = default;
+
+    constexpr transform_type& operator=(const transform_type& other) = default;
+
+public:
+    /// @{
+    /// @brief Get the element at the specified index of the \f$3 \times 4\f$ matrix.
+    /// @param i the row index. Must be within the bounds of \f$[0,3)\f$.
+    /// @param j the column index. Must be within the bounds of \f$[0,4)\f$.
+    /// @return a reference to the element
+    constexpr scalar_type& at(size_t i, size_t j)
+    { return m_elements[i * 4 + j]; }
+
+    constexpr const scalar_type& at(size_t i, size_t j) const
+    { return m_elements[i * 4 + j]; }
+
+    constexpr scalar_type& operator()(size_t i, size_t j)
+    { return at(i, j); }
+
+    constexpr const scalar_type& operator()(size_t i, size_t j) const
+    { return at(i, j); }
+    /// @}
+
+    /// @{
+    /// @brief Get the element at the specified index of the \f$3 \times 4\f$ matrix in row-major order.
+    /// @param i the index. Must be within the bounds of \f$[0,12)\f$.
+    /// @return a reference to the element
+    constexpr scalar_type& operator()(size_t i)
+    { return m_elements[i]; }
+
+    constexpr const scalar_type& operator()(size_t i) const
+    { return m_elements[i]; }
+    /// @}
+
+    /// @brief Get the linear part.
+    /// @return the linear part
+    constexpr linear_type linear() const
+    {
+        linear_type linear;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            { linear(i, j) = at(i, j); }
+        }
+        return linear;
+    }
+
+    /// @brief Get the translation.
+    /// @return the translation
+    constexpr vector_type translation() const
+    { return vector_type(at(0, 3), at(1, 3), at(2, 3)); }
+
+    constexpr bool operator==(const transform_type& other) const
+    {
+        for (size_t i = 0; i < number_of_elements(); ++i)
+        {
+            if (m_elements[i] != other.m_elements[i])
+            { return false; }
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const transform_type& other) const
+    { return !(*this == other); }
+
+    /// @brief Compose this transformation with another transformation.
+    /// @param other the other transformation
+    /// @return this transformation
+    /// @post This transformation is the composition <c>*this * other</c>, that is @a other is applied first.
+    constexpr transform_type& operator*=(const transform_type& other)
+    {
+        *this = arithmetic_binary_star_functor<transform_type, transform_type>()(*this, other);
+        return *this;
+    }
+
+    /// @brief Compute the inverse of this transformation.
+    /// @return the inverse of this transformation
+    /// @throw std::domain_error the determinant of the linear part is zero
+    constexpr transform_type inverse() const
+    {
+        return internal::is_constant_evaluated()
+             ? inverse(std::false_type{})
+             : inverse(std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this transformation using the SIMD code path.
+    template <typename S = scalar_type, typename = std::enable_if_t<internal::simd_matrix4<S>::is_enabled()>>
+    transform_type inverse(std::true_type) const
+    {
+        transform_type result(uninitialized);
+        if (!simd_type::affine_inverse3x4(m_elements, result.m_elements))
+        {
+            throw std::domain_error("Cannot inverse transformation with 0 determinant");
+        }
+        return result;
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this transformation using the scalar code path.
+    constexpr transform_type inverse(std::false_type) const
+    {
+        transform_type result;
+        // The adjugate of the linear part.
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                result.at(j, i) = at(i1, j1) * at(i2, j2) - at(i1, j2) * at(i2, j1);
+            }
+        }
+        const scalar_type det = at(0, 0) * result.at(0, 0) + at(0, 1) * result.at(1, 0) + at(0, 2) * result.at(2, 0);
+        if (det == zero<scalar_type>())
+        {
+            throw std::domain_error("Cannot inverse transformation with 0 determinant");
+        }
+        const scalar_type f = one<scalar_type>() / det;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            { result.at(i, j) *= f; }
+        }
+        result.set_inverse_translation(*this);
+        return result;
+    }
+
+    /// @brief Compute the inverse of this transformation if its linear part is orthonormal.
+    /// @return the inverse of this transformation
+    /// @pre The linear part is orthonormal, that is its inverse is its transpose.
+    /// Transformations composed of rotations and translations satisfy this precondition.
+    /// @remark The inverse of \f$x \mapsto A x + t\f$ is \f$x \mapsto A^T x - A^T t\f$.
+    constexpr transform_type orthonormal_inverse() const
+    {
+        return internal::is_constant_evaluated()
+             ? orthonormal_inverse(std::false_type{})
+             : orthonormal_inverse(std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this transformation using the SIMD code path if its linear part is orthonormal.
+    template <typename S = scalar_type, typename = std::enable_if_t<internal::simd_matrix4<S>::is_enabled()>>
+    transform_type orthonormal_inverse(std::true_type) const
+    {
+        transform_type result(uninitialized);
+        simd_type::orthonormal_inverse3x4(m_elements, result.m_elements);
+        return result;
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this transformation using the scalar code path if its linear part is orthonormal.
+    constexpr transform_type orthonormal_inverse(std::false_type) const
+    {
+        transform_type result;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            { result.at(i, j) = at(j, i); }
+        }
+        result.set_inverse_translation(*this);
+        return result;
+    }
+
+private:
+    /// @brief The kernels.
+    using simd_type = internal::simd_matrix4<scalar_type>;
+
+    /// @brief Set the translation of this transformation, the inverse of the specified transformation, to \f$-A^{-1}t\f$
+    /// where \f$A^{-1}\f$ is the linear part of this transformation and \f$t\f$ is the translation of the specified transformation.
+    constexpr void set_inverse_translation(const transform_type& other)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        { at(i, 3) = -(at(i, 0) * other.at(0, 3) + at(i, 1) * other.at(1, 3) + at(i, 2) * other.at(2, 3)); }
+    }
+
+    /// @brief The elements of the \f$3 \times 4\f$ matrix in row-major order.
+    scalar_type m_elements[12];
+
+}; // struct affine_transform
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor composing two affine transformations.
+/// The product \f$a b\f$ applies \f$b\f$ first and \f$a\f$ second.
+template <typename Scalar>
+struct arithmetic_binary_star_functor<affine_transform<Scalar>, affine_transform<Scalar>, void>
+{
+    using transform_type = affine_transform<Scalar>;
+    using simd_type = internal::simd_matrix4<Scalar>;
+
+    constexpr transform_type operator()(const transform_type& a, const transform_type& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::false_type{})
+             : impl(a, b, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the composition using the SIMD code path.
+    template <typename S = Scalar, typename = std::enable_if_t<internal::simd_matrix4<S>::is_enabled()>>
+    transform_type impl(const transform_type& a, const transform_type& b, std::true_type) const
+    {
+        transform_type c(uninitialized);
+        simd_type::mul3x4(&(a(0)), &(b(0)), &(c(0)));
+        return c;
+    }
+
+    /// @internal
+    /// @brief Compute the composition using the scalar code path.
+    constexpr transform_type impl(const transform_type& a, const transform_type& b, std::false_type) const
+    {
+        transform_type c;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            { c(i, j) = a(i, 0) * b(0, j) + a(i, 1) * b(1, j) + a(i, 2) * b(2, j); }
+            c(i, 3) += a(i, 3);
+        }
+        return c;
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor applying an affine transformation to a point.
+template <typename Scalar>
+struct arithmetic_binary_star_functor<affine_transform<Scalar>, point<vector<Scalar, 3>>, void>
+{
+    using transform_type = affine_transform<Scalar>;
+    using point_type = point<vector<Scalar, 3>>;
+
+    constexpr point_type operator()(const transform_type& a, const point_type& p) const
+    {
+        return point_type(a(0, 0) * p[0] + a(0, 1) * p[1] + a(0, 2) * p[2] + a(0, 3),
+                          a(1, 0) * p[0] + a(1, 1) * p[1] + a(1, 2) * p[2] + a(1, 3),
+                          a(2, 0) * p[0] + a(2, 1) * p[1] + a(2, 2) * p[2] + a(2, 3));
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor applying an affine transformation to a vector.
+/// The translation is not applied to vectors.
+template <typename Scalar>
+struct arithmetic_binary_star_functor<affine_transform<Scalar>, vector<Scalar, 3>, void>
+{
+    using transform_type = affine_transform<Scalar>;
+    using vector_type = vector<Scalar, 3>;
+
+    constexpr vector_type operator()(const transform_type& a, const vector_type& v) const
+    {
+        return vector_type(a(0, 0) * v[0] + a(0, 1) * v[1] + a(0, 2) * v[2],
+                           a(1, 0) * v[0] + a(1, 1) * v[1] + a(1, 2) * v[2],
+                           a(2, 0) * v[0] + a(2, 1) * v[1] + a(2, 2) * v[2]);
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::identity_functor returning the identity transformation.
+template <typename Scalar>
+struct identity_functor<affine_transform<Scalar>, void>
+{
+    constexpr affine_transform<Scalar> operator()() const
+    { return affine_transform<Scalar>(); }
+}; // struct identity_functor
+
+/// @brief Specialization of idlib::inverse_functor returning the inverse of an affine transformation.
+/// @throw std::domain_error the determinant of the linear part of the transformation is zero
+template <typename Scalar>
+struct inverse_functor<affine_transform<Scalar>, void>
+{
+    constexpr affine_transform<Scalar> operator()(const affine_transform<Scalar>& a) const
+    { return a.inverse(); }
+}; // struct inverse_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting an affine transformation into a \f$4 \times 4\f$ matrix.
+template <typename Scalar>
+struct semantic_cast_functor<matrix<Scalar, 4, 4>, affine_transform<Scalar>, void>
+{
+    constexpr matrix<Scalar, 4, 4> operator()(const affine_transform<Scalar>& a) const
+    {
+        matrix<Scalar, 4, 4> m;
+        for (size_t i = 0; i < affine_transform<Scalar>::number_of_elements(); ++i)
+        { m(i) = a(i); }
+        m(3, 3) = one<Scalar>();
+        return m;
+    }
+}; // struct semantic_cast_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting a \f$4 \times 4\f$ matrix into an affine transformation.
+/// The last row of the matrix is not read, it is assumed to be \f$(0, 0, 0, 1)\f$.
+template <typename Scalar>
+struct semantic_cast_functor<affine_transform<Scalar>, matrix<Scalar, 4, 4>, void>
+{
+    constexpr affine_transform<Scalar> operator()(const matrix<Scalar, 4, 4>& m) const
+    {
+        affine_transform<Scalar> a;
+        for (size_t i = 0; i < affine_transform<Scalar>::number_of_elements(); ++i)
+        { a(i) = m(i); }
+        return a;
+    }
+}; // struct semantic_cast_functor
+
+} // namespace idlib
@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/aligned.hpp
+/// @brief Aligned and padded storage layouts of vectors, points, and matrices.
+/// @author Michael Heilmann
+
+/// @detail
+/// The elements of idlib::vector, idlib::point, and idlib::matrix are tightly packed and aligned to their scalar type.
+/// An idlib::vector<single, 3>, for example, occupies 12 bytes. In an array such a vector may straddle a cache line
+/// and it can not be loaded into a SIMD register by an aligned load.
+///
+/// idlib::aligned<T, Alignment> stores the elements of a value of type @a T in an array aligned to @a Alignment bytes.
+/// The array is padded with zero elements to a multiple of @a Alignment bytes. The layout of @a T remains unchanged,
+/// values are converted explicitly between both layouts:
+/// @code
+/// idlib::vector<single, 3> v(1.0f, 2.0f, 3.0f);
+/// idlib::padded_vector<single, 3> w(v); // 16 bytes, aligned to 16 bytes, w(3) is 0.
+/// idlib::vector<single, 3> u(w);       // (1, 2, 3)
+/// @endcode
+/// Aligned vectors provide addition, subtraction, negation, multiplication by a scalar, the dot product, and the
+/// squared Euclidean norm. These operations use aligned loads and stores of full SIMD registers.
+
+#pragma once
+
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/point.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/math/uninitialized.hpp"
+#include "idlib/math/vector.hpp"
+#include <utility>
+
+namespace idlib {
+
+/// @brief Traits of types which can be stored in an aligned layout.
+/// Specializations provide
+/// - a member type @a scalar_type, the scalar type, and
+/// - a static constant member function @a length() returning the number of scalars.
+/// The scalars of a value @a x of the type are accessed by <c>x(i)</c> with \f$i \in [0,length())\f$.
+/// A value of the type is constructible from its scalars.
+/// @tparam T the type
+template <typename T>
+struct aligned_traits;
+
+template <typename Scalar, size_t Dimensionality>
+struct aligned_traits<vector<Scalar, Dimensionality>>
+{
+    using scalar_type = Scalar;
+    static constexpr size_t length() { return Dimensionality; }
+};
+
+template <typename Vector>
+struct aligned_traits<point<Vector>>
+{
+    using scalar_type = typename Vector::scalar_type;
+    static constexpr size_t length() { return Vector::dimensionality(); }
+};
+
+template <typename Element, size_t Number_Of_Rows, size_t Number_Of_Columns>
+struct aligned_traits<matrix<Element, Number_Of_Rows, Number_Of_Columns>>
+{
+    using scalar_type = Element;
+    static constexpr size_t length() { return Number_Of_Rows * Number_Of_Columns; }
+};
+
+/// @ingroup math
+/// @brief A value of type @a T stored in an array aligned to @a Alignment bytes.
+/// The array is padded with zero scalars to a multiple of @a Alignment bytes.
+/// @tparam T the type of the value
+/// @tparam Alignment the alignment, in bytes. Must be a power of two and a multiple of the size of the scalar type.
+template <typename T, size_t Alignment>
+struct alignas(Alignment) aligned
+{
+public:
+    /// @brief The type of the value.
+    using value_type = T;
+
+    /// @brief The scalar type.
+    using scalar_type = typename aligned_traits<value_type>::scalar_type;
+
+    /// @brief The type of this template/template specialization.
+    using aligned_type = aligned<value_type, Alignment>;
+
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(Alignment % sizeof(scalar_type) == 0, "alignment must be a multiple of the size of the scalar type");
+
+    /// @brief Get the alignment.
+    /// @return the alignment, in bytes
+    static constexpr size_t alignment()
+    { return Alignment; }
+
+    /// @brief Get the number of scalars of the value.
+    /// @return the number of scalars
+    static constexpr size_t length()
+    { return aligned_traits<value_type>::length(); }
+
+    /// @brief Get the number of scalars including the padding.
+    /// @return the number of scalars including the padding
+    static constexpr size_t padded_length()
+    { return ((length() * sizeof(scalar_type) + Alignment - 1) / Alignment) * Alignment / sizeof(scalar_type); }
+
+    /// @internal
+    /// @brief The scalars followed by the padding.
+    scalar_type m_elements[padded_length()];
+
+    /// @brief Default-construct this aligned value.
+    /// All scalars are zero.
+    constexpr aligned()
+        : m_elements{}
+    {}
+
+    /// @brief Construct this aligned value without initializing the scalars of the value.
+    /// The padding is zero.
+    explicit aligned(uninitialized_t)
+    {
+        for (size_t i = length(); i < padded_length(); ++i)
+        { m_elements[i] = scalar_type(0); }
+    }
+
+    /// @brief Construct this aligned value from a value.
+    /// @param value the value
+    explicit constexpr aligned(const value_type& value)
+        : aligned(value, std::make_index_sequence<length()>{})
+    {}
+
+    /// @brief Convert this aligned value into a value.
+    /// @return the value
+    explicit constexpr operator value_type() const
+    { return get(std::make_index_sequence<length()>{}); }
+
+    /// @brief Get the value.
+    /// @return the value
+    constexpr value_type get() const
+    { return get(std::make_index_sequence<length()>{}); }
+
+    /// @brief Assign a value to this aligned value.
+    /// @param value the value
+    constexpr void set(const value_type& value)
+    {
+        for (size_t i = 0; i < length(); ++i)
+        { m_elements[i] = value(i); }
+    }
+
+    /// @{
+    /// @brief Get the scalar at the specified index.
+    /// @param index the index
+    /// @return the scalar
+    constexpr scalar_type& operator()(size_t index)
+    { return m_elements[index]; }
+
+    constexpr const scalar_type& operator()(size_t index) const
+    { return m_elements[index]; }
+
+    constexpr scalar_type& operator[](size_t index)
+    { return m_elements[index]; }
+
+    constexpr const scalar_type& operator[](size_t index) const
+    { return m_elements[index]; }
+    /// @}
+
+    /// @{
+    /// @brief Get a pointer to the scalars.
+    /// @return a pointer to the scalars, aligned to alignment() bytes
+    scalar_type *data()
+    { return m_elements; }
+
+    const scalar_type *data() const
+    { return m_elements; }
+    /// @}
+
+    /// @{
+    /// @brief Compare the values of two aligned values.
+    constexpr bool operator==(const aligned_type& other) const
+    {
+        for (size_t i = 0; i < length(); ++i)
+        {
+            if (m_elements[i] != other.m_elements[i]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const aligned_type& other) const
+    { return !(*this == other); }
+    /// @}
+
+private:
+    template <size_t...Is>
+    constexpr aligned(const value_type& value, std::index_sequence<Is...>)
+        : m_elements{ value(Is)... }
+    {}
+
+    template <size_t...Is>
+    constexpr value_type get(std::index_sequence<Is...>) const
+    { return value_type(m_elements[Is]...); }
+
+}; // struct aligned
+
+namespace internal {
+
+/// @internal
+/// @brief Get the smallest power of two greater than or equal to a value.
+constexpr size_t ceil_power_of_two(size_t x, size_t y = 1)
+{ return y >= x ? y : ceil_power_of_two(x, 2 * y); }
+
+} // namespace internal
+
+/// @brief An idlib::vector padded with zero scalars to the next power of two of its size in bytes.
+/// For example, idlib::padded_vector<single, 3> occupies 16 bytes and is aligned to 16 bytes.
+template <typename Scalar, size_t Dimensionality>
+using padded_vector = aligned<vector<Scalar, Dimensionality>, internal::ceil_power_of_two(Dimensionality * sizeof(Scalar))>;
+
+/// @brief An idlib::point padded with zero scalars to the next power of two of its size in bytes.
+template <typename Vector>
+using padded_point = aligned<point<Vector>, internal::ceil_power_of_two(Vector::dimensionality() * sizeof(typename Vector::scalar_type))>;
+
+namespace internal {
+
+/// @internal
+/// @brief Kernels for aligned vectors.
+/// The kernels operate on all scalars including the padding using aligned loads and stores.
+/// The operations preserve zero such that the padding remains zero.
+/// @remark The pack is the scalar pack if no SIMD instruction set is selected or the alignment is too small.
+template <typename Scalar, size_t Padded_Length, size_t Alignment>
+struct aligned_kernels
+{
+    using scalar_type = Scalar;
+    using pack_type = simd_pack<scalar_type, simd_aligned_width<scalar_type, Alignment>::value>;
+    using register_type = typename pack_type::register_type;
+
+    static_assert(Padded_Length % pack_type::width() == 0, "padded length must be a multiple of the width of the pack");
+
+    static void add(const scalar_type *x, const scalar_type *y, scalar_type *z)
+    {
+        for (size_t i = 0; i < Padded_Length; i += pack_type::width())
+        { pack_type::store_aligned(z + i, pack_type::add(pack_type::load_aligned(x + i), pack_type::load_aligned(y + i))); }
+    }
+
+    static void sub(const scalar_type *x, const scalar_type *y, scalar_type *z)
+    {
+        for (size_t i = 0; i < Padded_Length; i += pack_type::width())
+        { pack_type::store_aligned(z + i, pack_type::sub(pack_type::load_aligned(x + i), pack_type::load_aligned(y + i))); }
+    }
+
+    static void mul(const scalar_type *x, scalar_type y, scalar_type *z)
+    {
+        const register_type b = pack_type::broadcast(y);
+        for (size_t i = 0; i < Padded_Length; i += pack_type::width())
+        { pack_type::store_aligned(z + i, pack_type::mul(pack_type::load_aligned(x + i), b)); }
+    }
+
+    static void neg(const scalar_type *x, scalar_type *z)
+    {
+        for (size_t i = 0; i < Padded_Length; i += pack_type::width())
+        { pack_type::store_aligned(z + i, pack_type::neg(pack_type::load_aligned(x + i))); }
+    }
+
+    static scalar_type dot(const scalar_type *x, const scalar_type *y)
+    {
+        register_type s = pack_type::mul(pack_type::load_aligned(x), pack_type::load_aligned(y));
+        for (size_t i = pack_type::width(); i < Padded_Length; i += pack_type::width())
+        { s = pack_type::add(s, pack_type::mul(pack_type::load_aligned(x + i), pack_type::load_aligned(y + i))); }
+        return pack_type::sum(s);
+    }
+};
+
+/// @internal
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+using aligned_vector_kernels = aligned_kernels<Scalar, aligned<vector<Scalar, Dimensionality>, Alignment>::padded_length(), Alignment>;
+
+} // namespace internal
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+struct dot_product_functor<aligned<vector<Scalar, Dimensionality>, Alignment>>
+{
+    using vector_type = aligned<vector<Scalar, Dimensionality>, Alignment>;
+
+    Scalar operator()(const vector_type& v, const vector_type& w) const
+    { return internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::dot(v.data(), w.data()); }
+
+}; // struct dot_product_functor
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+struct squared_euclidean_norm_functor<aligned<vector<Scalar, Dimensionality>, Alignment>>
+{
+    using vector_type = aligned<vector<Scalar, Dimensionality>, Alignment>;
+
+    Scalar operator()(const vector_type& v) const
+    { return internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::dot(v.data(), v.data()); }
+
+}; // struct squared_euclidean_norm_functor
+
+/// @{
+/// @brief Arithmetic operators for aligned vectors.
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment>& operator+=(aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                               const aligned<vector<Scalar, Dimensionality>, Alignment>& w)
+{
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::add(v.data(), w.data(), v.data());
+    return v;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment>& operator-=(aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                               const aligned<vector<Scalar, Dimensionality>, Alignment>& w)
+{
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::sub(v.data(), w.data(), v.data());
+    return v;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment>& operator*=(aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                               const Scalar& s)
+{
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::mul(v.data(), s, v.data());
+    return v;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment> operator+(const aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                             const aligned<vector<Scalar, Dimensionality>, Alignment>& w)
+{
+    aligned<vector<Scalar, Dimensionality>, Alignment> u(uninitialized);
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::add(v.data(), w.data(), u.data());
+    return u;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment> operator-(const aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                             const aligned<vector<Scalar, Dimensionality>, Alignment>& w)
+{
+    aligned<vector<Scalar, Dimensionality>, Alignment> u(uninitialized);
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::sub(v.data(), w.data(), u.data());
+    return u;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment> operator-(const aligned<vector<Scalar, Dimensionality>, Alignment>& v)
+{
+    aligned<vector<Scalar, Dimensionality>, Alignment> u(uninitialized);
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::neg(v.data(), u.data());
+    return u;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment> operator*(const aligned<vector<Scalar, Dimensionality>, Alignment>& v,
+                                                             const Scalar& s)
+{
+    aligned<vector<Scalar, Dimensionality>, Alignment> u(uninitialized);
+    internal::aligned_vector_kernels<Scalar, Dimensionality, Alignment>::mul(v.data(), s, u.data());
+    return u;
+}
+
+template <typename Scalar, size_t Dimensionality, size_t Alignment>
+aligned<vector<Scalar, Dimensionality>, Alignment> operator*(const Scalar& s,
+                                                             const aligned<vector<Scalar, Dimensionality>, Alignment>& v)
+{ return v * s; }
+/// @}
+
+} // namespace idlib
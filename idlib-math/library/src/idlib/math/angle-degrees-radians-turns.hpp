@@ -105,7 +105,7 @@ struct convert<T, idlib::turns,
                T, std::enable_if_t<std::is_floating_point<T>::value, idlib::radians>>
 {
     T operator()(T x) const
-    { return x * idlib::inv_two_pi<float>(); }
+    { return x * idlib::inv_two_pi<T>(); }
 }; // struct convert
 
 /// The conversion of an angle \f$\alpha\f$ in turns into an equivalent angle
@@ -115,7 +115,7 @@ struct convert<T, idlib::radians,
                T, std::enable_if_t<std::is_floating_point<T>::value, idlib::turns>>
 {
     T operator()(T x) const
-    { return x * idlib::two_pi<float>(); }
+    { return x * idlib::two_pi<T>(); }
 }; // struct convert
 
 } // namespace internal
@@ -27,6 +27,8 @@
 #include "idlib/utility/fold_expressions.hpp"
 #include "idlib/math/arithmetic_functor.hpp"
 #include "idlib/math/operators.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/math/uninitialized.hpp"
 #include "idlib/numeric.hpp"
 #include "idlib/bool_pack.hpp"
 #include <algorithm>
@@ -78,8 +80,13 @@ struct arithmetic_array_1d
 	{ return length(); }
 
 	/// @brief Default construct with the zero element value.
-	arithmetic_array_1d()
-	{ std::fill_n(&(m_elements[0]), number_of_elements(), zero_type()()); }
+	constexpr arithmetic_array_1d()
+		: arithmetic_array_1d(zero_type()(), std::make_index_sequence<Length>{})
+	{}
+
+	/// @brief Construct without initializing the element values.
+	explicit arithmetic_array_1d(uninitialized_t)
+	{}
 	
 	/// @brief Construct this tuple with the specified element values.
 	/// @param first, ... rest the element values
@@ -88,7 +95,7 @@ struct arithmetic_array_1d
              typename = std::enable_if_t<((1 + sizeof...(Xs)) == number_of_elements()) &&
 									      (all_true<std::is_convertible<typename std::decay<X>::type, element_type>::value>::value &&
                                            all_true<std::is_convertible<typename std::decay<Xs>::type, element_type>::value ...>::value)>>
-	arithmetic_array_1d(X&& x, Xs&& ... xs) :
+	constexpr arithmetic_array_1d(X&& x, Xs&& ... xs) :
         m_elements{ static_cast<element_type>(x), static_cast<element_type>(xs) ... }
     { static_assert(number_of_elements() == 1 + sizeof ... (xs), "wrong number of arguments"); }
 
@@ -100,45 +107,83 @@ struct arithmetic_array_1d
 	
 	arithmetic_array_1d& operator=(arithmetic_array_1d&& other) = default;
 
-	arithmetic_array_1d& operator += (const arithmetic_array_1d& other)
-	{ (*this) = (*this) + other; return *this; }
+	/// @{
+	/// @brief Compound assignment operators.
+	/// @remark The elements of this array are modified in place, no temporary array is created.
+	constexpr arithmetic_array_1d& operator += (const arithmetic_array_1d& other)
+	{ internal::is_constant_evaluated() ? add(other, std::false_type{}) : add(other, simd_enabled_type{}); return *this; }
 
-	arithmetic_array_1d& operator -= (const arithmetic_array_1d& other)
-	{ (*this) = (*this) - other; return *this; }
+	constexpr arithmetic_array_1d& operator -= (const arithmetic_array_1d& other)
+	{ internal::is_constant_evaluated() ? subtract(other, std::false_type{}) : subtract(other, simd_enabled_type{}); return *this; }
 
-	arithmetic_array_1d& operator *= (const element_type& other)
-	{ (*this) = (*this) * other; return *this; }
+	constexpr arithmetic_array_1d& operator *= (const element_type& other)
+	{ internal::is_constant_evaluated() ? multiply(other, std::false_type{}) : multiply(other, simd_enabled_type{}); return *this; }
 
-	arithmetic_array_1d& operator /= (const element_type& other)
-	{ (*this) = (*this) / other; return *this; }
+	constexpr arithmetic_array_1d& operator /= (const element_type& other)
+	{ internal::is_constant_evaluated() ? divide(other, std::false_type{}) : divide(other, simd_enabled_type{}); return *this; }
+	/// @}
 
 	/// @{
 	/// @brief Get the array element at the specified index.
 	/// @param i the index
 	/// @return the array element at the specified index
 	/// @pre The index is within bounds.
-	element_type& at(size_t i)
+	constexpr element_type& at(size_t i)
 	{ return m_elements[i]; }
 
-	element_type& operator()(size_t i)
+	constexpr element_type& operator()(size_t i)
 	{ return m_elements[i]; }
 
-	const element_type& at(size_t i) const
+	constexpr const element_type& at(size_t i) const
 	{ return m_elements[i]; }
 
-	const element_type& operator()(size_t i) const
+	constexpr const element_type& operator()(size_t i) const
 	{ return m_elements[i]; }
 	/// @}
 
 	template <typename G>
-	static arithmetic_array_1d generate(const G& g)
+	static constexpr arithmetic_array_1d generate(const G& g)
 	{ return generate(g, std::make_index_sequence<number_of_elements()>{}); }
 	
 private:
 	template <typename G, size_t...Is>
-	static arithmetic_array_1d generate(const G& g, std::index_sequence<Is...>)
+	static constexpr arithmetic_array_1d generate(const G& g, std::index_sequence<Is...>)
 	{ return arithmetic_array_1d((g(Is))...); }
 
+	/// @brief Construct with the specified element value for all elements.
+	template <size_t...Is>
+	constexpr arithmetic_array_1d(const element_type& x, std::index_sequence<Is...>)
+		: m_elements{ ((void)Is, x)... }
+	{}
+
+	using simd_type = internal::simd_array<element_type, Length>;
+
+	using simd_enabled_type = std::integral_constant<bool, simd_type::is_enabled()>;
+
+	void add(const arithmetic_array_1d& other, std::true_type)
+	{ simd_type::add(m_elements, other.m_elements, m_elements); }
+
+	constexpr void add(const arithmetic_array_1d& other, std::false_type)
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements[i] += other.m_elements[i]; }
+
+	void subtract(const arithmetic_array_1d& other, std::true_type)
+	{ simd_type::sub(m_elements, other.m_elements, m_elements); }
+
+	constexpr void subtract(const arithmetic_array_1d& other, std::false_type)
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements[i] -= other.m_elements[i]; }
+
+	void multiply(const element_type& other, std::true_type)
+	{ simd_type::mul(m_elements, other, m_elements); }
+
+	constexpr void multiply(const element_type& other, std::false_type)
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements[i] *= other; }
+
+	void divide(const element_type& other, std::true_type)
+	{ simd_type::div(m_elements, other, m_elements); }
+
+	constexpr void divide(const element_type& other, std::false_type)
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements[i] /= other; }
+
 	/// @brief The elements.
 	element_type m_elements[number_of_elements()];
 	
@@ -151,13 +196,27 @@ struct arithmetic_binary_star_functor<arithmetic_array_1d<Element, Length, Zero>
     using B = Element;
     using A = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const A& a, const B& b) const
-    { return impl(a, b, std::make_index_sequence<Length>{}); }
+    using simd_type = internal::simd_array<Element, Length>;
+
+    constexpr auto operator()(const A& a, const B& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::make_index_sequence<Length>{}, std::false_type{})
+             : impl(a, b, std::make_index_sequence<Length>{}, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 
 private:
-   template <size_t ... Is>
-    auto impl(const A& a, const B& b, std::index_sequence<Is...>) const
+    template <size_t ... Is>
+    constexpr auto impl(const A& a, const B& b, std::index_sequence<Is...>, std::false_type) const
     { return A((a(Is) * b)...); }
+
+    template <size_t ... Is>
+    auto impl(const A& a, const B& b, std::index_sequence<Is...>, std::true_type) const
+    {
+        Element t[Length];
+        simd_type::mul(&(a(0)), b, t);
+        return A(t[Is]...);
+    }
 };
 
 template <typename Element, size_t Length, typename Zero>
@@ -167,13 +226,27 @@ struct arithmetic_binary_slash_functor<arithmetic_array_1d<Element, Length, Zero
     using B = Element;
     using A = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const A& a, const B& b) const
-    { return impl(a, b, std::make_index_sequence<Length>{}); }
+    using simd_type = internal::simd_array<Element, Length>;
+
+    constexpr auto operator()(const A& a, const B& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::make_index_sequence<Length>{}, std::false_type{})
+             : impl(a, b, std::make_index_sequence<Length>{}, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 	
 private:
     template <size_t ... Is>
-    auto impl(const A& a, const B& b, std::index_sequence<Is...>) const
+    constexpr auto impl(const A& a, const B& b, std::index_sequence<Is...>, std::false_type) const
     { return A((a(Is) / b)...); }
+
+    template <size_t ... Is>
+    auto impl(const A& a, const B& b, std::index_sequence<Is...>, std::true_type) const
+    {
+        Element t[Length];
+        simd_type::div(&(a(0)), b, t);
+        return A(t[Is]...);
+    }
 };
 
 template <typename Element, size_t Length, typename Zero>
@@ -181,13 +254,27 @@ struct arithmetic_binary_plus_functor<arithmetic_array_1d<Element, Length, Zero>
 {
     using T = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const T& a, const T& b) const
-    { return impl(a, b, std::make_index_sequence<Length>{}); }
+    using simd_type = internal::simd_array<Element, Length>;
+
+    constexpr auto operator()(const T& a, const T& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::make_index_sequence<Length>{}, std::false_type{})
+             : impl(a, b, std::make_index_sequence<Length>{}, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 	
 private:
     template <size_t ... Is>
-    auto impl(const T& a, const T& b, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, const T& b, std::index_sequence<Is...>, std::false_type) const
     { return T((a(Is) + b(Is))...); }
+
+    template <size_t ... Is>
+    auto impl(const T& a, const T& b, std::index_sequence<Is...>, std::true_type) const
+    {
+        Element t[Length];
+        simd_type::add(&(a(0)), &(b(0)), t);
+        return T(t[Is]...);
+    }
 };
 
 template <typename Element, size_t Length, typename Zero>
@@ -195,13 +282,27 @@ struct arithmetic_binary_minus_functor<arithmetic_array_1d<Element, Length, Zero
 {
     using T = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const T& a, const T& b) const
-    { return impl(a, b, std::make_index_sequence<Length>{}); }
+    using simd_type = internal::simd_array<Element, Length>;
+
+    constexpr auto operator()(const T& a, const T& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::make_index_sequence<Length>{}, std::false_type{})
+             : impl(a, b, std::make_index_sequence<Length>{}, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 	
 private:
     template <size_t ... Is>
-    auto impl(const T& a, const T& b, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, const T& b, std::index_sequence<Is...>, std::false_type) const
     { return T((a(Is) - b(Is))...); }
+
+    template <size_t ... Is>
+    auto impl(const T& a, const T& b, std::index_sequence<Is...>, std::true_type) const
+    {
+        Element t[Length];
+        simd_type::sub(&(a(0)), &(b(0)), t);
+        return T(t[Is]...);
+    }
 };
 
 template <typename Element, size_t Length, typename Zero>
@@ -209,12 +310,12 @@ struct arithmetic_unary_plus_functor<arithmetic_array_1d<Element, Length, Zero>>
 {
     using T = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const T& a) const
+    constexpr auto operator()(const T& a) const
     { return impl(a, std::make_index_sequence<Length>{}); }
 	
 private:
     template <size_t ... Is>
-    auto impl(const T& a, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, std::index_sequence<Is...>) const
     { return T((+(a(Is)))...); }
 };
 
@@ -223,13 +324,27 @@ struct arithmetic_unary_minus_functor<arithmetic_array_1d<Element, Length, Zero>
 {
     using T = arithmetic_array_1d<Element, Length, Zero>;
 
-    auto operator()(const T& a) const
-    { return impl(a, std::make_index_sequence<Length>{}); }
+    using simd_type = internal::simd_array<Element, Length>;
+
+    constexpr auto operator()(const T& a) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, std::make_index_sequence<Length>{}, std::false_type{})
+             : impl(a, std::make_index_sequence<Length>{}, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 	
 private:
     template <size_t ... Is>
-    auto impl(const T& a, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, std::index_sequence<Is...>, std::false_type) const
     { return T((-(a(Is)))...); }
+
+    template <size_t ... Is>
+    auto impl(const T& a, std::index_sequence<Is...>, std::true_type) const
+    {
+        Element t[Length];
+        simd_type::neg(&(a(0)), t);
+        return T(t[Is]...);
+    }
 };
 
 /// @todo When all compilers support it, use real fold expressions.
@@ -239,12 +354,12 @@ struct arithmetic_binary_equal_equal_functor<arithmetic_array_1d<Element, Length
 {
 	using T = arithmetic_array_1d<Element, Length, Zero>;
 	
-	bool operator()(const T& a, const T& b) const
+	constexpr bool operator()(const T& a, const T& b) const
 	{ return impl(a, b, std::make_index_sequence<Length>{}); }
 	
 private:
 	template <size_t...Is>
-	static bool impl(const T& a, const T& b, std::index_sequence<Is...>)
+	static constexpr bool impl(const T& a, const T& b, std::index_sequence<Is...>)
 	{ return and_fold_expr()((a(Is) == b(Is))...); }
 };
 
@@ -313,7 +428,11 @@ struct arithmetic_array_1d<Element, 0, Zero>
     { return length(); }
 
 	/// @brief Default construct this arithmetic tuple.
-	arithmetic_array_1d()
+	constexpr arithmetic_array_1d()
+	{}
+
+	/// @brief Construct this arithmetic tuple.
+	explicit constexpr arithmetic_array_1d(uninitialized_t)
 	{}
 
 	arithmetic_array_1d(const arithmetic_array_1d& other) = default;
@@ -324,20 +443,20 @@ struct arithmetic_array_1d<Element, 0, Zero>
 	
     arithmetic_array_1d& operator=(arithmetic_array_1d&& other) = default;
 
-	arithmetic_array_1d& operator += (const arithmetic_array_1d& other)
+	constexpr arithmetic_array_1d& operator += (const arithmetic_array_1d& other)
 	{ return *this; }
 
-	arithmetic_array_1d& operator -= (const arithmetic_array_1d& other)
+	constexpr arithmetic_array_1d& operator -= (const arithmetic_array_1d& other)
 	{ return *this; }
 
-	arithmetic_array_1d& operator *= (const element_type& other)
+	constexpr arithmetic_array_1d& operator *= (const element_type& other)
 	{ return *this; }
 	
-	arithmetic_array_1d& operator /= (const element_type& other)
+	constexpr arithmetic_array_1d& operator /= (const element_type& other)
 	{ return *this; }
 
 	template <typename G>
-	static arithmetic_array_1d generate(const G& g)
+	static constexpr arithmetic_array_1d generate(const G& g)
 	{ return arithmetic_array_1d(); }
 	
 }; // struct arithmetic_array_1d
@@ -349,7 +468,7 @@ struct arithmetic_binary_star_functor<arithmetic_array_1d<Element, 0, Zero>,
     using B = Element;
     using A = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const A& a, const B& b) const
+    constexpr auto operator()(const A& a, const B& b) const
     { return A(); }
 };
 
@@ -360,7 +479,7 @@ struct arithmetic_binary_slash_functor<arithmetic_array_1d<Element, 0, Zero>,
     using B = Element;
     using A = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const A& a, const B& b) const
+    constexpr auto operator()(const A& a, const B& b) const
     { return A(); }
 };
 
@@ -369,7 +488,7 @@ struct arithmetic_binary_plus_functor<arithmetic_array_1d<Element, 0, Zero>>
 {
     using T = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const T& a, const T& b) const
+    constexpr auto operator()(const T& a, const T& b) const
     { return T(); }
 };
 
@@ -378,7 +497,7 @@ struct arithmetic_binary_minus_functor<arithmetic_array_1d<Element, 0, Zero>>
 {
     using T = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const T& a, const T& b) const
+    constexpr auto operator()(const T& a, const T& b) const
     { return T(); }
 };
 
@@ -387,7 +506,7 @@ struct arithmetic_unary_plus_functor<arithmetic_array_1d<Element, 0, Zero>>
 {
     using T = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const T& a) const
+    constexpr auto operator()(const T& a) const
     { return T(); }
 };
 
@@ -396,7 +515,7 @@ struct arithmetic_unary_minus_functor<arithmetic_array_1d<Element, 0, Zero>>
 {
     using T = arithmetic_array_1d<Element, 0, Zero>;
 
-    auto operator()(const T& a) const
+    constexpr auto operator()(const T& a) const
     { return T(); }
 };
 
@@ -406,7 +525,7 @@ struct arithmetic_binary_equal_equal_functor<arithmetic_array_1d<Element, 0, Zer
 {
 	using T = arithmetic_array_1d<Element, 0, Zero>;
 	
-	bool operator()(const T& a, const T& b) const
+	constexpr bool operator()(const T& a, const T& b) const
 	{ return true; }
 };
 
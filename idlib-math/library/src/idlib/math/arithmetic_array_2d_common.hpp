@@ -25,6 +25,7 @@
 #pragma once
 
 #include "idlib/platform.hpp"
+#include "idlib/math/uninitialized.hpp"
 
 namespace idlib {
 
@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/arithmetic_expression.hpp
+/// @brief Lazy element-wise arithmetic expressions.
+/// @author Michael Heilmann
+
+/// @detail
+/// The operators of idlib::arithmetic_array_1d, idlib::arithmetic_array_2d, idlib::vector, and idlib::matrix are eager:
+/// In <c>a + b * s - c</c> each operator creates a temporary.
+/// idlib::lazy wraps a value into an expression.
+/// Operators on expressions do not compute anything, they build an expression tree instead.
+/// The tree is evaluated element by element in a single loop when it is assigned to a value.
+/// @code
+/// idlib::vector<single, 3> a, b, c, r;
+/// single s;
+/// ...
+/// // Evaluate in a single loop writing to r.
+/// idlib::assign(r, idlib::lazy(a) + idlib::lazy(b) * s - idlib::lazy(c));
+/// // Evaluate in a single loop writing to r.
+/// r += idlib::lazy(b) * s - idlib::lazy(c);
+/// // Evaluate into a new value.
+/// auto t = idlib::evaluate(idlib::lazy(a) + idlib::lazy(b));
+/// @endcode
+/// The element operations are performed by the arithmetic functors of the element type (e.g. idlib::arithmetic_binary_plus_functor<single>).
+/// Expressions hold references to the wrapped values. They must not outlive them.
+/// As all operations are element-wise, the value assigned to may occur in the expression.
+
+#pragma once
+
+#include "idlib/math/arithmetic_array_1d.hpp"
+#include "idlib/math/arithmetic_array_2d.hpp"
+#include "idlib/math/arithmetic_functor.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/vector.hpp"
+#include <type_traits>
+
+namespace idlib {
+
+/// @brief Traits of types which can be wrapped into arithmetic expressions.
+/// Specializations provide
+/// - a member type @a element_type, the element type, and
+/// - a static constant member function @a size() returning the number of elements.
+/// The elements of a value @a x of the type are accessed by <c>x(i)</c> with \f$i \in [0,size())\f$.
+/// @tparam T the type
+template <typename T, typename Enabled = void>
+struct arithmetic_expression_traits;
+
+template <typename Element, size_t Length, typename Zero>
+struct arithmetic_expression_traits<arithmetic_array_1d<Element, Length, Zero>, void>
+{
+    using element_type = Element;
+    static constexpr size_t size() { return Length; }
+};
+
+template <typename Element, size_t Width, size_t Height, typename Zero>
+struct arithmetic_expression_traits<arithmetic_array_2d<Element, Width, Height, Zero>, void>
+{
+    using element_type = Element;
+    static constexpr size_t size() { return Width * Height; }
+};
+
+template <typename Scalar, size_t Dimensionality>
+struct arithmetic_expression_traits<vector<Scalar, Dimensionality>, void>
+{
+    using element_type = Scalar;
+    static constexpr size_t size() { return Dimensionality; }
+};
+
+template <typename Element, size_t Number_Of_Rows, size_t Number_Of_Columns>
+struct arithmetic_expression_traits<matrix<Element, Number_Of_Rows, Number_Of_Columns>, void>
+{
+    using element_type = Element;
+    static constexpr size_t size() { return Number_Of_Rows * Number_Of_Columns; }
+};
+
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to <tt>true</tt> if idlib::arithmetic_expression_traits is specialized for the specified type.
+/// Otherwise it is equal to <tt>false</tt>.
+template <typename T, typename Enabled = void>
+struct is_arithmetic_expression_operand : std::false_type
+{};
+
+template <typename T>
+struct is_arithmetic_expression_operand<T, std::void_t<decltype(arithmetic_expression_traits<T>::size())>> : std::true_type
+{};
+
+/// @brief Base of all arithmetic expressions (CRTP).
+/// The derived class needs to define
+/// - a member type @a result_type, the type of the value the expression evaluates to,
+/// - a member type @a element_type, the element type of the result type,
+/// - a static constant member function @a size() returning the number of elements of the result type, and
+/// - a constant member function <tt>element_type operator()(size_t i) const</tt> evaluating the expression for the element at the specified index.
+template <typename Derived>
+struct arithmetic_expression
+{
+    const Derived& derived() const
+    { return *static_cast<const Derived *>(this); }
+
+    /// @brief Evaluate this expression into a new value.
+    template <typename T, typename D = Derived, typename = std::enable_if_t<std::is_same<T, typename D::result_type>::value>>
+    operator T() const
+    {
+        T t(uninitialized);
+        for (size_t i = 0; i < Derived::size(); ++i)
+        { t(i) = derived()(i); }
+        return t;
+    }
+};
+
+/// @brief An expression wrapping a value.
+/// @tparam T the type of the value
+template <typename T>
+struct terminal_expression : public arithmetic_expression<terminal_expression<T>>
+{
+    using result_type = T;
+    using element_type = typename arithmetic_expression_traits<T>::element_type;
+
+    static constexpr size_t size()
+    { return arithmetic_expression_traits<T>::size(); }
+
+    explicit terminal_expression(const T& value)
+        : m_value(value)
+    {}
+
+    element_type operator()(size_t i) const
+    { return m_value(i); }
+
+private:
+    const T& m_value;
+};
+
+/// @brief An expression combining two expressions element-wise.
+/// @tparam Functor the functor type combining two elements
+/// @tparam L, R the types of the expressions
+template <typename Functor, typename L, typename R>
+struct binary_expression : public arithmetic_expression<binary_expression<Functor, L, R>>
+{
+    static_assert(std::is_same<typename L::result_type, typename R::result_type>::value, "result types of operands are not equal");
+
+    using result_type = typename L::result_type;
+    using element_type = typename L::element_type;
+
+    static constexpr size_t size()
+    { return L::size(); }
+
+    binary_expression(const L& l, const R& r)
+        : m_l(l), m_r(r)
+    {}
+
+    element_type operator()(size_t i) const
+    { return Functor()(m_l(i), m_r(i)); }
+
+private:
+    L m_l;
+    R m_r;
+};
+
+/// @brief An expression combining the elements of an expression with a scalar.
+/// @tparam Functor the functor type combining an element and the scalar
+/// @tparam L the type of the expression
+template <typename Functor, typename L>
+struct scalar_expression : public arithmetic_expression<scalar_expression<Functor, L>>
+{
+    using result_type = typename L::result_type;
+    using element_type = typename L::element_type;
+
+    static constexpr size_t size()
+    { return L::size(); }
+
+    scalar_expression(const L& l, const element_type& s)
+        : m_l(l), m_s(s)
+    {}
+
+    element_type operator()(size_t i) const
+    { return Functor()(m_l(i), m_s); }
+
+private:
+    L m_l;
+    element_type m_s;
+};
+
+/// @brief An expression transforming the elements of an expression.
+/// @tparam Functor the functor type transforming an element
+/// @tparam L the type of the expression
+template <typename Functor, typename L>
+struct unary_expression : public arithmetic_expression<unary_expression<Functor, L>>
+{
+    using result_type = typename L::result_type;
+    using element_type = typename L::element_type;
+
+    static constexpr size_t size()
+    { return L::size(); }
+
+    explicit unary_expression(const L& l)
+        : m_l(l)
+    {}
+
+    element_type operator()(size_t i) const
+    { return Functor()(m_l(i)); }
+
+private:
+    L m_l;
+};
+
+/// @brief Wrap a value into an expression.
+/// @param x the value
+/// @return the expression
+template <typename T, typename = std::enable_if_t<is_arithmetic_expression_operand<T>::value>>
+terminal_expression<T> lazy(const T& x)
+{ return terminal_expression<T>(x); }
+
+/// @brief Evaluate an expression and assign the result to a value.
+/// @param target the value
+/// @param e the expression
+/// @return the value
+/// @remark The expression is evaluated in a single loop writing to the value.
+template <typename T, typename E>
+std::enable_if_t<std::is_same<T, typename E::result_type>::value, T&>
+assign(T& target, const arithmetic_expression<E>& e)
+{
+    for (size_t i = 0; i < E::size(); ++i)
+    { target(i) = e.derived()(i); }
+    return target;
+}
+
+/// @brief Evaluate an expression into a new value.
+/// @param e the expression
+/// @return the value
+template <typename E>
+typename E::result_type evaluate(const arithmetic_expression<E>& e)
+{ return e; }
+
+/// @brief Evaluate an expression and add the result to a value.
+/// @remark The expression is evaluated in a single loop writing to the value.
+template <typename T, typename E>
+std::enable_if_t<std::is_same<T, typename E::result_type>::value, T&>
+operator+=(T& target, const arithmetic_expression<E>& e)
+{
+    using functor = arithmetic_binary_plus_functor<typename E::element_type>;
+    for (size_t i = 0; i < E::size(); ++i)
+    { target(i) = functor()(target(i), e.derived()(i)); }
+    return target;
+}
+
+/// @brief Evaluate an expression and subtract the result from a value.
+/// @remark The expression is evaluated in a single loop writing to the value.
+template <typename T, typename E>
+std::enable_if_t<std::is_same<T, typename E::result_type>::value, T&>
+operator-=(T& target, const arithmetic_expression<E>& e)
+{
+    using functor = arithmetic_binary_minus_functor<typename E::element_type>;
+    for (size_t i = 0; i < E::size(); ++i)
+    { target(i) = functor()(target(i), e.derived()(i)); }
+    return target;
+}
+
+/// @{
+/// @brief Binary plus and binary minus for two expressions or an expression and a value.
+template <typename L, typename R>
+auto operator+(const arithmetic_expression<L>& l, const arithmetic_expression<R>& r)
+{ return binary_expression<arithmetic_binary_plus_functor<typename L::element_type>, L, R>(l.derived(), r.derived()); }
+
+template <typename L, typename R, typename = std::enable_if_t<is_arithmetic_expression_operand<R>::value>>
+auto operator+(const arithmetic_expression<L>& l, const R& r)
+{ return l + lazy(r); }
+
+template <typename L, typename R, typename = std::enable_if_t<is_arithmetic_expression_operand<L>::value>>
+auto operator+(const L& l, const arithmetic_expression<R>& r)
+{ return lazy(l) + r; }
+
+template <typename L, typename R>
+auto operator-(const arithmetic_expression<L>& l, const arithmetic_expression<R>& r)
+{ return binary_expression<arithmetic_binary_minus_functor<typename L::element_type>, L, R>(l.derived(), r.derived()); }
+
+template <typename L, typename R, typename = std::enable_if_t<is_arithmetic_expression_operand<R>::value>>
+auto operator-(const arithmetic_expression<L>& l, const R& r)
+{ return l - lazy(r); }
+
+template <typename L, typename R, typename = std::enable_if_t<is_arithmetic_expression_operand<L>::value>>
+auto operator-(const L& l, const arithmetic_expression<R>& r)
+{ return lazy(l) - r; }
+/// @}
+
+/// @{
+/// @brief Binary star and binary slash for an expression and a scalar.
+template <typename L>
+auto operator*(const arithmetic_expression<L>& l, const typename L::element_type& s)
+{ return scalar_expression<arithmetic_binary_star_functor<typename L::element_type>, L>(l.derived(), s); }
+
+template <typename L>
+auto operator*(const typename L::element_type& s, const arithmetic_expression<L>& l)
+{ return l * s; }
+
+template <typename L>
+auto operator/(const arithmetic_expression<L>& l, const typename L::element_type& s)
+{ return scalar_expression<arithmetic_binary_slash_functor<typename L::element_type>, L>(l.derived(), s); }
+/// @}
+
+/// @{
+/// @brief Unary plus and unary minus for an expression.
+template <typename L>
+auto operator+(const arithmetic_expression<L>& l)
+{ return unary_expression<arithmetic_unary_plus_functor<typename L::element_type>, L>(l.derived()); }
+
+template <typename L>
+auto operator-(const arithmetic_expression<L>& l)
+{ return unary_expression<arithmetic_unary_minus_functor<typename L::element_type>, L>(l.derived()); }
+/// @}
+
+} // namespace idlib
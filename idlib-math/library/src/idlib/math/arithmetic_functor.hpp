@@ -68,7 +68,7 @@ struct arithmetic_binary_star_functor;
 template <typename T>
 struct arithmetic_binary_star_functor<T, T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    T operator()(T a, T b) const
+    constexpr T operator()(T a, T b) const
     { return a * b; }
 };
 
@@ -79,7 +79,7 @@ struct arithmetic_binary_slash_functor;
 template <typename T>
 struct arithmetic_binary_slash_functor<T, T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    T operator()(T a, T b) const
+    constexpr T operator()(T a, T b) const
     { return a / b; }
 };
 
@@ -90,7 +90,7 @@ struct arithmetic_binary_plus_functor;
 template <typename T>
 struct arithmetic_binary_plus_functor<T, T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    T operator()(T a, T b) const
+    constexpr T operator()(T a, T b) const
     { return a + b; }
 };
 	
@@ -101,7 +101,7 @@ struct arithmetic_binary_minus_functor;
 template <typename T>
 struct arithmetic_binary_minus_functor<T, T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-	T operator()(T a, T b) const
+	constexpr T operator()(T a, T b) const
 	{ return a - b; }
 };
 
@@ -112,7 +112,7 @@ struct arithmetic_unary_plus_functor;
 template <typename T>
 struct arithmetic_unary_plus_functor<T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    T operator()(T a) const
+    constexpr T operator()(T a) const
     { return +a; }
 };
 
@@ -123,7 +123,7 @@ struct arithmetic_unary_minus_functor;
 template <typename T>
 struct arithmetic_unary_minus_functor<T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    T operator()(T a) const
+    constexpr T operator()(T a) const
     { return -a; }
 };
 
@@ -135,54 +135,54 @@ struct arithmetic_binary_equal_equal_functor;
 template <typename T>
 struct arithmetic_binary_equal_equal_functor<T, T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-    bool operator()(T a, T b) const
+    constexpr bool operator()(T a, T b) const
     { return a == b; }
 };
 
 template <typename A, typename B>
-auto operator*(const A& a, const B& b) -> decltype(arithmetic_binary_star_functor<A, B>()(a, b))
+constexpr auto operator*(const A& a, const B& b) -> decltype(arithmetic_binary_star_functor<A, B>()(a, b))
 {
     return arithmetic_binary_star_functor<A, B>()(a, b);
 }
 
 template <typename A, typename B>
-auto operator/(const A& a, const B& b) -> decltype(arithmetic_binary_slash_functor<A, B>()(a, b))
+constexpr auto operator/(const A& a, const B& b) -> decltype(arithmetic_binary_slash_functor<A, B>()(a, b))
 {
     return arithmetic_binary_slash_functor<A, B>()(a, b);
 }
 
 template <typename A, typename B>
-auto operator+(const A& a, const B& b) -> decltype(arithmetic_binary_plus_functor<A, B>()(a, b))
+constexpr auto operator+(const A& a, const B& b) -> decltype(arithmetic_binary_plus_functor<A, B>()(a, b))
 {
     return arithmetic_binary_plus_functor<A, B>()(a, b);
 }
 
 template <typename A, typename B>
-auto operator-(const A& a, const B& b) -> decltype(arithmetic_binary_minus_functor<A, B>()(a, b))
+constexpr auto operator-(const A& a, const B& b) -> decltype(arithmetic_binary_minus_functor<A, B>()(a, b))
 {
     return arithmetic_binary_minus_functor<A, B>()(a, b);
 }
 
 template <typename A>
-auto operator+(const A& a) -> decltype(arithmetic_unary_plus_functor<A>()(a))
+constexpr auto operator+(const A& a) -> decltype(arithmetic_unary_plus_functor<A>()(a))
 {
     return arithmetic_unary_plus_functor<A>()(a);
 }
 
 template <typename A>
-auto operator-(const A& a) -> decltype(arithmetic_unary_minus_functor<A>()(a))
+constexpr auto operator-(const A& a) -> decltype(arithmetic_unary_minus_functor<A>()(a))
 {
     return arithmetic_unary_minus_functor<A>()(a);
 }
 
 template <typename A, typename B>
-auto operator==(const A& a, const B& b) -> decltype(arithmetic_binary_equal_equal_functor<A, B>()(a, b))
+constexpr auto operator==(const A& a, const B& b) -> decltype(arithmetic_binary_equal_equal_functor<A, B>()(a, b))
 {
     return arithmetic_binary_equal_equal_functor<A, B>()(a, b);
 }
 
 template <typename A, typename B>
-auto operator!=(const A& a, const B& b) -> decltype(!arithmetic_binary_equal_equal_functor<A, B>()(a, b))
+constexpr auto operator!=(const A& a, const B& b) -> decltype(!arithmetic_binary_equal_equal_functor<A, B>()(a, b))
 {
     return !arithmetic_binary_equal_equal_functor<A, B>()(a, b);
 }
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/cholesky_decomposition.hpp
+/// @brief Cholesky decomposition of symmetric positive definite matrices.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/decomposition_kernels.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/vector.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The Cholesky decomposition \f$A = L L^T\f$ of a symmetric positive definite \f$N \times N\f$ matrix \f$A\f$,
+/// where \f$L\f$ is a lower triangular matrix with a positive diagonal.
+/// @remark Solving a linear system by the Cholesky decomposition requires about half of the operations of the LU decomposition.
+/// Normal equations \f$A^T A x = A^T b\f$ and covariance matrices are symmetric positive definite.
+/// @tparam Element the element type. Must be a floating point type.
+/// @tparam N the number of rows and columns
+template <typename Element, size_t N>
+struct cholesky_decomposition
+{
+    static_assert(std::is_floating_point<Element>::value, "Element must be a floating point type");
+
+public:
+    /// @brief The element type.
+    using element_type = Element;
+
+    /// @brief The matrix type.
+    using matrix_type = matrix<element_type, N, N>;
+
+    /// @brief The vector type.
+    using vector_type = vector<element_type, N>;
+
+    /// @brief Construct this Cholesky decomposition.
+    /// @param a the matrix \f$A\f$. Only the elements on and below the diagonal are read.
+    /// @throw std::domain_error the matrix \f$A\f$ is not positive definite
+    explicit cholesky_decomposition(const matrix_type& a)
+        : m_l(a)
+    {
+        if (!kernels::cholesky(&(m_l._v[0])))
+        {
+            throw std::domain_error("Cannot decompose matrix which is not positive definite");
+        }
+        kernels::reciprocal_diagonal(&(m_l._v[0]), m_reciprocals);
+    }
+
+    /// @brief Get the matrix \f$L\f$.
+    /// @return the matrix \f$L\f$
+    const matrix_type& lower() const
+    { return m_l; }
+
+    /// @brief Get the determinant of the matrix \f$A\f$.
+    /// @return the determinant
+    element_type determinant() const
+    {
+        element_type d = one<element_type>();
+        for (size_t i = 0; i < N; ++i)
+        { d *= m_l(i, i); }
+        return d * d;
+    }
+
+    /// @brief Solve \f$A x = b\f$.
+    /// @param b the right-hand side \f$b\f$
+    /// @return the solution \f$x\f$
+    vector_type solve(const vector_type& b) const
+    {
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = b[i]; }
+        kernels::cholesky_solve(&(m_l._v[0]), m_reciprocals, y, 1);
+        vector_type x = b;
+        for (size_t i = 0; i < N; ++i)
+        { x[i] = y[i]; }
+        return x;
+    }
+
+    /// @brief Solve \f$A X = B\f$.
+    /// @param b the right-hand sides \f$B\f$
+    /// @return the solutions \f$X\f$
+    template <size_t K>
+    matrix<element_type, N, K> solve(const matrix<element_type, N, K>& b) const
+    {
+        matrix<element_type, N, K> x = b;
+        for (size_t j = 0; j < K; ++j)
+        { kernels::cholesky_solve(&(m_l._v[0]), m_reciprocals, &(x._v[j]), K); }
+        return x;
+    }
+
+    /// @brief Compute the inverse of the matrix \f$A\f$.
+    /// @return the inverse
+    matrix_type inverse() const
+    { return solve(identity<matrix_type>()); }
+
+private:
+    using kernels = internal::decomposition_kernels<element_type, N>;
+
+    /// @brief The matrix \f$L\f$.
+    matrix_type m_l;
+
+    /// @brief The reciprocals of the diagonal elements of \f$L\f$.
+    element_type m_reciprocals[N];
+
+}; // struct cholesky_decomposition
+
+} // namespace idlib
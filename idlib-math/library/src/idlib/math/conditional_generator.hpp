@@ -35,13 +35,13 @@ struct conditional_generator : generator
 {
 	using a_type = A;
 	using b_type = B;
-    conditional_generator(size_t i = size_t(),
+    constexpr conditional_generator(size_t i = size_t(),
 	                      const a_type& a = a_type(),
                           const b_type& b = b_type())
         : m_i(i), m_a(a), m_b(b)
 	{}
 
-	auto operator()(size_t i) const
+	constexpr auto operator()(size_t i) const
 	{ return i == m_i ? m_a(i) : m_b(i); }
 
 private:
@@ -55,7 +55,7 @@ private:
 /// @tparam i, a, b see \ref idlib::conditional_generator::idlib::conditional_generator(size_t,const A&,const &B) for more information
 /// @return the conditional generator
 template <typename A, typename B>
-auto make_conditional_generator(size_t i, const A& a, const B& b)
+constexpr auto make_conditional_generator(size_t i, const A& a, const B& b)
 {
 	return conditional_generator<A, B>(i, a, b);
 }
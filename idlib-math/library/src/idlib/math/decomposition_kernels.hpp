@@ -0,0 +1,335 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/decomposition_kernels.hpp
+/// @brief Kernels of the LU, Cholesky and QR decompositions of square matrices.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/numeric.hpp"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace idlib::internal {
+
+template <size_t First, typename F, size_t ... Is>
+void unroll(const F& f, std::index_sequence<Is ...>)
+{ (f(std::integral_constant<size_t, First + Is>{}), ...); }
+
+/// @internal
+/// @brief Invoke a function for the indices \f$[First,Last)\f$ in ascending order.
+/// @param f the function. Receives the index as a <c>std::integral_constant<size_t, I></c>.
+/// @remark The invocations are unrolled at compile time.
+template <size_t First, size_t Last, typename F>
+void unroll(const F& f)
+{ unroll<First>(f, std::make_index_sequence<Last - First>{}); }
+
+/// @internal
+/// @brief Kernels of the decompositions of \f$N \times N\f$ matrices of elements of type @a Element.
+/// @remark The matrices are passed as pointers to their elements in row-major order and are decomposed in place.
+/// Right-hand sides are passed as pointers to their first element and the distance between two consecutive elements,
+/// such that both vectors and the columns of a matrix can be passed.
+/// @remark The substitutions solving a system given a decomposition are unrolled at compile time if \f$N \leq 8\f$.
+template <typename Element, size_t N>
+struct decomposition_kernels
+{
+    using element_type = Element;
+
+    /// @brief @a std::true_type if the substitutions are unrolled, @a std::false_type otherwise.
+    using is_unrolled = std::integral_constant<bool, (N <= 8)>;
+
+    /// @brief Compute the LU decomposition \f$P A = L U\f$ with partial pivoting.
+    /// @param a the matrix \f$A\f$. Receives \f$L\f$ below the diagonal (the unit diagonal is not stored) and \f$U\f$ on and above the diagonal.
+    /// @param p receives the permutation: row @a i of \f$P A\f$ is row <c>p[i]</c> of \f$A\f$
+    /// @param sign receives the sign of the permutation
+    /// @return @a false if \f$A\f$ is singular, @a true otherwise
+    static bool lu(element_type *a, size_t *p, element_type& sign)
+    {
+        bool regular = true;
+        sign = one<element_type>();
+        for (size_t i = 0; i < N; ++i)
+        { p[i] = i; }
+        for (size_t k = 0; k < N; ++k)
+        {
+            size_t r = k;
+            element_type m = std::abs(a[k * N + k]);
+            for (size_t i = k + 1; i < N; ++i)
+            {
+                const element_type t = std::abs(a[i * N + k]);
+                if (t > m)
+                { m = t; r = i; }
+            }
+            if (m == zero<element_type>())
+            {
+                regular = false;
+                continue;
+            }
+            if (r != k)
+            {
+                for (size_t j = 0; j < N; ++j)
+                { std::swap(a[k * N + j], a[r * N + j]); }
+                std::swap(p[k], p[r]);
+                sign = -sign;
+            }
+            const element_type d = one<element_type>() / a[k * N + k];
+            for (size_t i = k + 1; i < N; ++i)
+            {
+                const element_type l = a[i * N + k] * d;
+                a[i * N + k] = l;
+                for (size_t j = k + 1; j < N; ++j)
+                { a[i * N + j] -= l * a[k * N + j]; }
+            }
+        }
+        return regular;
+    }
+
+    /// @brief Compute the reciprocals of the diagonal elements of a matrix.
+    /// @param a the matrix. Its diagonal elements must not be zero.
+    /// @param r receives the reciprocals
+    /// @remark The solvers multiply by the reciprocals instead of dividing by the diagonal elements.
+    /// This takes the divisions out of the dependency chains of the substitutions.
+    static void reciprocal_diagonal(const element_type *a, element_type *r)
+    {
+        for (size_t i = 0; i < N; ++i)
+        { r[i] = one<element_type>() / a[i * N + i]; }
+    }
+
+    /// @brief Solve \f$A x = b\f$ given the LU decomposition of \f$A\f$.
+    /// @param lu, p the LU decomposition of a regular matrix \f$A\f$ as computed by lu()
+    /// @param r the reciprocals of the diagonal elements of @a lu as computed by reciprocal_diagonal()
+    /// @param x the right-hand side \f$b\f$. Receives the solution \f$x\f$.
+    /// @param stride the distance between two consecutive elements of @a x
+    static void lu_solve(const element_type *lu, const size_t *p, const element_type *r, element_type *x, size_t stride)
+    {
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = x[p[i] * stride]; }
+        substitute_lower(lu, nullptr, y);
+        substitute_upper(lu, r, y);
+        for (size_t i = 0; i < N; ++i)
+        { x[i * stride] = y[i]; }
+    }
+
+    /// @brief Compute the Cholesky decomposition \f$A = L L^T\f$.
+    /// @param a the symmetric matrix \f$A\f$. Only the elements on and below the diagonal are read.
+    /// Receives \f$L\f$ on and below the diagonal and zeroes above the diagonal.
+    /// @return @a false if \f$A\f$ is not positive definite, @a true otherwise
+    static bool cholesky(element_type *a)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            element_type d = a[j * N + j];
+            for (size_t k = 0; k < j; ++k)
+            { d -= a[j * N + k] * a[j * N + k]; }
+            if (!(d > zero<element_type>()))
+            { return false; }
+            d = std::sqrt(d);
+            a[j * N + j] = d;
+            for (size_t i = j + 1; i < N; ++i)
+            {
+                element_type s = a[i * N + j];
+                for (size_t k = 0; k < j; ++k)
+                { s -= a[i * N + k] * a[j * N + k]; }
+                a[i * N + j] = s / d;
+                a[j * N + i] = zero<element_type>();
+            }
+        }
+        return true;
+    }
+
+    /// @brief Solve \f$A x = b\f$ given the Cholesky decomposition of \f$A\f$.
+    /// @param l the Cholesky decomposition of \f$A\f$ as computed by cholesky()
+    /// @param r the reciprocals of the diagonal elements of @a l as computed by reciprocal_diagonal()
+    /// @param x the right-hand side \f$b\f$. Receives the solution \f$x\f$.
+    /// @param stride the distance between two consecutive elements of @a x
+    static void cholesky_solve(const element_type *l, const element_type *r, element_type *x, size_t stride)
+    {
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = x[i * stride]; }
+        substitute_lower(l, r, y);
+        substitute_lower_transposed(l, r, y);
+        for (size_t i = 0; i < N; ++i)
+        { x[i * stride] = y[i]; }
+    }
+
+    /// @brief Compute the QR decomposition \f$A = Q R\f$ by Householder reflections.
+    /// @param a the matrix \f$A\f$. Receives \f$R\f$ on and above the diagonal and the Householder vectors below the diagonal.
+    /// @param tau receives the scaling factors of the Householder reflections
+    /// @remark \f$Q = H_0 H_1 \cdots H_{N-1}\f$ where \f$H_k = I - \tau_k v_k v_k^T\f$.
+    /// The first \f$k\f$ elements of \f$v_k\f$ are zero, its element \f$k\f$ is one and its remaining elements are stored below the diagonal in column \f$k\f$.
+    static void qr(element_type *a, element_type *tau)
+    {
+        for (size_t k = 0; k < N; ++k)
+        {
+            element_type s = zero<element_type>();
+            for (size_t i = k + 1; i < N; ++i)
+            { s += a[i * N + k] * a[i * N + k]; }
+            const element_type alpha = a[k * N + k];
+            if (s == zero<element_type>())
+            {
+                // Column k is already upper triangular.
+                tau[k] = zero<element_type>();
+                continue;
+            }
+            const element_type beta = -std::copysign(std::sqrt(alpha * alpha + s), alpha);
+            tau[k] = (beta - alpha) / beta;
+            const element_type scale = one<element_type>() / (alpha - beta);
+            for (size_t i = k + 1; i < N; ++i)
+            { a[i * N + k] *= scale; }
+            a[k * N + k] = beta;
+            for (size_t j = k + 1; j < N; ++j)
+            {
+                element_type t = a[k * N + j];
+                for (size_t i = k + 1; i < N; ++i)
+                { t += a[i * N + k] * a[i * N + j]; }
+                t *= tau[k];
+                a[k * N + j] -= t;
+                for (size_t i = k + 1; i < N; ++i)
+                { a[i * N + j] -= t * a[i * N + k]; }
+            }
+        }
+    }
+
+    /// @brief Compute \f$Q^T b\f$ given the QR decomposition of \f$A\f$.
+    /// @param qr, tau the QR decomposition of \f$A\f$ as computed by qr()
+    /// @param x the vector \f$b\f$. Receives \f$Q^T b\f$.
+    /// @param stride the distance between two consecutive elements of @a x
+    static void qr_apply_transposed_q(const element_type *qr, const element_type *tau, element_type *x, size_t stride)
+    {
+        for (size_t k = 0; k < N; ++k)
+        {
+            if (tau[k] == zero<element_type>())
+            { continue; }
+            element_type t = x[k * stride];
+            for (size_t i = k + 1; i < N; ++i)
+            { t += qr[i * N + k] * x[i * stride]; }
+            t *= tau[k];
+            x[k * stride] -= t;
+            for (size_t i = k + 1; i < N; ++i)
+            { x[i * stride] -= t * qr[i * N + k]; }
+        }
+    }
+
+    /// @brief Solve \f$A x = b\f$ given the QR decomposition of \f$A\f$.
+    /// @param qr, tau the QR decomposition of a regular matrix \f$A\f$ as computed by qr()
+    /// @param r the reciprocals of the diagonal elements of @a qr as computed by reciprocal_diagonal()
+    /// @param x the right-hand side \f$b\f$. Receives the solution \f$x\f$.
+    /// @param stride the distance between two consecutive elements of @a x
+    static void qr_solve(const element_type *qr, const element_type *tau, const element_type *r, element_type *x, size_t stride)
+    {
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = x[i * stride]; }
+        qr_apply_transposed_q(qr, tau, y, 1);
+        substitute_upper(qr, r, y);
+        for (size_t i = 0; i < N; ++i)
+        { x[i * stride] = y[i]; }
+    }
+
+private:
+    // The substitutions are column-oriented: once an element of the solution is known, it is eliminated from all remaining elements.
+    // The eliminations are independent of each other, such that the critical path is of length N rather than N * N / 2.
+
+    // Solve L y = b in place where L is the lower triangle of l and r are the reciprocals of its diagonal.
+    // If r is a null pointer, the diagonal of L is assumed to be one.
+    static void substitute_lower(const element_type *l, const element_type *r, element_type *y)
+    { substitute_lower(l, r, y, is_unrolled{}); }
+
+    static void substitute_lower(const element_type *l, const element_type *r, element_type *y, std::true_type)
+    {
+        unroll<0, N>([&](auto j)
+        {
+            if (r)
+            { y[j] *= r[j]; }
+            unroll<decltype(j)::value + 1, N>([&](auto i) { y[i] -= l[i * N + j] * y[j]; });
+        });
+    }
+
+    static void substitute_lower(const element_type *l, const element_type *r, element_type *y, std::false_type)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (r)
+            { y[j] *= r[j]; }
+            for (size_t i = j + 1; i < N; ++i)
+            { y[i] -= l[i * N + j] * y[j]; }
+        }
+    }
+
+    // Solve L^T y = b in place where L is the lower triangle of l and r are the reciprocals of its diagonal.
+    static void substitute_lower_transposed(const element_type *l, const element_type *r, element_type *y)
+    { substitute_lower_transposed(l, r, y, is_unrolled{}); }
+
+    static void substitute_lower_transposed(const element_type *l, const element_type *r, element_type *y, std::true_type)
+    {
+        unroll<0, N>([&](auto k)
+        {
+            constexpr size_t j = N - 1 - decltype(k)::value;
+            y[j] *= r[j];
+            unroll<0, j>([&](auto i) { y[i] -= l[j * N + i] * y[j]; });
+        });
+    }
+
+    static void substitute_lower_transposed(const element_type *l, const element_type *r, element_type *y, std::false_type)
+    {
+        for (size_t j = N; j-- > 0;)
+        {
+            y[j] *= r[j];
+            for (size_t i = 0; i < j; ++i)
+            { y[i] -= l[j * N + i] * y[j]; }
+        }
+    }
+
+    // Solve U y = b in place where U is the upper triangle of u and r are the reciprocals of its diagonal.
+    static void substitute_upper(const element_type *u, const element_type *r, element_type *y)
+    { substitute_upper(u, r, y, is_unrolled{}); }
+
+    static void substitute_upper(const element_type *u, const element_type *r, element_type *y, std::true_type)
+    {
+        unroll<0, N>([&](auto k)
+        {
+            constexpr size_t j = N - 1 - decltype(k)::value;
+            y[j] *= r[j];
+            unroll<0, j>([&](auto i) { y[i] -= u[i * N + j] * y[j]; });
+        });
+    }
+
+    static void substitute_upper(const element_type *u, const element_type *r, element_type *y, std::false_type)
+    {
+        for (size_t j = N; j-- > 0;)
+        {
+            y[j] *= r[j];
+            for (size_t i = 0; i < j; ++i)
+            { y[i] -= u[i * N + j] * y[j]; }
+        }
+    }
+
+}; // struct decomposition_kernels
+
+} // namespace idlib::internal
@@ -0,0 +1,505 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/dynamic_matrix.hpp
+/// @brief Matrices with a number of rows and columns determined at run time.
+/// @author Michael Heilmann
+
+/// @detail
+/// The product of two idlib::dynamic_matrix values and the product of an idlib::dynamic_matrix and an idlib::dynamic_vector
+/// are computed by cache-blocked kernels. idlib::multiply writes the product into a matrix or vector provided by the caller
+/// and splits the work across threads as specified by an idlib::execution_policy:
+/// @code
+/// idlib::dynamic_matrix<single> a(m, k), b(k, n), c;
+/// ...
+/// idlib::multiply(a, b, c, idlib::execution_policy::parallel());
+/// @endcode
+
+#pragma once
+
+#include "idlib/math/arithmetic_functor.hpp"
+#include "idlib/math/dynamic_vector.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/math/transpose.hpp"
+#include "idlib/semantic_cast.hpp"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A matrix with a number of rows and columns determined at run time.
+/// @remark The elements are stored contiguously in row-major order in memory obtained from the allocator.
+/// An arena is used by specifying an allocator drawing from it, e.g. <c>std::pmr::polymorphic_allocator<Element></c>.
+/// @remark A dynamic matrix is converted into an idlib::matrix and vice versa by idlib::semantic_cast.
+/// @tparam Element the element type
+/// @tparam Allocator the allocator type
+template <typename Element, typename Allocator = std::allocator<Element>>
+struct dynamic_matrix
+{
+public:
+    /// @brief The element type.
+    using element_type = Element;
+
+    /// @brief The allocator type.
+    using allocator_type = Allocator;
+
+    /// @brief The type of this template/template specialization.
+    using matrix_type = dynamic_matrix<element_type, allocator_type>;
+
+    /// @brief Construct this matrix with @a 0 rows and @a 0 columns.
+    /// @param allocator the allocator
+    explicit dynamic_matrix(const allocator_type& allocator = allocator_type())
+        : m_number_of_rows(0), m_number_of_columns(0), m_elements(allocator)
+    {}
+
+    /// @brief Construct this matrix with the zero matrix of the specified number of rows and columns.
+    /// @param number_of_rows the number of rows
+    /// @param number_of_columns the number of columns
+    /// @param allocator the allocator
+    dynamic_matrix(size_t number_of_rows, size_t number_of_columns, const allocator_type& allocator = allocator_type())
+        : m_number_of_rows(number_of_rows), m_number_of_columns(number_of_columns),
+          m_elements(number_of_rows * number_of_columns, zero<element_type>(), allocator)
+    {}
+
+    dynamic_matrix(const matrix_type& other) = default;
+
+    dynamic_matrix(matrix_type&& other) = default;
+
+    matrix_type& operator=(const matrix_type& other) = default;
+
+    matrix_type& operator=(matrix_type&& other) = default;
+
+public:
+    /// @brief Get the number of rows of this matrix.
+    /// @return the number of rows
+    size_t number_of_rows() const
+    { return m_number_of_rows; }
+
+    /// @brief Get the number of columns of this matrix.
+    /// @return the number of columns
+    size_t number_of_columns() const
+    { return m_number_of_columns; }
+
+    /// @brief Get the number of elements of this matrix.
+    /// @return the number of elements
+    size_t number_of_elements() const
+    { return m_elements.size(); }
+
+    /// @brief Set the number of rows and columns of this matrix.
+    /// @param number_of_rows the number of rows
+    /// @param number_of_columns the number of columns
+    /// @post This matrix is the zero matrix of the specified number of rows and columns.
+    /// @remark Memory is only allocated if the number of elements exceeds the capacity of this matrix.
+    void resize(size_t number_of_rows, size_t number_of_columns)
+    {
+        m_elements.assign(number_of_rows * number_of_columns, zero<element_type>());
+        m_number_of_rows = number_of_rows;
+        m_number_of_columns = number_of_columns;
+    }
+
+    /// @{
+    /// @brief Get a pointer to the elements in row-major order.
+    /// @return a pointer to the elements
+    element_type *data()
+    { return m_elements.data(); }
+
+    const element_type *data() const
+    { return m_elements.data(); }
+    /// @}
+
+    /// @{
+    /// @brief Get the element at the specified index.
+    /// @param i the row index. Must be within the bounds of \f$[0,number\_of\_rows())\f$.
+    /// @param j the column index. Must be within the bounds of \f$[0,number\_of\_columns())\f$.
+    /// @return a reference to the element
+    element_type& operator()(size_t i, size_t j)
+    { return m_elements[i * m_number_of_columns + j]; }
+
+    const element_type& operator()(size_t i, size_t j) const
+    { return m_elements[i * m_number_of_columns + j]; }
+    /// @}
+
+    /// @{
+    /// @brief Get the element at the specified index in row-major order.
+    /// @param i the index. Must be within the bounds of \f$[0,number\_of\_elements())\f$.
+    /// @return a reference to the element
+    element_type& operator()(size_t i)
+    { return m_elements[i]; }
+
+    const element_type& operator()(size_t i) const
+    { return m_elements[i]; }
+    /// @}
+
+    bool operator==(const matrix_type& other) const
+    {
+        return m_number_of_rows == other.m_number_of_rows && m_number_of_columns == other.m_number_of_columns
+            && m_elements == other.m_elements;
+    }
+
+    bool operator!=(const matrix_type& other) const
+    { return !(*this == other); }
+
+    /// @throw std::invalid_argument the numbers of rows or columns of the matrices are not equal
+    matrix_type& operator+=(const matrix_type& other)
+    {
+        check(other);
+        for (size_t i = 0; i < number_of_elements(); ++i)
+        { m_elements[i] += other.m_elements[i]; }
+        return *this;
+    }
+
+    /// @throw std::invalid_argument the numbers of rows or columns of the matrices are not equal
+    matrix_type& operator-=(const matrix_type& other)
+    {
+        check(other);
+        for (size_t i = 0; i < number_of_elements(); ++i)
+        { m_elements[i] -= other.m_elements[i]; }
+        return *this;
+    }
+
+    matrix_type& operator*=(element_type other)
+    {
+        for (auto& element : m_elements)
+        { element *= other; }
+        return *this;
+    }
+
+    /// @throw std::invalid_argument the numbers of rows or columns of the matrices are not equal
+    matrix_type operator+(const matrix_type& other) const
+    { auto t = *this; t += other; return t; }
+
+    /// @throw std::invalid_argument the numbers of rows or columns of the matrices are not equal
+    matrix_type operator-(const matrix_type& other) const
+    { auto t = *this; t -= other; return t; }
+
+    matrix_type operator*(element_type other) const
+    { auto t = *this; t *= other; return t; }
+
+    matrix_type operator-() const
+    { auto t = *this; t *= -one<element_type>(); return t; }
+
+private:
+    void check(const matrix_type& other) const
+    {
+        if (m_number_of_rows != other.m_number_of_rows || m_number_of_columns != other.m_number_of_columns)
+        {
+            throw std::invalid_argument("numbers of rows or columns of matrices are not equal");
+        }
+    }
+
+    /// @brief The number of rows.
+    size_t m_number_of_rows;
+
+    /// @brief The number of columns.
+    size_t m_number_of_columns;
+
+    /// @brief The elements in row-major order.
+    std::vector<element_type, allocator_type> m_elements;
+
+}; // struct dynamic_matrix
+
+namespace internal {
+
+/// @internal
+/// @brief Cache-blocked kernels for matrices of scalars of type @a Scalar in row-major order.
+/// @remark The product \f$C = A B\f$ is computed in blocks of depth_block() columns of \f$A\f$ and column_block() columns of \f$B\f$,
+/// such that the block of \f$B\f$ stays in the cache while all rows of \f$A\f$ are processed.
+/// Within a block, \f$4\f$ rows and two packs of columns of \f$C\f$ are accumulated in registers.
+/// If no SIMD instruction set is selected, the packs hold a single scalar.
+template <typename Scalar>
+struct dense_kernels
+{
+    using scalar_type = Scalar;
+    using pack_type = simd_native_pack<scalar_type>;
+    using register_type = typename pack_type::register_type;
+
+    /// @brief Get the number of rows of \f$C\f$ accumulated in registers.
+    static constexpr size_t row_block()
+    { return 4; }
+
+    /// @brief Get the number of columns of \f$A\f$ (and rows of \f$B\f$) of a block.
+    static constexpr size_t depth_block()
+    { return 256; }
+
+    /// @brief Get the number of columns of \f$B\f$ of a block.
+    static constexpr size_t column_block()
+    { return 128; }
+
+    /// @brief Compute the rows \f$[first,last)\f$ of the \f$m \times n\f$ matrix \f$C = A B\f$
+    /// where \f$A\f$ is an \f$m \times k\f$ matrix and \f$B\f$ is a \f$k \times n\f$ matrix.
+    /// @remark \f$C\f$ must not overlap with \f$A\f$ or \f$B\f$.
+    static void gemm(const scalar_type *a, const scalar_type *b, scalar_type *c, size_t k, size_t n, size_t first, size_t last)
+    {
+        std::fill(c + first * n, c + last * n, zero<scalar_type>());
+        for (size_t p = 0; p < k; p += depth_block())
+        {
+            const size_t kc = std::min(depth_block(), k - p);
+            for (size_t j = 0; j < n; j += column_block())
+            {
+                const size_t nc = std::min(column_block(), n - j);
+                size_t i = first;
+                for (; i + row_block() <= last; i += row_block())
+                { block<4>(a + i * k + p, k, b + p * n + j, n, c + i * n + j, n, kc, nc); }
+                switch (last - i)
+                {
+                    case 3: block<3>(a + i * k + p, k, b + p * n + j, n, c + i * n + j, n, kc, nc); break;
+                    case 2: block<2>(a + i * k + p, k, b + p * n + j, n, c + i * n + j, n, kc, nc); break;
+                    case 1: block<1>(a + i * k + p, k, b + p * n + j, n, c + i * n + j, n, kc, nc); break;
+                    default: break;
+                }
+            }
+        }
+    }
+
+    /// @brief Compute the elements \f$[first,last)\f$ of the \f$m\f$-dimensional vector \f$y = A x\f$
+    /// where \f$A\f$ is an \f$m \times n\f$ matrix and \f$x\f$ is an \f$n\f$-dimensional vector.
+    /// @remark \f$y\f$ must not overlap with \f$A\f$ or \f$x\f$.
+    static void gemv(const scalar_type *a, const scalar_type *x, scalar_type *y, size_t n, size_t first, size_t last)
+    {
+        constexpr size_t w = pack_type::width();
+        for (size_t i = first; i < last; ++i)
+        {
+            const scalar_type *r = a + i * n;
+            register_type s0 = pack_type::zero(), s1 = pack_type::zero();
+            size_t j = 0;
+            for (; j + 2 * w <= n; j += 2 * w)
+            {
+                s0 = pack_type::add(s0, pack_type::mul(pack_type::load(r + j), pack_type::load(x + j)));
+                s1 = pack_type::add(s1, pack_type::mul(pack_type::load(r + j + w), pack_type::load(x + j + w)));
+            }
+            for (; j < n; j += w)
+            {
+                const size_t l = std::min(w, n - j);
+                s0 = pack_type::add(s0, pack_type::mul(pack_type::load(r + j, l), pack_type::load(x + j, l)));
+            }
+            y[i] = pack_type::sum(pack_type::add(s0, s1));
+        }
+    }
+
+private:
+    // Add the product of a Rows x kc block of A and a kc x nc block of B to a Rows x nc block of C.
+    template <size_t Rows>
+    static void block(const scalar_type *a, size_t lda, const scalar_type *b, size_t ldb, scalar_type *c, size_t ldc, size_t kc, size_t nc)
+    {
+        constexpr size_t w = pack_type::width();
+        size_t j = 0;
+        for (; j + 2 * w <= nc; j += 2 * w)
+        {
+            register_type s[Rows][2];
+            for (size_t r = 0; r < Rows; ++r)
+            {
+                s[r][0] = pack_type::load(c + r * ldc + j);
+                s[r][1] = pack_type::load(c + r * ldc + j + w);
+            }
+            for (size_t p = 0; p < kc; ++p)
+            {
+                const register_type b0 = pack_type::load(b + p * ldb + j), b1 = pack_type::load(b + p * ldb + j + w);
+                for (size_t r = 0; r < Rows; ++r)
+                {
+                    const register_type x = pack_type::broadcast(a[r * lda + p]);
+                    s[r][0] = pack_type::add(s[r][0], pack_type::mul(x, b0));
+                    s[r][1] = pack_type::add(s[r][1], pack_type::mul(x, b1));
+                }
+            }
+            for (size_t r = 0; r < Rows; ++r)
+            {
+                pack_type::store(c + r * ldc + j, s[r][0]);
+                pack_type::store(c + r * ldc + j + w, s[r][1]);
+            }
+        }
+        for (; j < nc; j += w)
+        {
+            const size_t l = std::min(w, nc - j);
+            register_type s[Rows];
+            for (size_t r = 0; r < Rows; ++r)
+            { s[r] = pack_type::load(c + r * ldc + j, l); }
+            for (size_t p = 0; p < kc; ++p)
+            {
+                const register_type b0 = pack_type::load(b + p * ldb + j, l);
+                for (size_t r = 0; r < Rows; ++r)
+                { s[r] = pack_type::add(s[r], pack_type::mul(pack_type::broadcast(a[r * lda + p]), b0)); }
+            }
+            for (size_t r = 0; r < Rows; ++r)
+            { pack_type::store(c + r * ldc + j, s[r], l); }
+        }
+    }
+};
+
+/// @internal
+/// @brief Get the execution policy splitting the rows of a product.
+/// A row requires @a work multiply-adds. The minimum number of elements per thread of the specified policy is interpreted
+/// as the minimum number of multiply-adds per thread.
+inline execution_policy row_policy(const execution_policy& policy, size_t work)
+{
+    work = std::max<size_t>(1, work);
+    return execution_policy{ policy.number_of_threads, std::max<size_t>(1, (policy.minimum_elements_per_thread + work - 1) / work) };
+}
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Compute the product \f$C = A B\f$ of two matrices.
+/// @param a the \f$m \times k\f$ matrix \f$A\f$
+/// @param b the \f$k \times n\f$ matrix \f$B\f$
+/// @param c the matrix \f$C\f$. It is resized to \f$m \times n\f$, memory is only allocated if its capacity is exceeded.
+/// @param policy the execution policy. The rows of \f$C\f$ are split across threads.
+/// Its minimum number of elements per thread is interpreted as the minimum number of multiply-adds per thread.
+/// @throw std::invalid_argument the number of columns of \f$A\f$ is not equal to the number of rows of \f$B\f$
+/// @throw std::invalid_argument \f$C\f$ is \f$A\f$ or \f$B\f$
+template <typename Element, typename Allocator>
+void multiply(const dynamic_matrix<Element, Allocator>& a, const dynamic_matrix<Element, Allocator>& b, dynamic_matrix<Element, Allocator>& c,
+              const execution_policy& policy = execution_policy::sequential())
+{
+    if (a.number_of_columns() != b.number_of_rows())
+    {
+        throw std::invalid_argument("number of columns of left operand is not equal to number of rows of right operand");
+    }
+    if (&c == &a || &c == &b)
+    {
+        throw std::invalid_argument("result matrix is an operand");
+    }
+    const size_t k = a.number_of_columns(), n = b.number_of_columns();
+    c.resize(a.number_of_rows(), n);
+    const Element *x = a.data(), *y = b.data();
+    Element *z = c.data();
+    internal::parallel_for(a.number_of_rows(), internal::row_policy(policy, k * n), [x, y, z, k, n](size_t first, size_t last)
+    { internal::dense_kernels<Element>::gemm(x, y, z, k, n, first, last); });
+}
+
+/// @ingroup math
+/// @brief Compute the product \f$y = A x\f$ of a matrix and a vector.
+/// @param a the \f$m \times n\f$ matrix \f$A\f$
+/// @param x the \f$n\f$-dimensional vector \f$x\f$
+/// @param y the vector \f$y\f$. It is resized to \f$m\f$, memory is only allocated if its capacity is exceeded.
+/// @param policy the execution policy. The elements of \f$y\f$ are split across threads.
+/// Its minimum number of elements per thread is interpreted as the minimum number of multiply-adds per thread.
+/// @throw std::invalid_argument the number of columns of \f$A\f$ is not equal to the dimensionality of \f$x\f$
+/// @throw std::invalid_argument \f$y\f$ is \f$x\f$
+template <typename Element, typename Allocator>
+void multiply(const dynamic_matrix<Element, Allocator>& a, const dynamic_vector<Element, Allocator>& x, dynamic_vector<Element, Allocator>& y,
+              const execution_policy& policy = execution_policy::sequential())
+{
+    if (a.number_of_columns() != x.dimensionality())
+    {
+        throw std::invalid_argument("number of columns of matrix is not equal to dimensionality of vector");
+    }
+    if (&y == &x)
+    {
+        throw std::invalid_argument("result vector is an operand");
+    }
+    const size_t n = a.number_of_columns();
+    y.resize(a.number_of_rows());
+    const Element *p = a.data(), *q = x.data();
+    Element *r = y.data();
+    internal::parallel_for(a.number_of_rows(), internal::row_policy(policy, n), [p, q, r, n](size_t first, size_t last)
+    { internal::dense_kernels<Element>::gemv(p, q, r, n, first, last); });
+}
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor computing the product of two dynamic matrices.
+/// @throw std::invalid_argument the number of columns of the left operand is not equal to the number of rows of the right operand
+template <typename Element, typename Allocator>
+struct arithmetic_binary_star_functor<dynamic_matrix<Element, Allocator>, dynamic_matrix<Element, Allocator>, void>
+{
+    using matrix_type = dynamic_matrix<Element, Allocator>;
+
+    matrix_type operator()(const matrix_type& a, const matrix_type& b) const
+    {
+        matrix_type c;
+        multiply(a, b, c);
+        return c;
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor computing the product of a dynamic matrix and a dynamic vector.
+/// @throw std::invalid_argument the number of columns of the matrix is not equal to the dimensionality of the vector
+template <typename Element, typename Allocator>
+struct arithmetic_binary_star_functor<dynamic_matrix<Element, Allocator>, dynamic_vector<Element, Allocator>, void>
+{
+    using matrix_type = dynamic_matrix<Element, Allocator>;
+    using vector_type = dynamic_vector<Element, Allocator>;
+
+    vector_type operator()(const matrix_type& a, const vector_type& x) const
+    {
+        vector_type y;
+        multiply(a, x, y);
+        return y;
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::transpose_functor computing the transpose of a dynamic matrix.
+template <typename Element, typename Allocator>
+struct transpose_functor<dynamic_matrix<Element, Allocator>, void>
+{
+    using matrix_type = dynamic_matrix<Element, Allocator>;
+
+    matrix_type operator()(const matrix_type& a) const
+    {
+        matrix_type r(a.number_of_columns(), a.number_of_rows());
+        for (size_t i = 0; i < a.number_of_rows(); ++i)
+        {
+            for (size_t j = 0; j < a.number_of_columns(); ++j)
+            { r(j, i) = a(i, j); }
+        }
+        return r;
+    }
+}; // struct transpose_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting an idlib::matrix into an idlib::dynamic_matrix.
+template <typename Element, typename Allocator, size_t Number_Of_Rows, size_t Number_Of_Columns>
+struct semantic_cast_functor<dynamic_matrix<Element, Allocator>, matrix<Element, Number_Of_Rows, Number_Of_Columns>, void>
+{
+    dynamic_matrix<Element, Allocator> operator()(const matrix<Element, Number_Of_Rows, Number_Of_Columns>& a) const
+    {
+        dynamic_matrix<Element, Allocator> r(Number_Of_Rows, Number_Of_Columns);
+        for (size_t i = 0; i < Number_Of_Rows * Number_Of_Columns; ++i)
+        { r(i) = a(i); }
+        return r;
+    }
+}; // struct semantic_cast_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting an idlib::dynamic_matrix into an idlib::matrix.
+/// @throw std::invalid_argument the numbers of rows or columns of the matrices are not equal
+template <typename Element, size_t Number_Of_Rows, size_t Number_Of_Columns, typename Allocator>
+struct semantic_cast_functor<matrix<Element, Number_Of_Rows, Number_Of_Columns>, dynamic_matrix<Element, Allocator>, void>
+{
+    matrix<Element, Number_Of_Rows, Number_Of_Columns> operator()(const dynamic_matrix<Element, Allocator>& a) const
+    {
+        if (a.number_of_rows() != Number_Of_Rows || a.number_of_columns() != Number_Of_Columns)
+        {
+            throw std::invalid_argument("numbers of rows or columns of matrices are not equal");
+        }
+        matrix<Element, Number_Of_Rows, Number_Of_Columns> r;
+        for (size_t i = 0; i < Number_Of_Rows * Number_Of_Columns; ++i)
+        { r(i) = a(i); }
+        return r;
+    }
+}; // struct semantic_cast_functor
+
+} // namespace idlib
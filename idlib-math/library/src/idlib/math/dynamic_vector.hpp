@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/dynamic_vector.hpp
+/// @brief Vectors with a dimensionality determined at run time.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/dot_product.hpp"
+#include "idlib/math/vector.hpp"
+#include "idlib/semantic_cast.hpp"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A vector with a dimensionality determined at run time.
+/// @remark The components are stored contiguously in memory obtained from the allocator.
+/// An arena is used by specifying an allocator drawing from it, e.g. <c>std::pmr::polymorphic_allocator<Scalar></c>.
+/// @remark A dynamic vector is converted into an idlib::vector and vice versa by idlib::semantic_cast.
+/// @tparam Scalar the scalar type
+/// @tparam Allocator the allocator type
+template <typename Scalar, typename Allocator = std::allocator<Scalar>>
+struct dynamic_vector
+{
+public:
+    /// @brief The scalar type.
+    using scalar_type = Scalar;
+
+    /// @brief The allocator type.
+    using allocator_type = Allocator;
+
+    /// @brief The type of this template/template specialization.
+    using vector_type = dynamic_vector<scalar_type, allocator_type>;
+
+    /// @brief Construct this vector with the dimensionality @a 0.
+    /// @param allocator the allocator
+    explicit dynamic_vector(const allocator_type& allocator = allocator_type())
+        : m_elements(allocator)
+    {}
+
+    /// @brief Construct this vector with the zero vector of the specified dimensionality.
+    /// @param dimensionality the dimensionality
+    /// @param allocator the allocator
+    explicit dynamic_vector(size_t dimensionality, const allocator_type& allocator = allocator_type())
+        : m_elements(dimensionality, zero<scalar_type>(), allocator)
+    {}
+
+    dynamic_vector(const vector_type& other) = default;
+
+    dynamic_vector(vector_type&& other) = default;
+
+    vector_type& operator=(const vector_type& other) = default;
+
+    vector_type& operator=(vector_type&& other) = default;
+
+public:
+    /// @brief Get the dimensionality of this vector.
+    /// @return the dimensionality
+    size_t dimensionality() const
+    { return m_elements.size(); }
+
+    /// @brief Set the dimensionality of this vector.
+    /// @param dimensionality the dimensionality
+    /// @post This vector is the zero vector of the specified dimensionality.
+    void resize(size_t dimensionality)
+    { m_elements.assign(dimensionality, zero<scalar_type>()); }
+
+    /// @{
+    /// @brief Get a pointer to the components.
+    /// @return a pointer to the components
+    scalar_type *data()
+    { return m_elements.data(); }
+
+    const scalar_type *data() const
+    { return m_elements.data(); }
+    /// @}
+
+    /// @{
+    /// @brief Get the component at the specified index.
+    /// @param i the index. Must be within the bounds of \f$[0,dimensionality())\f$.
+    /// @return a reference to the component
+    scalar_type& operator[](size_t i)
+    { return m_elements[i]; }
+
+    const scalar_type& operator[](size_t i) const
+    { return m_elements[i]; }
+
+    scalar_type& operator()(size_t i)
+    { return m_elements[i]; }
+
+    const scalar_type& operator()(size_t i) const
+    { return m_elements[i]; }
+    /// @}
+
+    bool operator==(const vector_type& other) const
+    { return m_elements == other.m_elements; }
+
+    bool operator!=(const vector_type& other) const
+    { return m_elements != other.m_elements; }
+
+    /// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+    vector_type& operator+=(const vector_type& other)
+    {
+        check(other);
+        for (size_t i = 0; i < dimensionality(); ++i)
+        { m_elements[i] += other.m_elements[i]; }
+        return *this;
+    }
+
+    /// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+    vector_type& operator-=(const vector_type& other)
+    {
+        check(other);
+        for (size_t i = 0; i < dimensionality(); ++i)
+        { m_elements[i] -= other.m_elements[i]; }
+        return *this;
+    }
+
+    vector_type& operator*=(scalar_type other)
+    {
+        for (auto& element : m_elements)
+        { element *= other; }
+        return *this;
+    }
+
+    /// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+    vector_type operator+(const vector_type& other) const
+    { auto t = *this; t += other; return t; }
+
+    /// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+    vector_type operator-(const vector_type& other) const
+    { auto t = *this; t -= other; return t; }
+
+    vector_type operator*(scalar_type other) const
+    { auto t = *this; t *= other; return t; }
+
+    vector_type operator-() const
+    { auto t = *this; t *= -one<scalar_type>(); return t; }
+
+private:
+    void check(const vector_type& other) const
+    {
+        if (dimensionality() != other.dimensionality())
+        {
+            throw std::invalid_argument("dimensionalities of vectors are not equal");
+        }
+    }
+
+    /// @brief The components.
+    std::vector<scalar_type, allocator_type> m_elements;
+
+}; // struct dynamic_vector
+
+/// @brief Specialization of idlib::dot_product_functor for idlib::dynamic_vector.
+/// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+template <typename Scalar, typename Allocator>
+struct dot_product_functor<dynamic_vector<Scalar, Allocator>>
+{
+    Scalar operator()(const dynamic_vector<Scalar, Allocator>& v, const dynamic_vector<Scalar, Allocator>& w) const
+    {
+        if (v.dimensionality() != w.dimensionality())
+        {
+            throw std::invalid_argument("dimensionalities of vectors are not equal");
+        }
+        Scalar s = zero<Scalar>();
+        for (size_t i = 0; i < v.dimensionality(); ++i)
+        { s += v[i] * w[i]; }
+        return s;
+    }
+}; // struct dot_product_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting an idlib::vector into an idlib::dynamic_vector.
+template <typename Scalar, typename Allocator, size_t Dimensionality>
+struct semantic_cast_functor<dynamic_vector<Scalar, Allocator>, vector<Scalar, Dimensionality>, void>
+{
+    dynamic_vector<Scalar, Allocator> operator()(const vector<Scalar, Dimensionality>& v) const
+    {
+        dynamic_vector<Scalar, Allocator> w(Dimensionality);
+        for (size_t i = 0; i < Dimensionality; ++i)
+        { w[i] = v[i]; }
+        return w;
+    }
+}; // struct semantic_cast_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting an idlib::dynamic_vector into an idlib::vector.
+/// @throw std::invalid_argument the dimensionalities of the vectors are not equal
+template <typename Scalar, size_t Dimensionality, typename Allocator>
+struct semantic_cast_functor<vector<Scalar, Dimensionality>, dynamic_vector<Scalar, Allocator>, void>
+{
+    vector<Scalar, Dimensionality> operator()(const dynamic_vector<Scalar, Allocator>& v) const
+    {
+        if (v.dimensionality() != Dimensionality)
+        {
+            throw std::invalid_argument("dimensionalities of vectors are not equal");
+        }
+        vector<Scalar, Dimensionality> w;
+        for (size_t i = 0; i < Dimensionality; ++i)
+        { w[i] = v[i]; }
+        return w;
+    }
+}; // struct semantic_cast_functor
+
+} // namespace idlib
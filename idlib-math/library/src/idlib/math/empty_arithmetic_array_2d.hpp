@@ -64,6 +64,10 @@ struct arithmetic_array_2d<Element, Width, Height, Zero,
     /// @brief Default construct with the zero element value.
     arithmetic_array_2d()
     {}
+
+    /// @brief Construct without initializing the element values.
+    explicit arithmetic_array_2d(uninitialized_t)
+    {}
         
     arithmetic_array_2d(const arithmetic_array_2d& other) = default;
     
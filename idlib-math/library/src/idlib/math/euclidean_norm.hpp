@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include "idlib/numeric.hpp"
+
 namespace idlib {
 
 /// @ingroup math
@@ -37,11 +39,12 @@ namespace idlib {
 /// \sqrt{\sum_{i=0}^{n-1} v_i^2}
 /// \f]
 /// @tparam Vector the vector type
-template <typename Vector>
+/// @tparam P the precision policy of the square root
+template <typename Vector, precision P = precision::exact>
 struct euclidean_norm_functor;
 
-template <typename Vector>
-auto euclidean_norm(const Vector& v) -> decltype(euclidean_norm_functor<Vector>()(v))
-{ return euclidean_norm_functor<Vector>()(v); }
+template <precision P = precision::exact, typename Vector>
+auto euclidean_norm(const Vector& v) -> decltype(euclidean_norm_functor<Vector, P>()(v))
+{ return euclidean_norm_functor<Vector, P>()(v); }
 
 } // namespace idlib
@@ -9,7 +9,7 @@ template <typename T, typename Enabled = void>
 struct identity_functor;
 
 template <typename T>
-auto identity() -> decltype(identity_functor<T>()())
+constexpr auto identity() -> decltype(identity_functor<T>()())
 { return identity_functor<T>()(); }
 
 } // namespace idlib
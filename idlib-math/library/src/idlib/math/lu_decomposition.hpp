@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/lu_decomposition.hpp
+/// @brief LU decomposition of square matrices and solution of linear systems.
+/// @author Michael Heilmann
+
+/// @detail
+/// A linear system \f$A x = b\f$ is solved by
+/// @code
+/// auto x = idlib::solve(a, b);
+/// @endcode
+/// If several systems with the same matrix \f$A\f$ are solved, the decomposition is computed once and reused:
+/// @code
+/// idlib::lu_decomposition<single, 6> lu(a);
+/// for (const auto& b : right_hand_sides)
+/// { auto x = lu.solve(b); ... }
+/// @endcode
+
+#pragma once
+
+#include "idlib/math/decomposition_kernels.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/vector.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The LU decomposition \f$P A = L U\f$ of an \f$N \times N\f$ matrix \f$A\f$ with partial pivoting,
+/// where \f$P\f$ is a permutation matrix, \f$L\f$ is a unit lower triangular matrix and \f$U\f$ is an upper triangular matrix.
+/// @tparam Element the element type. Must be a floating point type.
+/// @tparam N the number of rows and columns
+template <typename Element, size_t N>
+struct lu_decomposition
+{
+    static_assert(std::is_floating_point<Element>::value, "Element must be a floating point type");
+
+public:
+    /// @brief The element type.
+    using element_type = Element;
+
+    /// @brief The matrix type.
+    using matrix_type = matrix<element_type, N, N>;
+
+    /// @brief The vector type.
+    using vector_type = vector<element_type, N>;
+
+    /// @brief Construct this LU decomposition.
+    /// @param a the matrix \f$A\f$
+    explicit lu_decomposition(const matrix_type& a)
+        : m_lu(a)
+    {
+        m_regular = kernels::lu(&(m_lu._v[0]), m_permutation, m_sign);
+        if (m_regular)
+        { kernels::reciprocal_diagonal(&(m_lu._v[0]), m_reciprocals); }
+    }
+
+    /// @brief Get if the matrix \f$A\f$ is singular.
+    /// @return @a true if \f$A\f$ is singular, @a false otherwise
+    bool is_singular() const
+    { return !m_regular; }
+
+    /// @brief Get the determinant of the matrix \f$A\f$.
+    /// @return the determinant
+    element_type determinant() const
+    {
+        if (!m_regular)
+        { return zero<element_type>(); }
+        element_type d = m_sign;
+        for (size_t i = 0; i < N; ++i)
+        { d *= m_lu(i, i); }
+        return d;
+    }
+
+    /// @brief Get the matrix \f$L\f$.
+    /// @return the matrix \f$L\f$
+    matrix_type lower() const
+    {
+        matrix_type l;
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            { l(i, j) = m_lu(i, j); }
+            l(i, i) = one<element_type>();
+        }
+        return l;
+    }
+
+    /// @brief Get the matrix \f$U\f$.
+    /// @return the matrix \f$U\f$
+    matrix_type upper() const
+    {
+        matrix_type u;
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = i; j < N; ++j)
+            { u(i, j) = m_lu(i, j); }
+        }
+        return u;
+    }
+
+    /// @brief Get the permutation.
+    /// @param i the row index. Must be within the bounds of \f$[0,N)\f$.
+    /// @return the index of the row of \f$A\f$ which is row @a i of \f$P A\f$
+    size_t permutation(size_t i) const
+    { return m_permutation[i]; }
+
+    /// @brief Solve \f$A x = b\f$.
+    /// @param b the right-hand side \f$b\f$
+    /// @return the solution \f$x\f$
+    /// @throw std::domain_error the matrix \f$A\f$ is singular
+    vector_type solve(const vector_type& b) const
+    {
+        ensure_regular();
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = b[i]; }
+        kernels::lu_solve(&(m_lu._v[0]), m_permutation, m_reciprocals, y, 1);
+        vector_type x = b;
+        for (size_t i = 0; i < N; ++i)
+        { x[i] = y[i]; }
+        return x;
+    }
+
+    /// @brief Solve \f$A X = B\f$.
+    /// @param b the right-hand sides \f$B\f$
+    /// @return the solutions \f$X\f$
+    /// @throw std::domain_error the matrix \f$A\f$ is singular
+    template <size_t K>
+    matrix<element_type, N, K> solve(const matrix<element_type, N, K>& b) const
+    {
+        ensure_regular();
+        matrix<element_type, N, K> x = b;
+        for (size_t j = 0; j < K; ++j)
+        { kernels::lu_solve(&(m_lu._v[0]), m_permutation, m_reciprocals, &(x._v[j]), K); }
+        return x;
+    }
+
+    /// @brief Compute the inverse of the matrix \f$A\f$.
+    /// @return the inverse
+    /// @throw std::domain_error the matrix \f$A\f$ is singular
+    matrix_type inverse() const
+    { return solve(identity<matrix_type>()); }
+
+private:
+    using kernels = internal::decomposition_kernels<element_type, N>;
+
+    void ensure_regular() const
+    {
+        if (!m_regular)
+        {
+            throw std::domain_error("Cannot solve linear system with singular matrix");
+        }
+    }
+
+    /// @brief \f$L\f$ below the diagonal and \f$U\f$ on and above the diagonal.
+    matrix_type m_lu;
+
+    /// @brief The permutation.
+    size_t m_permutation[N];
+
+    /// @brief The reciprocals of the diagonal elements of \f$U\f$.
+    element_type m_reciprocals[N];
+
+    /// @brief The sign of the permutation.
+    element_type m_sign;
+
+    /// @brief @a true if \f$A\f$ is regular, @a false otherwise.
+    bool m_regular;
+
+}; // struct lu_decomposition
+
+/// @ingroup math
+/// @brief Solve \f$A x = b\f$ by the LU decomposition of \f$A\f$.
+/// @param a the matrix \f$A\f$
+/// @param b the right-hand side \f$b\f$
+/// @return the solution \f$x\f$
+/// @throw std::domain_error the matrix \f$A\f$ is singular
+/// @remark To solve several systems with the same matrix, construct an idlib::lu_decomposition once and use its solve functions.
+template <typename Element, size_t N>
+vector<Element, N> solve(const matrix<Element, N, N>& a, const vector<Element, N>& b)
+{ return lu_decomposition<Element, N>(a).solve(b); }
+
+/// @ingroup math
+/// @brief Solve \f$A X = B\f$ by the LU decomposition of \f$A\f$.
+/// @param a the matrix \f$A\f$
+/// @param b the right-hand sides \f$B\f$
+/// @return the solutions \f$X\f$
+/// @throw std::domain_error the matrix \f$A\f$ is singular
+template <typename Element, size_t N, size_t K>
+matrix<Element, N, K> solve(const matrix<Element, N, N>& a, const matrix<Element, N, K>& b)
+{ return lu_decomposition<Element, N>(a).solve(b); }
+
+} // namespace idlib
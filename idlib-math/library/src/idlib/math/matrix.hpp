@@ -33,6 +33,8 @@
 #include "idlib/crtp.hpp"
 #include "idlib/debug.hpp"
 #include "idlib/math/arithmetic_array_2d.hpp"
+#include "idlib/math/decomposition_kernels.hpp"
+#include "idlib/math/simd_matrix.hpp"
 #include "idlib/numeric.hpp"
 #include "idlib/math/trace.hpp"
 #include "idlib/math/transpose.hpp"
@@ -87,11 +89,9 @@ struct matrix<Element,
 
     /// @brief Get the order of this matrix type.
     /// @return the order of this matrix type
-#if defined(_MSC_VER) && (_MSC_VER >= 1913)
-    constexpr static std::enable_if_t<Number_Of_Rows == Number_Of_Columns, size_t>
-#else
-    constexpr static std::enable_if_t<matrix::is_square(), size_t>
-#endif
+    /// @remark This function is only available if this matrix type is square.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    constexpr static std::enable_if_t<N == M, size_t>
     order()
     { return number_of_rows(); }
 
@@ -140,7 +140,7 @@ struct matrix<Element,
              typename = std::enable_if_t<(sizeof...(Args) == MyType::number_of_elements())
                                          &&
                                          (idlib::all_true<std::is_convertible<Args, element_type>::value ...>::value)>>
-    matrix(Args&& ... args)
+    constexpr matrix(Args&& ... args)
         : _v { static_cast<element_type>(args) ... }
     {
         static_assert(number_of_elements() == sizeof ... (args), "wrong number of arguments");
@@ -150,19 +150,28 @@ struct matrix<Element,
      * @brief
      *  Construct this matrix with default element values.
      */
-    matrix() {
+    constexpr matrix()
+        : _v{} {
         for (size_t i = 0; i < number_of_elements(); ++i) {
             _v[i] = idlib::zero<element_type>();
         }
     }
 
+    /**
+     * @brief
+     *  Construct this matrix without initializing its element values.
+     */
+    explicit matrix(uninitialized_t)
+    {}
+
     /**
      * @brief
      *  Construct this matrix with the element values of another matrix.
      * @param other
      *  the other matrix
      */
-    matrix(const matrix& other) {
+    constexpr matrix(const matrix& other)
+        : _v{} {
         for (size_t i = 0; i < number_of_elements(); ++i) {
             _v[i] = other._v[i];
         }
@@ -179,7 +188,7 @@ protected:
      * @post
      *  This matrix was assigned the values of another matrix.
      */
-    void assign(const matrix& other) {
+    constexpr void assign(const matrix& other) {
         for (size_t i = 0; i < number_of_elements(); ++i) {
             _v[i] = other._v[i];
         }
@@ -193,7 +202,7 @@ protected:
      * @return
      *  the matrix element
      */
-    element_type& at(const size_t i) {
+    constexpr element_type& at(const size_t i) {
         IDLIB_DEBUG_ASSERT(i < number_of_elements());
         return _v[i];
     }
@@ -206,7 +215,7 @@ protected:
      * @return
      *  the matrix element
      */
-    const element_type& at(const size_t i) const {
+    constexpr const element_type& at(const size_t i) const {
         IDLIB_DEBUG_ASSERT(i < number_of_elements());
         return _v[i];
     }
@@ -221,10 +230,10 @@ protected:
      * @return
      *  the matrix element
      */
-    element_type& at(const size_t i, const size_t j) {
+    constexpr element_type& at(const size_t i, const size_t j) {
         IDLIB_DEBUG_ASSERT(i < number_of_rows());
         IDLIB_DEBUG_ASSERT(j < number_of_columns());
-        return _v2[i][j];
+        return _v[i * number_of_columns() + j];
     }
 
     /**
@@ -237,15 +246,15 @@ protected:
      * @return
      *  the matrix element
      */
-    const element_type& at(const size_t i, const size_t j) const {
+    constexpr const element_type& at(const size_t i, const size_t j) const {
         IDLIB_DEBUG_ASSERT(i < number_of_rows());
         IDLIB_DEBUG_ASSERT(j < number_of_columns());
-        return _v2[i][j];
+        return _v[i * number_of_columns() + j];
     }
 
 public:
     // CRTP
-    bool equal_to(const matrix& other) const {
+    constexpr bool equal_to(const matrix& other) const {
         for (size_t i = 0; i < number_of_elements(); ++i) {
             if (at(i) != other.at(i)) {
                 return false;
@@ -256,16 +265,16 @@ public:
 
 public:
 
-    const element_type& operator()(const size_t i) const
+    constexpr const element_type& operator()(const size_t i) const
     { return at(i); }
 
-    element_type& operator()(const size_t i)
+    constexpr element_type& operator()(const size_t i)
     { return at(i); }
 
-    const element_type& operator()(const size_t i, const size_t j) const
+    constexpr const element_type& operator()(const size_t i, const size_t j) const
     { return at(i, j); }
 
-    element_type& operator()(const size_t i, const size_t j)
+    constexpr element_type& operator()(const size_t i, const size_t j)
     { return at(i, j); }
 
 public:
@@ -280,122 +289,211 @@ public:
      * @post
      *  This matrix was assigned the values of another matrix.
      */
-    matrix& operator=(const matrix& other) {
+    constexpr matrix& operator=(const matrix& other) {
         assign(other);
         return *this;
     }
 
 public:
-    matrix& operator+=(const matrix& other)
+    /// @{
+    /// @brief Compound assignment operators.
+    /// @remark The elements of this matrix are modified in place, no temporary matrix is created.
+    constexpr matrix& operator+=(const matrix& other)
     {
-        *this = *this + other;
+        for (size_t i = 0; i < number_of_elements(); ++i) {
+            _v[i] += other._v[i];
+        }
         return *this;
     }
 
-    matrix& operator-=(const matrix& other)
+    constexpr matrix& operator-=(const matrix& other)
     {
-        *this = *this - other;
+        for (size_t i = 0; i < number_of_elements(); ++i) {
+            _v[i] -= other._v[i];
+        }
         return *this;
     }
 
-    matrix& operator*=(const element_type& other)
+    constexpr matrix& operator*=(const element_type& other)
     {
-        *this = *this * other;
+        for (size_t i = 0; i < number_of_elements(); ++i) {
+            _v[i] *= other;
+        }
         return *this;
     }
 
-    matrix& operator/=(const element_type& other)
+    constexpr matrix& operator/=(const element_type& other)
     {
-        *this = *this / other;
+        for (size_t i = 0; i < number_of_elements(); ++i) {
+            _v[i] /= other;
+        }
         return *this;
     }
+    /// @}
 
     /**
      * Overloaded assignment multiplication operator.
+     * @remark The product is computed in place row by row, only a copy of the current row is created.
+     * If the other matrix is this matrix, a temporary matrix is created.
      */
     /// @todo Does not work for non-square matrices.
-    matrix& operator*=(const matrix& other) {
-        *this = *this * other;
+    constexpr matrix& operator*=(const matrix& other) {
+        return internal::is_constant_evaluated()
+             ? multiply_assign(other, std::false_type{})
+             : multiply_assign(other, std::integral_constant<bool, is_simd_matrix4()>{});
+    }
+
+private:
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    std::enable_if_t<N == 4 && M == 4, matrix&> multiply_assign(const matrix& other, std::true_type) {
+        simd_matrix4_type::mul(&(_v[0]), &(other._v[0]), &(_v[0]));
+        return *this;
+    }
+
+    constexpr matrix& multiply_assign(const matrix& other, std::false_type) {
+        if (this == &other) {
+            *this = *this * other;
+            return *this;
+        }
+        element_type row[number_of_columns()] = {};
+        for (size_t i = 0; i < number_of_rows(); ++i) {
+            for (size_t k = 0; k < number_of_columns(); ++k) {
+                row[k] = at(i, k);
+            }
+            for (size_t j = 0; j < number_of_columns(); ++j) {
+                element_type t = zero<element_type>();
+                for (size_t k = 0; k < number_of_columns(); ++k) {
+                    t += row[k] * other.at(k, j);
+                }
+                at(i, j) = t;
+            }
+        }
         return *this;
     }
 
+public:
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<(N == 1 && M == 1), element_type>
+    constexpr std::enable_if_t<(N == 1 && M == 1), element_type>
     det() const
     {
         static_assert(matrix::is_square(), "determinant on non-square matrix");
-        return _v2[0][0];
+        return at(0, 0);
     }
 
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == 2 && M == 2, element_type>
+    constexpr std::enable_if_t<N == 2 && M == 2, element_type>
     det() const
     {
         static_assert(matrix::is_square(), "determinant on non-square matrix");
-        return _v2[0][0] * _v2[1][1] - _v2[0][1] * _v2[1][0];
+        return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
     }
 
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == 3 && M == 3, element_type>
+    constexpr std::enable_if_t<N == 3 && M == 3, element_type>
     det() const
     {
         static_assert(matrix::is_square(), "determinant on non-square matrix");
-        return _v2[0][0] * (_v2[1][1] * _v2[2][2] - _v2[2][1] * _v2[1][2]) -
-               _v2[0][1] * (_v2[1][0] * _v2[2][2] - _v2[1][2] * _v2[2][0]) +
-               _v2[0][2] * (_v2[1][0] * _v2[2][1] - _v2[1][1] * _v2[2][0]);
+        return at(0, 0) * (at(1, 1) * at(2, 2) - at(2, 1) * at(1, 2)) -
+               at(0, 1) * (at(1, 0) * at(2, 2) - at(1, 2) * at(2, 0)) +
+               at(0, 2) * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0));
     }
 
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == 4 && M == 4, element_type>
+    constexpr std::enable_if_t<N == 4 && M == 4, element_type>
     det() const
     {
         static_assert(matrix::is_square(), "determinant on non-square matrix");
         return
-            _v2[0][3] * _v2[1][2] * _v2[2][1] * _v2[3][0] - _v2[0][2] * _v2[1][3] * _v2[2][1] * _v2[3][0] -
-            _v2[0][3] * _v2[1][1] * _v2[2][2] * _v2[3][0] + _v2[0][1] * _v2[1][3] * _v2[2][2] * _v2[3][0] +
-            _v2[0][2] * _v2[1][1] * _v2[2][3] * _v2[3][0] - _v2[0][1] * _v2[1][2] * _v2[2][3] * _v2[3][0] -
-            _v2[0][3] * _v2[1][2] * _v2[2][0] * _v2[3][1] + _v2[0][2] * _v2[1][3] * _v2[2][0] * _v2[3][1] +
-            _v2[0][3] * _v2[1][0] * _v2[2][2] * _v2[3][1] - _v2[0][0] * _v2[1][3] * _v2[2][2] * _v2[3][1] -
-            _v2[0][2] * _v2[1][0] * _v2[2][3] * _v2[3][1] + _v2[0][0] * _v2[1][2] * _v2[2][3] * _v2[3][1] +
-            _v2[0][3] * _v2[1][1] * _v2[2][0] * _v2[3][2] - _v2[0][1] * _v2[1][3] * _v2[2][0] * _v2[3][2] -
-            _v2[0][3] * _v2[1][0] * _v2[2][1] * _v2[3][2] + _v2[0][0] * _v2[1][3] * _v2[2][1] * _v2[3][2] +
-            _v2[0][1] * _v2[1][0] * _v2[2][3] * _v2[3][2] - _v2[0][0] * _v2[1][1] * _v2[2][3] * _v2[3][2] -
-            _v2[0][2] * _v2[1][1] * _v2[2][0] * _v2[3][3] + _v2[0][1] * _v2[1][2] * _v2[2][0] * _v2[3][3] +
-            _v2[0][2] * _v2[1][0] * _v2[2][1] * _v2[3][3] - _v2[0][0] * _v2[1][2] * _v2[2][1] * _v2[3][3] -
-            _v2[0][1] * _v2[1][0] * _v2[2][2] * _v2[3][3] + _v2[0][0] * _v2[1][1] * _v2[2][2] * _v2[3][3];
+            at(0, 3) * at(1, 2) * at(2, 1) * at(3, 0) - at(0, 2) * at(1, 3) * at(2, 1) * at(3, 0) -
+            at(0, 3) * at(1, 1) * at(2, 2) * at(3, 0) + at(0, 1) * at(1, 3) * at(2, 2) * at(3, 0) +
+            at(0, 2) * at(1, 1) * at(2, 3) * at(3, 0) - at(0, 1) * at(1, 2) * at(2, 3) * at(3, 0) -
+            at(0, 3) * at(1, 2) * at(2, 0) * at(3, 1) + at(0, 2) * at(1, 3) * at(2, 0) * at(3, 1) +
+            at(0, 3) * at(1, 0) * at(2, 2) * at(3, 1) - at(0, 0) * at(1, 3) * at(2, 2) * at(3, 1) -
+            at(0, 2) * at(1, 0) * at(2, 3) * at(3, 1) + at(0, 0) * at(1, 2) * at(2, 3) * at(3, 1) +
+            at(0, 3) * at(1, 1) * at(2, 0) * at(3, 2) - at(0, 1) * at(1, 3) * at(2, 0) * at(3, 2) -
+            at(0, 3) * at(1, 0) * at(2, 1) * at(3, 2) + at(0, 0) * at(1, 3) * at(2, 1) * at(3, 2) +
+            at(0, 1) * at(1, 0) * at(2, 3) * at(3, 2) - at(0, 0) * at(1, 1) * at(2, 3) * at(3, 2) -
+            at(0, 2) * at(1, 1) * at(2, 0) * at(3, 3) + at(0, 1) * at(1, 2) * at(2, 0) * at(3, 3) +
+            at(0, 2) * at(1, 0) * at(2, 1) * at(3, 3) - at(0, 0) * at(1, 2) * at(2, 1) * at(3, 3) -
+            at(0, 1) * at(1, 0) * at(2, 2) * at(3, 3) + at(0, 0) * at(1, 1) * at(2, 2) * at(3, 3);
     }
 
+    /// @remark The determinant is computed by the LU decomposition with partial pivoting.
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == M && N == 2, matrix<element_type, N, M>> inverse() const
+    std::enable_if_t<N == M && (N > 4) && std::is_floating_point<element_type>::value, element_type>
+    det() const
+    {
+        matrix lu(*this);
+        size_t p[N];
+        element_type d;
+        if (!internal::decomposition_kernels<element_type, N>::lu(&(lu._v[0]), p, d))
+        {
+            return zero<element_type>();
+        }
+        for (size_t i = 0; i < N; ++i)
+        {
+            d *= lu._v[i * N + i];
+        }
+        return d;
+    }
+
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    constexpr std::enable_if_t<N == M && N == 2, matrix<element_type, N, M>> inverse() const
     {
         const element_type determinant = det();
         matrix result;
-        result._v2[0][0] =  _v2[1][1] / determinant;
-        result._v2[0][1] = -_v2[0][1] / determinant;
-        result._v2[1][0] = -_v2[1][0] / determinant;
-        result._v2[1][1] =  _v2[0][0] / determinant;
+        result.at(0, 0) =  at(1, 1) / determinant;
+        result.at(0, 1) = -at(0, 1) / determinant;
+        result.at(1, 0) = -at(1, 0) / determinant;
+        result.at(1, 1) =  at(0, 0) / determinant;
         return result;
     }
 
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == M && N == 3, matrix> inverse() const
+    constexpr std::enable_if_t<N == M && N == 3, matrix> inverse() const
     {
         const element_type determinant = det();
         matrix result;
-        result._v2[0][0] = (_v2[1][1] * _v2[2][2] - _v2[2][1] * _v2[1][2]) / determinant;
-        result._v2[0][1] = (_v2[0][2] * _v2[2][1] - _v2[0][1] * _v2[2][2]) / determinant;
-        result._v2[0][2] = (_v2[0][1] * _v2[1][2] - _v2[0][2] * _v2[1][1]) / determinant;
-        result._v2[1][0] = (_v2[1][2] * _v2[2][0] - _v2[1][0] * _v2[2][2]) / determinant;
-        result._v2[1][1] = (_v2[0][0] * _v2[2][2] - _v2[0][2] * _v2[2][0]) / determinant;
-        result._v2[1][2] = (_v2[1][0] * _v2[0][2] - _v2[0][0] * _v2[1][2]) / determinant;
-        result._v2[2][0] = (_v2[1][0] * _v2[2][1] - _v2[2][0] * _v2[1][1]) / determinant;
-        result._v2[2][1] = (_v2[2][0] * _v2[0][1] - _v2[0][0] * _v2[2][1]) / determinant;
-        result._v2[2][2] = (_v2[0][0] * _v2[1][1] - _v2[1][0] * _v2[0][1]) / determinant;
+        result.at(0, 0) = (at(1, 1) * at(2, 2) - at(2, 1) * at(1, 2)) / determinant;
+        result.at(0, 1) = (at(0, 2) * at(2, 1) - at(0, 1) * at(2, 2)) / determinant;
+        result.at(0, 2) = (at(0, 1) * at(1, 2) - at(0, 2) * at(1, 1)) / determinant;
+        result.at(1, 0) = (at(1, 2) * at(2, 0) - at(1, 0) * at(2, 2)) / determinant;
+        result.at(1, 1) = (at(0, 0) * at(2, 2) - at(0, 2) * at(2, 0)) / determinant;
+        result.at(1, 2) = (at(1, 0) * at(0, 2) - at(0, 0) * at(1, 2)) / determinant;
+        result.at(2, 0) = (at(1, 0) * at(2, 1) - at(2, 0) * at(1, 1)) / determinant;
+        result.at(2, 1) = (at(2, 0) * at(0, 1) - at(0, 0) * at(2, 1)) / determinant;
+        result.at(2, 2) = (at(0, 0) * at(1, 1) - at(1, 0) * at(0, 1)) / determinant;
+        return result;
+    }
+
+    /// @brief Compute the inverse of this matrix.
+    /// @return the inverse of this matrix
+    /// @throw std::domain_error the determinant of this matrix is zero
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    constexpr std::enable_if_t<N == M && N == 4, matrix> inverse() const
+    {
+        return internal::is_constant_evaluated()
+             ? inverse(std::false_type{})
+             : inverse(std::integral_constant<bool, is_simd_matrix4()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this matrix using the SIMD code path.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    std::enable_if_t<N == M && N == 4, matrix> inverse(std::true_type) const
+    {
+        matrix result(uninitialized);
+        if (!simd_matrix4_type::inverse(&(_v[0]), &(result._v[0])))
+        {
+            throw std::domain_error("Cannot inverse matrix with 0 determinant");
+        }
         return result;
     }
 
+    /// @internal
+    /// @brief Compute the inverse of this matrix using the scalar code path.
     template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
-    std::enable_if_t<N == M && N == 4, matrix> inverse() const
+    constexpr std::enable_if_t<N == M && N == 4, matrix> inverse(std::false_type) const
     {
         matrix result;
 
@@ -527,6 +625,107 @@ public:
 
         return result;
     }
+
+    /// @brief Compute the inverse of this matrix.
+    /// @return the inverse of this matrix
+    /// @throw std::domain_error the determinant of this matrix is zero
+    /// @remark The inverse is computed by the LU decomposition with partial pivoting.
+    /// To solve linear systems, use idlib::solve or idlib::lu_decomposition instead of computing the inverse.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    std::enable_if_t<N == M && (N > 4) && std::is_floating_point<element_type>::value, matrix> inverse() const
+    {
+        using kernels = internal::decomposition_kernels<element_type, N>;
+        matrix lu(*this), result;
+        size_t p[N];
+        element_type sign, r[N];
+        if (!kernels::lu(&(lu._v[0]), p, sign))
+        {
+            throw std::domain_error("Cannot inverse matrix with 0 determinant");
+        }
+        kernels::reciprocal_diagonal(&(lu._v[0]), r);
+        for (size_t i = 0; i < N; ++i)
+        {
+            result._v[i * N + i] = one<element_type>();
+        }
+        for (size_t j = 0; j < N; ++j)
+        {
+            kernels::lu_solve(&(lu._v[0]), p, r, &(result._v[j]), N);
+        }
+        return result;
+    }
+
+    /// @brief Compute the inverse of this affine transformation matrix.
+    /// @return the inverse of this matrix
+    /// @throw std::domain_error the determinant of the upper left \f$3 \times 3\f$ matrix is zero
+    /// @pre The last row of this matrix is \f$(0, 0, 0, 1)\f$. It is not read.
+    /// @remark The inverse of \f$\begin{pmatrix} A & t \\ 0 & 1 \end{pmatrix}\f$ is
+    /// \f$\begin{pmatrix} A^{-1} & -A^{-1}t \\ 0 & 1 \end{pmatrix}\f$.
+    /// Computing it is considerably cheaper than computing the inverse of a general matrix.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    constexpr std::enable_if_t<N == M && N == 4, matrix> affine_inverse() const
+    {
+        return internal::is_constant_evaluated()
+             ? affine_inverse(std::false_type{})
+             : affine_inverse(std::integral_constant<bool, is_simd_matrix4()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this affine transformation matrix using the SIMD code path.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    std::enable_if_t<N == M && N == 4, matrix> affine_inverse(std::true_type) const
+    {
+        matrix result(uninitialized);
+        if (!simd_matrix4_type::affine_inverse(&(_v[0]), &(result._v[0])))
+        {
+            throw std::domain_error("Cannot inverse matrix with 0 determinant");
+        }
+        return result;
+    }
+
+    /// @internal
+    /// @brief Compute the inverse of this affine transformation matrix using the scalar code path.
+    template <size_t N = Number_Of_Rows, size_t M = Number_Of_Columns>
+    constexpr std::enable_if_t<N == M && N == 4, matrix> affine_inverse(std::false_type) const
+    {
+        matrix result;
+        // The adjugate of the upper left 3x3 matrix.
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                result.at(j, i) = at(i1, j1) * at(i2, j2) - at(i1, j2) * at(i2, j1);
+            }
+        }
+        const element_type det = at(0, 0) * result.at(0, 0) + at(0, 1) * result.at(1, 0) + at(0, 2) * result.at(2, 0);
+        if (det == zero<element_type>())
+        {
+            throw std::domain_error("Cannot inverse matrix with 0 determinant");
+        }
+        const element_type f = one<element_type>() / det;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                result.at(i, j) *= f;
+            }
+        }
+        for (size_t i = 0; i < 3; ++i)
+        {
+            result.at(i, 3) = -(result.at(i, 0) * at(0, 3) + result.at(i, 1) * at(1, 3) + result.at(i, 2) * at(2, 3));
+        }
+        result.at(3, 3) = one<element_type>();
+        return result;
+    }
+
+private:
+    /// @brief The kernels for 4x4 matrices.
+    using simd_matrix4_type = internal::simd_matrix4<element_type>;
+
+    /// @brief Get if this matrix type is a 4x4 matrix type and SIMD kernels are available for it.
+    static constexpr bool is_simd_matrix4()
+    { return number_of_rows() == 4 && number_of_columns() == 4 && simd_matrix4_type::is_enabled(); }
 };
 
 template <typename E, size_t N, size_t M>
@@ -534,12 +733,12 @@ struct arithmetic_binary_plus_functor<matrix<E, N, M>,
                                       matrix<E, N, M>>
 {
     using T = matrix<E, N, M>;
-    T operator()(const T& a, const T& b) const
+    constexpr T operator()(const T& a, const T& b) const
     { return impl(a, b, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    T impl(const T& a, const T& b, std::index_sequence<Is ...>) const
+    constexpr T impl(const T& a, const T& b, std::index_sequence<Is ...>) const
     { return T((a(Is) + b(Is)) ...); }
 };
 
@@ -548,12 +747,12 @@ struct arithmetic_binary_minus_functor<matrix<E, N, M>,
                                        matrix<E, N, M>>
 {
     using T = matrix<E, N, M>;
-    T operator()(const T& a, const T& b) const
+    constexpr T operator()(const T& a, const T& b) const
     { return impl(a, b, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    T impl(const T& a, const T& b, std::index_sequence<Is ...>) const
+    constexpr T impl(const T& a, const T& b, std::index_sequence<Is ...>) const
     { return T((a(Is) - b(Is)) ...); }
 };
 
@@ -562,12 +761,12 @@ struct arithmetic_unary_plus_functor<matrix<E, N, M>>
 {
     using T = matrix<E, N, M>;
 
-    auto operator()(const T& a) const
+    constexpr auto operator()(const T& a) const
     { return impl(a, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    auto impl(const T& a, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, std::index_sequence<Is...>) const
     { return T((+(a(Is)))...); }
 };
 
@@ -576,12 +775,12 @@ struct arithmetic_unary_minus_functor<matrix<E, N, M>>
 {
     using T = matrix<E, N, M>;
 
-    auto operator()(const T& a) const
+    constexpr auto operator()(const T& a) const
     { return impl(a, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    auto impl(const T& a, std::index_sequence<Is...>) const
+    constexpr auto impl(const T& a, std::index_sequence<Is...>) const
     { return T((-(a(Is)))...); }
 };
 
@@ -591,12 +790,12 @@ struct arithmetic_binary_star_functor<matrix<E, N, M>,
 {
     using B = E;
     using A = matrix<E, N, M>;
-    A operator()(const A& a, const B& b) const
+    constexpr A operator()(const A& a, const B& b) const
     { return impl(a, b, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    A impl(const A& a, const B& b, std::index_sequence<Is ...>) const
+    constexpr A impl(const A& a, const B& b, std::index_sequence<Is ...>) const
     { return A((a(Is) * b) ...); }
 };
 
@@ -606,12 +805,12 @@ struct arithmetic_binary_slash_functor<matrix<E, N, M>,
 {
     using B = E;
     using A = matrix<E, N, M>;
-    A operator()(const A& a, const B& b) const
+    constexpr A operator()(const A& a, const B& b) const
     { return impl(a, b, std::make_index_sequence<N * M>{}); }
 
 private:
     template <size_t ... Is>
-    A impl(const A& a, const B& b, std::index_sequence<Is ...>) const
+    constexpr A impl(const A& a, const B& b, std::index_sequence<Is ...>) const
     { return A((a(Is) / b) ...); }
 };
 
@@ -629,11 +828,27 @@ struct arithmetic_binary_star_functor<matrix<E, L, M>,
     using B = matrix<E, M, N>;
     using A = matrix<E, L, M>;
     using C = matrix<E, L, N>;
-    C operator()(const A& a, const B& b) const
-    { return impl(a, b); }
+    using simd_type = internal::simd_matrix4<E>;
 
-private:
-    C impl(const A& a, const B& b) const
+    constexpr C operator()(const A& a, const B& b) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, b, std::false_type{})
+             : impl(a, b, std::integral_constant<bool, L == 4 && M == 4 && N == 4 && simd_type::is_enabled()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the product using the SIMD code path.
+    C impl(const A& a, const B& b, std::true_type) const
+    {
+        C c(uninitialized);
+        simd_type::mul(&(a(0)), &(b(0)), &(c(0)));
+        return c;
+    }
+
+    /// @internal
+    /// @brief Compute the product using the scalar code path.
+    constexpr C impl(const A& a, const B& b, std::false_type) const
     {
         C c;
         for (size_t i = 0; i < L; ++i)
@@ -664,7 +879,7 @@ struct trace_functor<matrix<E, N, M>, std::enable_if_t<N == M>>
     using A = matrix<E, N, M>;
     using R = E;
 
-    R operator()(const A& a) const
+    constexpr R operator()(const A& a) const
     {
         R t = zero<R>();
         for (size_t i = 0; i < N; ++i)
@@ -689,7 +904,27 @@ struct transpose_functor<matrix<E, N, M>, void>
     using A = matrix<E, N, M>;
     using R = matrix<E, M, N>;
 
-    R operator()(const A& a) const
+    using simd_type = internal::simd_matrix4<E>;
+
+    constexpr R operator()(const A& a) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(a, std::false_type{})
+             : impl(a, std::integral_constant<bool, N == 4 && M == 4 && simd_type::is_enabled()>{});
+    }
+
+    /// @internal
+    /// @brief Compute the transpose using the SIMD code path.
+    R impl(const A& a, std::true_type) const
+    {
+        R r(uninitialized);
+        simd_type::transpose(&(a(0)), &(r(0)));
+        return r;
+    }
+
+    /// @internal
+    /// @brief Compute the transpose using the scalar code path.
+    constexpr R impl(const A& a, std::false_type) const
     {
         R r;
         for (size_t i = 0; i < N; ++i)
@@ -709,7 +944,7 @@ struct zero_functor<matrix<E, N, M>,
                     std::enable_if_t<(N > 0)>>
 {
     using R = matrix<E, N, M>;
-    R operator()() const
+    constexpr R operator()() const
     { return R(); }
 }; // struct zero_functor
 
@@ -723,7 +958,7 @@ struct identity_functor<matrix<E, N, M>,
                         std::enable_if_t<(N > 0) && (N == M)>>
 {
     using R = matrix<E, N, M>;
-    R operator()() const
+    constexpr R operator()() const
     {
         R r = zero<R>();
         for (size_t i = 0; i < N; ++i)
@@ -741,15 +976,15 @@ struct max_element_functor<matrix<E, N, M>,
 {
     using matrix_type = matrix<E, N, M>;
 
-    auto operator()(const matrix_type& m) const
+    constexpr auto operator()(const matrix_type& m) const
     { return impl(m); }
     
 private:
     template<std::size_t...Is>
-    auto impl(const matrix_type& m, std::index_sequence<Is...>) const
+    constexpr auto impl(const matrix_type& m, std::index_sequence<Is...>) const
     { return variadic::max((m(Is))...); }
 
-    auto impl(const matrix_type& m) const
+    constexpr auto impl(const matrix_type& m) const
     { return impl(m, std::make_index_sequence<N * M>{}); }
     
 }; // struct max_element_functor
@@ -761,15 +996,15 @@ struct min_element_functor<matrix<E, N, M>,
 {
     using matrix_type = matrix<E, N, M>;
 
-    auto operator()(const matrix_type& m) const
+    constexpr auto operator()(const matrix_type& m) const
     { return impl(m); }
 
 private:
     template<std::size_t...Is>
-    auto impl(const matrix_type& m, std::index_sequence<Is...>) const
+    constexpr auto impl(const matrix_type& m, std::index_sequence<Is...>) const
     { return variadic::min((m[Is])...); }
 
-    auto impl(const matrix_type& m) const
+    constexpr auto impl(const matrix_type& m) const
     { return impl(m, std::make_index_sequence<N * M>{}); }
 
 }; // struct min_element_functor
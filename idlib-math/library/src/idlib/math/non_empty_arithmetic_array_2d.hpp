@@ -69,6 +69,10 @@ struct arithmetic_array_2d<Element, Width, Height, Zero,
 	/// @brief Default construct with the zero element value.
 	arithmetic_array_2d()
 	{ std::fill_n(&(m_elements_1d[0]), number_of_elements(), zero_type()()); }
+
+	/// @brief Construct without initializing the element values.
+	explicit arithmetic_array_2d(uninitialized_t)
+	{}
 	
 	/// @brief Construct this tuple with the specified element values.
 	/// @param first, ... rest the element values
@@ -89,17 +93,21 @@ struct arithmetic_array_2d<Element, Width, Height, Zero,
 	
 	arithmetic_array_2d& operator=(arithmetic_array_2d&& other) = default;
 	
+	/// @{
+	/// @brief Compound assignment operators.
+	/// @remark The elements of this array are modified in place, no temporary array is created.
 	arithmetic_array_2d& operator += (const arithmetic_array_2d& other)
-	{ (*this) = (*this) + other; return *this; }
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements_1d[i] += other.m_elements_1d[i]; return *this; }
 
 	arithmetic_array_2d& operator -= (const arithmetic_array_2d& other)
-	{ (*this) = (*this) - other; return *this; }
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements_1d[i] -= other.m_elements_1d[i]; return *this; }
 
 	arithmetic_array_2d& operator *= (const element_type& other)
-	{ (*this) = (*this) * other; return *this; }
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements_1d[i] *= other; return *this; }
 
 	arithmetic_array_2d& operator /= (const element_type& other)
-	{ (*this) = (*this) / other; return *this; }
+	{ for (size_t i = 0; i < number_of_elements(); ++i) m_elements_1d[i] /= other; return *this; }
+	/// @}
 
 	/// @{
 	/// @brief Get the array element at the specified one-dimensional index.
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/parallel.hpp
+/// @brief Execution policies of bulk operations and helpers for their implementation.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief Describes if and how a bulk operation (e.g. idlib::transform_points) splits its work across threads.
+/// @remark A bulk operation uses at most number_of_threads threads, including the calling thread,
+/// and each thread processes at least minimum_elements_per_thread elements.
+/// Consequently, small inputs are processed by the calling thread alone.
+struct execution_policy
+{
+    /// @brief The maximum number of threads.
+    size_t number_of_threads;
+
+    /// @brief The minimum number of elements processed by a thread.
+    size_t minimum_elements_per_thread;
+
+    /// @brief Get an execution policy processing all elements in the calling thread.
+    /// @return the execution policy
+    static constexpr execution_policy sequential()
+    { return execution_policy{ 1, 1 }; }
+
+    /// @brief Get an execution policy splitting large inputs across threads.
+    /// @param number_of_threads the maximum number of threads. If @a 0, the number of concurrent threads supported by the implementation.
+    /// @param minimum_elements_per_thread the minimum number of elements processed by a thread
+    /// @return the execution policy
+    static execution_policy parallel(size_t number_of_threads = 0, size_t minimum_elements_per_thread = 4096)
+    {
+        if (0 == number_of_threads)
+        {
+            number_of_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        return execution_policy{ number_of_threads, std::max<size_t>(1, minimum_elements_per_thread) };
+    }
+};
+
+namespace internal {
+
+/// @internal
+/// @brief Get the number of threads an execution policy uses for the specified number of elements.
+/// @param count the number of elements
+/// @param policy the execution policy
+/// @return the number of threads. At least @a 1.
+inline size_t number_of_threads(size_t count, const execution_policy& policy)
+{
+    const size_t minimum = std::max<size_t>(1, policy.minimum_elements_per_thread);
+    return std::max<size_t>(1, std::min(policy.number_of_threads, count / minimum));
+}
+
+/// @internal
+/// @brief Get the execution policy of a bulk operation processing groups of elements (e.g. blocks or words of a bitmask).
+/// @param policy the execution policy of the bulk operation
+/// @param group_size the number of elements of a group. Must be greater than @a 0.
+/// @return the execution policy for the groups
+/// @remark The minimum number of elements per thread is converted into a minimum number of groups per thread.
+inline execution_policy group_policy(const execution_policy& policy, size_t group_size)
+{ return execution_policy{ policy.number_of_threads, (policy.minimum_elements_per_thread + group_size - 1) / group_size }; }
+
+/// @internal
+/// @brief Split the range \f$[0,count)\f$ into contiguous subranges and invoke a function for each subrange.
+/// @param count the number of elements
+/// @param policy the execution policy
+/// @param f the function receiving the first and the last index (exclusive) of a subrange
+/// @remark The subranges are processed concurrently. The last subrange is processed by the calling thread.
+/// If a function invocation throws, the first exception is rethrown after all threads have finished.
+template <typename F>
+void parallel_for(size_t count, const execution_policy& policy, F&& f)
+{
+    const size_t n = number_of_threads(count, policy);
+    if (n == 1)
+    {
+        f(size_t(0), count);
+        return;
+    }
+    std::vector<std::exception_ptr> exceptions(n);
+    std::vector<std::thread> threads;
+    threads.reserve(n - 1);
+    try
+    {
+        for (size_t i = 0; i < n - 1; ++i)
+        {
+            threads.emplace_back([&f, &exceptions, i, n, count]()
+            {
+                try
+                { f((count * i) / n, (count * (i + 1)) / n); }
+                catch (...)
+                { exceptions[i] = std::current_exception(); }
+            });
+        }
+    }
+    catch (...)
+    {
+        // A thread could not be started.
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        throw;
+    }
+    try
+    { f((count * (n - 1)) / n, count); }
+    catch (...)
+    { exceptions[n - 1] = std::current_exception(); }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto& exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+/// @internal
+/// @brief Get a pointer to the scalars of an array of points or vectors.
+template <typename T>
+auto scalars(T *p)
+{
+    using scalar_type = typename std::remove_const_t<T>::scalar_type;
+    static_assert(std::is_standard_layout<std::remove_const_t<T>>::value &&
+                  sizeof(T) == std::remove_const_t<T>::dimensionality() * sizeof(scalar_type),
+                  "the scalars of the type are not stored contiguously");
+    using pointer_type = std::conditional_t<std::is_const<T>::value, const scalar_type *, scalar_type *>;
+    return reinterpret_cast<pointer_type>(p);
+}
+
+} // namespace internal
+
+} // namespace idlib
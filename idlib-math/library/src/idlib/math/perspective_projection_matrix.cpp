@@ -21,7 +21,7 @@ matrix<single, 4, 4> perspective_projection_matrix(const angle<single, radians>&
 	return matrix<single, 4, 4>(f / aspect, 0.0f,   0.0f,                                0.0f,
 			                    0.0f,       f,      0.0f,                                0.0f,
 			                    0.0f,       0.0f,   (z_far + z_near) / (z_near - z_far), (2.0f * z_far * z_near) / (z_near - z_far),
-			                    0.0f,       0.0f,  -1.0f,                                1.0f);
+			                    0.0f,       0.0f,  -1.0f,                                0.0f);
 }
 	
 } // namespace idlib
@@ -32,7 +32,7 @@ namespace idlib {
  * \frac{f}{aspect} & 0 &  0                                                 & 0 \\
  * 0                & f &  0                                                 & 0 \\
  * 0                & 0 &  \frac{(z_{far} + z_{near})}{(z_{near} - z_{far})} & \frac{(2 * z_{far} * z_{near})}{(z_{near} - z_{far})} \\
- * 0                & 0 & -1                                                 & 1 \\
+ * 0                & 0 & -1                                                 & 0 \\
  * \end{matrix}\right]
  * \f]
  * where \f$f = cot(0.5 fov_y)\f$.
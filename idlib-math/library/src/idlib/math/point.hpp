@@ -77,17 +77,17 @@ public:
     template<typename ... Arguments,
              typename = std::enable_if_t<(sizeof...(Arguments)) == point_type::dimensionality() &&
                                          all_convertible<scalar_type, typename std::decay<Arguments>::type...>::value>>
-    point(Arguments&& ... arguments)
+    constexpr point(Arguments&& ... arguments)
         : m_implementation{ std::forward<Arguments>(arguments)...}
     { static_assert(dimensionality() == sizeof...(arguments), "wrong number of arguments"); }
 
     /// @brief Copy-construct this point with the values of another point.
     /// @param other the other point
-    point(const point_type& other) = default;
+    constexpr point(const point_type& other) = default;
 
     /// @internal
     template <typename G, std::size_t...Is>
-    static point_type generate(const G& g, std::index_sequence<Is...>)
+    static constexpr point_type generate(const G& g, std::index_sequence<Is...>)
     { return point_type((g(Is))...); }
     
     /// @brief Create a point with the values of a sequence generator.
@@ -95,31 +95,36 @@ public:
     /// @param g the generator
     /// @return the point
     template <typename G>
-    static point_type generate(const G& g)
+    static constexpr point_type generate(const G& g)
     { return generate(g, std::make_index_sequence<dimensionality()>{});    }
     
     /// @internal
     /// @brief Construct this point.
     /// @param other the implementation_type value
-    point(const implementation_type& other) :
+    constexpr point(const implementation_type& other) :
         m_implementation(other)
     {}
 
     /// @brief Default-construct this point.
-    point() : m_implementation()
+    constexpr point() : m_implementation()
     { /* Intentionally empty. */ }
 
+    /// @brief Construct this point without initializing its component values.
+    explicit point(uninitialized_t)
+        : m_implementation(uninitialized)
+    {}
+
     /// @{
     /// @brief Get the component value of the \f$x\f$ component.
     /// @return a reference to the component value of the \f$x\f$ component
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
+    constexpr std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
     {
         static_assert(point_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation(0);
     }
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
     {
         static_assert(point_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation(0);
@@ -130,13 +135,13 @@ public:
     /// @brief Get the component value of the \f$y\f$ component.
     /// @return a reference to the component value of the \f$y\f$ component
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y()
+    constexpr std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y()
     {
         static_assert(point_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation(1);
     }
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y() const
     {
         static_assert(point_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation(1);
@@ -147,13 +152,13 @@ public:
     /// @brief Get the component value of the \f$z\f$ component.
     /// @return a reference to the component value of the \f$z\f$ component
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
+    constexpr std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
     {
         static_assert(point_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation(2);
     }
     template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
     {
         static_assert(point_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation(2);
@@ -161,53 +166,53 @@ public:
     /// @}
 
 public:
-    bool operator==(const point_type& other) const
+    constexpr bool operator==(const point_type& other) const
     { return m_implementation == other.m_implementation; }
     
-    bool operator!=(const point_type& other) const
+    constexpr bool operator!=(const point_type& other) const
     { return m_implementation != other.m_implementation; }
 
-    point_type& operator=(const point_type& other)
+    constexpr point_type& operator=(const point_type& other)
     {
         m_implementation = other.m_implementation;
         return *this;
     }
     
 
-    point_type operator+(const vector_type& other) const
+    constexpr point_type operator+(const vector_type& other) const
     { return point_type(m_implementation + other.m_implementation); }
 
-    point_type& operator+=(const vector_type& other)
+    constexpr point_type& operator+=(const vector_type& other)
     { m_implementation += other.m_implementation; return *this; }
 
     
-    point_type operator-(const vector_type& other) const
+    constexpr point_type operator-(const vector_type& other) const
     { return point_type(m_implementation - other.m_implementation); }
     
-    point_type& operator-=(const vector_type& other)
+    constexpr point_type& operator-=(const vector_type& other)
     { m_implementation -= other.m_implementation; return *this; }
 
 
-    vector_type operator-(const point_type& other) const
+    constexpr vector_type operator-(const point_type& other) const
     { return vector_type(m_implementation - other.m_implementation); }
 
 
-    scalar_type& operator[](size_t const& index)
+    constexpr scalar_type& operator[](size_t const& index)
     { return m_implementation(index); }
 
-    const scalar_type& operator[](size_t const& index) const
+    constexpr const scalar_type& operator[](size_t const& index) const
     { return m_implementation(index); }
 
     
-    scalar_type& operator()(size_t const& index)
+    constexpr scalar_type& operator()(size_t const& index)
     { return m_implementation(index); }
 
-    const scalar_type& operator()(size_t const& index) const
+    constexpr const scalar_type& operator()(size_t const& index) const
     { return m_implementation(index); }
     
 private:
     template <typename C, std::size_t...Is>
-    bool equal_to(const point_type& other, const C& c, std::index_sequence<Is ...>) const
+    constexpr bool equal_to(const point_type& other, const C& c, std::index_sequence<Is ...>) const
     { return and_fold_expr()(c((*this)[Is], other[Is]) ...); }
 
 public:
@@ -216,7 +221,7 @@ public:
     /// @param other the other vector
     /// @param c the comparator
     template <typename C>
-    bool equal_to(const point_type& other, const C& c) const
+    constexpr bool equal_to(const point_type& other, const C& c) const
     { return equal_to(other, c, std::make_index_sequence<dimensionality()>{}); }
 #if 0
     /**
@@ -277,7 +282,7 @@ struct zero_functor<point<Vector>>
     static constexpr size_t dimensionality()
     { return vector_type::dimensionality(); }
 
-    auto operator()() const
+    constexpr auto operator()() const
     { return point_type::generate(constant_generator<scalar_type>(zero<scalar_type>())); }
 
 }; // struct zero_functor
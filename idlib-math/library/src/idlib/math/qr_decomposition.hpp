@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/qr_decomposition.hpp
+/// @brief QR decomposition of square matrices by Householder reflections.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/decomposition_kernels.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/vector.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The QR decomposition \f$A = Q R\f$ of an \f$N \times N\f$ matrix \f$A\f$ by Householder reflections,
+/// where \f$Q\f$ is an orthogonal matrix and \f$R\f$ is an upper triangular matrix.
+/// @remark The QR decomposition requires about twice the operations of the LU decomposition
+/// but is numerically stable without pivoting and reveals rank deficiency on the diagonal of \f$R\f$.
+/// @tparam Element the element type. Must be a floating point type.
+/// @tparam N the number of rows and columns
+template <typename Element, size_t N>
+struct qr_decomposition
+{
+    static_assert(std::is_floating_point<Element>::value, "Element must be a floating point type");
+
+public:
+    /// @brief The element type.
+    using element_type = Element;
+
+    /// @brief The matrix type.
+    using matrix_type = matrix<element_type, N, N>;
+
+    /// @brief The vector type.
+    using vector_type = vector<element_type, N>;
+
+    /// @brief Construct this QR decomposition.
+    /// @param a the matrix \f$A\f$
+    explicit qr_decomposition(const matrix_type& a)
+        : m_qr(a)
+    {
+        kernels::qr(&(m_qr._v[0]), m_tau);
+        if (!is_singular())
+        { kernels::reciprocal_diagonal(&(m_qr._v[0]), m_reciprocals); }
+    }
+
+    /// @brief Get if the matrix \f$A\f$ is singular.
+    /// @return @a true if \f$A\f$ is singular, @a false otherwise
+    bool is_singular() const
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (m_qr(i, i) == zero<element_type>())
+            { return true; }
+        }
+        return false;
+    }
+
+    /// @brief Get the matrix \f$Q\f$.
+    /// @return the matrix \f$Q\f$
+    matrix_type orthogonal() const
+    { return transpose(apply_transposed_q(identity<matrix_type>())); }
+
+    /// @brief Get the matrix \f$R\f$.
+    /// @return the matrix \f$R\f$
+    matrix_type upper() const
+    {
+        matrix_type r;
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = i; j < N; ++j)
+            { r(i, j) = m_qr(i, j); }
+        }
+        return r;
+    }
+
+    /// @brief Solve \f$A x = b\f$.
+    /// @param b the right-hand side \f$b\f$
+    /// @return the solution \f$x\f$
+    /// @throw std::domain_error the matrix \f$A\f$ is singular
+    vector_type solve(const vector_type& b) const
+    {
+        ensure_regular();
+        element_type y[N];
+        for (size_t i = 0; i < N; ++i)
+        { y[i] = b[i]; }
+        kernels::qr_solve(&(m_qr._v[0]), m_tau, m_reciprocals, y, 1);
+        vector_type x = b;
+        for (size_t i = 0; i < N; ++i)
+        { x[i] = y[i]; }
+        return x;
+    }
+
+    /// @brief Solve \f$A X = B\f$.
+    /// @param b the right-hand sides \f$B\f$
+    /// @return the solutions \f$X\f$
+    /// @throw std::domain_error the matrix \f$A\f$ is singular
+    template <size_t K>
+    matrix<element_type, N, K> solve(const matrix<element_type, N, K>& b) const
+    {
+        ensure_regular();
+        matrix<element_type, N, K> x = b;
+        for (size_t j = 0; j < K; ++j)
+        { kernels::qr_solve(&(m_qr._v[0]), m_tau, m_reciprocals, &(x._v[j]), K); }
+        return x;
+    }
+
+private:
+    using kernels = internal::decomposition_kernels<element_type, N>;
+
+    void ensure_regular() const
+    {
+        if (is_singular())
+        {
+            throw std::domain_error("Cannot solve linear system with singular matrix");
+        }
+    }
+
+    // Compute Q^T B.
+    matrix_type apply_transposed_q(matrix_type b) const
+    {
+        for (size_t j = 0; j < N; ++j)
+        { kernels::qr_apply_transposed_q(&(m_qr._v[0]), m_tau, &(b._v[j]), N); }
+        return b;
+    }
+
+    /// @brief \f$R\f$ on and above the diagonal and the Householder vectors below the diagonal.
+    matrix_type m_qr;
+
+    /// @brief The scaling factors of the Householder reflections.
+    element_type m_tau[N];
+
+    /// @brief The reciprocals of the diagonal elements of \f$R\f$.
+    element_type m_reciprocals[N];
+
+}; // struct qr_decomposition
+
+} // namespace idlib
@@ -0,0 +1,514 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/quaternion.hpp
+/// @brief Quaternions representing rotations of the three-dimensional Euclidean space.
+/// @author Michael Heilmann
+
+/// @detail
+/// A unit quaternion \f$q = (\sin(\frac{\theta}{2})\hat{r}, \cos(\frac{\theta}{2}))\f$ represents the counter-clockwise
+/// rotation by the angle \f$\theta\f$ about the axis \f$\hat{r}\f$, the same rotation as idlib::rotation_matrix(\f$\hat{r}\f$, \f$\theta\f$).
+/// Rotations are composed by the quaternion product, blended by idlib::nlerp and idlib::slerp, and converted into and from
+/// \f$4 \times 4\f$ rotation matrices by idlib::semantic_cast.
+/// @code
+/// idlib::quaternion<single> a(axis, idlib::angle<single, idlib::degrees>(90.0f)), b = ...;
+/// auto c = a * b;                     // composition: first b, then a
+/// auto v = c * w;                     // rotate a vector
+/// auto d = idlib::slerp(a, b, 0.25f); // blend
+/// auto m = idlib::semantic_cast<idlib::matrix<single, 4, 4>>(d);
+/// @endcode
+/// Arrays of quaternions are blended by the batched versions of idlib::nlerp and idlib::slerp,
+/// arrays of vectors are rotated by idlib::rotate_vectors.
+
+#pragma once
+
+#include "idlib/math/angle-degrees-radians-turns.hpp"
+#include "idlib/math/arithmetic_functor.hpp"
+#include "idlib/math/dot_product.hpp"
+#include "idlib/math/identity.hpp"
+#include "idlib/math/inverse.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/simd_matrix.hpp"
+#include "idlib/math/transform.hpp"
+#include "idlib/math/uninitialized.hpp"
+#include "idlib/math/vector.hpp"
+#include "idlib/semantic_cast.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A quaternion \f$q = (x, y, z, w) = (v, w)\f$ with the vector part \f$v\f$ and the scalar part \f$w\f$.
+/// @remark The scalars are stored in the order \f$x\f$, \f$y\f$, \f$z\f$, \f$w\f$.
+/// @tparam Scalar the scalar type. Must be a floating-point type.
+template <typename Scalar>
+struct quaternion
+{
+    static_assert(std::is_floating_point<Scalar>::value, "scalar type must be a floating-point type");
+
+public:
+    /// @brief The scalar type.
+    using scalar_type = Scalar;
+
+    /// @brief The vector type.
+    using vector_type = vector<scalar_type, 3>;
+
+    /// @brief The type of this template/template specialization.
+    using quaternion_type = quaternion<scalar_type>;
+
+    /// @brief Construct this quaternion with the identity quaternion \f$(0, 0, 0, 1)\f$.
+    constexpr quaternion()
+        : m_elements{ zero<scalar_type>(), zero<scalar_type>(), zero<scalar_type>(), one<scalar_type>() }
+    {}
+
+    /// @brief Construct this quaternion with the specified scalars.
+    constexpr quaternion(scalar_type x, scalar_type y, scalar_type z, scalar_type w)
+        : m_elements{ x, y, z, w }
+    {}
+
+    /// @brief Construct this quaternion with the unit quaternion representing a counter-clockwise rotation about an axis.
+    /// @param axis the rotation axis
+    /// @param angle the rotation angle
+    /// @throw std::invalid_argument the rotation axis is the zero vector
+    quaternion(const vector_type& axis, const angle<scalar_type, radians>& angle)
+    {
+        const scalar_type l = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (l == zero<scalar_type>())
+        {
+            throw std::invalid_argument("axis vector is zero vector");
+        }
+        const scalar_type h = angle.get_value() / scalar_type(2);
+        const scalar_type s = std::sin(h) / l;
+        m_elements[0] = axis[0] * s;
+        m_elements[1] = axis[1] * s;
+        m_elements[2] = axis[2] * s;
+        m_elements[3] = std::cos(h);
+    }
+
+    /// @brief Construct this quaternion with the unit quaternion representing a counter-clockwise rotation about an axis.
+    /// @param axis the rotation axis
+    /// @param angle the rotation angle
+    /// @throw std::invalid_argument the rotation axis is the zero vector
+    quaternion(const vector_type& axis, const angle<scalar_type, degrees>& angle)
+        : quaternion(axis, semantic_cast<idlib::angle<scalar_type, radians>>(angle))
+    {}
+
+    /// @brief Construct this quaternion with the unit quaternion representing a counter-clockwise rotation about an axis.
+    /// @param axis the rotation axis
+    /// @param angle the rotation angle
+    /// @throw std::invalid_argument the rotation axis is the zero vector
+    quaternion(const vector_type& axis, const angle<scalar_type, turns>& angle)
+        : quaternion(axis, semantic_cast<idlib::angle<scalar_type, radians>>(angle))
+    {}
+
+    /// @brief Construct this quaternion without initializing its scalars.
+    explicit quaternion(uninitialized_t)
+    {}
+
+    constexpr quaternion(const quaternion_type& other) = default;
+
+    constexpr quaternion_type& operator=(const quaternion_type& other) = default;
+
+public:
+    /// @{
+    /// @brief Get the scalar at the specified index.
+    /// @param i the index. Must be within the bounds of \f$[0,4)\f$.
+    /// @return a reference to the scalar
+    constexpr scalar_type& operator()(size_t i)
+    { return m_elements[i]; }
+
+    constexpr const scalar_type& operator()(size_t i) const
+    { return m_elements[i]; }
+    /// @}
+
+    /// @brief Get the scalar \f$x\f$.
+    constexpr scalar_type x() const
+    { return m_elements[0]; }
+
+    /// @brief Get the scalar \f$y\f$.
+    constexpr scalar_type y() const
+    { return m_elements[1]; }
+
+    /// @brief Get the scalar \f$z\f$.
+    constexpr scalar_type z() const
+    { return m_elements[2]; }
+
+    /// @brief Get the scalar \f$w\f$.
+    constexpr scalar_type w() const
+    { return m_elements[3]; }
+
+    constexpr bool operator==(const quaternion_type& other) const
+    {
+        return m_elements[0] == other.m_elements[0] && m_elements[1] == other.m_elements[1]
+            && m_elements[2] == other.m_elements[2] && m_elements[3] == other.m_elements[3];
+    }
+
+    constexpr bool operator!=(const quaternion_type& other) const
+    { return !(*this == other); }
+
+    constexpr quaternion_type operator+(const quaternion_type& other) const
+    { return quaternion_type(x() + other.x(), y() + other.y(), z() + other.z(), w() + other.w()); }
+
+    constexpr quaternion_type operator-(const quaternion_type& other) const
+    { return quaternion_type(x() - other.x(), y() - other.y(), z() - other.z(), w() - other.w()); }
+
+    constexpr quaternion_type operator-() const
+    { return quaternion_type(-x(), -y(), -z(), -w()); }
+
+    constexpr quaternion_type operator*(scalar_type s) const
+    { return quaternion_type(x() * s, y() * s, z() * s, w() * s); }
+
+    /// @brief Compose this quaternion with another quaternion.
+    /// @param other the other quaternion
+    /// @return this quaternion
+    /// @post This quaternion is the product <c>*this * other</c>, that is the rotation @a other is applied first.
+    constexpr quaternion_type& operator*=(const quaternion_type& other)
+    {
+        *this = arithmetic_binary_star_functor<quaternion_type, quaternion_type>()(*this, other);
+        return *this;
+    }
+
+    /// @brief Get the conjugate \f$(-v, w)\f$ of this quaternion.
+    /// @return the conjugate
+    /// @remark The conjugate of a unit quaternion is its inverse, the inverse rotation.
+    constexpr quaternion_type conjugate() const
+    { return quaternion_type(-x(), -y(), -z(), w()); }
+
+    /// @brief Get the inverse of this quaternion.
+    /// @return the inverse
+    /// @throw std::domain_error this quaternion is the zero quaternion
+    constexpr quaternion_type inverse() const
+    {
+        const scalar_type n = squared_norm();
+        if (n == zero<scalar_type>())
+        {
+            throw std::domain_error("Cannot inverse zero quaternion");
+        }
+        return conjugate() * (one<scalar_type>() / n);
+    }
+
+    /// @brief Get the squared norm of this quaternion.
+    /// @return the squared norm
+    constexpr scalar_type squared_norm() const
+    { return x() * x() + y() * y() + z() * z() + w() * w(); }
+
+    /// @brief Get the norm of this quaternion.
+    /// @return the norm
+    scalar_type norm() const
+    { return std::sqrt(squared_norm()); }
+
+    /// @brief Get the unit quaternion of this quaternion.
+    /// @return the unit quaternion
+    /// @throw std::domain_error this quaternion is the zero quaternion
+    quaternion_type normalized() const
+    {
+        const scalar_type n = norm();
+        if (n == zero<scalar_type>())
+        {
+            throw std::domain_error("Cannot normalize zero quaternion");
+        }
+        return *this * (one<scalar_type>() / n);
+    }
+
+    /// @brief Get the axis of the rotation represented by this quaternion.
+    /// @return the unit rotation axis. If the rotation angle is zero, the unit vector of the x-axis.
+    vector_type rotation_axis() const
+    {
+        const scalar_type l = std::sqrt(x() * x() + y() * y() + z() * z());
+        if (l == zero<scalar_type>())
+        {
+            return vector_type(one<scalar_type>(), zero<scalar_type>(), zero<scalar_type>());
+        }
+        return vector_type(x() / l, y() / l, z() / l);
+    }
+
+    /// @brief Get the angle of the rotation represented by this quaternion.
+    /// @return the rotation angle within the bounds of \f$[0,2\pi]\f$
+    angle<scalar_type, radians> rotation_angle() const
+    { return angle<scalar_type, radians>(scalar_type(2) * std::atan2(std::sqrt(x() * x() + y() * y() + z() * z()), w())); }
+
+private:
+    /// @brief The scalars \f$x\f$, \f$y\f$, \f$z\f$, and \f$w\f$.
+    scalar_type m_elements[4];
+
+}; // struct quaternion
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor computing the product (aka the composition) of two quaternions.
+/// @remark The product \f$(v_1, w_1)(v_2, w_2)\f$ is \f$(w_1 v_2 + w_2 v_1 + v_1 \times v_2, w_1 w_2 - v_1 \cdot v_2)\f$.
+/// If both quaternions are unit quaternions, the product applies the rotation of the second quaternion first.
+template <typename Scalar>
+struct arithmetic_binary_star_functor<quaternion<Scalar>, quaternion<Scalar>, void>
+{
+    using quaternion_type = quaternion<Scalar>;
+
+    constexpr quaternion_type operator()(const quaternion_type& a, const quaternion_type& b) const
+    {
+        return quaternion_type(a.w() * b.x() + a.x() * b.w() + a.y() * b.z() - a.z() * b.y(),
+                               a.w() * b.y() - a.x() * b.z() + a.y() * b.w() + a.z() * b.x(),
+                               a.w() * b.z() + a.x() * b.y() - a.y() * b.x() + a.z() * b.w(),
+                               a.w() * b.w() - a.x() * b.x() - a.y() * b.y() - a.z() * b.z());
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::arithmetic_binary_star_functor rotating a vector by a unit quaternion.
+/// @remark The rotated vector \f$q p q^{-1}\f$ is computed as \f$p + w t + v \times t\f$ with \f$t = 2 (v \times p)\f$,
+/// where \f$q = (v, w)\f$. This requires fewer operations than the quaternion products and than building a rotation matrix.
+template <typename Scalar>
+struct arithmetic_binary_star_functor<quaternion<Scalar>, vector<Scalar, 3>, void>
+{
+    using quaternion_type = quaternion<Scalar>;
+    using vector_type = vector<Scalar, 3>;
+
+    constexpr vector_type operator()(const quaternion_type& q, const vector_type& p) const
+    {
+        const Scalar tx = Scalar(2) * (q.y() * p[2] - q.z() * p[1]),
+                     ty = Scalar(2) * (q.z() * p[0] - q.x() * p[2]),
+                     tz = Scalar(2) * (q.x() * p[1] - q.y() * p[0]);
+        return vector_type(p[0] + q.w() * tx + (q.y() * tz - q.z() * ty),
+                           p[1] + q.w() * ty + (q.z() * tx - q.x() * tz),
+                           p[2] + q.w() * tz + (q.x() * ty - q.y() * tx));
+    }
+}; // struct arithmetic_binary_star_functor
+
+/// @brief Specialization of idlib::dot_product_functor computing the dot product of two quaternions.
+template <typename Scalar>
+struct dot_product_functor<quaternion<Scalar>>
+{
+    constexpr Scalar operator()(const quaternion<Scalar>& a, const quaternion<Scalar>& b) const
+    { return a.x() * b.x() + a.y() * b.y() + a.z() * b.z() + a.w() * b.w(); }
+}; // struct dot_product_functor
+
+/// @brief Specialization of idlib::identity_functor returning the identity quaternion.
+template <typename Scalar>
+struct identity_functor<quaternion<Scalar>, void>
+{
+    constexpr quaternion<Scalar> operator()() const
+    { return quaternion<Scalar>(); }
+}; // struct identity_functor
+
+/// @brief Specialization of idlib::inverse_functor returning the inverse of a quaternion.
+/// @throw std::domain_error the quaternion is the zero quaternion
+template <typename Scalar>
+struct inverse_functor<quaternion<Scalar>, void>
+{
+    constexpr quaternion<Scalar> operator()(const quaternion<Scalar>& q) const
+    { return q.inverse(); }
+}; // struct inverse_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting a quaternion into a \f$4 \times 4\f$ rotation matrix.
+/// @remark The quaternion need not be a unit quaternion, its norm is divided out.
+/// The result for the zero quaternion is undefined.
+template <typename Scalar>
+struct semantic_cast_functor<matrix<Scalar, 4, 4>, quaternion<Scalar>, void>
+{
+    constexpr matrix<Scalar, 4, 4> operator()(const quaternion<Scalar>& q) const
+    {
+        const Scalar s = Scalar(2) / q.squared_norm();
+        const Scalar xs = q.x() * s, ys = q.y() * s, zs = q.z() * s;
+        const Scalar xx = q.x() * xs, xy = q.x() * ys, xz = q.x() * zs,
+                     yy = q.y() * ys, yz = q.y() * zs, zz = q.z() * zs,
+                     wx = q.w() * xs, wy = q.w() * ys, wz = q.w() * zs;
+        const Scalar o = one<Scalar>(), z = zero<Scalar>();
+        return matrix<Scalar, 4, 4>(o - (yy + zz), xy - wz,       xz + wy,       z,
+                                    xy + wz,       o - (xx + zz), yz - wx,       z,
+                                    xz - wy,       yz + wx,       o - (xx + yy), z,
+                                    z,             z,             z,             o);
+    }
+}; // struct semantic_cast_functor
+
+/// @brief Specialization of idlib::semantic_cast_functor converting a \f$4 \times 4\f$ rotation matrix into a unit quaternion.
+/// @remark The upper left \f$3 \times 3\f$ matrix must be a rotation matrix. The other elements are not read.
+/// The quaternion is computed from the largest of its four components to avoid cancellation (Shepperd's method).
+template <typename Scalar>
+struct semantic_cast_functor<quaternion<Scalar>, matrix<Scalar, 4, 4>, void>
+{
+    quaternion<Scalar> operator()(const matrix<Scalar, 4, 4>& m) const
+    {
+        const Scalar t = m(0, 0) + m(1, 1) + m(2, 2);
+        if (t > zero<Scalar>())
+        {
+            const Scalar s = std::sqrt(t + one<Scalar>()) * Scalar(2);
+            return quaternion<Scalar>((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, s / Scalar(4));
+        }
+        else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2))
+        {
+            const Scalar s = std::sqrt(one<Scalar>() + m(0, 0) - m(1, 1) - m(2, 2)) * Scalar(2);
+            return quaternion<Scalar>(s / Scalar(4), (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+        }
+        else if (m(1, 1) > m(2, 2))
+        {
+            const Scalar s = std::sqrt(one<Scalar>() + m(1, 1) - m(0, 0) - m(2, 2)) * Scalar(2);
+            return quaternion<Scalar>((m(0, 1) + m(1, 0)) / s, s / Scalar(4), (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+        }
+        else
+        {
+            const Scalar s = std::sqrt(one<Scalar>() + m(2, 2) - m(0, 0) - m(1, 1)) * Scalar(2);
+            return quaternion<Scalar>((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, s / Scalar(4), (m(1, 0) - m(0, 1)) / s);
+        }
+    }
+}; // struct semantic_cast_functor
+
+/// @ingroup math
+/// @brief Blend two unit quaternions by normalized linear interpolation.
+/// @param a, b the unit quaternions
+/// @param t the interpolation parameter within the bounds of \f$[0,1]\f$
+/// @return the unit quaternion \f$\frac{(1-t)a + tb'}{|(1-t)a + tb'|}\f$
+/// where \f$b' = b\f$ if \f$a \cdot b \geq 0\f$ and \f$b' = -b\f$ otherwise, that is the shorter arc is interpolated.
+/// @remark The angular velocity of the interpolation is not constant. It is considerably cheaper than idlib::slerp.
+template <typename Scalar>
+quaternion<Scalar> nlerp(const quaternion<Scalar>& a, const quaternion<Scalar>& b, Scalar t)
+{
+    const Scalar u = dot_product(a, b) < zero<Scalar>() ? -t : t;
+    return (a * (one<Scalar>() - t) + b * u).normalized();
+}
+
+/// @ingroup math
+/// @brief Blend two unit quaternions by spherical linear interpolation.
+/// @param a, b the unit quaternions
+/// @param t the interpolation parameter within the bounds of \f$[0,1]\f$
+/// @return the unit quaternion \f$\frac{\sin((1-t)\theta)}{\sin(\theta)}a + \frac{\sin(t\theta)}{\sin(\theta)}b'\f$
+/// where \f$\cos(\theta) = a \cdot b'\f$ and \f$b' = b\f$ if \f$a \cdot b \geq 0\f$ and \f$b' = -b\f$ otherwise,
+/// that is the shorter arc is interpolated.
+/// @remark The angular velocity of the interpolation is constant.
+/// If the quaternions are almost parallel, idlib::nlerp is used as \f$\sin(\theta)\f$ is close to zero.
+template <typename Scalar>
+quaternion<Scalar> slerp(const quaternion<Scalar>& a, const quaternion<Scalar>& b, Scalar t)
+{
+    Scalar d = dot_product(a, b);
+    const quaternion<Scalar> c = d < zero<Scalar>() ? -b : b;
+    d = std::abs(d);
+    if (d > Scalar(0.9995))
+    {
+        return nlerp(a, c, t);
+    }
+    const Scalar theta = std::acos(d), s = one<Scalar>() / std::sin(theta);
+    return a * (std::sin((one<Scalar>() - t) * theta) * s) + c * (std::sin(t * theta) * s);
+}
+
+namespace internal {
+
+/// @internal
+/// @brief Kernels for arrays of quaternions of scalars of type @a Scalar.
+template <typename Scalar>
+struct quaternion_kernels
+{
+    using scalar_type = Scalar;
+    using quaternion_type = quaternion<scalar_type>;
+    using quad_type = simd_quad<scalar_type>;
+
+    static_assert(std::is_standard_layout<quaternion_type>::value && sizeof(quaternion_type) == 4 * sizeof(scalar_type),
+                  "the scalars of quaternions are not stored contiguously");
+
+    static constexpr bool is_enabled() noexcept
+    { return quad_type::is_enabled(); }
+
+    static void nlerp(const quaternion_type *a, const quaternion_type *b, size_t count, scalar_type t, quaternion_type *target)
+    { nlerp(a, b, count, t, target, std::integral_constant<bool, is_enabled()>{}); }
+
+    /// @internal
+    /// @brief The SIMD code path. Each quaternion is held in a single quad.
+    static void nlerp(const quaternion_type *a, const quaternion_type *b, size_t count, scalar_type t, quaternion_type *target, std::true_type)
+    {
+        using register_type = typename quad_type::register_type;
+        const scalar_type *p = reinterpret_cast<const scalar_type *>(a), *q = reinterpret_cast<const scalar_type *>(b);
+        scalar_type *r = reinterpret_cast<scalar_type *>(target);
+        const register_type s = quad_type::broadcast(one<scalar_type>() - t),
+                            u = quad_type::broadcast(t), v = quad_type::broadcast(-t);
+        for (size_t i = 0; i < count; ++i, p += 4, q += 4, r += 4)
+        {
+            const register_type x = quad_type::load(p), y = quad_type::load(q);
+            const bool shorter = quad_type::first(quad_type::sum(quad_type::mul(x, y))) < zero<scalar_type>();
+            const register_type z = quad_type::add(quad_type::mul(x, s), quad_type::mul(y, shorter ? v : u));
+            quad_type::store(r, quad_type::div(z, quad_type::sqrt(quad_type::sum(quad_type::mul(z, z)))));
+        }
+    }
+
+    /// @internal
+    /// @brief The scalar code path.
+    static void nlerp(const quaternion_type *a, const quaternion_type *b, size_t count, scalar_type t, quaternion_type *target, std::false_type)
+    {
+        for (size_t i = 0; i < count; ++i)
+        { target[i] = idlib::nlerp(a[i], b[i], t); }
+    }
+};
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Blend two arrays of unit quaternions by normalized linear interpolation.
+/// The quaternion at index \f$i\f$ of the target array is <c>idlib::nlerp(a[i], b[i], t)</c>.
+/// @param a, b pointers to the first quaternions of the source arrays
+/// @param count the number of quaternions
+/// @param t the interpolation parameter within the bounds of \f$[0,1]\f$
+/// @param target pointer to the first quaternion of the target array. Must have space for at least @a count quaternions.
+/// @param policy the execution policy
+/// @remark The target array may be one of the source arrays but must not overlap them otherwise.
+/// @remark If a SIMD instruction set is selected, each quaternion is blended in SIMD registers.
+template <typename Scalar>
+void nlerp(const quaternion<Scalar> *a, const quaternion<Scalar> *b, size_t count, Scalar t, quaternion<Scalar> *target,
+           const execution_policy& policy = execution_policy::sequential())
+{
+    internal::parallel_for(count, policy, [a, b, t, target](size_t first, size_t last)
+    { internal::quaternion_kernels<Scalar>::nlerp(a + first, b + first, last - first, t, target + first); });
+}
+
+/// @ingroup math
+/// @brief Blend two arrays of unit quaternions by spherical linear interpolation.
+/// The quaternion at index \f$i\f$ of the target array is <c>idlib::slerp(a[i], b[i], t)</c>.
+/// @param a, b pointers to the first quaternions of the source arrays
+/// @param count the number of quaternions
+/// @param t the interpolation parameter within the bounds of \f$[0,1]\f$
+/// @param target pointer to the first quaternion of the target array. Must have space for at least @a count quaternions.
+/// @param policy the execution policy
+/// @remark The target array may be one of the source arrays but must not overlap them otherwise.
+template <typename Scalar>
+void slerp(const quaternion<Scalar> *a, const quaternion<Scalar> *b, size_t count, Scalar t, quaternion<Scalar> *target,
+           const execution_policy& policy = execution_policy::sequential())
+{
+    internal::parallel_for(count, policy, [a, b, t, target](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        { target[i] = slerp(a[i], b[i], t); }
+    });
+}
+
+/// @ingroup math
+/// @brief Rotate an array of vectors by a unit quaternion.
+/// @param q the unit quaternion
+/// @param source pointer to the first vector of the source array
+/// @param count the number of vectors
+/// @param target pointer to the first vector of the target array. Must have space for at least @a count vectors.
+/// @param policy the execution policy
+/// @remark The quaternion is converted into a rotation matrix once and the vectors are transformed by idlib::transform_vectors.
+/// @remark The source and the target array may be the same array but must not overlap otherwise.
+template <typename Scalar>
+void rotate_vectors(const quaternion<Scalar>& q, const vector<Scalar, 3> *source, size_t count, vector<Scalar, 3> *target,
+                    const execution_policy& policy = execution_policy::sequential())
+{ transform_vectors(semantic_cast<matrix<Scalar, 4, 4>>(q), source, count, target, policy); }
+
+} // namespace idlib
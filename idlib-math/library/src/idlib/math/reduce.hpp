@@ -0,0 +1,388 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/reduce.hpp
+/// @brief Reductions of arrays of points and vectors.
+/// @author Michael Heilmann
+
+/// @detail
+/// idlib::zip_min, idlib::zip_max, idlib::bounds, idlib::sum, and idlib::centroid reduce contiguous arrays of
+/// points or vectors to a single point or vector (e.g. the axis-aligned bounds of a point cloud).
+/// @code
+/// std::vector<idlib::point<idlib::vector<single, 3>>> points(n);
+/// ...
+/// auto b = idlib::bounds(points.data(), points.size());
+/// // Split large inputs across threads.
+/// auto c = idlib::centroid(points.data(), points.size(), idlib::execution_policy::parallel());
+/// @endcode
+/// The arrays are split into blocks of a fixed number of elements. The blocks are reduced by SIMD kernels, concurrently
+/// if the execution policy permits, and the results of the blocks are combined in the order of the blocks.
+/// Consequently, the results do not depend on the execution policy, in particular not on the number of threads.
+/// They may depend on the SIMD instruction set as it determines the order in which sums are accumulated.
+
+#pragma once
+
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/point.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/math/vector.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief The kinds of reductions of idlib::internal::reduce_kernel.
+enum class reduce_kind
+{
+    /// @brief The component-wise minimum.
+    minimum,
+    /// @brief The component-wise maximum.
+    maximum,
+    /// @brief The component-wise sum.
+    sum,
+};
+
+/// @internal
+/// @brief Kernel reducing an array of tuples of @a Dimensionality scalars of type @a Scalar.
+/// @tparam Scalar the scalar type
+/// @tparam Dimensionality the number of scalars of a tuple
+template <typename Scalar, size_t Dimensionality>
+struct reduce_kernel
+{
+    using scalar_type = Scalar;
+    using pack_type = simd_native_pack<scalar_type>;
+    using register_type = typename pack_type::register_type;
+    using result_type = std::array<scalar_type, Dimensionality>;
+
+    /// @internal
+    /// @brief Reduce an array of tuples.
+    /// @param p pointer to the first scalar of the first tuple
+    /// @param count the number of tuples. Must be greater than @a 0.
+    /// @return the component-wise reduction of the tuples
+    /// @remark Each accumulator register covers width() tuples: Consider width() consecutive tuples as an array of
+    /// <c>width() * Dimensionality</c> scalars. That array is loaded into @a Dimensionality registers and
+    /// lane \f$l\f$ of register \f$j\f$ holds component \f$(j \cdot width() + l) \bmod Dimensionality\f$.
+    template <reduce_kind Kind>
+    static result_type apply(const scalar_type *p, size_t count)
+    {
+        constexpr size_t W = pack_type::width();
+        constexpr auto J = std::make_index_sequence<Dimensionality>{};
+        result_type r;
+        size_t i;
+        if (count >= W)
+        {
+            register_type a[Dimensionality];
+            load(a, p, J);
+            for (i = W; i + W <= count; i += W)
+            { step<Kind>(a, p + i * Dimensionality, J); }
+            r = fold<Kind>(a);
+        }
+        else
+        {
+            std::copy(p, p + Dimensionality, r.begin());
+            i = 1;
+        }
+        for (; i < count; ++i)
+        { r = combine<Kind>(r, p + i * Dimensionality, J); }
+        return r;
+    }
+
+    /// @internal
+    /// @brief Compute the component-wise minimum and the component-wise maximum of an array of tuples in one pass.
+    /// @param p pointer to the first scalar of the first tuple
+    /// @param count the number of tuples. Must be greater than @a 0.
+    /// @return the minimum and the maximum
+    static std::pair<result_type, result_type> apply_bounds(const scalar_type *p, size_t count)
+    {
+        constexpr size_t W = pack_type::width();
+        constexpr auto J = std::make_index_sequence<Dimensionality>{};
+        result_type r, s;
+        size_t i;
+        if (count >= W)
+        {
+            register_type a[Dimensionality], b[Dimensionality];
+            load(a, p, J);
+            load(b, p, J);
+            for (i = W; i + W <= count; i += W)
+            {
+                step<reduce_kind::minimum>(a, p + i * Dimensionality, J);
+                step<reduce_kind::maximum>(b, p + i * Dimensionality, J);
+            }
+            r = fold<reduce_kind::minimum>(a);
+            s = fold<reduce_kind::maximum>(b);
+        }
+        else
+        {
+            std::copy(p, p + Dimensionality, r.begin());
+            std::copy(p, p + Dimensionality, s.begin());
+            i = 1;
+        }
+        for (; i < count; ++i)
+        {
+            r = combine<reduce_kind::minimum>(r, p + i * Dimensionality, J);
+            s = combine<reduce_kind::maximum>(s, p + i * Dimensionality, J);
+        }
+        return std::make_pair(r, s);
+    }
+
+    /// @internal
+    /// @brief Combine two results component-wise.
+    template <reduce_kind Kind>
+    static result_type combine(const result_type& x, const result_type& y)
+    { return combine<Kind>(x, y.data(), std::make_index_sequence<Dimensionality>{}); }
+
+private:
+    using scalar_pack_type = simd_pack<scalar_type, 1>;
+
+    template <reduce_kind Kind, typename Pack>
+    static typename Pack::register_type op(typename Pack::register_type x, typename Pack::register_type y)
+    {
+        if (Kind == reduce_kind::minimum)
+        {
+            return Pack::min(x, y);
+        }
+        if (Kind == reduce_kind::maximum)
+        {
+            return Pack::max(x, y);
+        }
+        return Pack::add(x, y);
+    }
+
+    // The loops over the components are unrolled such that the accumulators are kept in registers.
+
+    template <size_t ... Js>
+    static void load(register_type (&a)[Dimensionality], const scalar_type *q, std::index_sequence<Js ...>)
+    { ((a[Js] = pack_type::load(q + Js * pack_type::width())), ...); }
+
+    template <reduce_kind Kind, size_t ... Js>
+    static void step(register_type (&a)[Dimensionality], const scalar_type *q, std::index_sequence<Js ...>)
+    { ((a[Js] = op<Kind, pack_type>(a[Js], pack_type::load(q + Js * pack_type::width()))), ...); }
+
+    template <reduce_kind Kind, size_t ... Js>
+    static result_type combine(const result_type& x, const scalar_type *y, std::index_sequence<Js ...>)
+    { return result_type{ op<Kind, scalar_pack_type>(x[Js], y[Js]) ... }; }
+
+    // Fold the lanes of the accumulator registers into a tuple.
+    template <reduce_kind Kind>
+    static result_type fold(const register_type (&a)[Dimensionality])
+    {
+        constexpr size_t W = pack_type::width();
+        scalar_type t[W * Dimensionality];
+        for (size_t j = 0; j < Dimensionality; ++j)
+        { pack_type::store(t + j * W, a[j]); }
+        result_type r;
+        std::copy(t, t + Dimensionality, r.begin());
+        for (size_t k = Dimensionality; k < W * Dimensionality; ++k)
+        { r[k % Dimensionality] = op<Kind, scalar_pack_type>(r[k % Dimensionality], t[k]); }
+        return r;
+    }
+};
+
+/// @internal
+/// @brief The number of elements of the blocks of idlib::internal::reduce_blocks.
+constexpr size_t reduce_block_size = 4096;
+
+/// @internal
+/// @brief Reduce the range \f$[0,count)\f$.
+/// The range is split into blocks of reduce_block_size elements. The blocks are reduced concurrently
+/// according to the execution policy and the results of the blocks are combined in the order of the blocks.
+/// @param count the number of elements. Must be greater than @a 0.
+/// @param policy the execution policy
+/// @param f the function receiving the first and the last index (exclusive) of a block and returning the result of the block
+/// @param g the function combining two results
+/// @return the result
+/// @remark The blocks do not depend on the execution policy, hence the result does not depend on it either.
+template <typename T, typename F, typename G>
+T reduce_blocks(size_t count, const execution_policy& policy, F&& f, G&& g)
+{
+    const size_t n = (count + reduce_block_size - 1) / reduce_block_size;
+    if (n == 1)
+    {
+        return f(size_t(0), count);
+    }
+    std::vector<T> results(n);
+    parallel_for(n, group_policy(policy, reduce_block_size), [count, &results, &f](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            results[i] = f(i * reduce_block_size, std::min(count, (i + 1) * reduce_block_size));
+        }
+    });
+    T r = results[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        r = g(r, results[i]);
+    }
+    return r;
+}
+
+/// @internal
+/// @brief Reduce an array of points or vectors.
+/// @pre @a count is greater than @a 0
+template <reduce_kind Kind, typename T>
+std::array<typename T::scalar_type, T::dimensionality()> reduce(const T *source, size_t count, const execution_policy& policy)
+{
+    using kernel_type = reduce_kernel<typename T::scalar_type, T::dimensionality()>;
+    using result_type = typename kernel_type::result_type;
+    const auto *p = scalars(source);
+    return reduce_blocks<result_type>(count, policy, [p](size_t first, size_t last)
+    {
+        return kernel_type::template apply<Kind>(p + T::dimensionality() * first, last - first);
+    }, [](const result_type& x, const result_type& y)
+    {
+        return kernel_type::template combine<Kind>(x, y);
+    });
+}
+
+/// @internal
+/// @brief Create a point or a vector from an array of scalars.
+template <typename T>
+T make(const std::array<typename T::scalar_type, T::dimensionality()>& a)
+{
+    T t(uninitialized);
+    auto *p = scalars(&t);
+    for (size_t j = 0; j < T::dimensionality(); ++j)
+    {
+        p[j] = a[j];
+    }
+    return t;
+}
+
+/// @internal
+/// @brief Raise an exception if an array is empty.
+inline void check_not_empty(size_t count)
+{
+    if (0 == count)
+    { throw std::invalid_argument("array is empty"); }
+}
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Compute the component-wise minimum of an array of points or vectors.
+/// @tparam T the point or vector type
+/// @param source pointer to the first point or vector
+/// @param count the number of points or vectors
+/// @param policy the execution policy
+/// @return the component-wise minimum
+/// @throw std::invalid_argument @a count is @a 0
+/// @remark If a component is NaN, the result is unspecified.
+template <typename T>
+T zip_min(const T *source, size_t count, const execution_policy& policy = execution_policy::sequential())
+{
+    internal::check_not_empty(count);
+    return internal::make<T>(internal::reduce<internal::reduce_kind::minimum>(source, count, policy));
+}
+
+/// @ingroup math
+/// @brief Compute the component-wise maximum of an array of points or vectors.
+/// @tparam T the point or vector type
+/// @param source pointer to the first point or vector
+/// @param count the number of points or vectors
+/// @param policy the execution policy
+/// @return the component-wise maximum
+/// @throw std::invalid_argument @a count is @a 0
+/// @remark If a component is NaN, the result is unspecified.
+template <typename T>
+T zip_max(const T *source, size_t count, const execution_policy& policy = execution_policy::sequential())
+{
+    internal::check_not_empty(count);
+    return internal::make<T>(internal::reduce<internal::reduce_kind::maximum>(source, count, policy));
+}
+
+/// @ingroup math
+/// @brief Compute the component-wise minimum and the component-wise maximum of an array of points or vectors in one pass.
+/// For an array of points, these are the corners of the smallest axis-aligned box enclosing the points.
+/// @tparam T the point or vector type
+/// @param source pointer to the first point or vector
+/// @param count the number of points or vectors
+/// @param policy the execution policy
+/// @return the component-wise minimum (first) and the component-wise maximum (second)
+/// @throw std::invalid_argument @a count is @a 0
+/// @remark If a component is NaN, the result is unspecified.
+template <typename T>
+std::pair<T, T> bounds(const T *source, size_t count, const execution_policy& policy = execution_policy::sequential())
+{
+    internal::check_not_empty(count);
+    using kernel_type = internal::reduce_kernel<typename T::scalar_type, T::dimensionality()>;
+    using result_type = std::pair<typename kernel_type::result_type, typename kernel_type::result_type>;
+    const auto *p = internal::scalars(source);
+    const auto r = internal::reduce_blocks<result_type>(count, policy, [p](size_t first, size_t last)
+    {
+        return kernel_type::apply_bounds(p + T::dimensionality() * first, last - first);
+    }, [](const result_type& x, const result_type& y)
+    {
+        return std::make_pair(kernel_type::template combine<internal::reduce_kind::minimum>(x.first, y.first),
+                              kernel_type::template combine<internal::reduce_kind::maximum>(x.second, y.second));
+    });
+    return std::make_pair(internal::make<T>(r.first), internal::make<T>(r.second));
+}
+
+/// @ingroup math
+/// @brief Compute the sum of an array of vectors.
+/// @param source pointer to the first vector
+/// @param count the number of vectors
+/// @param policy the execution policy
+/// @return the sum. The zero vector if @a count is @a 0.
+template <typename Scalar, size_t Dimensionality>
+vector<Scalar, Dimensionality> sum(const vector<Scalar, Dimensionality> *source, size_t count,
+                                   const execution_policy& policy = execution_policy::sequential())
+{
+    if (0 == count)
+    {
+        return vector<Scalar, Dimensionality>();
+    }
+    return internal::make<vector<Scalar, Dimensionality>>(internal::reduce<internal::reduce_kind::sum>(source, count, policy));
+}
+
+/// @ingroup math
+/// @brief Compute the centroid of an array of points.
+/// The centroid of the points \f$p_0,\ldots,p_{n-1}\f$ is \f$\frac{1}{n}\sum_{i=0}^{n-1} p_i\f$.
+/// @param source pointer to the first point
+/// @param count the number of points
+/// @param policy the execution policy
+/// @return the centroid
+/// @throw std::invalid_argument @a count is @a 0
+template <typename Vector>
+point<Vector> centroid(const point<Vector> *source, size_t count, const execution_policy& policy = execution_policy::sequential())
+{
+    static_assert(std::is_floating_point<typename Vector::scalar_type>::value, "scalar type must be a floating point type");
+    internal::check_not_empty(count);
+    auto a = internal::reduce<internal::reduce_kind::sum>(source, count, policy);
+    for (auto& x : a)
+    {
+        x /= static_cast<typename Vector::scalar_type>(count);
+    }
+    return internal::make<point<Vector>>(a);
+}
+
+} // namespace idlib
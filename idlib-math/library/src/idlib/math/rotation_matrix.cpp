@@ -1,16 +1,15 @@
 #include "idlib/math/rotation_matrix.hpp"
+#include "idlib/math/sincos.hpp"
 
 namespace idlib {
 
-matrix<single, 4, 4> rotation_matrix_x(const angle<single, degrees>& a)
-{ return rotation_matrix_x(semantic_cast<angle<single, radians>>(a)); }
-
-matrix<single, 4, 4> rotation_matrix_x(const angle<single, turns>& a)
-{ return rotation_matrix_x(semantic_cast<angle<single, radians>>(a)); }
+namespace {
 
-matrix<single, 4, 4> rotation_matrix_x(const angle<single, radians>& a)
+template <typename Semantics>
+matrix<single, 4, 4> make_rotation_matrix_x(const angle<single, Semantics>& a)
 {
-    single c = std::cos(a), s = std::sin(a);
+    const auto sc = sincos(a);
+    single s = sc.first, c = sc.second;
     return
         matrix<single, 4, 4>
         (
@@ -21,15 +20,11 @@ matrix<single, 4, 4> rotation_matrix_x(const angle<single, radians>& a)
         );
 }
 
-matrix<single, 4, 4> rotation_matrix_y(const angle<single, degrees>& a)
-{ return rotation_matrix_y(semantic_cast<angle<single, radians>>(a)); }
-
-matrix<single, 4, 4> rotation_matrix_y(const angle<single, turns>& a)
-{ return rotation_matrix_y(semantic_cast<angle<single, radians>>(a)); }
-
-matrix<single, 4, 4> rotation_matrix_y(const angle<single, radians>& a)
+template <typename Semantics>
+matrix<single, 4, 4> make_rotation_matrix_y(const angle<single, Semantics>& a)
 {
-    single c = std::cos(a), s = std::sin(a);
+    const auto sc = sincos(a);
+    single s = sc.first, c = sc.second;
     return
         matrix<single, 4, 4>
         (
@@ -40,15 +35,11 @@ matrix<single, 4, 4> rotation_matrix_y(const angle<single, radians>& a)
         );
 }
 
- matrix<single, 4, 4> rotation_matrix_z(const angle<single, degrees>& a)
-{ return rotation_matrix_z(semantic_cast<angle<single, radians>>(a)); }
-
-matrix<single, 4, 4> rotation_matrix_z(const angle<single, turns>& a)
-{ return rotation_matrix_z(semantic_cast<angle<single, radians>>(a)); }
-
-matrix<single, 4, 4> rotation_matrix_z(const angle<single, radians>& a)
+template <typename Semantics>
+matrix<single, 4, 4> make_rotation_matrix_z(const angle<single, Semantics>& a)
 {
-    single c = std::cos(a), s = std::sin(a);
+    const auto sc = sincos(a);
+    single s = sc.first, c = sc.second;
     return
         matrix<single, 4, 4>
         (
@@ -59,15 +50,11 @@ matrix<single, 4, 4> rotation_matrix_z(const angle<single, radians>& a)
         );
 }
 
-matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, degrees>& angle)
-{ return rotation_matrix(axis, semantic_cast<idlib::angle<single, radians>>(angle)); }
-
-matrix<single, 4, 4> rotation(const vector<single, 3>& axis, const angle<single, turns>& angle)
-{ return rotation_matrix(axis, semantic_cast<idlib::angle<single, radians>>(angle)); }
-
-matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, radians>& angle)
+template <typename Semantics>
+matrix<single, 4, 4> make_rotation_matrix(const vector<single, 3>& axis, const angle<single, Semantics>& angle)
 {
-    single c = std::cos(angle), s = std::sin(angle);
+    const auto sc = sincos(angle);
+    single c = sc.second, s = sc.first;
     single t = 1.0f - c;
     single x = axis[0], y = axis[1], z = axis[2];
     single xx = x*x, yy = y*y, zz = z*z;
@@ -90,4 +77,42 @@ matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<
         );
 }
 
+} // namespace
+
+matrix<single, 4, 4> rotation_matrix_x(const angle<single, degrees>& a)
+{ return make_rotation_matrix_x(a); }
+
+matrix<single, 4, 4> rotation_matrix_x(const angle<single, turns>& a)
+{ return make_rotation_matrix_x(a); }
+
+matrix<single, 4, 4> rotation_matrix_x(const angle<single, radians>& a)
+{ return make_rotation_matrix_x(a); }
+
+matrix<single, 4, 4> rotation_matrix_y(const angle<single, degrees>& a)
+{ return make_rotation_matrix_y(a); }
+
+matrix<single, 4, 4> rotation_matrix_y(const angle<single, turns>& a)
+{ return make_rotation_matrix_y(a); }
+
+matrix<single, 4, 4> rotation_matrix_y(const angle<single, radians>& a)
+{ return make_rotation_matrix_y(a); }
+
+matrix<single, 4, 4> rotation_matrix_z(const angle<single, degrees>& a)
+{ return make_rotation_matrix_z(a); }
+
+matrix<single, 4, 4> rotation_matrix_z(const angle<single, turns>& a)
+{ return make_rotation_matrix_z(a); }
+
+matrix<single, 4, 4> rotation_matrix_z(const angle<single, radians>& a)
+{ return make_rotation_matrix_z(a); }
+
+matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, degrees>& angle)
+{ return make_rotation_matrix(axis, angle); }
+
+matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, turns>& angle)
+{ return make_rotation_matrix(axis, angle); }
+
+matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, radians>& angle)
+{ return make_rotation_matrix(axis, angle); }
+
 } // namespace idlib
@@ -28,7 +28,7 @@ namespace idlib {
  *  0 & 0 &  0 & 1 \\
  *  \end{matrix}\right]
  *  \f]
- *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$.
+ *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$ are computed by idlib::sincos.
  */
 matrix<single, 4, 4> rotation_matrix_x(const angle<single, degrees>& a);
 
@@ -53,7 +53,7 @@ matrix<single, 4, 4> rotation_matrix_x(const angle<single, radians>& a);
  *   0 & 0 & 0 & 1 \\
  *  \end{matrix}\right]
  *  \f]
- *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$.
+ *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$ are computed by idlib::sincos.
  */
 matrix<single, 4, 4> rotation_matrix_y(const angle<single, degrees>& a);
 
@@ -78,7 +78,7 @@ matrix<single, 4, 4> rotation_matrix_y(const angle<single, radians>& a);
  *  0 &  0 & 0 & 1 \\
  *  \end{matrix}\right]
  *  \f]
- *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$.
+ *  where \f$c=\cos(a)\f$ and \f$s=\sin(a)\f$ are computed by idlib::sincos.
  */
 matrix<single, 4, 4> rotation_matrix_z(const angle<single, degrees>& a);
 
@@ -289,6 +289,7 @@ matrix<single, 4, 4> rotation_matrix_z(const angle<single, radians>& a);
  *  s_1 = s\hat{\vec{r}}_1, s_2 = s\hat{\vec{r}}_2, s_3 = s\hat{\vec{r}}_3
  *  \f}
  *  This implementation performs this form of elimination of common subexpressions.
+ *  The sine and the cosine are computed by idlib::sincos.
  */
 matrix<single, 4, 4> rotation_matrix(const vector<single, 3>& axis, const angle<single, degrees>& angle);
 
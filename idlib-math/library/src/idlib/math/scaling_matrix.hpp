@@ -12,23 +12,6 @@
 
 namespace idlib {
 
-/**
- * @brief Get a uniform scaling matrix.
- * @param s the scaling scalar
- * @return the matrix
- * @remark
- * The expression
- * @code
- * scaling(s)
- * @endcode
- * is equivalent to the expression
- * @code
- * scaling(one<vector<single, 3>>() * s)
- * @endcode call
- * @see idlib::scaling<const vector<single, 3>&)
- */
-matrix<single, 4, 4> scaling_matrix(single s);
-
 /**
  * @brief Get a non-uniform scaling scaling matrix.
  * @param s the scaling vector
@@ -44,6 +27,30 @@ matrix<single, 4, 4> scaling_matrix(single s);
  * \end{matrix}\right]
  * \f]
  */
-matrix<single, 4, 4> scaling_matrix(const vector<single, 3>& s);
+constexpr matrix<single, 4, 4> scaling_matrix(const vector<single, 3>& s)
+{
+    return matrix<single, 4, 4>(s[0], 0,    0,    0,
+                                0,    s[1], 0,    0,
+                                0,    0,    s[2], 0,
+                                0,    0,    0,    1);
+}
+
+/**
+ * @brief Get a uniform scaling matrix.
+ * @param s the scaling scalar
+ * @return the matrix
+ * @remark
+ * The expression
+ * @code
+ * scaling(s)
+ * @endcode
+ * is equivalent to the expression
+ * @code
+ * scaling(one<vector<single, 3>>() * s)
+ * @endcode call
+ * @see idlib::scaling<const vector<single, 3>&)
+ */
+constexpr matrix<single, 4, 4> scaling_matrix(single s)
+{ return scaling_matrix(one<vector<single, 3>>() * s); }
 
 } // namespace idlib
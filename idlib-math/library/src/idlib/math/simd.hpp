@@ -0,0 +1,759 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/simd.hpp
+/// @brief SIMD backend of the math library.
+/// @author Michael Heilmann
+
+/// @detail
+/// The instruction set used by the SIMD backend is selected at build time by defining the constant
+/// #IDLIB_MATH_SIMD to one of the following symbolic constants
+/// - #IDLIB_MATH_SIMD_NONE (scalar fallback),
+/// - #IDLIB_MATH_SIMD_SSE2 (SSE2), or
+/// - #IDLIB_MATH_SIMD_AVX (AVX).
+/// The build system defines #IDLIB_MATH_SIMD according to the value of the option <c>idlib-math-simd</c>.
+/// If #IDLIB_MATH_SIMD is not defined, it defaults to #IDLIB_MATH_SIMD_NONE.
+/// </br>
+/// The backend does not change the public API: the arithmetic functors of idlib::arithmetic_array_1d
+/// as well as idlib::dot_product, idlib::cross_product, idlib::squared_euclidean_norm, and idlib::euclidean_norm
+/// for idlib::vector dispatch to it if a kernel for the element type and the length is available.
+/// </br>
+/// The kernels cannot be constant-evaluated. Callers which are constexpr use their scalar code path
+/// if idlib::internal::is_constant_evaluated() is @a true.
+
+#pragma once
+
+#include "idlib/numeric.hpp"
+#include "idlib/platform.hpp"
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+/// @brief Symbolic constant denoting the scalar fallback.
+#define IDLIB_MATH_SIMD_NONE (0)
+
+/// @brief Symbolic constant denoting SSE2.
+#define IDLIB_MATH_SIMD_SSE2 (1)
+
+/// @brief Symbolic constant denoting AVX.
+#define IDLIB_MATH_SIMD_AVX (2)
+
+#if !defined(IDLIB_MATH_SIMD)
+    #define IDLIB_MATH_SIMD IDLIB_MATH_SIMD_NONE
+#endif
+
+#if IDLIB_MATH_SIMD != IDLIB_MATH_SIMD_NONE && IDLIB_MATH_SIMD != IDLIB_MATH_SIMD_SSE2 && IDLIB_MATH_SIMD != IDLIB_MATH_SIMD_AVX
+    #error IDLIB_MATH_SIMD must be defined to IDLIB_MATH_SIMD_NONE, IDLIB_MATH_SIMD_SSE2, or IDLIB_MATH_SIMD_AVX
+#endif
+
+#if IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_AVX
+    #include <immintrin.h>
+#elif IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace idlib::internal {
+
+/// @internal
+/// @brief Get if the call occurs within a constant-evaluated context.
+/// @return @a true if the call occurs within a constant-evaluated context, @a false otherwise
+/// @remark If the compiler does not provide the intrinsic, this function returns @a false.
+/// In that case, code dispatching to the SIMD backend cannot be constant-evaluated if a SIMD instruction set is selected.
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+/// @internal
+/// @brief A pack of @a Width scalars of type @a Scalar held in a single register.
+/// A pack provides static functions for loading, storing, and combining registers.
+/// @tparam Scalar the scalar type
+/// @tparam Width the number of scalars in a register
+/// @remark The partial specialization for @a Width equal to @a 1 is the scalar fallback and available for all scalar types.
+/// Other specializations are available depending on the value of #IDLIB_MATH_SIMD.
+template <typename Scalar, size_t Width, typename Enabled = void>
+struct simd_pack;
+
+template <typename Scalar>
+struct simd_pack<Scalar, 1, void>
+{
+    using scalar_type = Scalar;
+    using register_type = Scalar;
+    using mask_type = bool;
+
+    static constexpr size_t width() noexcept
+    { return 1; }
+
+    static register_type zero()
+    { return scalar_type(0); }
+
+    static register_type broadcast(scalar_type x)
+    { return x; }
+
+    static register_type load(const scalar_type *p)
+    { return *p; }
+
+    /// @brief Load from an address aligned to the size of a register.
+    static register_type load_aligned(const scalar_type *p)
+    { return *p; }
+
+    /// @brief Load the first @a n scalars, set the remaining ones to zero.
+    static register_type load(const scalar_type *p, size_t n)
+    { return n > 0 ? *p : scalar_type(0); }
+
+    static void store(scalar_type *p, register_type x)
+    { *p = x; }
+
+    /// @brief Store to an address aligned to the size of a register.
+    static void store_aligned(scalar_type *p, register_type x)
+    { *p = x; }
+
+    /// @brief Store the first @a n scalars.
+    static void store(scalar_type *p, register_type x, size_t n)
+    { if (n > 0) *p = x; }
+
+    static register_type add(register_type x, register_type y)
+    { return x + y; }
+
+    static register_type sub(register_type x, register_type y)
+    { return x - y; }
+
+    static register_type mul(register_type x, register_type y)
+    { return x * y; }
+
+    static register_type div(register_type x, register_type y)
+    { return x / y; }
+
+    static register_type neg(register_type x)
+    { return -x; }
+
+    /// @remark Returns @a y if any of @a x and @a y is NaN.
+    static register_type min(register_type x, register_type y)
+    { return x < y ? x : y; }
+
+    /// @remark Returns @a y if any of @a x and @a y is NaN.
+    static register_type max(register_type x, register_type y)
+    { return x > y ? x : y; }
+
+    static register_type sqrt(register_type x)
+    { return std::sqrt(x); }
+
+    /// @brief Compute the reciprocal of the square root of the scalar.
+    template <precision P>
+    static register_type rsqrt(register_type x)
+    { return rsqrt_functor<scalar_type, P>()(x); }
+
+    static mask_type cmp_gt(register_type x, register_type y)
+    { return x > y; }
+
+    /// @brief Select the scalars of @a x where the mask is set and the scalars of @a y otherwise.
+    static register_type select(mask_type m, register_type x, register_type y)
+    { return m ? x : y; }
+
+    /// @brief Get the bits of a mask: Bit \f$i\f$ is set if the mask is set for scalar \f$i\f$.
+    static unsigned int bits(mask_type m)
+    { return m ? 1 : 0; }
+
+    /// @brief Get the sum of the scalars in a register.
+    static scalar_type sum(register_type x)
+    { return x; }
+};
+
+#if IDLIB_MATH_SIMD >= IDLIB_MATH_SIMD_SSE2
+
+template <>
+struct simd_pack<single, 4, void>
+{
+    using scalar_type = single;
+    using register_type = __m128;
+    using mask_type = __m128;
+
+    static constexpr size_t width() noexcept
+    { return 4; }
+
+    static register_type zero()
+    { return _mm_setzero_ps(); }
+
+    static register_type broadcast(scalar_type x)
+    { return _mm_set1_ps(x); }
+
+    static register_type load(const scalar_type *p)
+    { return _mm_loadu_ps(p); }
+
+    static register_type load_aligned(const scalar_type *p)
+    { return _mm_load_ps(p); }
+
+    static register_type load(const scalar_type *p, size_t n)
+    {
+        switch (n)
+        {
+            case 0: return _mm_setzero_ps();
+            case 1: return _mm_load_ss(p);
+            case 2: return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(p)));
+            case 3: return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(p))), _mm_load_ss(p + 2));
+            default: return _mm_loadu_ps(p);
+        };
+    }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm_storeu_ps(p, x); }
+
+    static void store_aligned(scalar_type *p, register_type x)
+    { _mm_store_ps(p, x); }
+
+    static void store(scalar_type *p, register_type x, size_t n)
+    {
+        switch (n)
+        {
+            case 0: break;
+            case 1: _mm_store_ss(p, x); break;
+            case 2: _mm_store_sd(reinterpret_cast<double *>(p), _mm_castps_pd(x)); break;
+            case 3: _mm_store_sd(reinterpret_cast<double *>(p), _mm_castps_pd(x)); _mm_store_ss(p + 2, _mm_movehl_ps(x, x)); break;
+            default: _mm_storeu_ps(p, x); break;
+        };
+    }
+
+    static register_type add(register_type x, register_type y)
+    { return _mm_add_ps(x, y); }
+
+    static register_type sub(register_type x, register_type y)
+    { return _mm_sub_ps(x, y); }
+
+    static register_type mul(register_type x, register_type y)
+    { return _mm_mul_ps(x, y); }
+
+    static register_type div(register_type x, register_type y)
+    { return _mm_div_ps(x, y); }
+
+    static register_type neg(register_type x)
+    { return _mm_xor_ps(x, _mm_set1_ps(-0.0f)); }
+
+    static register_type min(register_type x, register_type y)
+    { return _mm_min_ps(x, y); }
+
+    static register_type max(register_type x, register_type y)
+    { return _mm_max_ps(x, y); }
+
+    static register_type sqrt(register_type x)
+    { return _mm_sqrt_ps(x); }
+
+    /// @brief Compute the reciprocals of the square roots of the scalars.
+    template <precision P>
+    static register_type rsqrt(register_type x)
+    { return rsqrt(x, std::integral_constant<precision, P>{}); }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::exact>)
+    { return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x)); }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::newton_raphson>)
+    {
+        const register_type y = _mm_rsqrt_ps(x);
+        const register_type t = _mm_mul_ps(_mm_mul_ps(x, y), y);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), t));
+    }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::estimate>)
+    { return _mm_rsqrt_ps(x); }
+
+    static mask_type cmp_gt(register_type x, register_type y)
+    { return _mm_cmpgt_ps(x, y); }
+
+    static register_type select(mask_type m, register_type x, register_type y)
+    { return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y)); }
+
+    static unsigned int bits(mask_type m)
+    { return static_cast<unsigned int>(_mm_movemask_ps(m)); }
+
+    /// @remark The sum is computed as \f$(x_0 + x_1) + (x_2 + x_3)\f$.
+    static scalar_type sum(register_type x)
+    {
+        register_type t = _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_add_ss(t, _mm_movehl_ps(t, t)));
+    }
+
+    /// @brief Rotate the first three scalars of a register to the left i.e. \f$(x_1,x_2,x_0,x_3)\f$.
+    static register_type rotate_left_3(register_type x)
+    { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 0, 2, 1)); }
+};
+
+template <>
+struct simd_pack<double, 2, void>
+{
+    using scalar_type = double;
+    using register_type = __m128d;
+    using mask_type = __m128d;
+
+    static constexpr size_t width() noexcept
+    { return 2; }
+
+    static register_type zero()
+    { return _mm_setzero_pd(); }
+
+    static register_type broadcast(scalar_type x)
+    { return _mm_set1_pd(x); }
+
+    static register_type load(const scalar_type *p)
+    { return _mm_loadu_pd(p); }
+
+    static register_type load_aligned(const scalar_type *p)
+    { return _mm_load_pd(p); }
+
+    static register_type load(const scalar_type *p, size_t n)
+    {
+        switch (n)
+        {
+            case 0: return _mm_setzero_pd();
+            case 1: return _mm_load_sd(p);
+            default: return _mm_loadu_pd(p);
+        };
+    }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm_storeu_pd(p, x); }
+
+    static void store_aligned(scalar_type *p, register_type x)
+    { _mm_store_pd(p, x); }
+
+    static void store(scalar_type *p, register_type x, size_t n)
+    {
+        switch (n)
+        {
+            case 0: break;
+            case 1: _mm_store_sd(p, x); break;
+            default: _mm_storeu_pd(p, x); break;
+        };
+    }
+
+    static register_type add(register_type x, register_type y)
+    { return _mm_add_pd(x, y); }
+
+    static register_type sub(register_type x, register_type y)
+    { return _mm_sub_pd(x, y); }
+
+    static register_type mul(register_type x, register_type y)
+    { return _mm_mul_pd(x, y); }
+
+    static register_type div(register_type x, register_type y)
+    { return _mm_div_pd(x, y); }
+
+    static register_type neg(register_type x)
+    { return _mm_xor_pd(x, _mm_set1_pd(-0.0)); }
+
+    static register_type min(register_type x, register_type y)
+    { return _mm_min_pd(x, y); }
+
+    static register_type max(register_type x, register_type y)
+    { return _mm_max_pd(x, y); }
+
+    static register_type sqrt(register_type x)
+    { return _mm_sqrt_pd(x); }
+
+    /// @brief Compute the reciprocals of the square roots of the scalars.
+    /// @remark No estimate is available for @a double: All precision policies compute the exact result.
+    template <precision P>
+    static register_type rsqrt(register_type x)
+    { return _mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(x)); }
+
+    static mask_type cmp_gt(register_type x, register_type y)
+    { return _mm_cmpgt_pd(x, y); }
+
+    static register_type select(mask_type m, register_type x, register_type y)
+    { return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, y)); }
+
+    static unsigned int bits(mask_type m)
+    { return static_cast<unsigned int>(_mm_movemask_pd(m)); }
+
+    static scalar_type sum(register_type x)
+    { return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x))); }
+};
+
+#endif
+
+#if IDLIB_MATH_SIMD >= IDLIB_MATH_SIMD_AVX
+
+template <>
+struct simd_pack<single, 8, void>
+{
+    using scalar_type = single;
+    using register_type = __m256;
+    using mask_type = __m256;
+
+    static constexpr size_t width() noexcept
+    { return 8; }
+
+    static register_type zero()
+    { return _mm256_setzero_ps(); }
+
+    static register_type broadcast(scalar_type x)
+    { return _mm256_set1_ps(x); }
+
+    static register_type load(const scalar_type *p)
+    { return _mm256_loadu_ps(p); }
+
+    static register_type load_aligned(const scalar_type *p)
+    { return _mm256_load_ps(p); }
+
+    static register_type load(const scalar_type *p, size_t n)
+    { return _mm256_maskload_ps(p, mask(n)); }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm256_storeu_ps(p, x); }
+
+    static void store_aligned(scalar_type *p, register_type x)
+    { _mm256_store_ps(p, x); }
+
+    static void store(scalar_type *p, register_type x, size_t n)
+    { _mm256_maskstore_ps(p, mask(n), x); }
+
+    static register_type add(register_type x, register_type y)
+    { return _mm256_add_ps(x, y); }
+
+    static register_type sub(register_type x, register_type y)
+    { return _mm256_sub_ps(x, y); }
+
+    static register_type mul(register_type x, register_type y)
+    { return _mm256_mul_ps(x, y); }
+
+    static register_type div(register_type x, register_type y)
+    { return _mm256_div_ps(x, y); }
+
+    static register_type neg(register_type x)
+    { return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f)); }
+
+    static register_type min(register_type x, register_type y)
+    { return _mm256_min_ps(x, y); }
+
+    static register_type max(register_type x, register_type y)
+    { return _mm256_max_ps(x, y); }
+
+    static register_type sqrt(register_type x)
+    { return _mm256_sqrt_ps(x); }
+
+    /// @brief Compute the reciprocals of the square roots of the scalars.
+    template <precision P>
+    static register_type rsqrt(register_type x)
+    { return rsqrt(x, std::integral_constant<precision, P>{}); }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::exact>)
+    { return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x)); }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::newton_raphson>)
+    {
+        const register_type y = _mm256_rsqrt_ps(x);
+        const register_type t = _mm256_mul_ps(_mm256_mul_ps(x, y), y);
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), y), _mm256_sub_ps(_mm256_set1_ps(3.0f), t));
+    }
+
+    static register_type rsqrt(register_type x, std::integral_constant<precision, precision::estimate>)
+    { return _mm256_rsqrt_ps(x); }
+
+    static mask_type cmp_gt(register_type x, register_type y)
+    { return _mm256_cmp_ps(x, y, _CMP_GT_OQ); }
+
+    static register_type select(mask_type m, register_type x, register_type y)
+    { return _mm256_blendv_ps(y, x, m); }
+
+    static unsigned int bits(mask_type m)
+    { return static_cast<unsigned int>(_mm256_movemask_ps(m)); }
+
+    static scalar_type sum(register_type x)
+    {
+        return simd_pack<single, 4>::sum(_mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1)));
+    }
+
+private:
+    static __m256i mask(size_t n)
+    {
+        const int m = static_cast<int>(std::min(n, width()));
+        return _mm256_setr_epi32(0 < m ? -1 : 0, 1 < m ? -1 : 0, 2 < m ? -1 : 0, 3 < m ? -1 : 0,
+                                 4 < m ? -1 : 0, 5 < m ? -1 : 0, 6 < m ? -1 : 0, 7 < m ? -1 : 0);
+    }
+};
+
+template <>
+struct simd_pack<double, 4, void>
+{
+    using scalar_type = double;
+    using register_type = __m256d;
+    using mask_type = __m256d;
+
+    static constexpr size_t width() noexcept
+    { return 4; }
+
+    static register_type zero()
+    { return _mm256_setzero_pd(); }
+
+    static register_type broadcast(scalar_type x)
+    { return _mm256_set1_pd(x); }
+
+    static register_type load(const scalar_type *p)
+    { return _mm256_loadu_pd(p); }
+
+    static register_type load_aligned(const scalar_type *p)
+    { return _mm256_load_pd(p); }
+
+    static register_type load(const scalar_type *p, size_t n)
+    { return _mm256_maskload_pd(p, mask(n)); }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm256_storeu_pd(p, x); }
+
+    static void store_aligned(scalar_type *p, register_type x)
+    { _mm256_store_pd(p, x); }
+
+    static void store(scalar_type *p, register_type x, size_t n)
+    { _mm256_maskstore_pd(p, mask(n), x); }
+
+    static register_type add(register_type x, register_type y)
+    { return _mm256_add_pd(x, y); }
+
+    static register_type sub(register_type x, register_type y)
+    { return _mm256_sub_pd(x, y); }
+
+    static register_type mul(register_type x, register_type y)
+    { return _mm256_mul_pd(x, y); }
+
+    static register_type div(register_type x, register_type y)
+    { return _mm256_div_pd(x, y); }
+
+    static register_type neg(register_type x)
+    { return _mm256_xor_pd(x, _mm256_set1_pd(-0.0)); }
+
+    static register_type min(register_type x, register_type y)
+    { return _mm256_min_pd(x, y); }
+
+    static register_type max(register_type x, register_type y)
+    { return _mm256_max_pd(x, y); }
+
+    static register_type sqrt(register_type x)
+    { return _mm256_sqrt_pd(x); }
+
+    /// @brief Compute the reciprocals of the square roots of the scalars.
+    /// @remark No estimate is available for @a double: All precision policies compute the exact result.
+    template <precision P>
+    static register_type rsqrt(register_type x)
+    { return _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(x)); }
+
+    static mask_type cmp_gt(register_type x, register_type y)
+    { return _mm256_cmp_pd(x, y, _CMP_GT_OQ); }
+
+    static register_type select(mask_type m, register_type x, register_type y)
+    { return _mm256_blendv_pd(y, x, m); }
+
+    static unsigned int bits(mask_type m)
+    { return static_cast<unsigned int>(_mm256_movemask_pd(m)); }
+
+    /// @remark The sum is computed as \f$(x_0 + x_1) + (x_2 + x_3)\f$.
+    static scalar_type sum(register_type x)
+    {
+        register_type t = _mm256_hadd_pd(x, x);
+        return _mm_cvtsd_f64(_mm_add_sd(_mm256_castpd256_pd128(t), _mm256_extractf128_pd(t, 1)));
+    }
+
+private:
+    static __m256i mask(size_t n)
+    {
+        const long long m = static_cast<long long>(std::min(n, width()));
+        return _mm256_setr_epi64x(0 < m ? -1 : 0, 1 < m ? -1 : 0, 2 < m ? -1 : 0, 3 < m ? -1 : 0);
+    }
+};
+
+#endif
+
+/// @internal
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to the width of the widest available idlib::internal::simd_pack for the specified scalar type.
+template <typename Scalar>
+struct simd_native_width : std::integral_constant<size_t, 1>
+{};
+
+#if IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_AVX
+
+template <>
+struct simd_native_width<single> : std::integral_constant<size_t, 8>
+{};
+
+template <>
+struct simd_native_width<double> : std::integral_constant<size_t, 4>
+{};
+
+#elif IDLIB_MATH_SIMD == IDLIB_MATH_SIMD_SSE2
+
+template <>
+struct simd_native_width<single> : std::integral_constant<size_t, 4>
+{};
+
+template <>
+struct simd_native_width<double> : std::integral_constant<size_t, 2>
+{};
+
+#endif
+
+/// @internal
+/// @brief The widest available idlib::internal::simd_pack for the specified scalar type.
+template <typename Scalar>
+using simd_native_pack = simd_pack<Scalar, simd_native_width<Scalar>::value>;
+
+/// @internal
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to the width of the narrowest available idlib::internal::simd_pack for the specified scalar type.
+template <typename Scalar>
+struct simd_narrowest_width
+    : std::integral_constant<size_t, (simd_native_width<Scalar>::value == 1) ? 1 :
+                                     (std::is_same<Scalar, single>::value ? 4 : 2)>
+{};
+
+/// @internal
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to the width of the widest available idlib::internal::simd_pack for the specified scalar type
+/// which can be loaded from and stored to addresses aligned to @a Alignment bytes.
+template <typename Scalar, size_t Alignment>
+struct simd_aligned_width
+    : std::integral_constant<size_t, (simd_native_width<Scalar>::value * sizeof(Scalar) <= Alignment) ? simd_native_width<Scalar>::value :
+                                     (simd_narrowest_width<Scalar>::value * sizeof(Scalar) <= Alignment) ? simd_narrowest_width<Scalar>::value : 1>
+{};
+
+/// @internal
+constexpr size_t simd_array_width_impl(size_t length, size_t width, size_t native_width)
+{ return (width >= native_width || width >= length) ? std::min(width, native_width) : simd_array_width_impl(length, 2 * width, native_width); }
+
+/// @internal
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to the width of the idlib::internal::simd_pack used for arrays of the specified length:
+/// The width of the narrowest pack holding the entire array if such a pack is available, the native width otherwise.
+template <typename Scalar, size_t Length>
+struct simd_array_width
+    : std::integral_constant<size_t, (Length <= 1) ? 1 : simd_array_width_impl(Length, simd_narrowest_width<Scalar>::value,
+                                                                               simd_native_width<Scalar>::value)>
+{};
+
+/// @internal
+/// @brief Kernels for arrays of @a Length scalars of type @a Scalar.
+/// The kernels operate on arrays of scalars rather than on registers.
+/// The array pointers need not be aligned and the arrays may overlap if they are identical.
+/// @remark is_enabled() is @a true if @a Scalar is idlib::single or @a double, @a Length is @a 2, @a 3, or @a 4, and a SIMD instruction set is selected.
+/// Callers are expected to use their scalar code path if is_enabled() is @a false.
+template <typename Scalar, size_t Length>
+struct simd_array
+{
+    using scalar_type = Scalar;
+    using pack_type = simd_pack<scalar_type, simd_array_width<scalar_type, Length>::value>;
+    using register_type = typename pack_type::register_type;
+
+    static constexpr bool is_enabled() noexcept
+    {
+        return (std::is_same<scalar_type, single>::value || std::is_same<scalar_type, double>::value)
+            && 2 <= Length && Length <= 4
+            && pack_type::width() > 1;
+    }
+
+    static void add(const scalar_type *x, const scalar_type *y, scalar_type *z)
+    { apply(x, y, z, [](register_type a, register_type b) { return pack_type::add(a, b); }); }
+
+    static void sub(const scalar_type *x, const scalar_type *y, scalar_type *z)
+    { apply(x, y, z, [](register_type a, register_type b) { return pack_type::sub(a, b); }); }
+
+    static void mul(const scalar_type *x, scalar_type y, scalar_type *z)
+    {
+        const register_type b = pack_type::broadcast(y);
+        apply(x, z, [b](register_type a) { return pack_type::mul(a, b); });
+    }
+
+    static void div(const scalar_type *x, scalar_type y, scalar_type *z)
+    {
+        const register_type b = pack_type::broadcast(y);
+        apply(x, z, [b](register_type a) { return pack_type::div(a, b); });
+    }
+
+    static void neg(const scalar_type *x, scalar_type *z)
+    { apply(x, z, [](register_type a) { return pack_type::neg(a); }); }
+
+    /// @brief Compute the dot product of two arrays.
+    /// @remark The products are summed up register by register.
+    static scalar_type dot(const scalar_type *x, const scalar_type *y)
+    {
+        constexpr size_t W = pack_type::width();
+        scalar_type s = pack_type::sum(pack_type::mul(pack_type::load(x, std::min(W, Length)),
+                                                      pack_type::load(y, std::min(W, Length))));
+        for (size_t i = W; i < Length; i += W)
+        {
+            const size_t n = std::min(W, Length - i);
+            s += pack_type::sum(pack_type::mul(pack_type::load(x + i, n), pack_type::load(y + i, n)));
+        }
+        return s;
+    }
+
+    /// @brief Compute the cross product of two arrays of length 3.
+    static void cross(const scalar_type *x, const scalar_type *y, scalar_type *z)
+    {
+        static_assert(Length == 3, "the cross product is only defined for arrays of length 3");
+        cross(x, y, z, std::integral_constant<bool, std::is_same<scalar_type, single>::value && pack_type::width() == 4>{});
+    }
+
+private:
+    // (x1 y2 - x2 y1, x2 y0 - x0 y2, x0 y1 - x1 y0) = rotate(x * rotate(y) - rotate(x) * y)
+    static void cross(const scalar_type *x, const scalar_type *y, scalar_type *z, std::true_type)
+    {
+        const register_type a = pack_type::load(x, 3), b = pack_type::load(y, 3);
+        const register_type c = pack_type::sub(pack_type::mul(a, pack_type::rotate_left_3(b)),
+                                               pack_type::mul(pack_type::rotate_left_3(a), b));
+        pack_type::store(z, pack_type::rotate_left_3(c), 3);
+    }
+
+    static void cross(const scalar_type *x, const scalar_type *y, scalar_type *z, std::false_type)
+    {
+        const scalar_type t0 = x[1] * y[2] - x[2] * y[1],
+                          t1 = x[2] * y[0] - x[0] * y[2],
+                          t2 = x[0] * y[1] - x[1] * y[0];
+        z[0] = t0; z[1] = t1; z[2] = t2;
+    }
+
+    template <typename F>
+    static void apply(const scalar_type *x, const scalar_type *y, scalar_type *z, F f)
+    {
+        constexpr size_t W = pack_type::width();
+        for (size_t i = 0; i < Length; i += W)
+        {
+            const size_t n = std::min(W, Length - i);
+            pack_type::store(z + i, f(pack_type::load(x + i, n), pack_type::load(y + i, n)), n);
+        }
+    }
+
+    template <typename F>
+    static void apply(const scalar_type *x, scalar_type *z, F f)
+    {
+        constexpr size_t W = pack_type::width();
+        for (size_t i = 0; i < Length; i += W)
+        {
+            const size_t n = std::min(W, Length - i);
+            pack_type::store(z + i, f(pack_type::load(x + i, n)), n);
+        }
+    }
+};
+
+} // namespace idlib::internal
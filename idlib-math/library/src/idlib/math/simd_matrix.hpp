@@ -0,0 +1,419 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/simd_matrix.hpp
+/// @brief SIMD kernels for \f$4 \times 4\f$ matrices.
+/// @author Michael Heilmann
+
+/// @detail
+/// The kernels operate on \f$4 \times 4\f$ matrices of idlib::single or @a double values stored in row-major order.
+/// Each row is held in an idlib::internal::simd_quad. The product, the transpose, the inverse, and the inverse of an
+/// affine transformation matrix of idlib::matrix dispatch to these kernels if a SIMD instruction set is selected.
+/// The composition and the inverses of idlib::affine_transform dispatch to the kernels for \f$3 \times 4\f$ matrices.
+
+#pragma once
+
+#include "idlib/math/simd.hpp"
+
+namespace idlib::internal {
+
+/// @internal
+/// @brief Four scalars of type @a Scalar held in registers.
+/// In addition to the arithmetic operations, a quad provides permutations of its scalars.
+/// @remark is_enabled() is @a true if @a Scalar is idlib::single or @a double and a SIMD instruction set is selected.
+template <typename Scalar, typename Enabled = void>
+struct simd_quad
+{
+    static constexpr bool is_enabled() noexcept
+    { return false; }
+};
+
+#if IDLIB_MATH_SIMD >= IDLIB_MATH_SIMD_SSE2
+
+template <>
+struct simd_quad<single, void>
+{
+    using scalar_type = single;
+    using register_type = __m128;
+
+    static constexpr bool is_enabled() noexcept
+    { return true; }
+
+    static register_type load(const scalar_type *p)
+    { return _mm_loadu_ps(p); }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm_storeu_ps(p, x); }
+
+    /// @brief Store \f$x_0\f$, \f$x_1\f$, and \f$x_2\f$.
+    static void store3(scalar_type *p, register_type x)
+    {
+        _mm_storel_pi(reinterpret_cast<__m64 *>(p), x);
+        _mm_store_ss(p + 2, _mm_movehl_ps(x, x));
+    }
+
+    static register_type set(scalar_type x, scalar_type y, scalar_type z, scalar_type w)
+    { return _mm_setr_ps(x, y, z, w); }
+
+    static register_type broadcast(scalar_type x)
+    { return _mm_set1_ps(x); }
+
+    static register_type add(register_type x, register_type y)
+    { return _mm_add_ps(x, y); }
+
+    static register_type sub(register_type x, register_type y)
+    { return _mm_sub_ps(x, y); }
+
+    static register_type mul(register_type x, register_type y)
+    { return _mm_mul_ps(x, y); }
+
+    static register_type div(register_type x, register_type y)
+    { return _mm_div_ps(x, y); }
+
+    static register_type sqrt(register_type x)
+    { return _mm_sqrt_ps(x); }
+
+    /// @brief Broadcast \f$x_0 + x_1 + x_2 + x_3\f$.
+    static register_type sum(register_type x)
+    {
+        x = _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    /// @brief Get \f$x_0\f$.
+    static scalar_type first(register_type x)
+    { return _mm_cvtss_f32(x); }
+
+    /// @brief Get \f$(x_{I_0}, x_{I_1}, x_{I_2}, x_{I_3})\f$.
+    template <int I0, int I1, int I2, int I3>
+    static register_type permute(register_type x)
+    { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(I3, I2, I1, I0)); }
+
+    /// @brief Get \f$(x_{I_0}, x_{I_1}, y_{I_2}, y_{I_3})\f$.
+    template <int I0, int I1, int I2, int I3>
+    static register_type shuffle(register_type x, register_type y)
+    { return _mm_shuffle_ps(x, y, _MM_SHUFFLE(I3, I2, I1, I0)); }
+};
+
+/// @remark The scalars are held in two SSE2 registers, also if AVX is selected.
+template <>
+struct simd_quad<double, void>
+{
+    using scalar_type = double;
+    struct register_type
+    {
+        __m128d lo, hi;
+    };
+
+    static constexpr bool is_enabled() noexcept
+    { return true; }
+
+    static register_type load(const scalar_type *p)
+    { return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; }
+
+    static void store(scalar_type *p, register_type x)
+    { _mm_storeu_pd(p, x.lo); _mm_storeu_pd(p + 2, x.hi); }
+
+    /// @brief Store \f$x_0\f$, \f$x_1\f$, and \f$x_2\f$.
+    static void store3(scalar_type *p, register_type x)
+    { _mm_storeu_pd(p, x.lo); _mm_store_sd(p + 2, x.hi); }
+
+    static register_type set(scalar_type x, scalar_type y, scalar_type z, scalar_type w)
+    { return { _mm_setr_pd(x, y), _mm_setr_pd(z, w) }; }
+
+    static register_type broadcast(scalar_type x)
+    { return { _mm_set1_pd(x), _mm_set1_pd(x) }; }
+
+    static register_type add(register_type x, register_type y)
+    { return { _mm_add_pd(x.lo, y.lo), _mm_add_pd(x.hi, y.hi) }; }
+
+    static register_type sub(register_type x, register_type y)
+    { return { _mm_sub_pd(x.lo, y.lo), _mm_sub_pd(x.hi, y.hi) }; }
+
+    static register_type mul(register_type x, register_type y)
+    { return { _mm_mul_pd(x.lo, y.lo), _mm_mul_pd(x.hi, y.hi) }; }
+
+    static register_type div(register_type x, register_type y)
+    { return { _mm_div_pd(x.lo, y.lo), _mm_div_pd(x.hi, y.hi) }; }
+
+    static register_type sqrt(register_type x)
+    { return { _mm_sqrt_pd(x.lo), _mm_sqrt_pd(x.hi) }; }
+
+    /// @brief Broadcast \f$x_0 + x_1 + x_2 + x_3\f$.
+    static register_type sum(register_type x)
+    {
+        const __m128d y = _mm_add_pd(x.lo, x.hi);
+        const __m128d z = _mm_add_pd(y, _mm_shuffle_pd(y, y, 1));
+        return { z, z };
+    }
+
+    /// @brief Get \f$x_0\f$.
+    static scalar_type first(register_type x)
+    { return _mm_cvtsd_f64(x.lo); }
+
+    /// @brief Get \f$(x_{I_0}, x_{I_1}, x_{I_2}, x_{I_3})\f$.
+    template <int I0, int I1, int I2, int I3>
+    static register_type permute(register_type x)
+    { return { pick<I0, I1>(x, x), pick<I2, I3>(x, x) }; }
+
+    /// @brief Get \f$(x_{I_0}, x_{I_1}, y_{I_2}, y_{I_3})\f$.
+    template <int I0, int I1, int I2, int I3>
+    static register_type shuffle(register_type x, register_type y)
+    { return { pick<I0, I1>(x, x), pick<I2, I3>(y, y) }; }
+
+private:
+    // Get (x_{I0}, y_{I1}).
+    template <int I0, int I1>
+    static __m128d pick(register_type x, register_type y)
+    { return _mm_shuffle_pd(I0 < 2 ? x.lo : x.hi, I1 < 2 ? y.lo : y.hi, (I0 & 1) | ((I1 & 1) << 1)); }
+};
+
+#endif
+
+/// @internal
+/// @brief Kernels for \f$4 \times 4\f$ matrices of scalars of type @a Scalar in row-major order.
+/// The matrix pointers need not be aligned. The result may be written to the storage of an operand.
+/// @remark is_enabled() is @a true if idlib::internal::simd_quad<Scalar>::is_enabled() is @a true.
+/// Callers are expected to use their scalar code path if is_enabled() is @a false.
+template <typename Scalar>
+struct simd_matrix4
+{
+    using scalar_type = Scalar;
+    using quad_type = simd_quad<scalar_type>;
+
+    static constexpr bool is_enabled() noexcept
+    { return quad_type::is_enabled(); }
+
+    /// @brief Compute the product \f$C = A B\f$.
+    /// @remark Row \f$i\f$ of \f$C\f$ is computed as \f$\sum_k A_{i,k} B_k\f$ where \f$B_k\f$ is row \f$k\f$ of \f$B\f$.
+    static void mul(const scalar_type *a, const scalar_type *b, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        const register_type b0 = quad_type::load(b + 0), b1 = quad_type::load(b + 4),
+                            b2 = quad_type::load(b + 8), b3 = quad_type::load(b + 12);
+        register_type r[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const register_type ai = quad_type::load(a + 4 * i);
+            r[i] = quad_type::add(quad_type::add(quad_type::mul(quad_type::template permute<0, 0, 0, 0>(ai), b0),
+                                                 quad_type::mul(quad_type::template permute<1, 1, 1, 1>(ai), b1)),
+                                  quad_type::add(quad_type::mul(quad_type::template permute<2, 2, 2, 2>(ai), b2),
+                                                 quad_type::mul(quad_type::template permute<3, 3, 3, 3>(ai), b3)));
+        }
+        for (size_t i = 0; i < 4; ++i)
+        { quad_type::store(c + 4 * i, r[i]); }
+    }
+
+    /// @brief Compute the transpose \f$C = A^T\f$.
+    static void transpose(const scalar_type *a, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        register_type r[4] = { quad_type::load(a + 0), quad_type::load(a + 4), quad_type::load(a + 8), quad_type::load(a + 12) };
+        transpose(r);
+        for (size_t i = 0; i < 4; ++i)
+        { quad_type::store(c + 4 * i, r[i]); }
+    }
+
+    /// @brief Compute the inverse \f$C = A^{-1}\f$.
+    /// @remark Let \f$A = \begin{pmatrix} P & Q \\ R & S \end{pmatrix}\f$ with \f$2 \times 2\f$ matrices \f$P\f$, \f$Q\f$, \f$R\f$, and \f$S\f$.
+    /// The inverse is computed blockwise from the adjugates of these matrices, each held in a single quad:
+    /// \f[
+    /// A^{-1} = \frac{1}{|A|} \begin{pmatrix} X & Y \\ Z & W \end{pmatrix}
+    /// \f]
+    /// where \f$X^\# = |S|P - Q(S^\#R)\f$, \f$Y^\# = |Q|R - S(P^\#Q)^\#\f$, \f$Z^\# = |R|Q - P(S^\#R)^\#\f$, \f$W^\# = |P|S - R(P^\#Q)\f$,
+    /// and \f$|A| = |P||S| + |Q||R| - \mathrm{tr}((P^\#Q)(S^\#R))\f$.
+    /// @return @a false if the determinant of \f$A\f$ is zero and \f$C\f$ was not written, @a true otherwise
+    static bool inverse(const scalar_type *a, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        const register_type r0 = quad_type::load(a + 0), r1 = quad_type::load(a + 4),
+                            r2 = quad_type::load(a + 8), r3 = quad_type::load(a + 12);
+        // The 2x2 blocks in row-major order.
+        const register_type p = quad_type::template shuffle<0, 1, 0, 1>(r0, r1),
+                            q = quad_type::template shuffle<2, 3, 2, 3>(r0, r1),
+                            r = quad_type::template shuffle<0, 1, 0, 1>(r2, r3),
+                            s = quad_type::template shuffle<2, 3, 2, 3>(r2, r3);
+        // (|P|, |Q|, |R|, |S|)
+        const register_type d = quad_type::sub(quad_type::mul(quad_type::template shuffle<0, 2, 0, 2>(r0, r2), quad_type::template shuffle<1, 3, 1, 3>(r1, r3)),
+                                               quad_type::mul(quad_type::template shuffle<1, 3, 1, 3>(r0, r2), quad_type::template shuffle<0, 2, 0, 2>(r1, r3)));
+        const register_type dp = quad_type::template permute<0, 0, 0, 0>(d), dq = quad_type::template permute<1, 1, 1, 1>(d),
+                            dr = quad_type::template permute<2, 2, 2, 2>(d), ds = quad_type::template permute<3, 3, 3, 3>(d);
+        const register_type sr = adj_mul2(s, r), pq = adj_mul2(p, q);
+        register_type x = quad_type::sub(quad_type::mul(ds, p), mul2(q, sr)),
+                      y = quad_type::sub(quad_type::mul(dq, r), mul_adj2(s, pq)),
+                      z = quad_type::sub(quad_type::mul(dr, q), mul_adj2(p, sr)),
+                      w = quad_type::sub(quad_type::mul(dp, s), mul2(r, pq));
+        const register_type da = quad_type::sub(quad_type::add(quad_type::mul(dp, ds), quad_type::mul(dq, dr)),
+                                                quad_type::sum(quad_type::mul(pq, quad_type::template permute<0, 2, 1, 3>(sr))));
+        if (quad_type::first(da) == scalar_type(0))
+        {
+            return false;
+        }
+        // The signs of the adjugate.
+        const register_type f = quad_type::div(quad_type::set(scalar_type(1), scalar_type(-1), scalar_type(-1), scalar_type(1)), da);
+        x = quad_type::mul(x, f);
+        y = quad_type::mul(y, f);
+        z = quad_type::mul(z, f);
+        w = quad_type::mul(w, f);
+        // The adjugates of X#, Y#, Z#, W# are the blocks of the inverse.
+        quad_type::store(c + 0, quad_type::template shuffle<3, 1, 3, 1>(x, y));
+        quad_type::store(c + 4, quad_type::template shuffle<2, 0, 2, 0>(x, y));
+        quad_type::store(c + 8, quad_type::template shuffle<3, 1, 3, 1>(z, w));
+        quad_type::store(c + 12, quad_type::template shuffle<2, 0, 2, 0>(z, w));
+        return true;
+    }
+
+    /// @brief Compute the inverse \f$C = A^{-1}\f$ of an affine transformation matrix
+    /// \f$A = \begin{pmatrix} M & t \\ 0 & 1 \end{pmatrix}\f$, that is \f$C = \begin{pmatrix} M^{-1} & -M^{-1}t \\ 0 & 1 \end{pmatrix}\f$.
+    /// @remark The last row of \f$A\f$ is not read.
+    /// @return @a false if the determinant of \f$M\f$ is zero and \f$C\f$ was not written, @a true otherwise
+    static bool affine_inverse(const scalar_type *a, scalar_type *c)
+    {
+        if (!affine_inverse3x4(a, c))
+        {
+            return false;
+        }
+        quad_type::store(c + 12, quad_type::set(scalar_type(0), scalar_type(0), scalar_type(0), scalar_type(1)));
+        return true;
+    }
+
+    /// @brief Compute the product \f$C = A B\f$ of affine transformation matrices
+    /// given by their upper \f$3 \times 4\f$ matrices, the last row \f$(0, 0, 0, 1)\f$ is implicit.
+    /// @remark Row \f$i\f$ of \f$C\f$ is computed as \f$\sum_{k<3} A_{i,k} B_k + A_{i,3} e_3\f$ where \f$B_k\f$ is row \f$k\f$ of \f$B\f$.
+    static void mul3x4(const scalar_type *a, const scalar_type *b, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        const register_type b0 = quad_type::load(b + 0), b1 = quad_type::load(b + 4), b2 = quad_type::load(b + 8),
+                            e3 = quad_type::set(scalar_type(0), scalar_type(0), scalar_type(0), scalar_type(1));
+        register_type r[3];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const register_type ai = quad_type::load(a + 4 * i);
+            r[i] = quad_type::add(quad_type::add(quad_type::mul(quad_type::template permute<0, 0, 0, 0>(ai), b0),
+                                                 quad_type::mul(quad_type::template permute<1, 1, 1, 1>(ai), b1)),
+                                  quad_type::add(quad_type::mul(quad_type::template permute<2, 2, 2, 2>(ai), b2),
+                                                 quad_type::mul(quad_type::template permute<3, 3, 3, 3>(ai), e3)));
+        }
+        for (size_t i = 0; i < 3; ++i)
+        { quad_type::store(c + 4 * i, r[i]); }
+    }
+
+    /// @brief Compute the inverse \f$C = A^{-1}\f$ of an affine transformation matrix given by its upper \f$3 \times 4\f$ matrix
+    /// \f$\begin{pmatrix} M & t \end{pmatrix}\f$, that is \f$C = \begin{pmatrix} M^{-1} & -M^{-1}t \end{pmatrix}\f$.
+    /// @remark The columns of \f$M^{-1}\f$ are \f$\frac{1}{|M|}(m_1 \times m_2, m_2 \times m_0, m_0 \times m_1)\f$ where \f$m_i\f$ is row \f$i\f$ of \f$M\f$.
+    /// @return @a false if the determinant of \f$M\f$ is zero and \f$C\f$ was not written, @a true otherwise
+    static bool affine_inverse3x4(const scalar_type *a, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        const register_type r0 = quad_type::load(a + 0), r1 = quad_type::load(a + 4), r2 = quad_type::load(a + 8);
+        // The fourth scalar of the cross products is zero.
+        register_type m[4] = { cross3(r1, r2), cross3(r2, r0), cross3(r0, r1) };
+        const register_type d = quad_type::sum(quad_type::mul(r0, m[0]));
+        if (quad_type::first(d) == scalar_type(0))
+        {
+            return false;
+        }
+        const register_type f = quad_type::div(quad_type::broadcast(scalar_type(1)), d);
+        m[0] = quad_type::mul(m[0], f);
+        m[1] = quad_type::mul(m[1], f);
+        m[2] = quad_type::mul(m[2], f);
+        m[3] = negated_sum3(r0, r1, r2, m);
+        transpose(m);
+        for (size_t i = 0; i < 3; ++i)
+        { quad_type::store(c + 4 * i, m[i]); }
+        return true;
+    }
+
+    /// @brief Compute the inverse \f$C = A^{-1}\f$ of an affine transformation matrix given by its upper \f$3 \times 4\f$ matrix
+    /// \f$\begin{pmatrix} M & t \end{pmatrix}\f$ where \f$M\f$ is orthonormal, that is \f$C = \begin{pmatrix} M^T & -M^Tt \end{pmatrix}\f$.
+    static void orthonormal_inverse3x4(const scalar_type *a, scalar_type *c)
+    {
+        using register_type = typename quad_type::register_type;
+        const register_type r0 = quad_type::load(a + 0), r1 = quad_type::load(a + 4), r2 = quad_type::load(a + 8);
+        register_type m[4] = { r0, r1, r2 };
+        m[3] = negated_sum3(r0, r1, r2, m);
+        transpose(m);
+        for (size_t i = 0; i < 3; ++i)
+        { quad_type::store(c + 4 * i, m[i]); }
+    }
+
+private:
+    template <typename Register>
+    static void transpose(Register (&r)[4])
+    {
+        const Register t0 = quad_type::template shuffle<0, 1, 0, 1>(r[0], r[1]),
+                       t1 = quad_type::template shuffle<2, 3, 2, 3>(r[0], r[1]),
+                       t2 = quad_type::template shuffle<0, 1, 0, 1>(r[2], r[3]),
+                       t3 = quad_type::template shuffle<2, 3, 2, 3>(r[2], r[3]);
+        r[0] = quad_type::template shuffle<0, 2, 0, 2>(t0, t2);
+        r[1] = quad_type::template shuffle<1, 3, 1, 3>(t0, t2);
+        r[2] = quad_type::template shuffle<0, 2, 0, 2>(t1, t3);
+        r[3] = quad_type::template shuffle<1, 3, 1, 3>(t1, t3);
+    }
+
+    // Compute -(t_0 m_0 + t_1 m_1 + t_2 m_2) where t_i is the fourth scalar of r_i.
+    // If m_0, m_1, m_2 are the columns of the inverse of the linear part, then the first three scalars are the translation of the inverse.
+    template <typename Register>
+    static Register negated_sum3(Register r0, Register r1, Register r2, const Register (&m)[4])
+    {
+        return quad_type::sub(quad_type::broadcast(scalar_type(0)),
+                              quad_type::add(quad_type::add(quad_type::mul(quad_type::template permute<3, 3, 3, 3>(r0), m[0]),
+                                                            quad_type::mul(quad_type::template permute<3, 3, 3, 3>(r1), m[1])),
+                                             quad_type::mul(quad_type::template permute<3, 3, 3, 3>(r2), m[2])));
+    }
+
+    // The cross product of the first three scalars. The fourth scalar of the result is zero if it is finite in both operands.
+    template <typename Register>
+    static Register cross3(Register x, Register y)
+    {
+        return quad_type::sub(quad_type::mul(quad_type::template permute<1, 2, 0, 3>(x), quad_type::template permute<2, 0, 1, 3>(y)),
+                              quad_type::mul(quad_type::template permute<2, 0, 1, 3>(x), quad_type::template permute<1, 2, 0, 3>(y)));
+    }
+
+    // 2x2 matrices in row-major order: X Y
+    template <typename Register>
+    static Register mul2(Register x, Register y)
+    {
+        return quad_type::add(quad_type::mul(x, quad_type::template permute<0, 3, 0, 3>(y)),
+                              quad_type::mul(quad_type::template permute<1, 0, 3, 2>(x), quad_type::template permute<2, 1, 2, 1>(y)));
+    }
+
+    // 2x2 matrices in row-major order: X# Y
+    template <typename Register>
+    static Register adj_mul2(Register x, Register y)
+    {
+        return quad_type::sub(quad_type::mul(quad_type::template permute<3, 3, 0, 0>(x), y),
+                              quad_type::mul(quad_type::template permute<1, 1, 2, 2>(x), quad_type::template permute<2, 3, 0, 1>(y)));
+    }
+
+    // 2x2 matrices in row-major order: X Y#
+    template <typename Register>
+    static Register mul_adj2(Register x, Register y)
+    {
+        return quad_type::sub(quad_type::mul(x, quad_type::template permute<3, 0, 3, 0>(y)),
+                              quad_type::mul(quad_type::template permute<1, 0, 3, 2>(x), quad_type::template permute<2, 1, 2, 1>(y)));
+    }
+};
+
+} // namespace idlib::internal
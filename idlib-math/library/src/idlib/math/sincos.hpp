@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/sincos.hpp
+/// @brief Fast simultaneous computation of the sine and the cosine of angles in degrees, radians, and turns.
+/// @author Michael Heilmann
+
+/// @detail
+/// The angle is converted into turns (by a division by the angle value of one turn) and reduced to \f$r \in [-\frac{1}{8}, +\frac{1}{8}]\f$ turns and a multiple
+/// \f$q \in \{-2,-1,0,+1,+2\}\f$ of quarter turns. The reduction of an angle in turns is exact.
+/// The sine and the cosine of \f$r\f$ are approximated by minimax polynomials and combined with
+/// \f$\sin(q \frac{\pi}{2})\f$ and \f$\cos(q \frac{\pi}{2})\f$ (which are \f$-1\f$, \f$0\f$, or \f$+1\f$) by the angle addition theorems.
+/// No libm functions are called and there are no branches, hence the batched idlib::sincos processes a SIMD pack of angles at once.
+///
+/// The absolute error of the sine and the cosine of an angle in turns is below \f$2^{-23}\f$ for @a single and below \f$2^{-52}\f$ for @a double.
+/// For angles in degrees or radians, the rounding error of the conversion into turns adds up to \f$2 \pi |\alpha| \epsilon\f$
+/// where \f$|\alpha|\f$ is the magnitude of the angle in turns and \f$\epsilon\f$ is the machine epsilon.
+/// Multiples of quarter turns (e.g. 90 degrees) yield exact results.
+/// @code
+/// const auto sc = idlib::sincos(idlib::angle<single, idlib::degrees>(30.0f));
+/// single s = sc.first, c = sc.second;
+/// @endcode
+/// @remark The rounding to the nearest integer relies on IEEE 754 arithmetic and is broken by options like @a -ffast-math.
+
+#pragma once
+
+#include "idlib/math/angle-degrees-radians-turns.hpp"
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/simd.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace idlib {
+
+namespace internal {
+
+template <typename Scalar>
+struct sincos_constants;
+
+template <>
+struct sincos_constants<single>
+{
+    /// @brief Adding and subtracting this value rounds values of a magnitude of at most 2^22 to the nearest integer.
+    static constexpr single rounding_magic() { return 12582912.0f; } // 1.5 * 2^23
+    /// @brief Values of a magnitude of at least this value are integers.
+    /// Adding and subtracting this value with the sign of a value of a smaller magnitude rounds that value to the nearest integer.
+    static constexpr single rounding_bound() { return 8388608.0f; } // 2^23
+    static constexpr single two_pi() { return 6.28318530717958647692f; }
+    /// @brief \f$\sin(x) \approx x + x z (s_0 + z (s_1 + z s_2))\f$ where \f$z = x^2\f$ and \f$|x| \leq \frac{\pi}{4}\f$.
+    static constexpr single sin(size_t i)
+    {
+        constexpr single c[] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f };
+        return c[i];
+    }
+    /// @brief \f$\cos(x) \approx 1 - \frac{z}{2} + z^2 (c_0 + z (c_1 + z c_2))\f$ where \f$z = x^2\f$ and \f$|x| \leq \frac{\pi}{4}\f$.
+    static constexpr single cos(size_t i)
+    {
+        constexpr single c[] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f };
+        return c[i];
+    }
+    static constexpr size_t degree() { return 3; }
+};
+
+template <>
+struct sincos_constants<double>
+{
+    static constexpr double rounding_magic() { return 6755399441055744.0; } // 1.5 * 2^52
+    static constexpr double rounding_bound() { return 4503599627370496.0; } // 2^52
+    static constexpr double two_pi() { return 6.28318530717958647692; }
+    static constexpr double sin(size_t i)
+    {
+        constexpr double c[] = { 1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                 -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1 };
+        return c[i];
+    }
+    static constexpr double cos(size_t i)
+    {
+        constexpr double c[] = { -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                 2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2 };
+        return c[i];
+    }
+    static constexpr size_t degree() { return 6; }
+};
+
+/// @internal
+/// @brief The kernels of idlib::sincos, generic over the SIMD pack type.
+template <typename Pack>
+struct sincos_kernels
+{
+    using pack_type = Pack;
+    using scalar_type = typename pack_type::scalar_type;
+    using register_type = typename pack_type::register_type;
+    using constants = sincos_constants<scalar_type>;
+
+    /// @brief Compute the sines and the cosines of angles in turns.
+    /// @param t the angles in turns. Must be finite.
+    /// @param s, c receive the sines and the cosines
+    static void sincos(register_type t, register_type& s, register_type& c)
+    {
+        const register_type one = pack_type::broadcast(scalar_type(1)), two = pack_type::broadcast(scalar_type(2)),
+                            magic = pack_type::broadcast(constants::rounding_magic());
+        // Subtract the nearest whole number of turns. Values of a large magnitude are whole numbers already.
+        const register_type bound = pack_type::broadcast(constants::rounding_bound()),
+                            m = pack_type::select(pack_type::cmp_gt(pack_type::zero(), t), pack_type::neg(bound), bound),
+                            w = pack_type::sub(pack_type::add(t, m), m);
+        t = pack_type::sub(t, pack_type::select(pack_type::cmp_gt(abs(t), bound), t, w));
+        // Subtract the nearest number of quarter turns q in {-2,-1,0,+1,+2}.
+        const register_type q = pack_type::sub(pack_type::add(pack_type::mul(t, pack_type::broadcast(scalar_type(4))), magic), magic);
+        const register_type x = pack_type::mul(pack_type::sub(t, pack_type::mul(q, pack_type::broadcast(scalar_type(0.25)))),
+                                               pack_type::broadcast(constants::two_pi()));
+        const register_type z = pack_type::mul(x, x);
+        register_type ps = pack_type::broadcast(constants::sin(0)), pc = pack_type::broadcast(constants::cos(0));
+        for (size_t i = 1; i < constants::degree(); ++i)
+        {
+            ps = pack_type::add(pack_type::mul(ps, z), pack_type::broadcast(constants::sin(i)));
+            pc = pack_type::add(pack_type::mul(pc, z), pack_type::broadcast(constants::cos(i)));
+        }
+        ps = pack_type::add(x, pack_type::mul(pack_type::mul(x, z), ps));
+        pc = pack_type::add(pack_type::sub(one, pack_type::mul(z, pack_type::broadcast(scalar_type(0.5)))), pack_type::mul(pack_type::mul(z, z), pc));
+        // sin(q pi/2) = q (2 - |q|) and cos(q pi/2) = 1 - |q|.
+        const register_type a = abs(q), qs = pack_type::mul(q, pack_type::sub(two, a)), qc = pack_type::sub(one, a);
+        s = pack_type::add(pack_type::mul(ps, qc), pack_type::mul(pc, qs));
+        c = pack_type::sub(pack_type::mul(pc, qc), pack_type::mul(ps, qs));
+    }
+
+    /// @brief Compute the sines and the cosines of an array of angles.
+    /// @param x pointer to the first angle value
+    /// @param count the number of angles
+    /// @param u the angle value of one turn
+    /// @param s, c pointers to the first elements of the arrays receiving the sines and the cosines
+    static void sincos(const scalar_type *x, size_t count, scalar_type u, scalar_type *s, scalar_type *c)
+    {
+        constexpr size_t W = pack_type::width();
+        const register_type g = pack_type::broadcast(u);
+        for (size_t i = 0; i < count; i += W)
+        {
+            const size_t n = std::min(W, count - i);
+            register_type a, b;
+            sincos(pack_type::div(pack_type::load(x + i, n), g), a, b);
+            pack_type::store(s + i, a, n);
+            pack_type::store(c + i, b, n);
+        }
+    }
+
+private:
+    static register_type abs(register_type x)
+    { return pack_type::max(x, pack_type::neg(x)); }
+};
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Functor computing the sine and the cosine of an angle.
+/// @remark A specialization for floating-point angles in degrees, radians, and turns is provided.
+template <typename Syntactics, typename Semantics, typename Enabled = void>
+struct sincos_functor;
+
+template <typename Syntactics, typename Semantics>
+struct sincos_functor<Syntactics, Semantics,
+                      std::enable_if_t<(std::is_same<Semantics, degrees>::value ||
+                                        std::is_same<Semantics, radians>::value ||
+                                        std::is_same<Semantics, turns>::value) &&
+                                        std::is_floating_point<Syntactics>::value>>
+{
+    using angle_type = angle<Syntactics, Semantics>;
+    using result_type = std::pair<Syntactics, Syntactics>;
+
+    result_type operator()(const angle_type& x) const
+    {
+        using kernels_type = internal::sincos_kernels<internal::simd_pack<Syntactics, 1>>;
+        result_type r;
+        kernels_type::sincos(x.get_value() / internal::convert<Syntactics, Semantics, Syntactics, turns>()(one<Syntactics>()), r.first, r.second);
+        return r;
+    }
+
+}; // struct sincos_functor
+
+/// @ingroup math
+/// @brief Compute the sine and the cosine of an angle.
+/// @param x the angle. Must be finite.
+/// @return a pair of the sine (first) and the cosine (second) of the angle
+template <typename Syntactics, typename Semantics>
+auto sincos(const angle<Syntactics, Semantics>& x) -> decltype(sincos_functor<Syntactics, Semantics>()(x))
+{ return sincos_functor<Syntactics, Semantics>()(x); }
+
+/// @ingroup math
+/// @brief Compute the sines and the cosines of an array of angles.
+/// The values at index \f$i\f$ of the target arrays are the pair <c>idlib::sincos(x[i])</c>.
+/// @param x pointer to the first angle of the source array
+/// @param count the number of angles
+/// @param sines, cosines pointers to the first elements of the target arrays. Must have space for at least @a count scalars.
+/// @param policy the execution policy
+template <typename Syntactics, typename Semantics>
+auto sincos(const angle<Syntactics, Semantics> *x, size_t count, Syntactics *sines, Syntactics *cosines,
+            const execution_policy& policy = execution_policy::sequential())
+    -> std::enable_if_t<std::is_same<decltype(sincos(*x)), std::pair<Syntactics, Syntactics>>::value>
+{
+    static_assert(std::is_standard_layout<angle<Syntactics, Semantics>>::value && sizeof(angle<Syntactics, Semantics>) == sizeof(Syntactics),
+                  "the values of angles are not stored contiguously");
+    using kernels_type = internal::sincos_kernels<internal::simd_native_pack<Syntactics>>;
+    const Syntactics *p = reinterpret_cast<const Syntactics *>(x);
+    const Syntactics u = internal::convert<Syntactics, Semantics, Syntactics, turns>()(one<Syntactics>());
+    internal::parallel_for(count, policy, [p, u, sines, cosines](size_t first, size_t last)
+    { kernels_type::sincos(p + first, last - first, u, sines + first, cosines + first); });
+}
+
+} // namespace idlib
@@ -41,7 +41,7 @@ template <typename Vector>
 struct squared_euclidean_norm_functor;
 
 template <typename Vector>
-auto squared_euclidean_norm(const Vector& v) -> decltype(squared_euclidean_norm_functor<Vector>()(v))
+constexpr auto squared_euclidean_norm(const Vector& v) -> decltype(squared_euclidean_norm_functor<Vector>()(v))
 { return squared_euclidean_norm_functor<Vector>()(v); }
 
 } // namespace idlib
@@ -9,7 +9,7 @@ template <typename T, typename Enabled = void>
 struct trace_functor;
 
 template <typename T>
-auto trace(const T& v) -> decltype(trace_functor<T>()(v))
+constexpr auto trace(const T& v) -> decltype(trace_functor<T>()(v))
 { return trace_functor<T>()(v); }
 
 } // namespace idlib
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/transform.hpp
+/// @brief Transformation of arrays of points and vectors by \f$4 \times 4\f$ matrices.
+/// @author Michael Heilmann
+
+/// @detail
+/// idlib::transform_points, idlib::transform_vectors, and idlib::project_points transform contiguous arrays of
+/// three-dimensional points or vectors by a \f$4 \times 4\f$ matrix (e.g. a matrix created by idlib::translation_matrix,
+/// idlib::rotation_matrix, idlib::look_at_matrix, or idlib::perspective_projection_matrix).
+/// The results are written to arrays provided by the caller, nothing is allocated.
+/// @code
+/// std::vector<idlib::point<idlib::vector<single, 3>>> source(n), target(n);
+/// ...
+/// idlib::transform_points(m, source.data(), source.size(), target.data());
+/// // Split large inputs across threads.
+/// idlib::transform_points(m, source.data(), source.size(), target.data(), idlib::execution_policy::parallel());
+/// @endcode
+/// If a SIMD instruction set is selected, the arrays are transformed by SIMD kernels for idlib::single and @a double.
+
+#pragma once
+
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/parallel.hpp"
+#include "idlib/math/point.hpp"
+#include "idlib/math/simd_matrix.hpp"
+#include "idlib/math/vector.hpp"
+#include <type_traits>
+
+namespace idlib {
+
+namespace internal {
+
+/// @internal
+/// @brief The kinds of transformations of idlib::internal::transform_kernel.
+enum class transform_kind
+{
+    /// @brief \f$(x',y',z') = M(x,y,z,1)\f$, the fourth component of the product is dropped.
+    point,
+    /// @brief \f$(x',y',z') = M(x,y,z,0)\f$, the fourth component of the product is dropped.
+    vector,
+    /// @brief \f$(x',y',z') = (x'',y'',z'') / w''\f$ where \f$(x'',y'',z'',w'') = M(x,y,z,1)\f$.
+    projection,
+};
+
+/// @internal
+/// @brief Kernel transforming an array of triplets of scalars of type @a Scalar by a \f$4 \times 4\f$ matrix in row-major order.
+/// The source and the target may be the same array but must not overlap otherwise.
+/// @tparam Scalar the scalar type
+/// @tparam Kind the kind of the transformation
+template <typename Scalar, transform_kind Kind>
+struct transform_kernel
+{
+    using scalar_type = Scalar;
+    using quad_type = simd_quad<scalar_type>;
+
+    static constexpr bool is_enabled() noexcept
+    { return quad_type::is_enabled(); }
+
+    static void apply(const scalar_type *m, const scalar_type *source, size_t count, scalar_type *target)
+    { apply(m, source, count, target, std::integral_constant<bool, is_enabled()>{}); }
+
+    /// @internal
+    /// @brief The SIMD code path.
+    /// @remark Each triplet is transformed as \f$x M_0 + y M_1 + z M_2 + M_3\f$ where \f$M_j\f$ is column \f$j\f$ of the matrix.
+    static void apply(const scalar_type *m, const scalar_type *source, size_t count, scalar_type *target, std::true_type)
+    {
+        using register_type = typename quad_type::register_type;
+        scalar_type t[16];
+        simd_matrix4<scalar_type>::transpose(m, t);
+        const register_type c0 = quad_type::load(t + 0), c1 = quad_type::load(t + 4),
+                            c2 = quad_type::load(t + 8), c3 = quad_type::load(t + 12);
+        for (size_t i = 0; i < count; ++i, source += 3, target += 3)
+        {
+            register_type r = quad_type::add(quad_type::add(quad_type::mul(c0, quad_type::broadcast(source[0])),
+                                                            quad_type::mul(c1, quad_type::broadcast(source[1]))),
+                                             quad_type::mul(c2, quad_type::broadcast(source[2])));
+            if (Kind != transform_kind::vector)
+            {
+                r = quad_type::add(r, c3);
+            }
+            if (Kind == transform_kind::projection)
+            {
+                r = quad_type::div(r, quad_type::template permute<3, 3, 3, 3>(r));
+            }
+            quad_type::store3(target, r);
+        }
+    }
+
+    /// @internal
+    /// @brief The scalar code path.
+    static void apply(const scalar_type *m, const scalar_type *source, size_t count, scalar_type *target, std::false_type)
+    {
+        for (size_t i = 0; i < count; ++i, source += 3, target += 3)
+        {
+            const scalar_type x = source[0], y = source[1], z = source[2];
+            scalar_type r[4];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                r[j] = m[4 * j + 0] * x + m[4 * j + 1] * y + m[4 * j + 2] * z;
+                if (Kind != transform_kind::vector)
+                {
+                    r[j] += m[4 * j + 3];
+                }
+            }
+            if (Kind == transform_kind::projection)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    r[j] /= r[3];
+                }
+            }
+            for (size_t j = 0; j < 3; ++j)
+            {
+                target[j] = r[j];
+            }
+        }
+    }
+};
+
+/// @internal
+template <transform_kind Kind, typename Scalar, typename Source, typename Target>
+void transform(const matrix<Scalar, 4, 4>& m, const Source *source, size_t count, Target *target, const execution_policy& policy)
+{
+    const Scalar *a = &(m(0));
+    const Scalar *s = scalars(source);
+    Scalar *t = scalars(target);
+    parallel_for(count, policy, [a, s, t](size_t first, size_t last)
+    {
+        transform_kernel<Scalar, Kind>::apply(a, s + 3 * first, last - first, t + 3 * first);
+    });
+}
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Transform an array of points by a matrix.
+/// The point \f$p\f$ is transformed into the point \f$p'\f$ with \f$(p',w') = M(p,1)\f$.
+/// The fourth component \f$w'\f$ of the product is dropped.
+/// @param m the matrix \f$M\f$
+/// @param source pointer to the first point of the source array
+/// @param count the number of points
+/// @param target pointer to the first point of the target array. Must have space for at least @a count points.
+/// @param policy the execution policy
+/// @remark The source and the target array may be the same array but must not overlap otherwise.
+template <typename Scalar>
+void transform_points(const matrix<Scalar, 4, 4>& m, const point<vector<Scalar, 3>> *source, size_t count, point<vector<Scalar, 3>> *target,
+                      const execution_policy& policy = execution_policy::sequential())
+{ internal::transform<internal::transform_kind::point>(m, source, count, target, policy); }
+
+/// @ingroup math
+/// @brief Transform an array of vectors by a matrix.
+/// The vector \f$v\f$ is transformed into the vector \f$v'\f$ with \f$(v',w') = M(v,0)\f$, that is the translation of \f$M\f$ is not applied.
+/// The fourth component \f$w'\f$ of the product is dropped.
+/// @param m the matrix \f$M\f$
+/// @param source pointer to the first vector of the source array
+/// @param count the number of vectors
+/// @param target pointer to the first vector of the target array. Must have space for at least @a count vectors.
+/// @param policy the execution policy
+/// @remark The source and the target array may be the same array but must not overlap otherwise.
+template <typename Scalar>
+void transform_vectors(const matrix<Scalar, 4, 4>& m, const vector<Scalar, 3> *source, size_t count, vector<Scalar, 3> *target,
+                       const execution_policy& policy = execution_policy::sequential())
+{ internal::transform<internal::transform_kind::vector>(m, source, count, target, policy); }
+
+/// @ingroup math
+/// @brief Project an array of points by a matrix.
+/// The point \f$p\f$ is projected to the point \f$p' = \frac{1}{w'}q'\f$ with \f$(q',w') = M(p,1)\f$.
+/// @param m the matrix \f$M\f$, e.g. the product of a projection matrix and a view matrix
+/// @param source pointer to the first point of the source array
+/// @param count the number of points
+/// @param target pointer to the first point of the target array. Must have space for at least @a count points.
+/// @param policy the execution policy
+/// @remark The source and the target array may be the same array but must not overlap otherwise.
+/// @remark If \f$w'\f$ is zero, the components of the projected point are infinities or NaNs.
+template <typename Scalar>
+void project_points(const matrix<Scalar, 4, 4>& m, const point<vector<Scalar, 3>> *source, size_t count, point<vector<Scalar, 3>> *target,
+                    const execution_policy& policy = execution_policy::sequential())
+{ internal::transform<internal::transform_kind::projection>(m, source, count, target, policy); }
+
+} // namespace idlib
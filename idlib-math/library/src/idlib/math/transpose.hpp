@@ -14,7 +14,7 @@ template <typename T, typename Enabled = void>
 struct transpose_functor;
 
 template <typename T>
-auto transpose(const T& v) -> decltype(transpose_functor<T>()(v))
+constexpr auto transpose(const T& v) -> decltype(transpose_functor<T>()(v))
 { return transpose_functor<T>()(v); }
 	
 } // namespace idlib
\ No newline at end of file
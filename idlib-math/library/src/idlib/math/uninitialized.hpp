@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/uninitialized.hpp
+/// @brief Construction of math types without initialization of their elements.
+/// @author Michael Heilmann
+
+/// @detail
+/// Default construction of idlib::arithmetic_array_1d, idlib::arithmetic_array_2d, idlib::vector, idlib::point,
+/// and idlib::matrix assigns the zero element value to all elements. Passing idlib::uninitialized instead leaves
+/// the element values indeterminate. This is useful if the value is overwritten anyway:
+/// @code
+/// idlib::vector<single, 3> v(idlib::uninitialized);
+/// read(v); // Assign all elements.
+/// @endcode
+/// Containers value-initialize elements on <c>resize</c>. idlib::uninitialized_allocator changes this behavior:
+/// @code
+/// std::vector<idlib::vector<single, 3>, idlib::uninitialized_allocator<idlib::vector<single, 3>>> v;
+/// v.resize(1000000); // Does not assign the zero element value to the elements of the vectors.
+/// @endcode
+
+#pragma once
+
+#include "idlib/platform.hpp"
+#include <memory>
+#include <type_traits>
+
+namespace idlib {
+
+/// @brief Tag type selecting the constructor not initializing the elements of a value.
+struct uninitialized_t
+{
+    explicit constexpr uninitialized_t() = default;
+};
+
+/// @brief Tag value selecting the constructor not initializing the elements of a value.
+inline constexpr uninitialized_t uninitialized{};
+
+/// @brief Provide member constant value <tt>value</tt>.
+/// That constant is equal to <tt>true</tt> if the specified type is constructible from idlib::uninitialized_t
+/// or if it is trivially default constructible. Otherwise it is equal to <tt>false</tt>.
+/// @tparam T the type
+template <typename T>
+struct is_uninitialized_constructible
+    : std::integral_constant<bool, std::is_constructible<T, uninitialized_t>::value ||
+                                   std::is_trivially_default_constructible<T>::value>
+{};
+
+/// @brief An allocator adaptor which does not initialize the elements of values constructed without arguments.
+/// If a container value-initializes an element (e.g. by <c>resize</c>), the element is constructed
+/// - with idlib::uninitialized if it is constructible from idlib::uninitialized_t,
+/// - by default-initialization if it is trivially default constructible, or
+/// - by value-initialization otherwise.
+/// All other operations are forwarded to the adapted allocator.
+/// @tparam T the value type
+/// @tparam Allocator the adapted allocator type
+template <typename T, typename Allocator = std::allocator<T>>
+struct uninitialized_allocator : public Allocator
+{
+private:
+    using traits = std::allocator_traits<Allocator>;
+
+public:
+    template <typename U>
+    struct rebind
+    {
+        using other = uninitialized_allocator<U, typename traits::template rebind_alloc<U>>;
+    };
+
+    using Allocator::Allocator;
+
+    uninitialized_allocator() = default;
+
+    template <typename U, typename OtherAllocator>
+    uninitialized_allocator(const uninitialized_allocator<U, OtherAllocator>& other) noexcept
+        : Allocator(static_cast<const OtherAllocator&>(other))
+    {}
+
+    /// @brief Construct a value without initializing its elements.
+    /// @param p a pointer to the storage of the value
+    template <typename U>
+    void construct(U *p) noexcept(std::is_nothrow_default_constructible<U>::value)
+    { construct_uninitialized(p, std::is_constructible<U, uninitialized_t>{}, std::is_trivially_default_constructible<U>{}); }
+
+    /// @brief Construct a value with the specified arguments.
+    /// @param p a pointer to the storage of the value
+    /// @param args the arguments
+    template <typename U, typename ... Args>
+    void construct(U *p, Args&& ... args)
+    { traits::construct(static_cast<Allocator&>(*this), p, std::forward<Args>(args)...); }
+
+private:
+    template <typename U, typename Trivial>
+    static void construct_uninitialized(U *p, std::true_type, Trivial)
+    { ::new (static_cast<void *>(p)) U(uninitialized); }
+
+    template <typename U>
+    static void construct_uninitialized(U *p, std::false_type, std::true_type)
+    { ::new (static_cast<void *>(p)) U; }
+
+    template <typename U>
+    static void construct_uninitialized(U *p, std::false_type, std::false_type)
+    { ::new (static_cast<void *>(p)) U(); }
+}; // struct uninitialized_allocator
+
+template <typename T, typename A, typename U, typename B>
+bool operator==(const uninitialized_allocator<T, A>& a, const uninitialized_allocator<U, B>& b) noexcept
+{ return static_cast<const A&>(a) == static_cast<const B&>(b); }
+
+template <typename T, typename A, typename U, typename B>
+bool operator!=(const uninitialized_allocator<T, A>& a, const uninitialized_allocator<U, B>& b) noexcept
+{ return !(a == b); }
+
+} // namespace idlib
@@ -29,6 +29,7 @@
 #pragma once
 
 #include "idlib/math/arithmetic_array_1d.hpp"
+#include "idlib/math/simd.hpp"
 #include "idlib/math/constant_generator.hpp"
 #include "idlib/math/conditional_generator.hpp"
 #include "idlib/utility/fold_expressions.hpp"
@@ -86,40 +87,45 @@ public:
     template<typename ... Arguments,
              typename = std::enable_if_t<(sizeof...(Arguments)) == vector_type::dimensionality() &&
                                          all_convertible<scalar_type, typename std::decay<Arguments>::type...>::value>>
-    vector(Arguments&& ... arguments)
+    constexpr vector(Arguments&& ... arguments)
         : m_implementation(std::forward<Arguments>(arguments)...)
     { static_assert(dimensionality() == sizeof ... (arguments), "wrong number of arguments"); }
 
     /// @brief Copy-construct this vector with the values of another vector.
     /// @param other the other vector
-    vector(const vector_type& other)
+    constexpr vector(const vector_type& other)
         : m_implementation(other.m_implementation)
     {}
 
     /// @internal
     /// @brief Construct this vector.
     /// @param other the implementation_type value
-    vector(const implementation_type& other) :
+    constexpr vector(const implementation_type& other) :
         m_implementation(other)
     {}
     
     /// @brief Default-construct this vector.
-    vector()
+    constexpr vector()
         : m_implementation()
     { /* Intentionally empty. */ }
 
+    /// @brief Construct this vector without initializing its component values.
+    explicit vector(uninitialized_t)
+        : m_implementation(uninitialized)
+    {}
+
 public:
     /// @{
     /// @brief Get the component value of the \f$x\f$ component.
     /// @return a reference to the component value of the \f$x\f$ component
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
+    constexpr std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
     {
         static_assert(vector_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation(0);
     }
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
     {
         static_assert(vector_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation(0);
@@ -130,13 +136,13 @@ public:
     /// @brief Get the component value of the \f$y\f$ component.
     /// @return a reference to the component value of the \f$y\f$ component
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    scalar_type& y()
+    constexpr scalar_type& y()
     {
         static_assert(vector_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation(1);
     }
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    const scalar_type& y() const
+    constexpr const scalar_type& y() const
     {
         static_assert(vector_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation(1);
@@ -147,13 +153,13 @@ public:
     /// @brief Get the component value of the \f$z\f$ component.
     /// @return a reference to the component value of the \f$z\f$ component
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
+    constexpr std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
     {
         static_assert(vector_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation(2);
     }
     template <size_t LocalDimensionality = vector_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
     {
         static_assert(vector_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation(2);
@@ -161,13 +167,13 @@ public:
     /// @}
 
 public:
-    bool operator==(const vector_type& other) const
+    constexpr bool operator==(const vector_type& other) const
     { return m_implementation == other.m_implementation; }
 
-    bool operator!=(const vector_type& other) const
+    constexpr bool operator!=(const vector_type& other) const
     { return m_implementation != other.m_implementation; }
 
-    vector_type& operator=(const vector_type& other)
+    constexpr vector_type& operator=(const vector_type& other)
     {
         m_implementation = other.m_implementation;
         return *this;
@@ -175,7 +181,7 @@ public:
 
 private:
     template <typename C, size_t...Is>
-    bool equal_to(const vector_type& other, const C& c, std::index_sequence<Is ...>) const
+    constexpr bool equal_to(const vector_type& other, const C& c, std::index_sequence<Is ...>) const
     { return and_fold_expr()(c((*this)[Is], other[Is]) ...); }
 
 public:
@@ -184,7 +190,7 @@ public:
     /// @param other the other vector
     /// @param c the comparator
     template <typename C>
-    bool equal_to(const vector_type& other, const C& c) const
+    constexpr bool equal_to(const vector_type& other, const C& c) const
     { return equal_to(other, c, std::make_index_sequence<Dimensionality>{}); }
 
 #if 0
@@ -231,29 +237,29 @@ public:
 #endif
 
 public:
-    scalar_type& operator[](size_t const& index)
+    constexpr scalar_type& operator[](size_t const& index)
     { return m_implementation(index); }
 
-    const scalar_type& operator[](size_t const& index) const
+    constexpr const scalar_type& operator[](size_t const& index) const
     { return m_implementation(index); }
     
-    scalar_type& operator()(size_t const& index)
+    constexpr scalar_type& operator()(size_t const& index)
     { return m_implementation(index); }
 
-    const scalar_type& operator()(size_t const& index) const
+    constexpr const scalar_type& operator()(size_t const& index) const
     { return m_implementation(index); }
 
 public:
-    vector_type& operator+=(const vector_type& other) { m_implementation += other.m_implementation; return *this; }
-    vector_type operator+(const vector_type& other) const { auto t = m_implementation; t += other.m_implementation; return vector_type(t); }
-    vector_type& operator-=(const vector_type& other) { m_implementation -= other.m_implementation; return *this; }
-    vector_type operator-(const vector_type& other) const { auto t = m_implementation; t -= other.m_implementation; return vector_type(t); }
-    vector_type& operator*=(const scalar_type& other) { m_implementation *= other; return *this; }
-    vector_type operator*(const scalar_type& other) const { auto t = m_implementation; t *= other; return vector_type(t); }
-    vector_type& operator/=(const scalar_type& other) { m_implementation /= other; return *this; }
-    vector_type operator/(const scalar_type& other) const { auto t = m_implementation; t /= other; return vector_type(t); }
-    vector_type operator-() const { return vector_type(-m_implementation); }
-    vector_type operator+() const { return vector_type(+m_implementation); }
+    constexpr vector_type& operator+=(const vector_type& other) { m_implementation += other.m_implementation; return *this; }
+    constexpr vector_type operator+(const vector_type& other) const { auto t = m_implementation; t += other.m_implementation; return vector_type(t); }
+    constexpr vector_type& operator-=(const vector_type& other) { m_implementation -= other.m_implementation; return *this; }
+    constexpr vector_type operator-(const vector_type& other) const { auto t = m_implementation; t -= other.m_implementation; return vector_type(t); }
+    constexpr vector_type& operator*=(const scalar_type& other) { m_implementation *= other; return *this; }
+    constexpr vector_type operator*(const scalar_type& other) const { auto t = m_implementation; t *= other; return vector_type(t); }
+    constexpr vector_type& operator/=(const scalar_type& other) { m_implementation /= other; return *this; }
+    constexpr vector_type operator/(const scalar_type& other) const { auto t = m_implementation; t /= other; return vector_type(t); }
+    constexpr vector_type operator-() const { return vector_type(-m_implementation); }
+    constexpr vector_type operator+() const { return vector_type(+m_implementation); }
 
 public:
     /// @brief Get if this vector is a unit vector.
@@ -274,7 +280,7 @@ public:
 
     /// @internal
     template <typename G, size_t...Is>
-    static vector_type generate(const G& g, std::index_sequence<Is...>)
+    static constexpr vector_type generate(const G& g, std::index_sequence<Is...>)
     {
         return vector_type((g(Is))...);
     }
@@ -284,14 +290,14 @@ public:
     /// @param g the generator
     /// @return the vector
     template <typename G>
-    static vector_type generate(const G& g)
+    static constexpr vector_type generate(const G& g)
     {
         return generate(g, std::make_index_sequence<dimensionality()>{});
     }
 
     /// @brief Get a unit vector in which the component of the specified index is @a 1.
     /// @return the unit vector
-    static vector_type unit(size_t index)
+    static constexpr vector_type unit(size_t index)
     {
         using a = constant_generator<scalar_type>;
         using b = constant_generator<scalar_type>;
@@ -311,7 +317,7 @@ struct zero_functor<vector<Scalar, Dimensionality>>
     using scalar_type = Scalar;
     using vector_type = vector<scalar_type, Dimensionality>;
 
-    auto operator()() const
+    constexpr auto operator()() const
     { return vector_type::generate(constant_generator<scalar_type>(zero<scalar_type>())); }
 };
 
@@ -321,7 +327,7 @@ struct one_functor<vector<Scalar, Dimensionality>>
     using scalar_type = Scalar;
     using vector_type = vector<scalar_type, Dimensionality>;
 
-    auto operator()() const
+    constexpr auto operator()() const
     { return vector_type::generate(constant_generator<scalar_type>(one<scalar_type>())); }
 };
 
@@ -423,7 +429,17 @@ template <typename Scalar>
 struct cross_product_functor<vector<Scalar, 3>>
 {
     using vector_type = vector<Scalar, 3>;
-    auto operator()(const vector_type& v, const vector_type& w) const
+    using simd_type = internal::simd_array<Scalar, 3>;
+
+    constexpr auto operator()(const vector_type& v, const vector_type& w) const
+    {
+        return internal::is_constant_evaluated()
+             ? impl(v, w, std::false_type{})
+             : impl(v, w, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
+
+private:
+    static constexpr vector_type impl(const vector_type& v, const vector_type& w, std::false_type)
     {
         return
             vector_type
@@ -433,6 +449,13 @@ struct cross_product_functor<vector<Scalar, 3>>
                     v[0] * w[1] - v[1] * w[0]
                 );
     }
+
+    static vector_type impl(const vector_type& v, const vector_type& w, std::true_type)
+    {
+        Scalar t[3];
+        simd_type::cross(&(v[0]), &(w[0]), t);
+        return vector_type(t[0], t[1], t[2]);
+    }
 };
 
 template <typename Scalar, size_t Dimensionality>
@@ -441,16 +464,28 @@ struct dot_product_functor<vector<Scalar, Dimensionality>>
     using scalar_type = Scalar;
     using vector_type = vector<scalar_type, Dimensionality>;
     
-    auto operator()(const vector_type& v, const vector_type& w) const
+    using simd_type = internal::simd_array<scalar_type, Dimensionality>;
+
+    constexpr auto operator()(const vector_type& v, const vector_type& w) const
     { return impl(v, w); }
 
 private:
     template <size_t...Is>
-    static scalar_type impl(const vector_type& v, const vector_type& w, std::index_sequence<Is...>)
+    static constexpr scalar_type impl(const vector_type& v, const vector_type& w, std::index_sequence<Is...>)
     { return idlib::plus_fold_expr()((v[Is] * w[Is])...); }
 
-    static scalar_type impl(const vector_type& v, const vector_type& w)
+    static constexpr scalar_type impl(const vector_type& v, const vector_type& w, std::false_type)
     { return impl(v, w, std::make_index_sequence<vector_type::dimensionality()>{}); }
+
+    static scalar_type impl(const vector_type& v, const vector_type& w, std::true_type)
+    { return simd_type::dot(&(v[0]), &(w[0])); }
+
+    static constexpr scalar_type impl(const vector_type& v, const vector_type& w)
+    {
+        return internal::is_constant_evaluated()
+             ? impl(v, w, std::false_type{})
+             : impl(v, w, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
 }; // struct dot_product_functor
 
 template <typename Scalar, size_t Dimensionality>
@@ -459,35 +494,55 @@ struct squared_euclidean_norm_functor<vector<Scalar, Dimensionality>>
     using scalar_type = Scalar;
     using vector_type = vector<scalar_type, Dimensionality>;
     
-    auto operator()(const vector_type& v) const
+    using simd_type = internal::simd_array<scalar_type, Dimensionality>;
+
+    constexpr auto operator()(const vector_type& v) const
     { return impl(v); }
     
 private:
     template <size_t...Is>
-    static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
+    static constexpr scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
     { return idlib::plus_fold_expr()((v[Is] * v[Is])...); }
 
-    static scalar_type impl(const vector_type& v)
+    static constexpr scalar_type impl(const vector_type& v, std::false_type)
     { return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
+    static scalar_type impl(const vector_type& v, std::true_type)
+    { return simd_type::dot(&(v[0]), &(v[0])); }
+
+    static constexpr scalar_type impl(const vector_type& v)
+    {
+        return internal::is_constant_evaluated()
+             ? impl(v, std::false_type{})
+             : impl(v, std::integral_constant<bool, simd_type::is_enabled()>{});
+    }
+
 }; // struct squared_euclidean_norm_functor
 
-template <typename Scalar, size_t Dimensionality>
-struct euclidean_norm_functor<vector<Scalar, Dimensionality>>
+template <typename Scalar, size_t Dimensionality, precision P>
+struct euclidean_norm_functor<vector<Scalar, Dimensionality>, P>
 {
     using scalar_type = Scalar;
     using vector_type = vector<scalar_type, Dimensionality>;
     
+    using simd_type = internal::simd_array<scalar_type, Dimensionality>;
+
     auto operator()(const vector_type& v) const
     { return impl(v); }
 
 private:
     template <size_t...Is>
     static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
-    { return std::sqrt(idlib::plus_fold_expr()((v[Is] * v[Is])...)); }
+    { return sqrt_functor<scalar_type, P>()(idlib::plus_fold_expr()((v[Is] * v[Is])...)); }
 
-    static scalar_type impl(const vector_type& v)
+    static scalar_type impl(const vector_type& v, std::false_type)
     { return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
+
+    static scalar_type impl(const vector_type& v, std::true_type)
+    { return sqrt_functor<scalar_type, P>()(simd_type::dot(&(v[0]), &(v[0]))); }
+
+    static scalar_type impl(const vector_type& v)
+    { return impl(v, std::integral_constant<bool, simd_type::is_enabled()>{}); }
     
 }; // struct euclidean_norm_functor
 
@@ -590,6 +645,50 @@ private:
 
 }; // struct normalize_functor
 
+/// @internal
+/// @brief Specialization of idlib::normalize_functor for idlib::vector<Scalar, Dimensionality> values and the Euclidean norm.
+/// @remark If the precision policy is not idlib::precision::exact,
+/// the vector is multiplied by the reciprocal of the square root of its squared length instead of being divided by its length.
+template <typename Scalar, size_t Dimensionality, precision P>
+struct normalize_functor<vector<Scalar, Dimensionality>, euclidean_norm_functor<vector<Scalar, Dimensionality>, P>>
+{
+    using scalar_type = Scalar;
+    using vector_type = vector<scalar_type, Dimensionality>;
+    using norm_type = euclidean_norm_functor<vector_type, P>;
+    using result_type = normalization_result<scalar_type, Dimensionality>;
+
+    auto operator()(const vector_type& v, const norm_type& n) const
+    { return impl(v, n, std::integral_constant<bool, P == precision::exact>{}); }
+
+private:
+    static result_type impl(const vector_type& v, const norm_type& n, std::true_type)
+    {
+        auto l = n(v);
+        if (l == zero<scalar_type>())
+        {
+            return result_type(v, l);
+        }
+        else
+        {
+            return result_type(v / l, one<scalar_type>());
+        }
+    }
+
+    static result_type impl(const vector_type& v, const norm_type&, std::false_type)
+    {
+        auto s = squared_euclidean_norm_functor<vector_type>()(v);
+        if (s == zero<scalar_type>())
+        {
+            return result_type(v, s);
+        }
+        else
+        {
+            return result_type(v * rsqrt_functor<scalar_type, P>()(s), one<scalar_type>());
+        }
+    }
+
+}; // struct normalize_functor
+
 /// @internal
 /// @brief Specialization of idlib::max_element_functor for idlib::vector<Scalar, Dimensionality> values.
 template <typename Scalar, size_t Dimensionality>
@@ -625,15 +724,15 @@ struct zip_max_functor<vector<Scalar, Dimensionality>,
 {
     using vector_type = vector<Scalar, Dimensionality>;
 
-    auto operator()(const vector_type& u, const vector_type& v) const
+    constexpr auto operator()(const vector_type& u, const vector_type& v) const
     { return impl(u, v); }
 
 private:
     template<size_t...Is>
-    auto impl(const vector_type& u, const vector_type& v, std::index_sequence<Is...>) const
+    constexpr auto impl(const vector_type& u, const vector_type& v, std::index_sequence<Is...>) const
     { return vector_type(std::max(u[Is], v[Is])...); }
 
-    auto impl(const vector_type& u, const vector_type& v) const
+    constexpr auto impl(const vector_type& u, const vector_type& v) const
     { return impl(u, v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
 }; // struct zip_max_functor
@@ -673,15 +772,15 @@ struct zip_min_functor<vector<Scalar, Dimensionality>,
 {
     using vector_type = vector<Scalar, Dimensionality>;
 
-    auto operator()(const vector_type& u, const vector_type& v) const
+    constexpr auto operator()(const vector_type& u, const vector_type& v) const
     { return impl(u, v); }
 
 private:
     template<size_t...Is>
-    auto impl(const vector_type& u, const vector_type& v, std::index_sequence<Is...>) const
+    constexpr auto impl(const vector_type& u, const vector_type& v, std::index_sequence<Is...>) const
     { return vector_type(std::min(u[Is], v[Is])...); }
 
-    auto impl(const vector_type& u, const vector_type& v) const
+    constexpr auto impl(const vector_type& u, const vector_type& v) const
     { return impl(u, v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
 }; // struct zip_min_functor
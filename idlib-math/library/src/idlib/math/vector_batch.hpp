@@ -0,0 +1,435 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/vector_batch.hpp
+/// @brief Batches of \f$n\f$-dimensional vectors in structure-of-arrays layout.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/vector.hpp"
+#include "idlib/math/simd.hpp"
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A batch of vectors in structure-of-arrays layout:
+/// The \f$i\f$-th components of all vectors of the batch are stored contiguously.
+/// @remark The component arrays are padded with zeroes to a multiple of granularity() such that the batch kernels
+/// (idlib::euclidean_norm, idlib::squared_euclidean_norm, idlib::dot_product, idlib::cross_product, idlib::normalize,
+/// idlib::zip_min, idlib::zip_max for batches) always operate on full SIMD registers.
+/// @tparam Scalar the scalar type
+/// @tparam Dimensionality the dimensionality. Must be greater than @a 0.
+template <typename Scalar, size_t Dimensionality>
+struct vector_batch
+{
+    static_assert(Dimensionality > 0, "dimensionality must be greater than 0");
+
+public:
+    /// @brief The scalar type.
+    using scalar_type = Scalar;
+
+    /// @brief The vector type.
+    using vector_type = vector<scalar_type, Dimensionality>;
+
+    /// @brief The type of this template/template specialization.
+    using batch_type = vector_batch<scalar_type, Dimensionality>;
+
+    /// @brief Get the dimensionality.
+    /// @return the dimensionality
+    static constexpr size_t dimensionality()
+    { return Dimensionality; }
+
+    /// @brief Get the granularity of the component arrays.
+    /// @return the granularity, the width of the native SIMD pack of the scalar type
+    static constexpr size_t granularity()
+    { return internal::simd_native_width<scalar_type>::value; }
+
+    /// @brief Construct this batch with no vectors.
+    vector_batch()
+        : m_size(0)
+    { resize(0); }
+
+    /// @brief Construct this batch with the specified number of zero vectors.
+    /// @param size the number of vectors
+    explicit vector_batch(size_t size)
+        : m_size(0)
+    { resize(size); }
+
+    /// @brief Construct this batch with the values of the specified vectors.
+    /// @param source pointer to the first vector
+    /// @param count the number of vectors
+    vector_batch(const vector_type *source, size_t count)
+        : m_size(0)
+    { gather(source, count); }
+
+    vector_batch(const batch_type& other) = default;
+
+    vector_batch(batch_type&& other) = default;
+
+    batch_type& operator=(const batch_type& other) = default;
+
+    batch_type& operator=(batch_type&& other) = default;
+
+public:
+    /// @brief Get the number of vectors in this batch.
+    /// @return the number of vectors in this batch
+    size_t size() const
+    { return m_size; }
+
+    /// @brief Get if this batch is empty.
+    /// @return @a true if this batch is empty, @a false otherwise
+    bool empty() const
+    { return 0 == m_size; }
+
+    /// @brief Get the size of the component arrays.
+    /// @return the size of this batch rounded up to a multiple of granularity()
+    size_t padded_size() const
+    { return m_components[0].size(); }
+
+    /// @brief Resize this batch.
+    /// @param size the new number of vectors
+    /// @remark If the batch grows, the new vectors are zero vectors.
+    void resize(size_t size)
+    {
+        const size_t padded = ((size + granularity() - 1) / granularity()) * granularity();
+        for (auto& component : m_components)
+        {
+            component.resize(padded, zero<scalar_type>());
+            std::fill(component.begin() + size, component.end(), zero<scalar_type>());
+        }
+        m_size = size;
+    }
+
+    /// @brief Remove all vectors from this batch.
+    void clear()
+    { resize(0); }
+
+    /// @brief Append a vector to this batch.
+    /// @param v the vector
+    void push_back(const vector_type& v)
+    {
+        resize(m_size + 1);
+        set(m_size - 1, v);
+    }
+
+    /// @{
+    /// @brief Get a pointer to the component array of the specified component.
+    /// @param component the index of the component
+    /// @return a pointer to the component array. The array has padded_size() elements.
+    scalar_type *data(size_t component)
+    { return m_components[component].data(); }
+
+    const scalar_type *data(size_t component) const
+    { return m_components[component].data(); }
+    /// @}
+
+    /// @{
+    /// @brief Get the specified component of the specified vector.
+    /// @param component the index of the component
+    /// @param index the index of the vector
+    /// @return a reference to the component value
+    scalar_type& operator()(size_t component, size_t index)
+    { return m_components[component][index]; }
+
+    const scalar_type& operator()(size_t component, size_t index) const
+    { return m_components[component][index]; }
+    /// @}
+
+    /// @brief Get the vector at the specified index.
+    /// @param index the index
+    /// @return the vector
+    vector_type get(size_t index) const
+    { return get(index, std::make_index_sequence<Dimensionality>{}); }
+
+    /// @brief Set the vector at the specified index.
+    /// @param index the index
+    /// @param v the vector
+    void set(size_t index, const vector_type& v)
+    {
+        for (size_t j = 0; j < Dimensionality; ++j)
+        { m_components[j][index] = v[j]; }
+    }
+
+    /// @brief Replace the contents of this batch by the values of the specified vectors.
+    /// @param source pointer to the first vector
+    /// @param count the number of vectors
+    void gather(const vector_type *source, size_t count)
+    {
+        resize(count);
+        for (size_t j = 0; j < Dimensionality; ++j)
+        {
+            scalar_type *target = m_components[j].data();
+            for (size_t i = 0; i < count; ++i)
+            { target[i] = source[i][j]; }
+        }
+    }
+
+    /// @brief Write the values of the vectors of this batch to the specified vectors.
+    /// @param target pointer to the first vector. Must point to an array of at least size() vectors.
+    void scatter(vector_type *target) const
+    {
+        for (size_t j = 0; j < Dimensionality; ++j)
+        {
+            const scalar_type *source = m_components[j].data();
+            for (size_t i = 0; i < m_size; ++i)
+            { target[i][j] = source[i]; }
+        }
+    }
+
+public:
+    /// @brief Multiply all vectors of this batch by a scalar.
+    /// @param s the scalar
+    /// @return this batch
+    batch_type& operator*=(const scalar_type& s)
+    {
+        apply([](typename pack_type::register_type x, typename pack_type::register_type y) { return pack_type::mul(x, y); }, s);
+        return *this;
+    }
+
+    /// @brief Divide all vectors of this batch by a scalar.
+    /// @param s the scalar
+    /// @return this batch
+    batch_type& operator/=(const scalar_type& s)
+    {
+        apply([](typename pack_type::register_type x, typename pack_type::register_type y) { return pack_type::div(x, y); }, s);
+        return *this;
+    }
+
+private:
+    using pack_type = internal::simd_native_pack<scalar_type>;
+
+    template <size_t ... Is>
+    vector_type get(size_t index, std::index_sequence<Is ...>) const
+    { return vector_type(m_components[Is][index] ...); }
+
+    // Apply a binary operation to all components and a broadcasted scalar.
+    // Only the components of the vectors are modified, the padding is kept.
+    template <typename F>
+    void apply(F f, const scalar_type& s)
+    {
+        constexpr size_t W = pack_type::width();
+        const auto b = pack_type::broadcast(s);
+        for (auto& component : m_components)
+        {
+            scalar_type *p = component.data();
+            for (size_t i = 0; i < m_size; i += W)
+            { pack_type::store(p + i, f(pack_type::load(p + i), b), std::min(W, m_size - i)); }
+        }
+    }
+
+    /// @brief The number of vectors.
+    size_t m_size;
+
+    /// @brief The component arrays.
+    std::array<std::vector<scalar_type>, Dimensionality> m_components;
+
+}; // struct vector_batch
+
+namespace internal {
+
+/// @internal
+/// @brief Raise an exception if the sizes of two batches are not equal.
+template <typename Scalar, size_t Dimensionality>
+void check_equal_sizes(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b)
+{
+    if (a.size() != b.size())
+    { throw std::invalid_argument("sizes of batches are not equal"); }
+}
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Compute the squared Euclidean norms of the vectors of a batch.
+/// @param v the batch
+/// @param result pointer to an array of at least <c>v.size()</c> scalars receiving the norms
+template <typename Scalar, size_t Dimensionality>
+void squared_euclidean_norm(const vector_batch<Scalar, Dimensionality>& v, Scalar *result)
+{
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t i = 0, n = v.size(); i < n; i += W)
+    {
+        auto s = pack_type::zero();
+        for (size_t j = 0; j < Dimensionality; ++j)
+        {
+            const auto x = pack_type::load(v.data(j) + i);
+            s = pack_type::add(s, pack_type::mul(x, x));
+        }
+        pack_type::store(result + i, s, std::min(W, n - i));
+    }
+}
+
+/// @ingroup math
+/// @brief Compute the Euclidean norms of the vectors of a batch.
+/// @tparam P the precision policy of the square roots
+/// @param v the batch
+/// @param result pointer to an array of at least <c>v.size()</c> scalars receiving the norms
+template <precision P = precision::exact, typename Scalar, size_t Dimensionality>
+void euclidean_norm(const vector_batch<Scalar, Dimensionality>& v, Scalar *result)
+{
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t i = 0, n = v.size(); i < n; i += W)
+    {
+        auto s = pack_type::zero();
+        for (size_t j = 0; j < Dimensionality; ++j)
+        {
+            const auto x = pack_type::load(v.data(j) + i);
+            s = pack_type::add(s, pack_type::mul(x, x));
+        }
+        if (P == precision::exact)
+        {
+            pack_type::store(result + i, pack_type::sqrt(s), std::min(W, n - i));
+        }
+        else
+        {
+            const auto l = pack_type::mul(s, pack_type::template rsqrt<P>(s));
+            pack_type::store(result + i, pack_type::select(pack_type::cmp_gt(s, pack_type::zero()), l, s), std::min(W, n - i));
+        }
+    }
+}
+
+/// @ingroup math
+/// @brief Compute the dot products of the vectors of two batches.
+/// @param v, w the batches
+/// @param result pointer to an array of at least <c>v.size()</c> scalars receiving the dot products
+/// @throw std::invalid_argument the sizes of the batches are not equal
+template <typename Scalar, size_t Dimensionality>
+void dot_product(const vector_batch<Scalar, Dimensionality>& v, const vector_batch<Scalar, Dimensionality>& w, Scalar *result)
+{
+    internal::check_equal_sizes(v, w);
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t i = 0, n = v.size(); i < n; i += W)
+    {
+        auto s = pack_type::zero();
+        for (size_t j = 0; j < Dimensionality; ++j)
+        { s = pack_type::add(s, pack_type::mul(pack_type::load(v.data(j) + i), pack_type::load(w.data(j) + i))); }
+        pack_type::store(result + i, s, std::min(W, n - i));
+    }
+}
+
+/// @ingroup math
+/// @brief Compute the cross products of the vectors of two batches of 3-dimensional vectors.
+/// @param v, w the batches
+/// @param result the batch receiving the cross products. May be @a v or @a w.
+/// @throw std::invalid_argument the sizes of the batches are not equal
+template <typename Scalar>
+void cross_product(const vector_batch<Scalar, 3>& v, const vector_batch<Scalar, 3>& w, vector_batch<Scalar, 3>& result)
+{
+    internal::check_equal_sizes(v, w);
+    result.resize(v.size());
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t i = 0, n = v.size(); i < n; i += W)
+    {
+        const auto vx = pack_type::load(v.data(0) + i), vy = pack_type::load(v.data(1) + i), vz = pack_type::load(v.data(2) + i);
+        const auto wx = pack_type::load(w.data(0) + i), wy = pack_type::load(w.data(1) + i), wz = pack_type::load(w.data(2) + i);
+        pack_type::store(result.data(0) + i, pack_type::sub(pack_type::mul(vy, wz), pack_type::mul(vz, wy)));
+        pack_type::store(result.data(1) + i, pack_type::sub(pack_type::mul(vz, wx), pack_type::mul(vx, wz)));
+        pack_type::store(result.data(2) + i, pack_type::sub(pack_type::mul(vx, wy), pack_type::mul(vy, wx)));
+    }
+}
+
+/// @ingroup math
+/// @brief Normalize the vectors of a batch with respect to the Euclidean norm.
+/// @tparam P the precision policy of the square roots.
+/// If it is not idlib::precision::exact, the vectors are multiplied by the reciprocals of the square roots of their squared lengths.
+/// @param v the batch
+/// @param result the batch receiving the normalized vectors. May be @a v.
+/// @remark Zero vectors are not modified (cf. idlib::normalization_result::get_vector_or_default).
+template <precision P = precision::exact, typename Scalar, size_t Dimensionality>
+void normalize(const vector_batch<Scalar, Dimensionality>& v, vector_batch<Scalar, Dimensionality>& result)
+{
+    result.resize(v.size());
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t i = 0, n = v.size(); i < n; i += W)
+    {
+        typename pack_type::register_type x[Dimensionality];
+        auto s = pack_type::zero();
+        for (size_t j = 0; j < Dimensionality; ++j)
+        {
+            x[j] = pack_type::load(v.data(j) + i);
+            s = pack_type::add(s, pack_type::mul(x[j], x[j]));
+        }
+        const auto m = pack_type::cmp_gt(s, pack_type::zero());
+        if (P == precision::exact)
+        {
+            const auto l = pack_type::sqrt(s);
+            for (size_t j = 0; j < Dimensionality; ++j)
+            { pack_type::store(result.data(j) + i, pack_type::select(m, pack_type::div(x[j], l), x[j])); }
+        }
+        else
+        {
+            const auto r = pack_type::template rsqrt<P>(s);
+            for (size_t j = 0; j < Dimensionality; ++j)
+            { pack_type::store(result.data(j) + i, pack_type::select(m, pack_type::mul(x[j], r), x[j])); }
+        }
+    }
+}
+
+/// @ingroup math
+/// @brief Compute the component-wise minima of the vectors of two batches.
+/// @param v, w the batches
+/// @param result the batch receiving the minima. May be @a v or @a w.
+/// @throw std::invalid_argument the sizes of the batches are not equal
+template <typename Scalar, size_t Dimensionality>
+void zip_min(const vector_batch<Scalar, Dimensionality>& v, const vector_batch<Scalar, Dimensionality>& w, vector_batch<Scalar, Dimensionality>& result)
+{
+    internal::check_equal_sizes(v, w);
+    result.resize(v.size());
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t j = 0; j < Dimensionality; ++j)
+    {
+        for (size_t i = 0, n = v.size(); i < n; i += W)
+        { pack_type::store(result.data(j) + i, pack_type::min(pack_type::load(w.data(j) + i), pack_type::load(v.data(j) + i))); }
+    }
+}
+
+/// @ingroup math
+/// @brief Compute the component-wise maxima of the vectors of two batches.
+/// @param v, w the batches
+/// @param result the batch receiving the maxima. May be @a v or @a w.
+/// @throw std::invalid_argument the sizes of the batches are not equal
+template <typename Scalar, size_t Dimensionality>
+void zip_max(const vector_batch<Scalar, Dimensionality>& v, const vector_batch<Scalar, Dimensionality>& w, vector_batch<Scalar, Dimensionality>& result)
+{
+    internal::check_equal_sizes(v, w);
+    result.resize(v.size());
+    using pack_type = internal::simd_native_pack<Scalar>;
+    constexpr size_t W = pack_type::width();
+    for (size_t j = 0; j < Dimensionality; ++j)
+    {
+        for (size_t i = 0, n = v.size(); i < n; i += W)
+        { pack_type::store(result.data(j) + i, pack_type::max(pack_type::load(w.data(j) + i), pack_type::load(v.data(j) + i))); }
+    }
+}
+
+} // namespace idlib
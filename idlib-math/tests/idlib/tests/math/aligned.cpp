@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace idlib::tests {
+
+static_assert(sizeof(padded_vector<single, 3>) == 16, "padded_vector<single, 3> must occupy 16 bytes");
+static_assert(alignof(padded_vector<single, 3>) == 16, "padded_vector<single, 3> must be aligned to 16 bytes");
+static_assert(sizeof(padded_vector<double, 3>) == 32, "padded_vector<double, 3> must occupy 32 bytes");
+static_assert(sizeof(padded_vector<single, 4>) == 16, "padded_vector<single, 4> must not be padded");
+static_assert(sizeof(aligned<matrix<single, 4, 4>, 32>) == 64, "aligned<matrix<single, 4, 4>, 32> must not be padded");
+static_assert(alignof(aligned<matrix<single, 4, 4>, 32>) == 32, "aligned<matrix<single, 4, 4>, 32> must be aligned to 32 bytes");
+static_assert(sizeof(vector<single, 3>) == 12, "the layout of vector<single, 3> must remain unchanged");
+static_assert(!std::is_convertible<vector<single, 3>, padded_vector<single, 3>>::value, "conversion must be explicit");
+static_assert(!std::is_convertible<padded_vector<single, 3>, vector<single, 3>>::value, "conversion must be explicit");
+
+template <typename Vector>
+struct aligned_test : public ::testing::Test
+{
+    using aligned_type = Vector;
+    using vector_type = typename aligned_type::value_type;
+    using scalar_type = typename aligned_type::scalar_type;
+
+    static vector_type get_vector(int offset)
+    { return vector_type::generate([offset](size_t i) { return scalar_type(offset + int(i)); }); }
+};
+
+using aligned_test_types = ::testing::Types<padded_vector<single, 3>, padded_vector<single, 4>,
+                                            padded_vector<double, 3>, padded_vector<double, 4>,
+                                            aligned<vector<single, 3>, 32>, aligned<vector<single, 2>, 8>>;
+
+TYPED_TEST_SUITE(aligned_test, aligned_test_types);
+
+TYPED_TEST(aligned_test, layout)
+{
+    using aligned_type = typename TestFixture::aligned_type;
+    std::vector<aligned_type> vs(16);
+    for (const auto& v : vs)
+    { ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(v.data()) % aligned_type::alignment()); }
+}
+
+TYPED_TEST(aligned_test, conversion)
+{
+    using aligned_type = typename TestFixture::aligned_type;
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    const vector_type v = TestFixture::get_vector(1);
+    const aligned_type a(v);
+    for (size_t i = 0; i < aligned_type::length(); ++i)
+    { ASSERT_EQ(v[i], a[i]); }
+    for (size_t i = aligned_type::length(); i < aligned_type::padded_length(); ++i)
+    { ASSERT_EQ(scalar_type(0), a[i]); }
+    ASSERT_EQ(v, vector_type(a));
+    ASSERT_EQ(v, a.get());
+}
+
+TYPED_TEST(aligned_test, arithmetic)
+{
+    using aligned_type = typename TestFixture::aligned_type;
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    const vector_type v = TestFixture::get_vector(1), w = TestFixture::get_vector(5);
+    const aligned_type a(v), b(w);
+    ASSERT_EQ(v + w, (a + b).get());
+    ASSERT_EQ(v - w, (a - b).get());
+    ASSERT_EQ(-v, (-a).get());
+    ASSERT_EQ(v * scalar_type(2), (a * scalar_type(2)).get());
+    ASSERT_EQ(v * scalar_type(2), (scalar_type(2) * a).get());
+    ASSERT_EQ(dot_product(v, w), dot_product(a, b));
+    ASSERT_EQ(squared_euclidean_norm(v), squared_euclidean_norm(a));
+    aligned_type c(a);
+    c += b;
+    c -= a;
+    c *= scalar_type(3);
+    ASSERT_EQ(w * scalar_type(3), c.get());
+    for (size_t i = aligned_type::length(); i < aligned_type::padded_length(); ++i)
+    { ASSERT_EQ(scalar_type(0), c[i]); }
+}
+
+TEST(aligned, point)
+{
+    using point_type = point<vector<single, 3>>;
+    const point_type p(1.0f, 2.0f, 3.0f);
+    const padded_point<vector<single, 3>> a(p);
+    ASSERT_EQ(16u, sizeof(a));
+    ASSERT_EQ(p, point_type(a));
+}
+
+TEST(aligned, matrix)
+{
+    using matrix_type = matrix<double, 3, 3>;
+    const matrix_type m(1.0, 2.0, 3.0,
+                        4.0, 5.0, 6.0,
+                        7.0, 8.0, 9.0);
+    aligned<matrix_type, 32> a(m);
+    ASSERT_EQ(12u, a.padded_length());
+    ASSERT_EQ(m, matrix_type(a));
+    a.set(identity<matrix_type>());
+    ASSERT_EQ(identity<matrix_type>(), a.get());
+}
+
+} // namespace idlib::tests
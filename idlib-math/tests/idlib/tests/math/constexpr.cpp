@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+
+namespace idlib::tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using matrix_4s_4s = idlib::matrix<single, 4, 4>;
+
+// Vectors.
+constexpr vector_3s a(1.0f, 2.0f, 3.0f), b(4.0f, 5.0f, 6.0f);
+static_assert(a + b == vector_3s(5.0f, 7.0f, 9.0f), "vector-vector addition is not constexpr");
+static_assert(b - a == vector_3s(3.0f, 3.0f, 3.0f), "vector-vector subtraction is not constexpr");
+static_assert(a * 2.0f == vector_3s(2.0f, 4.0f, 6.0f), "vector-scalar multiplication is not constexpr");
+static_assert(-a == vector_3s(-1.0f, -2.0f, -3.0f), "vector negation is not constexpr");
+static_assert(idlib::dot_product(a, b) == 32.0f, "dot product is not constexpr");
+static_assert(idlib::squared_euclidean_norm(a) == 14.0f, "squared euclidean norm is not constexpr");
+static_assert(idlib::cross_product(vector_3s::unit(0), vector_3s::unit(1)) == vector_3s::unit(2), "cross product is not constexpr");
+static_assert(idlib::zero<vector_3s>() == vector_3s(0.0f, 0.0f, 0.0f), "zero vector is not constexpr");
+static_assert(idlib::zip_max(a, vector_3s(3.0f, 0.0f, 4.0f)) == vector_3s(3.0f, 2.0f, 4.0f), "zip max is not constexpr");
+
+// Points.
+constexpr point_3s p(1.0f, 1.0f, 1.0f);
+static_assert(p + a == point_3s(2.0f, 3.0f, 4.0f), "point-vector addition is not constexpr");
+static_assert((p + a) - p == a, "point-point subtraction is not constexpr");
+
+// Matrices and transforms.
+constexpr matrix_4s_4s t = idlib::translation_matrix(vector_3s(1.0f, 2.0f, 3.0f));
+constexpr matrix_4s_4s s = idlib::scaling_matrix(2.0f);
+constexpr matrix_4s_4s ts = t * s;
+static_assert(ts(0, 0) == 2.0f && ts(1, 1) == 2.0f && ts(2, 2) == 2.0f && ts(3, 3) == 1.0f, "matrix product is not constexpr");
+static_assert(ts(0, 3) == 1.0f && ts(1, 3) == 2.0f && ts(2, 3) == 3.0f, "matrix product is not constexpr");
+static_assert(idlib::identity<matrix_4s_4s>() * t == t, "identity matrix is not constexpr");
+static_assert(idlib::transpose(t)(3, 0) == 1.0f, "transpose is not constexpr");
+static_assert(idlib::trace(s) == 7.0f, "trace is not constexpr");
+static_assert(s.det() == 8.0f, "determinant is not constexpr");
+static_assert(t.inverse() * t == idlib::identity<matrix_4s_4s>(), "inverse is not constexpr");
+
+// Lookup table computed at compile time.
+constexpr idlib::arithmetic_array_1d<double, 8, idlib::zero_functor<double>> squares =
+    idlib::arithmetic_array_1d<double, 8, idlib::zero_functor<double>>::generate([](size_t i) { return double(i * i); });
+static_assert(squares(7) == 49.0, "arithmetic array generation is not constexpr");
+
+/// @brief Assert values computed at compile time are equal to values computed at run time.
+TEST(constexpr_test, compile_time_equals_run_time)
+{
+    vector_3s x = a, y = b;
+    ASSERT_EQ(x + y, a + b);
+    ASSERT_EQ(idlib::cross_product(x, y), idlib::cross_product(a, b));
+    matrix_4s_4s u = idlib::translation_matrix(x);
+    ASSERT_EQ(u, t);
+    ASSERT_EQ(u * s, ts);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct dynamic_matrix_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using matrix_type = idlib::dynamic_matrix<scalar_type>;
+    using vector_type = idlib::dynamic_vector<scalar_type>;
+
+    static matrix_type get_matrix(size_t number_of_rows, size_t number_of_columns, size_t seed)
+    {
+        matrix_type a(number_of_rows, number_of_columns);
+        for (size_t i = 0; i < a.number_of_elements(); ++i)
+        { a(i) = scalar_type(int((i * 7 + seed) % 13) - 6) / scalar_type(4); }
+        return a;
+    }
+
+    static vector_type get_vector(size_t dimensionality)
+    {
+        vector_type x(dimensionality);
+        for (size_t i = 0; i < dimensionality; ++i)
+        { x[i] = scalar_type(int(i % 9) - 4) / scalar_type(2); }
+        return x;
+    }
+
+    /// @brief Compute the product of two matrices by the textbook triple loop.
+    static matrix_type naive(const matrix_type& a, const matrix_type& b)
+    {
+        matrix_type c(a.number_of_rows(), b.number_of_columns());
+        for (size_t i = 0; i < a.number_of_rows(); ++i)
+        {
+            for (size_t j = 0; j < b.number_of_columns(); ++j)
+            {
+                scalar_type s = 0;
+                for (size_t k = 0; k < a.number_of_columns(); ++k)
+                { s += a(i, k) * b(k, j); }
+                c(i, j) = s;
+            }
+        }
+        return c;
+    }
+
+    static void assert_near(const matrix_type& a, const matrix_type& b)
+    {
+        ASSERT_EQ(a.number_of_rows(), b.number_of_rows());
+        ASSERT_EQ(a.number_of_columns(), b.number_of_columns());
+        for (size_t i = 0; i < a.number_of_elements(); ++i)
+        {
+            ASSERT_NEAR(a(i), b(i), scalar_type(1e-4) * std::max(scalar_type(1), std::abs(b(i))));
+        }
+    }
+};
+
+using dynamic_matrix_test_types = ::testing::Types<single, double>;
+TYPED_TEST_SUITE(dynamic_matrix_test, dynamic_matrix_test_types);
+
+TYPED_TEST(dynamic_matrix_test, arithmetic)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using matrix_type = typename TestFixture::matrix_type;
+    const auto a = TestFixture::get_matrix(3, 5, 1), b = TestFixture::get_matrix(3, 5, 2);
+    const auto c = a + b, d = c - b, e = a * scalar_type(2), f = -a;
+    for (size_t i = 0; i < a.number_of_elements(); ++i)
+    {
+        ASSERT_EQ(c(i), a(i) + b(i));
+        ASSERT_EQ(d(i), a(i));
+        ASSERT_EQ(e(i), a(i) * scalar_type(2));
+        ASSERT_EQ(f(i), -a(i));
+    }
+    ASSERT_THROW(a + TestFixture::get_matrix(5, 3, 1), std::invalid_argument);
+    const auto t = idlib::transpose(a);
+    ASSERT_EQ(t.number_of_rows(), 5);
+    ASSERT_EQ(t.number_of_columns(), 3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 5; ++j)
+        { ASSERT_EQ(t(j, i), a(i, j)); }
+    }
+    ASSERT_EQ(idlib::transpose(t), a);
+    matrix_type g;
+    ASSERT_EQ(g.number_of_elements(), 0);
+}
+
+TYPED_TEST(dynamic_matrix_test, conversions)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using matrix_type = typename TestFixture::matrix_type;
+    using vector_type = typename TestFixture::vector_type;
+    idlib::matrix<scalar_type, 2, 3> a(1, 2, 3,
+                                       4, 5, 6);
+    const auto b = idlib::semantic_cast<matrix_type>(a);
+    ASSERT_EQ(b.number_of_rows(), 2);
+    ASSERT_EQ(b.number_of_columns(), 3);
+    ASSERT_EQ(b(1, 0), scalar_type(4));
+    ASSERT_EQ((idlib::semantic_cast<idlib::matrix<scalar_type, 2, 3>>(b)), a);
+    ASSERT_THROW((idlib::semantic_cast<idlib::matrix<scalar_type, 3, 2>>(b)), std::invalid_argument);
+
+    idlib::vector<scalar_type, 3> x(1, 2, 3);
+    const auto y = idlib::semantic_cast<vector_type>(x);
+    ASSERT_EQ(y.dimensionality(), 3);
+    ASSERT_EQ(idlib::dot_product(y, y), scalar_type(14));
+    ASSERT_EQ((idlib::semantic_cast<idlib::vector<scalar_type, 3>>(y)), x);
+    ASSERT_THROW((idlib::semantic_cast<idlib::vector<scalar_type, 2>>(y)), std::invalid_argument);
+
+    // The product agrees with the product of fixed matrices.
+    const auto z = b * y;
+    ASSERT_EQ(z.dimensionality(), 2);
+    ASSERT_EQ(z[0], scalar_type(14));
+    ASSERT_EQ(z[1], scalar_type(32));
+}
+
+TYPED_TEST(dynamic_matrix_test, gemm)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    // Odd sizes and sizes crossing the block boundaries of the kernels.
+    const size_t sizes[][3] = { {1, 1, 1}, {3, 5, 7}, {4, 4, 4}, {17, 33, 9}, {7, 300, 130}, {65, 257, 129} };
+    for (const auto& s : sizes)
+    {
+        const auto a = TestFixture::get_matrix(s[0], s[1], 1), b = TestFixture::get_matrix(s[1], s[2], 2);
+        matrix_type c;
+        idlib::multiply(a, b, c);
+        TestFixture::assert_near(c, TestFixture::naive(a, b));
+        TestFixture::assert_near(a * b, c);
+    }
+    const auto a = TestFixture::get_matrix(3, 4, 1);
+    matrix_type c;
+    ASSERT_THROW(idlib::multiply(a, a, c), std::invalid_argument);
+    auto b = TestFixture::get_matrix(4, 4, 1);
+    ASSERT_THROW(idlib::multiply(b, b, b), std::invalid_argument);
+}
+
+TYPED_TEST(dynamic_matrix_test, gemv)
+{
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    const size_t sizes[][2] = { {1, 1}, {3, 5}, {17, 33}, {130, 257} };
+    for (const auto& s : sizes)
+    {
+        const auto a = TestFixture::get_matrix(s[0], s[1], 1);
+        const auto x = TestFixture::get_vector(s[1]);
+        vector_type y;
+        idlib::multiply(a, x, y);
+        ASSERT_EQ(y.dimensionality(), s[0]);
+        for (size_t i = 0; i < s[0]; ++i)
+        {
+            scalar_type e = 0;
+            for (size_t j = 0; j < s[1]; ++j)
+            { e += a(i, j) * x[j]; }
+            ASSERT_NEAR(y[i], e, scalar_type(1e-4) * std::max(scalar_type(1), std::abs(e)));
+        }
+    }
+    vector_type y;
+    ASSERT_THROW(idlib::multiply(TestFixture::get_matrix(3, 4, 1), TestFixture::get_vector(3), y), std::invalid_argument);
+}
+
+TYPED_TEST(dynamic_matrix_test, parallel)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    using vector_type = typename TestFixture::vector_type;
+    const auto a = TestFixture::get_matrix(67, 45, 1), b = TestFixture::get_matrix(45, 39, 2);
+    const auto x = TestFixture::get_vector(45);
+    matrix_type c, d;
+    vector_type y, z;
+    idlib::multiply(a, b, c);
+    idlib::multiply(a, x, y);
+    // The results do not depend on the number of threads.
+    for (size_t number_of_threads : { 2, 3, 8 })
+    {
+        const idlib::execution_policy policy{ number_of_threads, 1 };
+        idlib::multiply(a, b, d, policy);
+        ASSERT_EQ(c, d);
+        idlib::multiply(a, x, z, policy);
+        ASSERT_EQ(y, z);
+    }
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+
+namespace idlib::tests {
+
+template <typename Vector>
+struct expression_test : public ::testing::Test
+{
+    using vector_type = Vector;
+    using scalar_type = typename vector_type::scalar_type;
+
+    static vector_type get_vector(int offset)
+    { return vector_type::generate([offset](size_t i) { return scalar_type(offset + int(i)); }); }
+};
+
+using expression_test_types = ::testing::Types<idlib::vector<single, 3>, idlib::vector<single, 4>,
+                                               idlib::vector<double, 3>, idlib::vector<double, 4>>;
+
+TYPED_TEST_SUITE(expression_test, expression_test_types);
+
+/// @brief Assert lazy evaluation yields the same results as eager evaluation.
+TYPED_TEST(expression_test, lazy_equals_eager)
+{
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    const auto a = TestFixture::get_vector(1), b = TestFixture::get_vector(-3), c = TestFixture::get_vector(7);
+    const scalar_type s = 2;
+    vector_type r;
+    idlib::assign(r, idlib::lazy(a) + idlib::lazy(b) * s - idlib::lazy(c));
+    ASSERT_EQ(r, a + b * s - c);
+    idlib::assign(r, -idlib::lazy(a) + s * idlib::lazy(b) / s);
+    ASSERT_EQ(r, -a + b);
+    idlib::assign(r, a - idlib::lazy(b) + c);
+    ASSERT_EQ(r, a - b + c);
+    vector_type t = idlib::lazy(a) - idlib::lazy(c);
+    ASSERT_EQ(t, a - c);
+    ASSERT_EQ(idlib::evaluate(+idlib::lazy(a) * s), a * s);
+}
+
+/// @brief Assert compound assignment of expressions yields the same results as eager evaluation.
+TYPED_TEST(expression_test, compound_assignment)
+{
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    const auto a = TestFixture::get_vector(1), b = TestFixture::get_vector(-3);
+    const scalar_type s = 3;
+    vector_type r = a;
+    r += idlib::lazy(b) * s;
+    ASSERT_EQ(r, a + b * s);
+    r -= idlib::lazy(b) * s - idlib::lazy(a);
+    ASSERT_EQ(r, a + a);
+}
+
+/// @brief Assert the value assigned to may occur in the expression.
+TYPED_TEST(expression_test, aliasing)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    const auto a = TestFixture::get_vector(2);
+    auto r = a;
+    idlib::assign(r, idlib::lazy(r) * scalar_type(2) + idlib::lazy(r));
+    ASSERT_EQ(r, a * scalar_type(3));
+}
+
+/// @brief Assert lazy evaluation and in place compound assignment of matrices yield the same results as eager evaluation.
+TEST(expression_test, matrix)
+{
+    using matrix_type = idlib::matrix<single, 4, 4>;
+    matrix_type a, b, c;
+    for (size_t i = 0; i < matrix_type::number_of_elements(); ++i)
+    {
+        a(i) = single(i);
+        b(i) = single(int(i) - 8);
+        c(i) = single(int(i % 3));
+    }
+    matrix_type r;
+    idlib::assign(r, idlib::lazy(a) + idlib::lazy(b) * 2.0f - idlib::lazy(c));
+    ASSERT_EQ(r, a + b * 2.0f - c);
+    r = a;
+    r += b;
+    r -= c;
+    r *= 2.0f;
+    r /= 4.0f;
+    ASSERT_EQ(r, (a + b - c) * 2.0f / 4.0f);
+    r = a;
+    r *= b;
+    ASSERT_EQ(r, a * b);
+    r = a;
+    r *= r;
+    ASSERT_EQ(r, a * a);
+}
+
+/// @brief Assert lazy evaluation and in place compound assignment of arrays yield the same results as eager evaluation.
+TEST(expression_test, arithmetic_array)
+{
+    using array_1d_type = idlib::arithmetic_array_1d<double, 5, idlib::zero_functor<double>>;
+    using array_2d_type = idlib::arithmetic_array_2d<double, 3, 2, idlib::zero_functor<double>>;
+    const auto a = array_1d_type::generate([](size_t i) { return double(i); }),
+               b = array_1d_type::generate([](size_t i) { return double(7 - int(i)); });
+    array_1d_type r;
+    idlib::assign(r, idlib::lazy(a) * 2.0 - idlib::lazy(b));
+    ASSERT_EQ(r, a * 2.0 - b);
+    r = a;
+    r += b;
+    r *= 2.0;
+    ASSERT_EQ(r, (a + b) * 2.0);
+    array_2d_type c(1.0, 2.0, 3.0, 4.0, 5.0, 6.0), d(3.0, 2.0, 1.0, 0.0, -1.0, -2.0);
+    c += d;
+    c /= 2.0;
+    ASSERT_EQ(c, array_2d_type(2.0, 2.0, 2.0, 2.0, 2.0, 2.0));
+    array_2d_type e = idlib::lazy(c) - idlib::lazy(d);
+    ASSERT_EQ(e, array_2d_type(-1.0, 0.0, 1.0, 2.0, 3.0, 4.0));
+}
+
+} // namespace idlib::tests
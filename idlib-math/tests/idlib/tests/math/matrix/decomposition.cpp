@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct decomposition_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    static constexpr size_t order = 6;
+    using matrix_type = idlib::matrix<scalar_type, order, order>;
+    using vector_type = idlib::vector<scalar_type, order>;
+    using right_hand_sides_type = idlib::matrix<scalar_type, order, 3>;
+
+    /// @brief Get a regular matrix which requires pivoting.
+    static matrix_type get_matrix()
+    {
+        matrix_type a;
+        for (size_t i = 0; i < order; ++i)
+        {
+            for (size_t j = 0; j < order; ++j)
+            { a(i, j) = scalar_type(int((i * 5 + j * 3) % 7) - 3); }
+        }
+        a(0, 0) = 0;
+        return a;
+    }
+
+    /// @brief Get a symmetric positive definite matrix \f$A^T A + I\f$.
+    static matrix_type get_symmetric_positive_definite_matrix()
+    {
+        const auto a = get_matrix();
+        return idlib::transpose(a) * a + idlib::identity<matrix_type>();
+    }
+
+    static vector_type get_vector()
+    {
+        vector_type b;
+        for (size_t i = 0; i < order; ++i)
+        { b[i] = scalar_type(int(i) - 2); }
+        return b;
+    }
+
+    static right_hand_sides_type get_right_hand_sides()
+    {
+        right_hand_sides_type b;
+        for (size_t i = 0; i < order; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            { b(i, j) = scalar_type(int(i * 3 + j) % 5 - 2); }
+        }
+        return b;
+    }
+
+    static scalar_type tolerance()
+    { return std::is_same<scalar_type, single>::value ? scalar_type(1e-4) : scalar_type(1e-10); }
+
+    template <size_t N, size_t M>
+    static void assert_near(const idlib::matrix<scalar_type, N, M>& a, const idlib::matrix<scalar_type, N, M>& b)
+    {
+        for (size_t i = 0; i < N * M; ++i)
+        { ASSERT_NEAR(a(i), b(i), tolerance() * std::max(scalar_type(1), std::abs(b(i)))); }
+    }
+
+    /// @brief Assert \f$A x = b\f$.
+    static void assert_solution(const matrix_type& a, const vector_type& x, const vector_type& b)
+    {
+        for (size_t i = 0; i < order; ++i)
+        {
+            scalar_type s = 0;
+            for (size_t j = 0; j < order; ++j)
+            { s += a(i, j) * x[j]; }
+            ASSERT_NEAR(s, b[i], tolerance() * std::max(scalar_type(1), std::abs(b[i])));
+        }
+    }
+};
+
+using decomposition_test_types = ::testing::Types<single, double>;
+TYPED_TEST_SUITE(decomposition_test, decomposition_test_types);
+
+TYPED_TEST(decomposition_test, lu_decomposition)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using matrix_type = typename TestFixture::matrix_type;
+    constexpr size_t order = TestFixture::order;
+    const auto a = TestFixture::get_matrix();
+    const idlib::lu_decomposition<scalar_type, order> lu(a);
+    ASSERT_FALSE(lu.is_singular());
+    // P A = L U
+    matrix_type pa;
+    for (size_t i = 0; i < order; ++i)
+    {
+        for (size_t j = 0; j < order; ++j)
+        { pa(i, j) = a(lu.permutation(i), j); }
+    }
+    TestFixture::assert_near(lu.lower() * lu.upper(), pa);
+    // One decomposition, several right-hand sides.
+    const auto b = TestFixture::get_vector();
+    TestFixture::assert_solution(a, lu.solve(b), b);
+    TestFixture::assert_solution(a, lu.solve(b * scalar_type(2)), b * scalar_type(2));
+    TestFixture::assert_solution(a, idlib::solve(a, b), b);
+    const auto c = TestFixture::get_right_hand_sides();
+    TestFixture::assert_near(a * lu.solve(c), c);
+    TestFixture::assert_near(a * idlib::solve(a, c), c);
+    TestFixture::assert_near(a * lu.inverse(), idlib::identity<matrix_type>());
+    // The determinant agrees with the determinant of the matrix.
+    ASSERT_NEAR(lu.determinant(), a.det(), TestFixture::tolerance() * std::abs(a.det()));
+}
+
+TYPED_TEST(decomposition_test, lu_decomposition_singular)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    constexpr size_t order = TestFixture::order;
+    auto a = TestFixture::get_matrix();
+    for (size_t j = 0; j < order; ++j)
+    { a(3, j) = a(1, j) * scalar_type(2); }
+    const idlib::lu_decomposition<scalar_type, order> lu(a);
+    ASSERT_TRUE(lu.is_singular());
+    ASSERT_EQ(lu.determinant(), scalar_type(0));
+    ASSERT_THROW(lu.solve(TestFixture::get_vector()), std::domain_error);
+    ASSERT_THROW(idlib::solve(idlib::matrix<scalar_type, 2, 2>(), idlib::vector<scalar_type, 2>()), std::domain_error);
+}
+
+TYPED_TEST(decomposition_test, cholesky_decomposition)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using matrix_type = typename TestFixture::matrix_type;
+    constexpr size_t order = TestFixture::order;
+    const auto a = TestFixture::get_symmetric_positive_definite_matrix();
+    const idlib::cholesky_decomposition<scalar_type, order> cholesky(a);
+    const auto& l = cholesky.lower();
+    for (size_t i = 0; i < order; ++i)
+    {
+        ASSERT_GT(l(i, i), scalar_type(0));
+        for (size_t j = i + 1; j < order; ++j)
+        { ASSERT_EQ(l(i, j), scalar_type(0)); }
+    }
+    TestFixture::assert_near(l * idlib::transpose(l), a);
+    const auto b = TestFixture::get_vector();
+    TestFixture::assert_solution(a, cholesky.solve(b), b);
+    const auto c = TestFixture::get_right_hand_sides();
+    TestFixture::assert_near(a * cholesky.solve(c), c);
+    TestFixture::assert_near(a * cholesky.inverse(), idlib::identity<matrix_type>());
+    ASSERT_NEAR(cholesky.determinant(), a.det(), TestFixture::tolerance() * std::abs(a.det()));
+    // Not positive definite.
+    ASSERT_THROW((idlib::cholesky_decomposition<scalar_type, order>(-a)), std::domain_error);
+}
+
+TYPED_TEST(decomposition_test, qr_decomposition)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using matrix_type = typename TestFixture::matrix_type;
+    constexpr size_t order = TestFixture::order;
+    const auto a = TestFixture::get_matrix();
+    const idlib::qr_decomposition<scalar_type, order> qr(a);
+    ASSERT_FALSE(qr.is_singular());
+    const auto q = qr.orthogonal(), r = qr.upper();
+    TestFixture::assert_near(idlib::transpose(q) * q, idlib::identity<matrix_type>());
+    for (size_t i = 0; i < order; ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        { ASSERT_EQ(r(i, j), scalar_type(0)); }
+    }
+    TestFixture::assert_near(q * r, a);
+    const auto b = TestFixture::get_vector();
+    TestFixture::assert_solution(a, qr.solve(b), b);
+    const auto c = TestFixture::get_right_hand_sides();
+    TestFixture::assert_near(a * qr.solve(c), c);
+    // A matrix with a zero column is singular.
+    auto s = a;
+    for (size_t i = 0; i < order; ++i)
+    { s(i, 2) = 0; }
+    ASSERT_THROW((idlib::qr_decomposition<scalar_type, order>(s).solve(b)), std::domain_error);
+}
+
+TYPED_TEST(decomposition_test, small_orders)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    // The decompositions agree with the closed forms for small orders.
+    const idlib::matrix<scalar_type, 3, 3> a(2, -1, 0,
+                                             -1, 2, -1,
+                                             0, -1, 2);
+    const idlib::vector<scalar_type, 3> b(1, 0, 1);
+    const auto x = idlib::solve(a, b);
+    for (size_t i = 0; i < 3; ++i)
+    { ASSERT_NEAR(x[i], scalar_type(1), TestFixture::tolerance()); }
+    ASSERT_NEAR((idlib::lu_decomposition<scalar_type, 3>(a).determinant()), a.det(), TestFixture::tolerance());
+    ASSERT_NEAR((idlib::cholesky_decomposition<scalar_type, 3>(a).determinant()), a.det(), TestFixture::tolerance());
+    TestFixture::assert_near(idlib::lu_decomposition<scalar_type, 3>(a).inverse(), a.inverse());
+    TestFixture::assert_near(idlib::qr_decomposition<scalar_type, 3>(a).solve(idlib::identity<idlib::matrix<scalar_type, 3, 3>>()), a.inverse());
+}
+
+TYPED_TEST(decomposition_test, inverse_and_determinant)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    // idlib::matrix::inverse and idlib::matrix::det are available for orders greater than 4.
+    const auto a = TestFixture::get_matrix();
+    TestFixture::assert_near(a * a.inverse(), idlib::identity<matrix_type>());
+    ASSERT_EQ(idlib::identity<matrix_type>().det(), 1);
+    ASSERT_EQ(idlib::identity<matrix_type>().inverse(), idlib::identity<matrix_type>());
+    ASSERT_EQ(matrix_type().det(), 0);
+    ASSERT_THROW(matrix_type().inverse(), std::domain_error);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace idlib::tests {
+
+template <typename Matrix>
+struct matrix_simd_test : public ::testing::Test
+{
+    using matrix_type = Matrix;
+    using element_type = typename matrix_type::element_type;
+
+    /// @brief Get a well-conditioned matrix with non-trivial element values.
+    static matrix_type get_matrix(int offset)
+    {
+        matrix_type m;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            { m(i, j) = element_type((int(i * 7 + j * 3) + offset) % 11 - 5) / element_type(4); }
+            m(i, i) += element_type(6);
+        }
+        return m;
+    }
+
+    /// @brief Get an affine transformation matrix with non-trivial element values.
+    static matrix_type get_affine_matrix(int offset)
+    {
+        matrix_type m = get_matrix(offset);
+        m(3, 0) = m(3, 1) = m(3, 2) = element_type(0);
+        m(3, 3) = element_type(1);
+        return m;
+    }
+
+    static void assert_near(const matrix_type& a, const matrix_type& b)
+    {
+        const element_type epsilon = std::is_same<element_type, single>::value ? element_type(1e-5) : element_type(1e-12);
+        for (size_t i = 0; i < 16; ++i)
+        { ASSERT_NEAR(a(i), b(i), epsilon * (element_type(1) + std::abs(b(i)))); }
+    }
+};
+
+using matrix_simd_test_types = ::testing::Types<idlib::matrix<single, 4, 4>, idlib::matrix<double, 4, 4>>;
+
+TYPED_TEST_SUITE(matrix_simd_test, matrix_simd_test_types);
+
+/// @brief Assert the product yields the same results as its definition
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(matrix_simd_test, product)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    using element_type = typename TestFixture::element_type;
+    const auto a = TestFixture::get_matrix(0), b = TestFixture::get_matrix(5);
+    matrix_type c;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            element_type t = 0;
+            for (size_t k = 0; k < 4; ++k)
+            { t += a(i, k) * b(k, j); }
+            c(i, j) = t;
+        }
+    }
+    TestFixture::assert_near(a * b, c);
+    auto d = a;
+    d *= b;
+    TestFixture::assert_near(d, c);
+    d = a;
+    d *= d;
+    TestFixture::assert_near(d, a * a);
+}
+
+/// @brief Assert the transpose yields the same result as its definition
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(matrix_simd_test, transpose)
+{
+    const auto a = TestFixture::get_matrix(3);
+    const auto b = transpose(a);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        { ASSERT_EQ(a(i, j), b(j, i)); }
+    }
+}
+
+/// @brief Assert the inverse yields the inverse matrix
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(matrix_simd_test, inverse)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    for (int offset = 0; offset < 11; ++offset)
+    {
+        const auto a = TestFixture::get_matrix(offset);
+        const auto b = a.inverse();
+        TestFixture::assert_near(a * b, identity<matrix_type>());
+        TestFixture::assert_near(b * a, identity<matrix_type>());
+    }
+}
+
+/// @brief Assert the inverse of an affine transformation matrix yields the inverse matrix
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(matrix_simd_test, affine_inverse)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    for (int offset = 0; offset < 11; ++offset)
+    {
+        const auto a = TestFixture::get_affine_matrix(offset);
+        const auto b = a.affine_inverse();
+        TestFixture::assert_near(b, a.inverse());
+        TestFixture::assert_near(a * b, identity<matrix_type>());
+    }
+}
+
+/// @brief Assert the inverse of a singular matrix raises an exception.
+TYPED_TEST(matrix_simd_test, inverse_of_singular_matrix)
+{
+    using matrix_type = typename TestFixture::matrix_type;
+    ASSERT_THROW(zero<matrix_type>().inverse(), std::domain_error);
+    ASSERT_THROW(zero<matrix_type>().affine_inverse(), std::domain_error);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib::tests {
+
+TEST(parallel_test, number_of_threads)
+{
+    const auto policy = idlib::execution_policy::parallel(4, 100);
+    ASSERT_EQ(size_t(1), idlib::internal::number_of_threads(0, policy));
+    ASSERT_EQ(size_t(1), idlib::internal::number_of_threads(199, policy));
+    ASSERT_EQ(size_t(2), idlib::internal::number_of_threads(200, policy));
+    ASSERT_EQ(size_t(4), idlib::internal::number_of_threads(100000, policy));
+    ASSERT_EQ(size_t(1), idlib::internal::number_of_threads(100000, idlib::execution_policy::sequential()));
+}
+
+TEST(parallel_test, parallel_for_covers_range)
+{
+    std::vector<std::atomic<int>> visits(1003);
+    idlib::internal::parallel_for(visits.size(), idlib::execution_policy::parallel(5, 10), [&visits](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        { visits[i]++; }
+    });
+    for (const auto& visit : visits)
+    { ASSERT_EQ(1, visit.load()); }
+}
+
+TEST(parallel_test, parallel_for_rethrows)
+{
+    auto f = [](size_t first, size_t)
+    {
+        if (first == 0)
+        { throw std::runtime_error("failure"); }
+    };
+    ASSERT_THROW(idlib::internal::parallel_for(1000, idlib::execution_policy::parallel(4, 10), f), std::runtime_error);
+}
+
+} // namespace idlib::tests
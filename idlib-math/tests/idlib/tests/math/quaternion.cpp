@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct quaternion_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using quaternion_type = idlib::quaternion<scalar_type>;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using matrix_type = idlib::matrix<scalar_type, 4, 4>;
+
+    static matrix_type to_matrix(const idlib::matrix<single, 4, 4>& m)
+    {
+        matrix_type r;
+        for (size_t i = 0; i < 16; ++i)
+        { r(i) = scalar_type(m(i)); }
+        return r;
+    }
+
+    /// @brief Get a unit quaternion with a non-trivial axis and angle.
+    static quaternion_type get_quaternion(int offset)
+    {
+        return quaternion_type(vector_type(scalar_type(1), scalar_type(offset % 3 - 1), scalar_type(2)),
+                               idlib::angle<scalar_type, idlib::degrees>(scalar_type(35 * offset + 20)));
+    }
+
+    static void assert_near(scalar_type a, scalar_type b)
+    { ASSERT_LE(std::abs(a - b), scalar_type(1e-4) * std::max(scalar_type(1), std::abs(b))); }
+
+    static void assert_near(const vector_type& a, const vector_type& b)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        { assert_near(a[i], b[i]); }
+    }
+
+    static void assert_near(const matrix_type& a, const matrix_type& b)
+    {
+        for (size_t i = 0; i < 16; ++i)
+        { assert_near(a(i), b(i)); }
+    }
+
+    /// @brief Assert two unit quaternions represent the same rotation.
+    static void assert_near(const quaternion_type& a, const quaternion_type& b)
+    { assert_near(std::abs(idlib::dot_product(a, b)), scalar_type(1)); }
+};
+
+using quaternion_test_types = ::testing::Types<single, double>;
+TYPED_TEST_SUITE(quaternion_test, quaternion_test_types);
+
+TYPED_TEST(quaternion_test, rotation_matrix)
+{
+    using fixture = quaternion_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    using quaternion_type = typename fixture::quaternion_type;
+    const idlib::vector<single, 3> axis(1.0f, -2.0f, 0.5f);
+    const idlib::vector<TypeParam, 3> axis_(1, -2, 0.5);
+    for (int i = -4; i < 8; ++i)
+    {
+        const single a = 50.0f * single(i);
+        const auto m = fixture::to_matrix(idlib::rotation_matrix(axis, idlib::angle<single, idlib::degrees>(a)));
+        const quaternion_type q(axis_, idlib::angle<TypeParam, idlib::degrees>(TypeParam(a)));
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(q), m);
+        fixture::assert_near(idlib::semantic_cast<quaternion_type>(m), q);
+    }
+    fixture::assert_near(idlib::semantic_cast<matrix_type>(quaternion_type(idlib::vector<TypeParam, 3>(1, 0, 0), idlib::angle<TypeParam, idlib::turns>(TypeParam(0.25)))),
+                         fixture::to_matrix(idlib::rotation_matrix_x(idlib::angle<single, idlib::turns>(0.25f))));
+    fixture::assert_near(idlib::semantic_cast<matrix_type>(quaternion_type(idlib::vector<TypeParam, 3>(0, 0, 1), idlib::angle<TypeParam, idlib::radians>(TypeParam(1)))),
+                         fixture::to_matrix(idlib::rotation_matrix_z(idlib::angle<single, idlib::radians>(1.0f))));
+    ASSERT_THROW(quaternion_type(idlib::vector<TypeParam, 3>(), idlib::angle<TypeParam, idlib::radians>(TypeParam(1))), std::invalid_argument);
+}
+
+TYPED_TEST(quaternion_test, axis_and_angle)
+{
+    using fixture = quaternion_test<TypeParam>;
+    using vector_type = typename fixture::vector_type;
+    const typename fixture::quaternion_type q(vector_type(0, 3, 4), idlib::angle<TypeParam, idlib::radians>(TypeParam(2)));
+    fixture::assert_near(q.rotation_axis(), vector_type(0, TypeParam(0.6), TypeParam(0.8)));
+    fixture::assert_near(q.rotation_angle().get_value(), TypeParam(2));
+    fixture::assert_near(idlib::identity<typename fixture::quaternion_type>().rotation_angle().get_value(), TypeParam(0));
+}
+
+TYPED_TEST(quaternion_test, rotation_and_composition)
+{
+    using fixture = quaternion_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    const auto a = fixture::get_quaternion(1), b = fixture::get_quaternion(2);
+    const typename fixture::vector_type v(1, -2, 3);
+    const auto m = idlib::semantic_cast<matrix_type>(a), n = idlib::semantic_cast<matrix_type>(b);
+    const auto w = a * v;
+    for (size_t i = 0; i < 3; ++i)
+    { fixture::assert_near(w[i], m(i, 0) * v[0] + m(i, 1) * v[1] + m(i, 2) * v[2]); }
+    fixture::assert_near(idlib::semantic_cast<matrix_type>(a * b), m * n);
+    auto c = a;
+    c *= b;
+    ASSERT_EQ(a * b, c);
+    fixture::assert_near(a * (a.inverse() * v), v);
+    fixture::assert_near(a.conjugate() * a, idlib::identity<typename fixture::quaternion_type>());
+    ASSERT_THROW(typename fixture::quaternion_type(0, 0, 0, 0).inverse(), std::domain_error);
+}
+
+TYPED_TEST(quaternion_test, interpolation)
+{
+    using fixture = quaternion_test<TypeParam>;
+    using quaternion_type = typename fixture::quaternion_type;
+    using vector_type = typename fixture::vector_type;
+    const vector_type axis(1, 2, -1);
+    const quaternion_type a(axis, idlib::angle<TypeParam, idlib::degrees>(TypeParam(10))),
+                          b(axis, idlib::angle<TypeParam, idlib::degrees>(TypeParam(130)));
+    for (int i = 0; i <= 4; ++i)
+    {
+        const TypeParam t = TypeParam(i) / TypeParam(4);
+        // The angular velocity of slerp is constant.
+        fixture::assert_near(idlib::slerp(a, b, t), quaternion_type(axis, idlib::angle<TypeParam, idlib::degrees>(TypeParam(10) + t * TypeParam(120))));
+        // The shorter arc is interpolated.
+        fixture::assert_near(idlib::slerp(a, -b, t), idlib::slerp(a, b, t));
+        fixture::assert_near(idlib::nlerp(a, -b, t), idlib::nlerp(a, b, t));
+        fixture::assert_near(idlib::nlerp(a, b, t).norm(), TypeParam(1));
+    }
+    fixture::assert_near(idlib::nlerp(a, b, TypeParam(0.5)), idlib::slerp(a, b, TypeParam(0.5)));
+    fixture::assert_near(idlib::slerp(a, a, TypeParam(0.5)), a);
+}
+
+TYPED_TEST(quaternion_test, batched)
+{
+    using fixture = quaternion_test<TypeParam>;
+    using quaternion_type = typename fixture::quaternion_type;
+    using vector_type = typename fixture::vector_type;
+    const size_t count = 101;
+    std::vector<quaternion_type> a, b, c(count), d(count);
+    std::vector<vector_type> v, w(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        a.push_back(fixture::get_quaternion(int(i)));
+        b.push_back(i % 2 ? -fixture::get_quaternion(int(i) + 3) : fixture::get_quaternion(int(i) + 3));
+        v.push_back(vector_type(TypeParam(i), TypeParam(1), TypeParam(i % 5)));
+    }
+    const TypeParam t = TypeParam(0.3);
+    idlib::nlerp(a.data(), b.data(), count, t, c.data());
+    idlib::slerp(a.data(), b.data(), count, t, d.data(), idlib::execution_policy::parallel(3, 8));
+    idlib::rotate_vectors(a[7], v.data(), count, w.data());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto x = idlib::nlerp(a[i], b[i], t);
+        for (size_t j = 0; j < 4; ++j)
+        { fixture::assert_near(c[i](j), x(j)); }
+        ASSERT_EQ(idlib::slerp(a[i], b[i], t), d[i]);
+        fixture::assert_near(w[i], a[7] * v[i]);
+    }
+    // In place.
+    idlib::nlerp(a.data(), b.data(), count, t, a.data(), idlib::execution_policy::parallel(3, 8));
+    ASSERT_EQ(c, a);
+}
+
+} // namespace idlib::tests
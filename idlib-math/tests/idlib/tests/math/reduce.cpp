@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct reduce_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+
+    /// @brief Get an array of points.
+    /// The number of points is not a multiple of the block size and the width of the SIMD packs.
+    static std::vector<point_type> get_points(size_t count = 3 * 4096 + 7)
+    {
+        std::vector<point_type> points(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            points[i] = point_type(scalar_type(int((i * 7919) % 1000) - 500) / scalar_type(8),
+                                   scalar_type(int((i * 104729) % 777) - 300) / scalar_type(16),
+                                   scalar_type(int((i * 31) % 1013)) / scalar_type(4));
+        }
+        return points;
+    }
+};
+
+using reduce_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(reduce_test, reduce_test_types);
+
+TYPED_TEST(reduce_test, bounds)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    for (size_t count : { size_t(1), size_t(2), size_t(7), size_t(4096), size_t(3 * 4096 + 7) })
+    {
+        const auto points = fixture::get_points(count);
+        point_type a = points[0], b = points[0];
+        for (const auto& p : points)
+        {
+            a = idlib::zip_min(a, p);
+            b = idlib::zip_max(b, p);
+        }
+        const auto r = idlib::bounds(points.data(), points.size());
+        ASSERT_EQ(a, idlib::zip_min(points.data(), points.size()));
+        ASSERT_EQ(b, idlib::zip_max(points.data(), points.size()));
+        ASSERT_EQ(a, r.first);
+        ASSERT_EQ(b, r.second);
+    }
+}
+
+TYPED_TEST(reduce_test, sum_and_centroid)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    using vector_type = typename fixture::vector_type;
+    using point_type = typename fixture::point_type;
+    const auto points = fixture::get_points();
+    std::vector<vector_type> vectors;
+    long double s[3] = { 0.0L, 0.0L, 0.0L };
+    for (const auto& p : points)
+    {
+        vectors.push_back(p - point_type());
+        for (size_t j = 0; j < 3; ++j)
+        { s[j] += p[j]; }
+    }
+    const auto v = idlib::sum(vectors.data(), vectors.size());
+    const auto c = idlib::centroid(points.data(), points.size());
+    for (size_t j = 0; j < 3; ++j)
+    {
+        const long double bound = std::abs(s[j]) * std::numeric_limits<scalar_type>::epsilon() * 16;
+        ASSERT_LE(std::abs(v[j] - s[j]), bound);
+        ASSERT_LE(std::abs(c[j] - s[j] / points.size()), bound / points.size());
+    }
+    ASSERT_EQ(vector_type(), idlib::sum(vectors.data(), 0));
+}
+
+TYPED_TEST(reduce_test, deterministic)
+{
+    using fixture = TestFixture;
+    const auto points = fixture::get_points(10 * 4096 + 3);
+    const auto c = idlib::centroid(points.data(), points.size());
+    const auto b = idlib::bounds(points.data(), points.size());
+    for (size_t n = 1; n <= 7; ++n)
+    {
+        const auto policy = idlib::execution_policy::parallel(n, 1);
+        ASSERT_EQ(c, idlib::centroid(points.data(), points.size(), policy));
+        ASSERT_EQ(b, idlib::bounds(points.data(), points.size(), policy));
+    }
+}
+
+TYPED_TEST(reduce_test, empty)
+{
+    using fixture = TestFixture;
+    using point_type = typename fixture::point_type;
+    const point_type *p = nullptr;
+    ASSERT_THROW(idlib::zip_min(p, 0), std::invalid_argument);
+    ASSERT_THROW(idlib::zip_max(p, 0), std::invalid_argument);
+    ASSERT_THROW(idlib::bounds(p, 0), std::invalid_argument);
+    ASSERT_THROW(idlib::centroid(p, 0), std::invalid_argument);
+}
+
+TEST(reduce_test, dimensionalities)
+{
+    const std::vector<idlib::vector<int, 2>> u = { { 1, -2 }, { -3, 4 }, { 5, 0 } };
+    ASSERT_EQ((idlib::vector<int, 2>(-3, -2)), idlib::zip_min(u.data(), u.size()));
+    ASSERT_EQ((idlib::vector<int, 2>(3, 2)), idlib::sum(u.data(), u.size()));
+    std::vector<idlib::vector<single, 4>> v;
+    for (int i = 0; i < 100; ++i)
+    { v.emplace_back(single(i), single(-i), single(i % 10), single(1)); }
+    const auto r = idlib::bounds(v.data(), v.size());
+    ASSERT_EQ((idlib::vector<single, 4>(0.0f, -99.0f, 0.0f, 1.0f)), r.first);
+    ASSERT_EQ((idlib::vector<single, 4>(99.0f, 0.0f, 9.0f, 1.0f)), r.second);
+    ASSERT_EQ((idlib::vector<single, 4>(4950.0f, -4950.0f, 450.0f, 100.0f)), idlib::sum(v.data(), v.size()));
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct sincos_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+
+    /// @brief The bound of the absolute error for angles in turns.
+    static scalar_type get_bound()
+    { return std::ldexp(scalar_type(1), std::is_same<scalar_type, single>::value ? -23 : -52); }
+
+    /// @brief Assert the absolute errors of the sine and the cosine of an angle are within the specified bound.
+    /// @param x the angle value
+    /// @param turns the angle value in turns
+    template <typename Semantics>
+    static void check(scalar_type x, long double turns, scalar_type bound)
+    {
+        const auto r = idlib::sincos(idlib::angle<scalar_type, Semantics>(x));
+        const long double a = turns * 6.283185307179586476925286766559L;
+        ASSERT_LE(std::abs(r.first - std::sin(a)), bound) << x;
+        ASSERT_LE(std::abs(r.second - std::cos(a)), bound) << x;
+    }
+};
+
+using sincos_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(sincos_test, sincos_test_types);
+
+TYPED_TEST(sincos_test, turns)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    for (int i = -100000; i <= 100000; ++i)
+    {
+        const scalar_type x = scalar_type(i) / scalar_type(8192) + scalar_type(i % 7) / scalar_type(65536);
+        fixture::template check<idlib::turns>(x, x, fixture::get_bound());
+    }
+}
+
+TYPED_TEST(sincos_test, degrees_and_radians)
+{
+    using fixture = TestFixture;
+    using scalar_type = typename fixture::scalar_type;
+    const scalar_type e = std::numeric_limits<scalar_type>::epsilon();
+    for (int i = -10000; i <= 10000; ++i)
+    {
+        const scalar_type d = scalar_type(i) / scalar_type(16), r = scalar_type(i) / scalar_type(1024);
+        const long double td = (long double)d / 360.0L, tr = (long double)r / 6.283185307179586476925286766559L;
+        fixture::template check<idlib::degrees>(d, td, fixture::get_bound() + scalar_type(8) * std::abs(scalar_type(td)) * e);
+        fixture::template check<idlib::radians>(r, tr, fixture::get_bound() + scalar_type(8) * std::abs(scalar_type(tr)) * e);
+    }
+}
+
+TYPED_TEST(sincos_test, exact_values)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using angle_type = idlib::angle<scalar_type, idlib::degrees>;
+    const std::pair<scalar_type, scalar_type> expected[] = { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 } };
+    for (int i = -8; i <= 8; ++i)
+    {
+        const auto r = idlib::sincos(angle_type(scalar_type(90 * i)));
+        ASSERT_EQ(r.first, expected[(i + 8) % 4].first);
+        ASSERT_EQ(r.second, expected[(i + 8) % 4].second);
+    }
+    // Angles in turns of a large magnitude are whole numbers of turns.
+    const auto r = idlib::sincos(idlib::angle<scalar_type, idlib::turns>(std::ldexp(scalar_type(3), 60)));
+    ASSERT_EQ(r.first, scalar_type(0));
+    ASSERT_EQ(r.second, scalar_type(1));
+    // Angles in turns of a magnitude below 2^p, where p + 1 is the number of digits, can be half-integers.
+    const int p = std::numeric_limits<scalar_type>::digits - 1;
+    for (const scalar_type x : { std::ldexp(scalar_type(1), p - 1) + scalar_type(0.5),
+                                 std::ldexp(scalar_type(1), p - 1) + std::ldexp(scalar_type(1), p - 3) + scalar_type(0.5),
+                                 std::ldexp(scalar_type(1), p) - scalar_type(0.5) })
+    {
+        for (const scalar_type y : { x, -x })
+        {
+            const auto h = idlib::sincos(idlib::angle<scalar_type, idlib::turns>(y));
+            ASSERT_EQ(h.first, scalar_type(0));
+            ASSERT_EQ(h.second, scalar_type(-1));
+        }
+    }
+}
+
+TYPED_TEST(sincos_test, batch)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using angle_type = idlib::angle<scalar_type, idlib::radians>;
+    std::vector<angle_type> x;
+    for (int i = 0; i < 1003; ++i)
+    { x.emplace_back(scalar_type(i - 500) / scalar_type(37)); }
+    std::vector<scalar_type> s(x.size()), c(x.size());
+    // The batch and the scalar code path execute the same operations but may be contracted differently.
+    const scalar_type e = scalar_type(4) * std::numeric_limits<scalar_type>::epsilon();
+    for (const auto& policy : { idlib::execution_policy::sequential(), idlib::execution_policy::parallel(4, 100) })
+    {
+        idlib::sincos(x.data(), x.size(), s.data(), c.data(), policy);
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            const auto r = idlib::sincos(x[i]);
+            ASSERT_NEAR(s[i], r.first, e);
+            ASSERT_NEAR(c[i], r.second, e);
+        }
+    }
+}
+
+} // namespace idlib::tests
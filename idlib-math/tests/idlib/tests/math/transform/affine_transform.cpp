@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct affine_transform_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using transform_type = idlib::affine_transform<scalar_type>;
+    using matrix_type = idlib::matrix<scalar_type, 4, 4>;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+
+    /// @brief Get an affine transformation matrix with a non-orthonormal linear part.
+    static matrix_type get_matrix(int offset)
+    {
+        matrix_type m;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            { m(i, j) = scalar_type((int(i * 7 + j * 3) + offset) % 11 - 5) / scalar_type(4); }
+            m(i, i) += scalar_type(3);
+        }
+        m(3, 3) = scalar_type(1);
+        return m;
+    }
+
+    /// @brief Get a rigid transformation matrix.
+    static matrix_type get_rigid_matrix(int offset)
+    {
+        const auto s = idlib::translation_matrix(idlib::vector<single, 3>(single(offset), -2.0f, 0.5f))
+                     * idlib::rotation_matrix_y(idlib::angle<single, idlib::degrees>(single(10 * offset)))
+                     * idlib::rotation_matrix_x(idlib::angle<single, idlib::degrees>(single(25 + offset)));
+        matrix_type m;
+        for (size_t i = 0; i < 16; ++i)
+        { m(i) = scalar_type(s(i)); }
+        return m;
+    }
+
+    static transform_type to_transform(const matrix_type& m)
+    { return idlib::semantic_cast<transform_type>(m); }
+
+    static void assert_near(const matrix_type& a, const matrix_type& b)
+    {
+        for (size_t i = 0; i < 16; ++i)
+        { ASSERT_LE(std::abs(a(i) - b(i)), scalar_type(1e-4) * std::max(scalar_type(1), std::abs(b(i)))) << "element " << i; }
+    }
+};
+
+using affine_transform_test_types = ::testing::Types<single, double>;
+TYPED_TEST_SUITE(affine_transform_test, affine_transform_test_types);
+
+TYPED_TEST(affine_transform_test, conversion)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    const auto m = fixture::get_matrix(1);
+    const auto a = fixture::to_transform(m);
+    ASSERT_EQ(m, idlib::semantic_cast<matrix_type>(a));
+    ASSERT_EQ(idlib::identity<matrix_type>(), idlib::semantic_cast<matrix_type>(idlib::identity<typename fixture::transform_type>()));
+    ASSERT_EQ(a, typename fixture::transform_type(a.linear(), a.translation()));
+}
+
+TYPED_TEST(affine_transform_test, composition)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    const auto m = fixture::get_matrix(1), n = fixture::get_matrix(4);
+    const auto a = fixture::to_transform(m), b = fixture::to_transform(n);
+    fixture::assert_near(idlib::semantic_cast<matrix_type>(a * b), m * n);
+    auto c = a;
+    c *= b;
+    ASSERT_EQ(a * b, c);
+    c = a;
+    c *= c;
+    ASSERT_EQ(a * a, c);
+}
+
+TYPED_TEST(affine_transform_test, application)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    using point_type = typename fixture::point_type;
+    using vector_type = typename fixture::vector_type;
+    const auto m = fixture::get_matrix(2);
+    const auto a = fixture::to_transform(m);
+    const point_type p(TypeParam(1), TypeParam(-2), TypeParam(3));
+    const vector_type v(TypeParam(1), TypeParam(-2), TypeParam(3));
+    const point_type q = a * p;
+    const vector_type w = a * v;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(m(i, 0) * p[0] + m(i, 1) * p[1] + m(i, 2) * p[2] + m(i, 3), q[i]);
+        ASSERT_EQ(m(i, 0) * v[0] + m(i, 1) * v[1] + m(i, 2) * v[2], w[i]);
+    }
+}
+
+TYPED_TEST(affine_transform_test, inverse)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    for (int offset = 0; offset < 4; ++offset)
+    {
+        const auto m = fixture::get_matrix(offset);
+        const auto a = fixture::to_transform(m);
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(a.inverse()), m.inverse());
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(a.inverse(std::false_type{})), m.inverse());
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(idlib::inverse(a) * a), idlib::identity<matrix_type>());
+    }
+}
+
+TYPED_TEST(affine_transform_test, orthonormal_inverse)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    using matrix_type = typename fixture::matrix_type;
+    for (int offset = 0; offset < 4; ++offset)
+    {
+        const auto m = fixture::get_rigid_matrix(offset);
+        const auto a = fixture::to_transform(m);
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(a.orthonormal_inverse()), m.inverse());
+        fixture::assert_near(idlib::semantic_cast<matrix_type>(a.orthonormal_inverse(std::false_type{})), m.inverse());
+    }
+}
+
+TYPED_TEST(affine_transform_test, inverse_of_singular_transformation)
+{
+    using fixture = affine_transform_test<TypeParam>;
+    auto m = fixture::get_matrix(3);
+    for (size_t j = 0; j < 3; ++j)
+    { m(2, j) = m(0, j) + m(1, j); }
+    const auto a = fixture::to_transform(m);
+    ASSERT_THROW(a.inverse(), std::domain_error);
+    ASSERT_THROW(a.inverse(std::false_type{}), std::domain_error);
+}
+
+TEST(affine_transform_test, constant_expression)
+{
+    using transform_type = idlib::affine_transform<single>;
+    constexpr transform_type a(idlib::matrix<single, 3, 3>(2.0f, 0.0f, 0.0f,
+                                                           0.0f, 4.0f, 0.0f,
+                                                           0.0f, 0.0f, 8.0f),
+                               idlib::vector<single, 3>(1.0f, 2.0f, 3.0f));
+    constexpr transform_type b = a * a.inverse();
+    static_assert(b == idlib::identity<transform_type>(), "a * a^-1 is not the identity");
+    static_assert((a * idlib::point<idlib::vector<single, 3>>(1.0f, 1.0f, 1.0f))[2] == 11.0f, "wrong application");
+}
+
+} // namespace idlib::tests
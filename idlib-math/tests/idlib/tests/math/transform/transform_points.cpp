@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace idlib::tests {
+
+template <typename Scalar>
+struct transform_points_test : public ::testing::Test
+{
+    using scalar_type = Scalar;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    using point_type = idlib::point<vector_type>;
+    using matrix_type = idlib::matrix<scalar_type, 4, 4>;
+
+    /// @brief Get a transformation matrix with a projective last row.
+    static matrix_type get_matrix()
+    {
+        const auto s = idlib::perspective_projection_matrix(idlib::angle<single, idlib::degrees>(60.0f), 1.5f, 0.5f, 100.0f)
+                     * idlib::translation_matrix(idlib::vector<single, 3>(1.0f, -2.0f, -10.0f))
+                     * idlib::rotation_matrix_y(idlib::angle<single, idlib::degrees>(30.0f));
+        matrix_type m;
+        for (size_t i = 0; i < 16; ++i)
+        { m(i) = scalar_type(s(i)); }
+        return m;
+    }
+
+    /// @brief Get the affine part of get_matrix().
+    static matrix_type get_affine_matrix()
+    {
+        matrix_type m = get_matrix();
+        m(3, 0) = m(3, 1) = m(3, 2) = scalar_type(0);
+        m(3, 3) = scalar_type(1);
+        return m;
+    }
+
+    static std::vector<point_type> get_points(size_t count)
+    {
+        std::vector<point_type> points;
+        for (size_t i = 0; i < count; ++i)
+        {
+            points.emplace_back(scalar_type(int(i % 7) - 3), scalar_type(int(i % 5) - 2) / scalar_type(2), scalar_type(int(i % 11)));
+        }
+        return points;
+    }
+
+    /// @brief Compute \f$M(x,y,z,w)\f$.
+    static std::array<scalar_type, 4> multiply(const matrix_type& m, scalar_type x, scalar_type y, scalar_type z, scalar_type w)
+    {
+        std::array<scalar_type, 4> r;
+        for (size_t i = 0; i < 4; ++i)
+        { r[i] = m(i, 0) * x + m(i, 1) * y + m(i, 2) * z + m(i, 3) * w; }
+        return r;
+    }
+
+    static void assert_near(scalar_type a, scalar_type b)
+    { ASSERT_LE(std::abs(a - b), scalar_type(1e-4) * std::max(scalar_type(1), std::abs(b))); }
+};
+
+using transform_points_test_types = ::testing::Types<single, double>;
+TYPED_TEST_SUITE(transform_points_test, transform_points_test_types);
+
+TYPED_TEST(transform_points_test, transform_points)
+{
+    using fixture = transform_points_test<TypeParam>;
+    const auto m = fixture::get_affine_matrix();
+    const auto source = fixture::get_points(37);
+    std::vector<typename fixture::point_type> target(source.size());
+    idlib::transform_points(m, source.data(), source.size(), target.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const auto& p = source[i];
+        const auto r = fixture::multiply(m, p.x(), p.y(), p.z(), TypeParam(1));
+        for (size_t j = 0; j < 3; ++j)
+        { fixture::assert_near(target[i][j], r[j]); }
+    }
+}
+
+TYPED_TEST(transform_points_test, transform_vectors)
+{
+    using fixture = transform_points_test<TypeParam>;
+    const auto m = fixture::get_affine_matrix();
+    const auto points = fixture::get_points(37);
+    std::vector<typename fixture::vector_type> source, target(points.size());
+    for (const auto& p : points)
+    { source.push_back(p - typename fixture::point_type()); }
+    idlib::transform_vectors(m, source.data(), source.size(), target.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const auto& v = source[i];
+        const auto r = fixture::multiply(m, v.x(), v.y(), v.z(), TypeParam(0));
+        for (size_t j = 0; j < 3; ++j)
+        { fixture::assert_near(target[i][j], r[j]); }
+    }
+}
+
+TYPED_TEST(transform_points_test, project_points)
+{
+    using fixture = transform_points_test<TypeParam>;
+    const auto m = fixture::get_matrix();
+    const auto source = fixture::get_points(37);
+    std::vector<typename fixture::point_type> target(source.size());
+    idlib::project_points(m, source.data(), source.size(), target.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const auto& p = source[i];
+        const auto r = fixture::multiply(m, p.x(), p.y(), p.z(), TypeParam(1));
+        for (size_t j = 0; j < 3; ++j)
+        { fixture::assert_near(target[i][j], r[j] / r[3]); }
+    }
+}
+
+TYPED_TEST(transform_points_test, in_place)
+{
+    using fixture = transform_points_test<TypeParam>;
+    const auto m = fixture::get_matrix();
+    const auto source = fixture::get_points(37);
+    std::vector<typename fixture::point_type> expected(source.size()), actual = source;
+    idlib::project_points(m, source.data(), source.size(), expected.data());
+    idlib::project_points(m, actual.data(), actual.size(), actual.data());
+    ASSERT_EQ(expected, actual);
+}
+
+TYPED_TEST(transform_points_test, parallel)
+{
+    using fixture = transform_points_test<TypeParam>;
+    const auto m = fixture::get_matrix();
+    const auto source = fixture::get_points(1001);
+    std::vector<typename fixture::point_type> expected(source.size()), actual(source.size());
+    idlib::project_points(m, source.data(), source.size(), expected.data());
+    idlib::project_points(m, source.data(), source.size(), actual.data(), idlib::execution_policy::parallel(4, 16));
+    ASSERT_EQ(expected, actual);
+}
+
+TYPED_TEST(transform_points_test, empty)
+{
+    using fixture = transform_points_test<TypeParam>;
+    idlib::transform_points(fixture::get_matrix(), static_cast<const typename fixture::point_type *>(nullptr), 0,
+                            static_cast<typename fixture::point_type *>(nullptr), idlib::execution_policy::parallel(4, 1));
+}
+
+} // namespace idlib::tests
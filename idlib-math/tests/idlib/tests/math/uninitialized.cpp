@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <vector>
+
+namespace idlib::tests {
+
+namespace {
+
+struct counting_element
+{
+    static size_t number_of_uninitialized_constructions;
+    static size_t number_of_default_constructions;
+
+    int value;
+
+    counting_element() : value(0)
+    { number_of_default_constructions++; }
+
+    explicit counting_element(uninitialized_t)
+    { number_of_uninitialized_constructions++; }
+};
+
+size_t counting_element::number_of_uninitialized_constructions = 0;
+size_t counting_element::number_of_default_constructions = 0;
+
+} // namespace
+
+static_assert(is_uninitialized_constructible<vector<single, 3>>::value, "vector<single, 3> must be uninitialized constructible");
+static_assert(is_uninitialized_constructible<point<vector<single, 3>>>::value, "point<vector<single, 3>> must be uninitialized constructible");
+static_assert(is_uninitialized_constructible<matrix<single, 4, 4>>::value, "matrix<single, 4, 4> must be uninitialized constructible");
+static_assert(is_uninitialized_constructible<arithmetic_array_2d<single, 3, 3, zero_functor<single>>>::value, "arithmetic_array_2d<single, 3, 3> must be uninitialized constructible");
+static_assert(is_uninitialized_constructible<int>::value, "int must be uninitialized constructible");
+static_assert(!std::is_convertible<uninitialized_t, vector<single, 3>>::value, "uninitialized construction must be explicit");
+
+TEST(uninitialized, vector)
+{
+    using vector_type = vector<single, 3>;
+    vector_type v(uninitialized);
+    v = vector_type(1.0f, 2.0f, 3.0f);
+    ASSERT_EQ(v, vector_type(1.0f, 2.0f, 3.0f));
+}
+
+TEST(uninitialized, point)
+{
+    using point_type = point<vector<single, 3>>;
+    point_type p(uninitialized);
+    p = point_type(1.0f, 2.0f, 3.0f);
+    ASSERT_EQ(p, point_type(1.0f, 2.0f, 3.0f));
+}
+
+TEST(uninitialized, matrix)
+{
+    using matrix_type = matrix<single, 4, 4>;
+    matrix_type m(uninitialized);
+    m = identity<matrix_type>();
+    ASSERT_EQ(m, identity<matrix_type>());
+}
+
+TEST(uninitialized, resize)
+{
+    using vector_type = vector<single, 3>;
+    std::vector<vector_type, uninitialized_allocator<vector_type>> vs;
+    vs.resize(128);
+    for (size_t i = 0; i < vs.size(); ++i)
+    { vs[i] = vector_type(single(i), 0.0f, 0.0f); }
+    vs.resize(256);
+    for (size_t i = 0; i < 128; ++i)
+    { ASSERT_EQ(vs[i], vector_type(single(i), 0.0f, 0.0f)); }
+    vs.emplace_back(1.0f, 2.0f, 3.0f);
+    ASSERT_EQ(vs.back(), vector_type(1.0f, 2.0f, 3.0f));
+}
+
+TEST(uninitialized, allocator_uses_tag_constructor)
+{
+    counting_element::number_of_uninitialized_constructions = 0;
+    counting_element::number_of_default_constructions = 0;
+    std::vector<counting_element, uninitialized_allocator<counting_element>> xs;
+    xs.resize(16);
+    ASSERT_EQ(16u, counting_element::number_of_uninitialized_constructions);
+    ASSERT_EQ(0u, counting_element::number_of_default_constructions);
+    std::vector<counting_element> ys;
+    ys.resize(16);
+    ASSERT_EQ(16u, counting_element::number_of_default_constructions);
+}
+
+} // namespace idlib::tests
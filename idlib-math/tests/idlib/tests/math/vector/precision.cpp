@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+#include <cmath>
+#include <vector>
+
+namespace idlib::tests {
+
+namespace {
+
+template <idlib::precision P>
+single max_relative_error()
+{ return P == idlib::precision::exact ? 2.5e-7f : (P == idlib::precision::newton_raphson ? 9.5e-7f : 3.7e-4f); }
+
+template <typename Scalar>
+std::vector<Scalar> get_arguments()
+{
+    std::vector<Scalar> x;
+    // Cover several binades including subnormal-free small and large arguments.
+    for (int e = -30; e <= 30; ++e)
+    {
+        for (int i = 0; i < 64; ++i)
+        { x.push_back(std::ldexp(Scalar(1) + Scalar(i) / Scalar(64), e)); }
+    }
+    return x;
+}
+
+template <idlib::precision P>
+void test_rsqrt()
+{
+    for (auto x : get_arguments<single>())
+    {
+        const double e = 1.0 / std::sqrt(double(x));
+        ASSERT_LE(std::abs(idlib::rsqrt<P>(x) - e) / e, max_relative_error<P>()) << x;
+        ASSERT_LE(std::abs(idlib::sqrt<P>(x) - 1.0 / e) * e, max_relative_error<P>()) << x;
+    }
+    ASSERT_EQ(idlib::sqrt<P>(0.0f), 0.0f);
+    // All policies are exact for double.
+    for (auto x : get_arguments<double>())
+    {
+        ASSERT_EQ(idlib::rsqrt<P>(x), 1.0 / std::sqrt(x));
+        ASSERT_EQ(idlib::sqrt<P>(x), std::sqrt(x));
+    }
+}
+
+} // namespace
+
+TEST(precision_test, sqrt)
+{
+    ASSERT_EQ(idlib::sqrt(4.0f), 2.0f);
+    ASSERT_EQ(idlib::sqrt(9.0), 3.0);
+    ASSERT_EQ(idlib::sqrt(2.0f), std::sqrt(2.0f));
+}
+
+TEST(precision_test, rsqrt)
+{
+    test_rsqrt<idlib::precision::exact>();
+    test_rsqrt<idlib::precision::newton_raphson>();
+    test_rsqrt<idlib::precision::estimate>();
+}
+
+TEST(precision_test, euclidean_norm_and_normalize)
+{
+    using vector_type = idlib::vector<single, 3>;
+    const vector_type v(3.0f, -4.0f, 12.0f);
+    ASSERT_EQ(idlib::euclidean_norm(v), 13.0f);
+    ASSERT_EQ(idlib::euclidean_norm<idlib::precision::exact>(v), 13.0f);
+    ASSERT_NEAR(idlib::euclidean_norm<idlib::precision::newton_raphson>(v), 13.0f, 13.0f * 9.5e-7f);
+    ASSERT_NEAR(idlib::euclidean_norm<idlib::precision::estimate>(v), 13.0f, 13.0f * 3.7e-4f);
+    ASSERT_EQ(idlib::euclidean_norm<idlib::precision::estimate>(idlib::zero<vector_type>()), 0.0f);
+
+    const auto exact = idlib::normalize(v, idlib::euclidean_norm_functor<vector_type>()).get_vector();
+    const auto refined = idlib::normalize(v, idlib::euclidean_norm_functor<vector_type, idlib::precision::newton_raphson>()).get_vector();
+    const auto estimated = idlib::normalize(v, idlib::euclidean_norm_functor<vector_type, idlib::precision::estimate>()).get_vector();
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(exact[i], v[i] / 13.0f);
+        ASSERT_NEAR(refined[i], exact[i], 9.5e-7f);
+        ASSERT_NEAR(estimated[i], exact[i], 3.7e-4f);
+    }
+    // Zero vectors cannot be normalized.
+    const auto r = idlib::normalize(idlib::zero<vector_type>(), idlib::euclidean_norm_functor<vector_type, idlib::precision::estimate>());
+    ASSERT_EQ(r.get_length(), 0.0f);
+    ASSERT_THROW(r.get_vector(), std::domain_error);
+}
+
+TEST(precision_test, vector_batch)
+{
+    using vector_type = idlib::vector<single, 3>;
+    std::vector<vector_type> source;
+    for (size_t i = 0; i < 37; ++i)
+    { source.emplace_back(single(int(i % 5) - 2), single(int(i % 7) - 3) * 10.0f, single(i % 3)); }
+    source[5] = idlib::zero<vector_type>();
+    idlib::vector_batch<single, 3> batch(source.data(), source.size()), normalized;
+    std::vector<single> norms(source.size());
+
+    idlib::normalize<idlib::precision::newton_raphson>(batch, normalized);
+    idlib::euclidean_norm<idlib::precision::newton_raphson>(batch, norms.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const auto e = idlib::normalize(source[i], idlib::euclidean_norm_functor<vector_type>()).get_vector_or_default();
+        const auto n = idlib::euclidean_norm(source[i]);
+        for (size_t j = 0; j < 3; ++j)
+        { ASSERT_NEAR(normalized.get(i)[j], e[j], 9.5e-7f); }
+        ASSERT_NEAR(norms[i], n, n * 9.5e-7f);
+    }
+
+    idlib::normalize<idlib::precision::estimate>(batch, normalized);
+    idlib::euclidean_norm<idlib::precision::estimate>(batch, norms.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const auto e = idlib::normalize(source[i], idlib::euclidean_norm_functor<vector_type>()).get_vector_or_default();
+        const auto n = idlib::euclidean_norm(source[i]);
+        for (size_t j = 0; j < 3; ++j)
+        { ASSERT_NEAR(normalized.get(i)[j], e[j], 3.7e-4f); }
+        ASSERT_NEAR(norms[i], n, n * 3.7e-4f);
+    }
+    // Zero vectors are not modified.
+    ASSERT_EQ(normalized.get(5), idlib::zero<vector_type>());
+    ASSERT_EQ(norms[5], 0.0f);
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+
+namespace idlib::tests {
+
+template <typename Vector>
+struct vector_simd_test : public ::testing::Test
+{};
+
+using vector_simd_test_types = ::testing::Types<idlib::vector<single, 2>, idlib::vector<single, 3>, idlib::vector<single, 4>,
+                                                idlib::vector<double, 2>, idlib::vector<double, 3>, idlib::vector<double, 4>>;
+
+TYPED_TEST_SUITE(vector_simd_test, vector_simd_test_types);
+
+/// @brief Assert the arithmetic operators yield the component-wise results
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(vector_simd_test, arithmetic)
+{
+    using vector_type = TypeParam;
+    using scalar_type = typename vector_type::scalar_type;
+    const auto n = vector_type::dimensionality();
+    const auto u = vector_type::generate([](size_t i) { return scalar_type(i + 1); }),
+               v = vector_type::generate([](size_t i) { return scalar_type(2 * i + 3); });
+    const auto a = u + v, b = u - v, c = u * scalar_type(4), d = v / scalar_type(2), e = -u;
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT_EQ(a[i], u[i] + v[i]);
+        ASSERT_EQ(b[i], u[i] - v[i]);
+        ASSERT_EQ(c[i], u[i] * scalar_type(4));
+        ASSERT_EQ(d[i], v[i] / scalar_type(2));
+        ASSERT_EQ(e[i], -u[i]);
+    }
+    auto f = u;
+    f += v;
+    ASSERT_EQ(f, a);
+    f -= v;
+    ASSERT_EQ(f, u);
+}
+
+/// @brief Assert the dot product and the norms yield the same results as their definitions
+/// (regardless of the instruction set selected for the SIMD backend).
+TYPED_TEST(vector_simd_test, dot_product_and_norms)
+{
+    using vector_type = TypeParam;
+    using scalar_type = typename vector_type::scalar_type;
+    const auto n = vector_type::dimensionality();
+    const auto u = vector_type::generate([](size_t i) { return scalar_type(i + 1); }),
+               v = vector_type::generate([](size_t i) { return scalar_type(2 * i + 3); });
+    scalar_type uv = 0, uu = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        uv += u[i] * v[i];
+        uu += u[i] * u[i];
+    }
+    ASSERT_EQ(idlib::dot_product(u, v), uv);
+    ASSERT_EQ(idlib::squared_euclidean_norm(u), uu);
+    ASSERT_EQ(idlib::euclidean_norm(u), std::sqrt(uu));
+    ASSERT_EQ(idlib::euclidean_norm(idlib::zero<vector_type>()), idlib::zero<scalar_type>());
+}
+
+template <typename Vector>
+struct vector_3_simd_test : public ::testing::Test
+{};
+
+using vector_3_simd_test_types = ::testing::Types<idlib::vector<single, 3>, idlib::vector<double, 3>>;
+
+TYPED_TEST_SUITE(vector_3_simd_test, vector_3_simd_test_types);
+
+/// @brief Assert the cross product of the unit vectors and the cross product of a vector with itself.
+TYPED_TEST(vector_3_simd_test, cross_product)
+{
+    using vector_type = TypeParam;
+    using scalar_type = typename vector_type::scalar_type;
+    const auto x = vector_type::unit(0), y = vector_type::unit(1), z = vector_type::unit(2);
+    ASSERT_EQ(idlib::cross_product(x, y), z);
+    ASSERT_EQ(idlib::cross_product(y, z), x);
+    ASSERT_EQ(idlib::cross_product(z, x), y);
+    ASSERT_EQ(idlib::cross_product(y, x), -z);
+    const vector_type u(scalar_type(1), scalar_type(2), scalar_type(3)),
+                      v(scalar_type(-4), scalar_type(5), scalar_type(7));
+    ASSERT_EQ(idlib::cross_product(u, u), idlib::zero<vector_type>());
+    ASSERT_EQ(idlib::cross_product(u, v), vector_type(scalar_type(2 * 7 - 3 * 5), scalar_type(3 * -4 - 1 * 7), scalar_type(1 * 5 - 2 * -4)));
+}
+
+} // namespace idlib::tests
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/math.hpp"
+
+namespace idlib::tests {
+
+template <typename Vector>
+struct vector_batch_test : public ::testing::Test
+{
+    using vector_type = Vector;
+    using scalar_type = typename vector_type::scalar_type;
+    using batch_type = idlib::vector_batch<scalar_type, vector_type::dimensionality()>;
+
+    /// @brief Get a sequence of vectors. The length of the sequence is not a multiple of the batch granularity.
+    static std::vector<vector_type> get_vectors()
+    {
+        std::vector<vector_type> vectors;
+        for (size_t i = 0; i < 4 * batch_type::granularity() + 3; ++i)
+        {
+            vectors.push_back(vector_type::generate([i](size_t j) { return scalar_type(int(i % 7) - 3 + int(j)); }));
+        }
+        vectors.push_back(idlib::zero<vector_type>());
+        return vectors;
+    }
+};
+
+using vector_batch_test_types = ::testing::Types<idlib::vector<single, 2>, idlib::vector<single, 3>, idlib::vector<single, 4>,
+                                                 idlib::vector<double, 2>, idlib::vector<double, 3>, idlib::vector<double, 4>>;
+
+TYPED_TEST_SUITE(vector_batch_test, vector_batch_test_types);
+
+/// @brief Assert gathering and scattering restores the vectors.
+TYPED_TEST(vector_batch_test, gather_scatter)
+{
+    using vector_type = typename TestFixture::vector_type;
+    using batch_type = typename TestFixture::batch_type;
+    const auto source = TestFixture::get_vectors();
+    batch_type batch(source.data(), source.size());
+    ASSERT_EQ(batch.size(), source.size());
+    ASSERT_EQ(batch.padded_size() % batch_type::granularity(), 0);
+    std::vector<vector_type> target(source.size());
+    batch.scatter(target.data());
+    ASSERT_EQ(source, target);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(batch.get(i), source[i]);
+    }
+    batch.push_back(source[0]);
+    ASSERT_EQ(batch.size(), source.size() + 1);
+    ASSERT_EQ(batch.get(source.size()), source[0]);
+}
+
+/// @brief Assert the batch kernels yield the same results as the functions for single vectors.
+TYPED_TEST(vector_batch_test, norms_and_dot_product)
+{
+    using scalar_type = typename TestFixture::scalar_type;
+    using batch_type = typename TestFixture::batch_type;
+    const auto source = TestFixture::get_vectors();
+    const batch_type batch(source.data(), source.size());
+    std::vector<scalar_type> a(source.size()), b(source.size()), c(source.size());
+    idlib::squared_euclidean_norm(batch, a.data());
+    idlib::euclidean_norm(batch, b.data());
+    idlib::dot_product(batch, batch, c.data());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(a[i], idlib::squared_euclidean_norm(source[i]));
+        ASSERT_EQ(b[i], idlib::euclidean_norm(source[i]));
+        ASSERT_EQ(c[i], idlib::dot_product(source[i], source[i]));
+    }
+    ASSERT_THROW(idlib::dot_product(batch, batch_type(1), c.data()), std::invalid_argument);
+}
+
+/// @brief Assert normalization, the zip functions, and scalar multiplication yield the same results as the functions for single vectors.
+TYPED_TEST(vector_batch_test, normalize_zip_scale)
+{
+    using vector_type = typename TestFixture::vector_type;
+    using scalar_type = typename TestFixture::scalar_type;
+    using batch_type = typename TestFixture::batch_type;
+    const auto source = TestFixture::get_vectors();
+    std::vector<vector_type> reversed(source.rbegin(), source.rend());
+    const batch_type u(source.data(), source.size()), v(reversed.data(), reversed.size());
+    batch_type a, b, c, d(u);
+    idlib::normalize(u, a);
+    idlib::zip_min(u, v, b);
+    idlib::zip_max(u, v, c);
+    d *= scalar_type(3);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(a.get(i), idlib::normalize(source[i], idlib::euclidean_norm_functor<vector_type>()).get_vector_or_default());
+        ASSERT_EQ(b.get(i), idlib::zip_min(source[i], reversed[i]));
+        ASSERT_EQ(c.get(i), idlib::zip_max(source[i], reversed[i]));
+        ASSERT_EQ(d.get(i), source[i] * scalar_type(3));
+    }
+    // In-place normalization.
+    idlib::normalize(d, d);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(d.get(i), idlib::normalize(source[i] * scalar_type(3), idlib::euclidean_norm_functor<vector_type>()).get_vector_or_default());
+    }
+}
+
+template <typename Scalar>
+struct vector_batch_3_test : public ::testing::Test
+{};
+
+using vector_batch_3_test_types = ::testing::Types<single, double>;
+
+TYPED_TEST_SUITE(vector_batch_3_test, vector_batch_3_test_types);
+
+/// @brief Assert the cross products of a batch yield the same results as the cross products of single vectors.
+TYPED_TEST(vector_batch_3_test, cross_product)
+{
+    using scalar_type = TypeParam;
+    using vector_type = idlib::vector<scalar_type, 3>;
+    std::vector<vector_type> u, v;
+    for (int i = 0; i < 13; ++i)
+    {
+        u.emplace_back(scalar_type(i), scalar_type(i - 2), scalar_type(3 - i));
+        v.emplace_back(scalar_type(1 - i), scalar_type(2 * i), scalar_type(5));
+    }
+    idlib::vector_batch<scalar_type, 3> a(u.data(), u.size()), b(v.data(), v.size());
+    idlib::cross_product(a, b, a);
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        ASSERT_EQ(a.get(i), idlib::cross_product(u[i], v[i]));
+    }
+}
+
+} // namespace idlib::tests
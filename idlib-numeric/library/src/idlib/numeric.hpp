@@ -75,6 +75,11 @@
 #include "idlib/numeric/sq_floating_point.hpp"
 #include "idlib/numeric/sq_integer.hpp"
 
+#include "idlib/numeric/precision.hpp"
+
+#include "idlib/numeric/rsqrt.hpp"
+#include "idlib/numeric/rsqrt_floating_point.hpp"
+
 #include "idlib/numeric/sqrt.hpp"
 #include "idlib/numeric/sqrt_floating_point.hpp"
 
@@ -53,7 +53,7 @@ struct one_functor;
 /// @tparam T the type
 /// @return the one value of the type @a T
 template <typename T>
-decltype(auto) one()
+constexpr decltype(auto) one()
 { return one_functor<T>()(); }
 
 } // namespace idlib
@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/numeric.hpp` instead)
+#endif
+
+namespace idlib {
+
+/// @brief Precision policies of functions which can be computed by faster approximations.
+/// @remark A policy is an upper bound for the relative error.
+/// If no faster approximation meeting that bound is available for a type, the function is computed more precisely.
+/// In particular, all policies compute the exact result for @a double.
+enum class precision
+{
+    /// @brief The result is as precise as the result of the standard library functions.
+    exact,
+    /// @brief An estimate refined by one Newton-Raphson step.
+    /// The relative error is at most \f$2^{-20} \approx 9.5 \cdot 10^{-7}\f$.
+    newton_raphson,
+    /// @brief A hardware estimate.
+    /// The relative error is at most \f$1.5 \cdot 2^{-12} \approx 3.7 \cdot 10^{-4}\f$.
+    estimate,
+}; // enum class precision
+
+} // namespace idlib
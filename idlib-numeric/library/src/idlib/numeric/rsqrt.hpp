@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/numeric.hpp` instead)
+#endif
+
+namespace idlib {
+
+/// @brief Functor computing the reciprocal of the square root.
+/// @remark Normalizing a vector by multiplying with the reciprocal of the square root of its squared length
+/// is considerably faster than computing the square root and dividing by it if an approximation is acceptable.
+/// @tparam T the type
+/// @tparam P the precision policy
+/// @tparam Enabled for SFINAE
+template <typename T, precision P = precision::exact, typename Enabled = void>
+struct rsqrt_functor;
+
+/// @brief The function corresponding to idlib::rsqrt_functor.
+template <precision P = precision::exact, typename T>
+auto rsqrt(const T& v)
+{ return rsqrt_functor<T, P>()(v); }
+
+} // namespace idlib
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/numeric.hpp` instead)
+#endif
+
+#pragma push_macro("IDLIB_PRIVATE")
+#undef IDLIB_PRIVATE
+#define IDLIB_PRIVATE (1)
+
+#include "idlib/numeric/precision.hpp"
+#include "idlib/numeric/rsqrt.hpp"
+
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define IDLIB_NUMERIC_HAS_RSQRT_ESTIMATE (1)
+    #include <xmmintrin.h>
+#else
+    #define IDLIB_NUMERIC_HAS_RSQRT_ESTIMATE (0)
+#endif
+
+namespace idlib {
+
+/// @remark The approximations require @a x to be positive and finite.
+template <typename T, precision P>
+struct rsqrt_functor<T, P, std::enable_if_t<std::is_floating_point<T>::value>>
+{
+	T operator()(T x) const
+	{ return impl(x, std::integral_constant<bool, P != precision::exact && std::is_same<T, float>::value>{}); }
+
+private:
+	static T impl(T x, std::false_type)
+	{ return T(1) / std::sqrt(x); }
+
+	static T impl(T x, std::true_type)
+	{
+		const float y = estimate(x);
+		return P == precision::newton_raphson ? newton_raphson(x, y) : y;
+	}
+
+	// One Newton-Raphson step for f(y) = 1/y^2 - x squares the relative error of the estimate y.
+	static float newton_raphson(float x, float y)
+	{ return y * (1.5f - 0.5f * x * y * y); }
+
+#if IDLIB_NUMERIC_HAS_RSQRT_ESTIMATE == 1
+	static float estimate(float x)
+	{ return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x))); }
+#else
+	// Without a hardware estimate, the initial guess obtained from the bit representation of x
+	// (relative error below 3.5e-3) is refined by two Newton-Raphson steps.
+	static float estimate(float x)
+	{
+		std::uint32_t i;
+		std::memcpy(&i, &x, sizeof(float));
+		i = 0x5f3759df - (i >> 1);
+		float y;
+		std::memcpy(&y, &i, sizeof(float));
+		return newton_raphson(x, newton_raphson(x, y));
+	}
+#endif
+}; // struct rsqrt_functor
+
+} // namespace idlib
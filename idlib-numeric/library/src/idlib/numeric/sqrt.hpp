@@ -33,13 +33,14 @@ namespace idlib {
 /// @brief Functor computing the square root (NOT the square).
 /// @remark Specializations for @a single, @a double, and @a quadruple are provided.
 /// @tparam T the type
+/// @tparam P the precision policy
 /// @tparam Enabled for SFINAE
-template <typename T, typename Enabled = void>
+template <typename T, precision P = precision::exact, typename Enabled = void>
 struct sqrt_functor;
 
 /// @brief The function corresponding to idlib::sqrt_functor.
-template <typename T>
+template <precision P = precision::exact, typename T>
 auto sqrt(const T& v)
-{ return sq_functor<T>()(v); }
+{ return sqrt_functor<T, P>()(v); }
 
 } // namespace idlib
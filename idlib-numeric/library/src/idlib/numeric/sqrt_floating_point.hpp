@@ -32,6 +32,8 @@
 #undef IDLIB_PRIVATE
 #define IDLIB_PRIVATE (1)
 
+#include "idlib/numeric/precision.hpp"
+#include "idlib/numeric/rsqrt_floating_point.hpp"
 #include "idlib/numeric/sqrt.hpp"
 
 #undef IDLIB_PRIVATE
@@ -42,11 +44,19 @@
 
 namespace idlib {
 
-template <typename T>
-struct sqrt_functor<T, std::enable_if_t<std::is_floating_point<T>::value>>
+/// @remark The approximations are available for @a single only and compute \f$x \cdot \frac{1}{\sqrt{x}}\f$ for positive @a x and require @a x to be finite.
+template <typename T, precision P>
+struct sqrt_functor<T, P, std::enable_if_t<std::is_floating_point<T>::value>>
 {
 	T operator()(T x) const
+	{ return impl(x, std::integral_constant<bool, P == precision::exact || !std::is_same<T, float>::value>{}); }
+
+private:
+	static T impl(T x, std::true_type)
 	{ return std::sqrt(x); }
-}; // struct sq_functor
+
+	static T impl(T x, std::false_type)
+	{ return x > T(0) ? x * rsqrt_functor<T, P>()(x) : x; }
+}; // struct sqrt_functor
 
 } // namespace idlib
@@ -60,7 +60,7 @@ struct zero_functor;
 /// @tparam T the type
 /// @return the zero value of the type @a T
 template <typename T>
-decltype(auto) zero()
+constexpr decltype(auto) zero()
 { return zero_functor<T>()(); }
 
 } // namespace idlib
@@ -86,11 +86,11 @@ template <typename Derived>
 class equal_to_expr
 {
 public:
-    bool operator==(const Derived& other) const
+    constexpr bool operator==(const Derived& other) const
     {
         return static_cast<const Derived *>(this)->equal_to(other);
     }
-    bool operator!=(const Derived& other) const
+    constexpr bool operator!=(const Derived& other) const
     {
         return !(*static_cast<const Derived *>(this) == other);
     }